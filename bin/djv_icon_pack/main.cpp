@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCmdLineApp/Application.h>
+
+#include <djvUI/IconPack.h>
+
+#include <djvAV/IOSystem.h>
+
+#include <djvImage/Data.h>
+
+#include <djvSystem/Context.h>
+#include <djvSystem/File.h>
+#include <djvSystem/FileInfoFunc.h>
+#include <djvSystem/TextSystem.h>
+#include <djvSystem/TimerFunc.h>
+
+#include <djvCore/ErrorFunc.h>
+
+#include <iostream>
+#include <thread>
+
+using namespace djv;
+
+//! This application creates the icon pack (see UI::IconPack) from the icons
+//! in the DPI directories. It is run at build time.
+class Application : public CmdLine::Application
+{
+    DJV_NON_COPYABLE(Application);
+
+protected:
+    void _init(std::list<std::string>& args)
+    {
+        CmdLine::Application::_init(args);
+        _parseCmdLine(args);
+    }
+
+    Application()
+    {}
+
+public:
+    ~Application() override
+    {}
+
+    static std::shared_ptr<Application> create(std::list<std::string>& args)
+    {
+        auto out = std::shared_ptr<Application>(new Application);
+        out->_init(args);
+        return out;
+    }
+
+    void run() override
+    {
+        auto iconPack = UI::IconPack::create();
+        size_t errors = 0;
+        for (const auto& i : System::File::directoryList(System::File::Path(_input)))
+        {
+            // Find the DPI directories.
+            const std::string fileName = i.getFileName(Math::Frame::invalid, false);
+            const size_t size = fileName.size();
+            if (System::File::Type::Directory == i.getType() &&
+                size > 3 &&
+                fileName[size - 3] == 'D' &&
+                fileName[size - 2] == 'P' &&
+                fileName[size - 1] == 'I')
+            {
+                const uint16_t dpi = static_cast<uint16_t>(std::stoi(fileName.substr(0, size - 3)));
+                for (const auto& j : System::File::directoryList(i.getPath()))
+                {
+                    if (".png" == j.getPath().getExtension())
+                    {
+                        try
+                        {
+                            iconPack->addIcon(j.getPath().getBaseName(), dpi, _read(j));
+                        }
+                        catch (const std::exception& e)
+                        {
+                            std::cerr << Core::Error::format(e) << std::endl;
+                            ++errors;
+                        }
+                    }
+                }
+            }
+        }
+        try
+        {
+            iconPack->write(_output);
+            std::cout << _output << ": " << iconPack->getCount() << " icons" << std::endl;
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << Core::Error::format(e) << std::endl;
+            exit(1);
+        }
+        if (errors > 0)
+        {
+            exit(1);
+        }
+    }
+
+protected:
+    void _parseCmdLine(std::list<std::string>& args) override
+    {
+        CmdLine::Application::_parseCmdLine(args);
+        if (0 == getExitCode())
+        {
+            if (!args.size())
+            {
+                _printUsage();
+                exit(1);
+            }
+            else if (2 == args.size())
+            {
+                _input = args.front();
+                args.pop_front();
+                _output = args.front();
+                args.pop_front();
+            }
+            else
+            {
+                auto textSystem = getSystemT<System::TextSystem>();
+                throw std::runtime_error(textSystem->getText(DJV_TEXT("djv_icon_pack_args_error")));
+            }
+        }
+    }
+
+    void _printUsage() override
+    {
+        auto textSystem = getSystemT<System::TextSystem>();
+        std::cout << std::endl;
+        std::cout << " " << textSystem->getText(DJV_TEXT("djv_icon_pack_description")) << std::endl;
+        std::cout << std::endl;
+        std::cout << " " << textSystem->getText(DJV_TEXT("djv_icon_pack_usage")) << std::endl;
+        std::cout << std::endl;
+        std::cout << "   " << textSystem->getText(DJV_TEXT("djv_icon_pack_usage_format")) << std::endl;
+        std::cout << std::endl;
+
+        CmdLine::Application::_printUsage();
+    }
+
+private:
+    std::shared_ptr<Image::Data> _read(const System::File::Info& fileInfo)
+    {
+        std::shared_ptr<Image::Data> out;
+        auto read = getSystemT<AV::IO::IOSystem>()->read(fileInfo);
+        const auto timeout = System::getTimerValue(System::TimerValue::VeryFast);
+        bool finished = false;
+        while (!out && !finished)
+        {
+            {
+                std::lock_guard<std::mutex> lock(read->getMutex());
+                auto& queue = read->getVideoQueue();
+                if (!queue.isEmpty())
+                {
+                    out = queue.popFrame().data;
+                }
+                else if (queue.isFinished())
+                {
+                    finished = true;
+                }
+            }
+            if (!out && !finished)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+            }
+        }
+        if (!out)
+        {
+            //! \todo How can we translate this?
+            throw System::File::Error(fileInfo.getFileName() + ": Cannot read.");
+        }
+        return out;
+    }
+
+    std::string _input;
+    std::string _output;
+};
+
+DJV_MAIN()
+{
+    int r = 1;
+    try
+    {
+        auto args = Application::args(argc, argv);
+        auto app = Application::create(args);
+        if (0 == app->getExitCode())
+        {
+            app->run();
+        }
+        r = app->getExitCode();
+    }
+    catch (const std::exception& error)
+    {
+        std::cerr << Core::Error::format(error) << std::endl;
+    }
+    return r;
+}
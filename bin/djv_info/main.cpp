@@ -6,6 +6,7 @@
 
 #include <djvAV/AVSystem.h>
 #include <djvAV/IOSystem.h>
+#include <djvAV/InfoCache.h>
 #include <djvAV/TimeFunc.h>
 
 #include <djvImage/InfoFunc.h>
@@ -13,6 +14,7 @@
 #include <djvSystem/Context.h>
 #include <djvSystem/FileInfoFunc.h>
 #include <djvSystem/PathFunc.h>
+#include <djvSystem/ResourceSystem.h>
 #include <djvSystem/TextSystem.h>
 
 #include <djvCore/ErrorFunc.h>
@@ -31,6 +33,20 @@ protected:
 
         _textSystem = getSystemT<System::TextSystem>();
 
+        _infoCache = AV::IO::InfoCache::create();
+        auto resourceSystem = getSystemT<System::ResourceSystem>();
+        _infoCacheFileName = System::File::Path(
+            resourceSystem->getPath(System::File::ResourcePath::Documents),
+            AV::IO::infoCacheFileName).get();
+        try
+        {
+            _infoCache->read(_infoCacheFileName);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << Core::Error::format(e) << std::endl;
+        }
+
         _parseCmdLine(args);
 
         bool hasInputs = args.size();
@@ -44,7 +60,7 @@ protected:
             else
             {
                 auto textSystem = getSystemT<System::TextSystem>();
-                std::cout << Core::Error::format(Core::String::Format("{0}: {1}").
+                std::cerr << Core::Error::format(Core::String::Format("{0}: {1}").
                     arg(fileInfo.getFileName()).
                     arg(textSystem->getText(DJV_TEXT("error_file_open")))) << std::endl;
             }
@@ -97,6 +113,17 @@ public:
             default: break;
             }
         }
+        if (_infoCache->isDirty())
+        {
+            try
+            {
+                _infoCache->write(_infoCacheFileName);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << Core::Error::format(e) << std::endl;
+            }
+        }
     }
 
 protected:
@@ -121,8 +148,13 @@ private:
         {
             try
             {
-                const auto read = io->read(fileInfo);
-                const auto info = read->getInfo().get();
+                AV::IO::Info info;
+                if (!_infoCache->get(fileInfo, info))
+                {
+                    const auto read = io->read(fileInfo);
+                    info = read->getInfo().get();
+                    _infoCache->add(fileInfo, info);
+                }
                 std::cout << fileInfo << std::endl;
                 std::cout.precision(2);
                 if (info.videoSequence.getFrameCount() > 1)
@@ -157,12 +189,14 @@ private:
             }
             catch (const std::exception & e)
             {
-                std::cout << Core::Error::format(e) << std::endl;
+                std::cerr << Core::Error::format(e) << std::endl;
             }
         }
     }
 
     std::shared_ptr<System::TextSystem> _textSystem;
+    std::shared_ptr<AV::IO::InfoCache> _infoCache;
+    std::string _infoCacheFileName;
     std::vector<System::File::Info> _inputs;
 };
 
@@ -181,7 +215,7 @@ DJV_MAIN()
     }
     catch (const std::exception & error)
     {
-        std::cout << Core::Error::format(error) << std::endl;
+        std::cerr << Core::Error::format(error) << std::endl;
     }
     return r;
 }
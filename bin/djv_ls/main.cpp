@@ -14,8 +14,70 @@
 #include <djvCore/ErrorFunc.h>
 #include <djvCore/StringFormat.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <iomanip>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+
 using namespace djv;
 
+namespace
+{
+    const size_t threadCountMax = 64;
+
+    size_t getThreadCountDefault()
+    {
+        return std::min(std::max(static_cast<size_t>(std::thread::hardware_concurrency()), size_t(4)), size_t(16));
+    }
+
+    std::string escapeJSON(const std::string& value)
+    {
+        std::stringstream ss;
+        for (const auto i : value)
+        {
+            switch (i)
+            {
+            case '"':  ss << "\\\""; break;
+            case '\\': ss << "\\\\"; break;
+            case '\b': ss << "\\b"; break;
+            case '\f': ss << "\\f"; break;
+            case '\n': ss << "\\n"; break;
+            case '\r': ss << "\\r"; break;
+            case '\t': ss << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(i) < 0x20)
+                {
+                    ss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(i) << std::dec;
+                }
+                else
+                {
+                    ss << i;
+                }
+                break;
+            }
+        }
+        return ss.str();
+    }
+
+    std::string getTypeJSON(System::File::Type value)
+    {
+        std::string out;
+        switch (value)
+        {
+        case System::File::Type::File:      out = "file";      break;
+        case System::File::Type::Sequence:  out = "sequence";  break;
+        case System::File::Type::Directory: out = "directory"; break;
+        default: break;
+        }
+        return out;
+    }
+
+} // namespace
+
 class Application : public CmdLine::Application
 {
     DJV_NON_COPYABLE(Application);
@@ -65,31 +127,95 @@ public:
     void run() override
     {
         auto io = getSystemT<AV::IO::IOSystem>();
+        _options.sequences = true;
+        _options.sequenceExtensions = io->getSequenceExtensions();
+        _options.stat = false;
+
         for (const auto& i : _inputs)
         {
             switch (i.getType())
             {
             case System::File::Type::File:
-                _print(std::string(i));
-                break;
-            case System::File::Type::Directory:
-            {
-                std::cout << i.getPath() << ":" << std::endl;
-                System::File::DirectoryListOptions options;
-                options.sequences = true;
-                options.sequenceExtensions = io->getSequenceExtensions();
-                for (const auto& j : System::File::directoryList(i.getPath(), options))
+                if (_json)
+                {
+                    _print(i.getPath().getDirectoryName(), { i });
+                }
+                else
                 {
-                    _print(j.getFileName(Math::Frame::invalid, false));
+                    std::cout << std::string(i) << std::endl;
                 }
                 break;
-            }
+            case System::File::Type::Directory:
+                _queueDirectory(i.getPath());
+                break;
             default: break;
             }
         }
+
+        // Crawl the directories. Each directory is listed and printed as soon
+        // as it is finished, and in recursive mode the sub-directories are
+        // added to the queue.
+        std::vector<std::thread> threads;
+        const size_t threadCount = _recursive ? _threadCount : std::min(_threadCount, _queue.size());
+        for (size_t i = 0; i < threadCount; ++i)
+        {
+            threads.push_back(std::thread([this] { _work(); }));
+        }
+        for (auto& i : threads)
+        {
+            i.join();
+        }
     }
 
 protected:
+    void _parseCmdLine(std::list<std::string>& args) override
+    {
+        CmdLine::Application::_parseCmdLine(args);
+        if (0 == getExitCode())
+        {
+            auto textSystem = getSystemT<System::TextSystem>();
+            auto i = args.begin();
+            while (i != args.end())
+            {
+                if ("-recursive" == *i)
+                {
+                    i = args.erase(i);
+                    _recursive = true;
+                }
+                else if ("-json" == *i)
+                {
+                    i = args.erase(i);
+                    _json = true;
+                }
+                else if ("-threads" == *i)
+                {
+                    i = args.erase(i);
+                    if (args.end() == i)
+                    {
+                        throw std::runtime_error(Core::String::Format("{0}: {1}").
+                            arg("-threads").
+                            arg(textSystem->getText(DJV_TEXT("error_cannot_parse_argument"))));
+                    }
+                    size_t value = 0;
+                    std::stringstream ss(*i);
+                    ss >> value;
+                    if (ss.fail() || 0 == value || value > threadCountMax)
+                    {
+                        throw std::runtime_error(Core::String::Format("{0}: {1}").
+                            arg("-threads").
+                            arg(textSystem->getText(DJV_TEXT("error_cannot_parse_argument"))));
+                    }
+                    i = args.erase(i);
+                    _threadCount = value;
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+        }
+    }
+
     void _printUsage() override
     {
         auto textSystem = getSystemT<System::TextSystem>();
@@ -100,17 +226,153 @@ protected:
         std::cout << std::endl;
         std::cout << "   " << textSystem->getText(DJV_TEXT("djv_ls_usage_format")) << std::endl;
         std::cout << std::endl;
+        std::cout << " " << textSystem->getText(DJV_TEXT("djv_ls_options")) << std::endl;
+        std::cout << std::endl;
+        std::cout << "   " << textSystem->getText(DJV_TEXT("djv_ls_option_recursive")) << std::endl;
+        std::cout << "   " << textSystem->getText(DJV_TEXT("djv_ls_option_recursive_description")) << std::endl;
+        std::cout << std::endl;
+        std::cout << "   " << textSystem->getText(DJV_TEXT("djv_ls_option_json")) << std::endl;
+        std::cout << "   " << textSystem->getText(DJV_TEXT("djv_ls_option_json_description")) << std::endl;
+        std::cout << std::endl;
+        std::cout << "   " << textSystem->getText(DJV_TEXT("djv_ls_option_threads")) << std::endl;
+        std::cout << "   " << textSystem->getText(DJV_TEXT("djv_ls_option_threads_description")) << getThreadCountDefault() << std::endl;
+        std::cout << std::endl;
 
         CmdLine::Application::_printUsage();
     }
 
     std::vector<System::File::Info> _inputs;
+    bool _recursive = false;
+    bool _json = false;
+    size_t _threadCount = getThreadCountDefault();
 
 private:
-    void _print(const std::string & fileName)
+    // This function must be called with the queue mutex locked, or before
+    // the threads are started.
+    void _queueDirectory(const System::File::Path& value)
+    {
+        // Guard against symbolic links that create loops.
+        std::string key = value.get();
+        try
+        {
+            key = System::File::getAbsolute(System::File::Path(value, ".")).get();
+        }
+        catch (const std::exception&)
+        {}
+        if (_visited.insert(key).second)
+        {
+            _queue.push_back(value);
+        }
+    }
+
+    void _work()
+    {
+        while (true)
+        {
+            System::File::Path path;
+            {
+                std::unique_lock<std::mutex> lock(_queueMutex);
+                _queueCV.wait(
+                    lock,
+                    [this]
+                    {
+                        return _queue.size() || 0 == _active;
+                    });
+                if (_queue.empty())
+                {
+                    break;
+                }
+                path = _queue.front();
+                _queue.pop_front();
+                ++_active;
+            }
+
+            std::vector<System::File::Info> items;
+            try
+            {
+                items = System::File::directoryList(path, _options);
+            }
+            catch (const std::exception& e)
+            {
+                std::lock_guard<std::mutex> lock(_outputMutex);
+                std::cout << Core::Error::format(e) << std::endl;
+            }
+            _print(path.get(), items);
+
+            {
+                std::lock_guard<std::mutex> lock(_queueMutex);
+                if (_recursive)
+                {
+                    for (const auto& i : items)
+                    {
+                        if (System::File::Type::Directory == i.getType())
+                        {
+                            _queueDirectory(i.getPath());
+                        }
+                    }
+                }
+                --_active;
+            }
+            _queueCV.notify_all();
+        }
+    }
+
+    void _print(const std::string& path, const std::vector<System::File::Info>& items)
     {
-        std::cout << fileName << std::endl;
+        // Format the output before locking so the threads only serialize on
+        // writing it.
+        std::stringstream ss;
+        if (_json)
+        {
+            ss << "{\"path\":\"" << escapeJSON(path) << "\",\"items\":[";
+            for (size_t i = 0; i < items.size(); ++i)
+            {
+                const auto& item = items[i];
+                if (i > 0)
+                {
+                    ss << ",";
+                }
+                ss << "{\"name\":\"" << escapeJSON(item.getFileName(Math::Frame::invalid, false)) << "\"";
+                ss << ",\"type\":\"" << getTypeJSON(item.getType()) << "\"";
+                if (System::File::Type::Sequence == item.getType())
+                {
+                    const auto& sequence = item.getSequence();
+                    ss << ",\"frames\":[";
+                    const auto& ranges = sequence.getRanges();
+                    for (size_t j = 0; j < ranges.size(); ++j)
+                    {
+                        if (j > 0)
+                        {
+                            ss << ",";
+                        }
+                        ss << "[" << ranges[j].getMin() << "," << ranges[j].getMax() << "]";
+                    }
+                    ss << "],\"pad\":" << sequence.getPad();
+                    ss << ",\"frameCount\":" << sequence.getFrameCount();
+                }
+                ss << "}";
+            }
+            ss << "]}\n";
+        }
+        else
+        {
+            ss << path << ":\n";
+            for (const auto& i : items)
+            {
+                ss << i.getFileName(Math::Frame::invalid, false) << "\n";
+            }
+        }
+        std::lock_guard<std::mutex> lock(_outputMutex);
+        std::cout << ss.str() << std::flush;
     }
+
+    System::File::DirectoryListOptions _options;
+    std::deque<System::File::Path> _queue;
+    std::set<std::string> _visited;
+    size_t _active = 0;
+    std::mutex _queueMutex;
+    std::condition_variable _queueCV;
+    std::mutex _outputMutex;
 };
 
 DJV_MAIN()
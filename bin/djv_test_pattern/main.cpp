@@ -182,6 +182,11 @@ void Application::tick()
     {
         exit(0);
     }
+    else
+    {
+        // Keep ticking until the writer has finished.
+        requestTick();
+    }
 }
 
 void Application::_parseCmdLine(std::list<std::string>& args)
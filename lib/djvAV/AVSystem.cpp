@@ -10,7 +10,6 @@
 
 #include <djvOCIO/OCIOSystem.h>
 
-#include <djvGL/GLFWSystem.h>
 #include <djvGL/ShaderSystem.h>
 
 #include <djvAudio/AudioSystem.h>
@@ -41,13 +40,11 @@ namespace djv
             p.defaultSpeed = Observer::ValueSubject<FPS>::create(getDefaultSpeed());
 
             auto audioSystem = Audio::AudioSystem::create(context);
-            auto glfwSystem = GL::GLFW::GLFWSystem::create(context);
             auto shaderSystem = GL::ShaderSystem::create(context);
             auto ocioSystem = OCIO::OCIOSystem::create(context);
             auto ioSystem = IO::IOSystem::create(context);
             p.thumbnailSystem = ThumbnailSystem::create(context);
             addDependency(audioSystem);
-            addDependency(glfwSystem);
             addDependency(shaderSystem);
             addDependency(ocioSystem);
             addDependency(ioSystem);
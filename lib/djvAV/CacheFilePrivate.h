@@ -0,0 +1,271 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvImage/Info.h>
+#include <djvImage/Tags.h>
+
+#include <djvSystem/File.h>
+#include <djvSystem/FileIO.h>
+#include <djvSystem/FileInfo.h>
+
+#include <djvMath/FrameNumberFunc.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            //! This class provides a writer for binary cache files.
+            //!
+            //! The cache files are local to a machine so values are written
+            //! in the native byte order.
+            class CacheFileWriter
+            {
+            public:
+                explicit CacheFileWriter(std::vector<uint8_t>& data) :
+                    _data(data)
+                {}
+
+                template<typename T>
+                void write(T value)
+                {
+                    const size_t size = _data.size();
+                    _data.resize(size + sizeof(T));
+                    memcpy(_data.data() + size, &value, sizeof(T));
+                }
+
+                void write(const void* value, size_t byteCount)
+                {
+                    const size_t size = _data.size();
+                    _data.resize(size + byteCount);
+                    if (byteCount)
+                    {
+                        memcpy(_data.data() + size, value, byteCount);
+                    }
+                }
+
+                void write(const std::string& value)
+                {
+                    write(static_cast<uint32_t>(value.size()));
+                    write(value.data(), value.size());
+                }
+
+            private:
+                std::vector<uint8_t>& _data;
+            };
+
+            //! This class provides a reader for binary cache files.
+            class CacheFileReader
+            {
+            public:
+                CacheFileReader(const uint8_t* data, size_t size) :
+                    _p(data),
+                    _end(data + size)
+                {}
+
+                bool isEOF() const
+                {
+                    return _p >= _end;
+                }
+
+                //! Throws:
+                //! - System::File::Error
+                template<typename T>
+                T read()
+                {
+                    T out;
+                    memcpy(&out, _get(sizeof(T)), sizeof(T));
+                    return out;
+                }
+
+                //! Throws:
+                //! - System::File::Error
+                const uint8_t* read(size_t byteCount)
+                {
+                    return _get(byteCount);
+                }
+
+                //! Throws:
+                //! - System::File::Error
+                std::string readString()
+                {
+                    const size_t size = read<uint32_t>();
+                    const uint8_t* p = _get(size);
+                    return std::string(reinterpret_cast<const char*>(p), size);
+                }
+
+            private:
+                const uint8_t* _get(size_t byteCount)
+                {
+                    if (byteCount > static_cast<size_t>(_end - _p))
+                    {
+                        //! \todo How can we translate this?
+                        throw System::File::Error("Unexpected end of cache file.");
+                    }
+                    const uint8_t* out = _p;
+                    _p += byteCount;
+                    return out;
+                }
+
+                const uint8_t* _p   = nullptr;
+                const uint8_t* _end = nullptr;
+            };
+
+            //! Get the cache key for a file. Sequences are keyed without their
+            //! frame numbers so that a sequence which gains new frames replaces
+            //! the old entry.
+            inline std::string getCacheKey(const System::File::Info& fileInfo)
+            {
+                const auto& path = fileInfo.getPath();
+                std::string out = path.getDirectoryName() + path.getBaseName();
+                out += System::File::Type::Sequence == fileInfo.getType() ? std::string("#") : path.getNumber();
+                out += path.getExtension();
+                return out;
+            }
+
+            //! Get the sequence frame numbers used to validate a cache entry.
+            inline std::string getCacheSequence(const System::File::Info& fileInfo)
+            {
+                return System::File::Type::Sequence == fileInfo.getType() ?
+                    Math::Frame::toString(fileInfo.getSequence()) :
+                    std::string();
+            }
+
+            inline void writeImageInfo(CacheFileWriter& writer, const Image::Info& value)
+            {
+                writer.write(value.name);
+                writer.write(static_cast<uint16_t>(value.size.w));
+                writer.write(static_cast<uint16_t>(value.size.h));
+                writer.write(static_cast<float>(value.pixelAspectRatio));
+                writer.write(static_cast<uint8_t>(value.type));
+                writer.write(static_cast<uint8_t>(value.layout.mirror.x));
+                writer.write(static_cast<uint8_t>(value.layout.mirror.y));
+                writer.write(static_cast<int32_t>(value.layout.alignment));
+                writer.write(static_cast<uint8_t>(value.layout.endian));
+                writer.write(value.codec);
+            }
+
+            //! Throws:
+            //! - System::File::Error
+            inline Image::Info readImageInfo(CacheFileReader& reader)
+            {
+                Image::Info out;
+                out.name = reader.readString();
+                out.size.w = reader.read<uint16_t>();
+                out.size.h = reader.read<uint16_t>();
+                out.pixelAspectRatio = reader.read<float>();
+                out.type = static_cast<Image::Type>(reader.read<uint8_t>());
+                out.layout.mirror.x = reader.read<uint8_t>() != 0;
+                out.layout.mirror.y = reader.read<uint8_t>() != 0;
+                out.layout.alignment = reader.read<int32_t>();
+                out.layout.endian = static_cast<Core::Memory::Endian>(reader.read<uint8_t>());
+                out.codec = reader.readString();
+                return out;
+            }
+
+            inline void writeTags(CacheFileWriter& writer, const Image::Tags& value)
+            {
+                const auto& tags = value.get();
+                writer.write(static_cast<uint32_t>(tags.size()));
+                for (const auto& i : tags)
+                {
+                    writer.write(i.first);
+                    writer.write(i.second);
+                }
+            }
+
+            //! Throws:
+            //! - System::File::Error
+            inline Image::Tags readTags(CacheFileReader& reader)
+            {
+                Image::Tags out;
+                const uint32_t count = reader.read<uint32_t>();
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    const std::string key = reader.readString();
+                    const std::string value = reader.readString();
+                    out.set(key, value);
+                }
+                return out;
+            }
+
+            //! Read the contents of a cache file. Returns false if the file
+            //! does not exist.
+            //! Throws:
+            //! - System::File::Error
+            inline bool readCacheFile(const std::string& fileName, std::vector<uint8_t>& out)
+            {
+                if (!System::File::Info(fileName).doesExist())
+                {
+                    return false;
+                }
+                auto io = System::File::IO::create();
+                io->open(fileName, System::File::Mode::Read);
+                out.resize(io->getSize());
+                if (out.size())
+                {
+                    io->read(out.data(), out.size());
+                }
+                return true;
+            }
+
+            //! Rename a temporary cache file to the final file name.
+            //! Throws:
+            //! - System::File::Error
+            inline void renameCacheFile(const std::string& tmp, const std::string& fileName)
+            {
+                if (std::rename(tmp.c_str(), fileName.c_str()) != 0)
+                {
+                    // Windows cannot rename over an existing file.
+                    std::remove(fileName.c_str());
+                    if (std::rename(tmp.c_str(), fileName.c_str()) != 0)
+                    {
+                        std::remove(tmp.c_str());
+                        //! \todo How can we translate this?
+                        throw System::File::Error(fileName + ": Cannot write.");
+                    }
+                }
+            }
+
+            //! Get a temporary file name for writing a cache file.
+            inline std::string getCacheTempFileName(const std::string& fileName)
+            {
+                return fileName + "." +
+                    std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".tmp";
+            }
+
+            //! Write the contents of a cache file. The data is written to a
+            //! temporary file first and then renamed so that other processes
+            //! never read a partially written file.
+            //! Throws:
+            //! - System::File::Error
+            inline void writeCacheFile(const std::string& fileName, const std::vector<uint8_t>& data)
+            {
+                const std::string tmp = getCacheTempFileName(fileName);
+                try
+                {
+                    auto io = System::File::IO::create();
+                    io->open(tmp, System::File::Mode::Write);
+                    io->write(data.data(), data.size());
+                }
+                catch (const std::exception&)
+                {
+                    std::remove(tmp.c_str());
+                    throw;
+                }
+                renameCacheFile(tmp, fileName);
+            }
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
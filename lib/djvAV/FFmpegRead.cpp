@@ -4,6 +4,8 @@
 
 #include <djvAV/FFmpegFunc.h>
 
+#include <djvImage/DataFunc.h>
+
 #include <djvSystem/File.h>
 #include <djvSystem/LogSystem.h>
 #include <djvSystem/TimerFunc.h>
@@ -49,6 +51,7 @@ namespace djv
                     AVFrame* avFrame = nullptr;
                     AVFrame* avFrameRgb = nullptr;
                     SwsContext* swsContext = nullptr;
+                    Image::Size proxySize;
                 };
 
                 void Read::_init(
@@ -164,13 +167,20 @@ namespace djv
                                 // Initialize the buffers.
                                 p.avFrameRgb = av_frame_alloc();
 
-                                // Initialize the software scaler.
+                                // Initialize the software scaler. Proxy frames
+                                // are reduced by the scaler as they are
+                                // converted.
+                                p.proxySize = Image::getProxySize(
+                                    Image::Size(
+                                        p.avCodecParameters[p.avVideoStream]->width,
+                                        p.avCodecParameters[p.avVideoStream]->height),
+                                    _options.proxy);
                                 p.swsContext = sws_getContext(
                                     p.avCodecParameters[p.avVideoStream]->width,
                                     p.avCodecParameters[p.avVideoStream]->height,
                                     static_cast<AVPixelFormat>(p.avCodecParameters[p.avVideoStream]->format),
-                                    p.avCodecParameters[p.avVideoStream]->width,
-                                    p.avCodecParameters[p.avVideoStream]->height,
+                                    p.proxySize.w,
+                                    p.proxySize.h,
                                     AV_PIX_FMT_RGBA,
                                     SWS_BILINEAR,
                                     0,
@@ -314,7 +324,10 @@ namespace djv
                                 }
                                 if (info.video.size() && _options.layer < info.video.size())
                                 {
-                                    const size_t dataByteCount = info.video[_options.layer].info.getDataByteCount();
+                                    // Proxy frames are charged at the proxy size.
+                                    Image::Info imageInfo = info.video[_options.layer].info;
+                                    imageInfo.size = p.proxySize;
+                                    const size_t dataByteCount = imageInfo.getDataByteCount();
                                     _cache.setMax(cacheMaxByteCount / dataByteCount);
                                 }
                                 else
@@ -649,6 +662,7 @@ namespace djv
                                 {
                                     imageInfo = p.info.video[0];
                                 }
+                                imageInfo.size = p.proxySize;
                                 if (!((0 == p.avFrame->sample_aspect_ratio.num && 1 == p.avFrame->sample_aspect_ratio.den) ||
                                     0 == p.avFrame->sample_aspect_ratio.den))
                                 {
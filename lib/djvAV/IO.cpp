@@ -6,6 +6,9 @@
 
 #include <djvAV/SpeedFunc.h>
 
+#include <algorithm>
+#include <iterator>
+
 using namespace djv::Core;
 
 namespace djv
@@ -116,7 +119,9 @@ namespace djv
                 _out(std::max(in, out))
             {}
 
-            Cache::Cache()
+            Cache::Cache() :
+                _sequence(std::make_shared<Math::Frame::Sequence>()),
+                _frames(std::make_shared<Math::Frame::Sequence>())
             {}
 
             void Cache::setMax(size_t value)
@@ -127,39 +132,18 @@ namespace djv
                 _cacheUpdate();
             }
 
-            Math::Frame::Sequence Cache::getFrames() const
+            std::shared_ptr<const Math::Frame::Sequence> Cache::getFrames() const
             {
-                Math::Frame::Sequence out;
-                std::vector<Math::Frame::Index> frames;
-                for (const auto& i : _cache)
-                {
-                    frames.push_back(i.first);
-                }
-                const size_t size = frames.size();
-                if (size)
+                if (!_frames)
                 {
-                    std::sort(frames.begin(), frames.end());
-                    Math::Frame::Number rangeStart = frames[0];
-                    Math::Frame::Number prevFrame = frames[0];
-                    size_t i = 1;
-                    for (; i < size; prevFrame = frames[i], ++i)
-                    {
-                        if (frames[i] != prevFrame + 1)
-                        {
-                            out.add(Math::Frame::Range(rangeStart, prevFrame));
-                            rangeStart = frames[i];
-                        }
-                    }
-                    if (size > 1)
+                    std::vector<Math::Frame::Range> ranges;
+                    for (const auto& i : _ranges)
                     {
-                        out.add(Math::Frame::Range(rangeStart, prevFrame));
-                    }
-                    else
-                    {
-                        out.add(Math::Frame::Range(rangeStart));
+                        ranges.push_back(Math::Frame::Range(i.first, i.second));
                     }
+                    _frames = std::make_shared<Math::Frame::Sequence>(ranges);
                 }
-                return out;
+                return _frames;
             }
 
             void Cache::setSequenceSize(size_t value)
@@ -196,97 +180,216 @@ namespace djv
 
             void Cache::add(Math::Frame::Index index, const std::shared_ptr<Image::Data>& image)
             {
-                _cache[index] = image;
-                _cacheUpdate();
+                if (index < 0)
+                    return;
+                if (index >= static_cast<Math::Frame::Index>(_cache.size()))
+                {
+                    _cache.resize(index + 1);
+                }
+                auto& frame = _cache[index];
+                if (frame.image)
+                {
+                    _byteCount -= frame.image->getDataByteCount();
+                }
+                if (!frame.cached)
+                {
+                    frame.cached = true;
+                    ++_count;
+                    _addRange(index);
+                }
+                frame.image = image;
+                if (frame.image)
+                {
+                    _byteCount += frame.image->getDataByteCount();
+                }
+                if (!_sequence->contains(index))
+                {
+                    _removeRange(index, index);
+                }
+            }
+
+            void Cache::remove(Math::Frame::Index index)
+            {
+                if (contains(index))
+                {
+                    _removeRange(index, index);
+                }
+            }
+
+            void Cache::clear()
+            {
+                _cache.clear();
+                _count = 0;
+                _byteCount = 0;
+                _ranges.clear();
+                _frames.reset();
             }
 
             void Cache::_cacheUpdate()
             {
+                // Find the first frame, behind the current frame.
                 const auto range = _inOutPoints.getRange(_sequenceSize);
                 Math::Frame::Index frame = _currentFrame;
-                _sequence = Math::Frame::Sequence();
-                switch (_direction)
+                for (size_t i = 0; i < _readBehind; ++i)
                 {
-                case Direction::Forward:
-                {
-                    for (size_t i = 0; i < _readBehind; ++i)
+                    switch (_direction)
                     {
+                    case Direction::Forward:
                         --frame;
                         if (frame < range.getMin())
                         {
                             frame = range.getMax();
                         }
-                    }
-                    _sequence.add(Math::Frame::Range(frame));
-                    const Math::Frame::Index first = frame;
-                    for (size_t i = 0; i < _max; ++i)
-                    {
+                        break;
+                    case Direction::Reverse:
                         ++frame;
-                        if (first == frame)
-                        {
-                            break;
-                        }
                         if (frame > range.getMax())
                         {
                             frame = range.getMin();
-                            if (frame != _sequence.getRanges().back().getMax())
-                            {
-                                _sequence.add(Math::Frame::Range(frame));
-                            }
-                        }
-                        else
-                        {
-                            _sequence.add(Math::Frame::Range(frame));
                         }
+                        break;
+                    default: break;
                     }
-                    break;
                 }
-                case Direction::Reverse:
+
+                // Add the frames ahead of the first frame, wrapping around
+                // the in/out points. The frames are added a range at a time,
+                // and once every frame has been added we can stop.
+                auto sequence = std::make_shared<Math::Frame::Sequence>(Math::Frame::Range(frame));
+                size_t remaining = _max;
+                size_t wrap = 0;
+                while (remaining > 0 && wrap < 2)
                 {
-                    for (size_t i = 0; i < _readBehind; ++i)
+                    switch (_direction)
                     {
-                        ++frame;
-                        if (frame > range.getMax())
+                    case Direction::Forward:
+                        if (frame < range.getMax())
+                        {
+                            const Math::Frame::Index count = std::min(
+                                static_cast<Math::Frame::Index>(remaining),
+                                range.getMax() - frame);
+                            sequence->add(Math::Frame::Range(frame + 1, frame + count));
+                            frame += count;
+                            remaining -= count;
+                        }
+                        else
                         {
                             frame = range.getMin();
+                            sequence->add(Math::Frame::Range(frame));
+                            --remaining;
+                            ++wrap;
                         }
-                    }
-                    _sequence.add(Math::Frame::Range(frame));
-                    const Math::Frame::Index first = frame;
-                    for (size_t i = 0; i < _max; ++i)
-                    {
-                        --frame;
-                        if (first == frame)
+                        break;
+                    case Direction::Reverse:
+                        if (frame > range.getMin())
                         {
-                            break;
+                            const Math::Frame::Index count = std::min(
+                                static_cast<Math::Frame::Index>(remaining),
+                                frame - range.getMin());
+                            sequence->add(Math::Frame::Range(frame - count, frame - 1));
+                            frame -= count;
+                            remaining -= count;
                         }
-                        if (frame < range.getMin())
+                        else
                         {
                             frame = range.getMax();
-                            if (frame != _sequence.getRanges().back().getMin())
-                            {
-                                _sequence.add(Math::Frame::Range(frame));
-                            }
+                            sequence->add(Math::Frame::Range(frame));
+                            --remaining;
+                            ++wrap;
                         }
-                        else
+                        break;
+                    default:
+                        remaining = 0;
+                        break;
+                    }
+                }
+                _sequence = sequence;
+
+                // Remove the cached frames that are outside of the sequence.
+                std::vector<Math::Frame::Range> remove;
+                for (const auto& i : _ranges)
+                {
+                    Math::Frame::Index min = i.first;
+                    for (const auto& j : _sequence->getRanges())
+                    {
+                        if (j.getMax() < min)
+                            continue;
+                        if (j.getMin() > i.second)
+                            break;
+                        if (j.getMin() > min)
                         {
-                            _sequence.add(Math::Frame::Range(frame));
+                            remove.push_back(Math::Frame::Range(min, j.getMin() - 1));
                         }
+                        min = j.getMax() + 1;
+                        if (min > i.second)
+                            break;
+                    }
+                    if (min <= i.second)
+                    {
+                        remove.push_back(Math::Frame::Range(min, i.second));
+                    }
+                }
+                for (const auto& i : remove)
+                {
+                    _removeRange(i.getMin(), i.getMax());
+                }
+            }
+
+            void Cache::_addRange(Math::Frame::Index index)
+            {
+                Math::Frame::Index min = index;
+                Math::Frame::Index max = index;
+                auto i = _ranges.upper_bound(index);
+                if (i != _ranges.end() && i->first == index + 1)
+                {
+                    max = i->second;
+                    i = _ranges.erase(i);
+                }
+                if (i != _ranges.begin())
+                {
+                    const auto j = std::prev(i);
+                    if (j->second == index - 1)
+                    {
+                        min = j->first;
+                        _ranges.erase(j);
                     }
-                    break;
                 }
-                default: break;
+                _ranges[min] = max;
+                _frames.reset();
+            }
+
+            void Cache::_removeRange(Math::Frame::Index min, Math::Frame::Index max)
+            {
+                // The frames must be within a single cached range.
+                auto i = _ranges.upper_bound(min);
+                if (i == _ranges.begin())
+                    return;
+                --i;
+                const Math::Frame::Index rangeMin = i->first;
+                const Math::Frame::Index rangeMax = i->second;
+                if (max > rangeMax)
+                    return;
+                _ranges.erase(i);
+                if (rangeMin < min)
+                {
+                    _ranges[rangeMin] = min - 1;
+                }
+                if (max < rangeMax)
+                {
+                    _ranges[max + 1] = rangeMax;
                 }
-                auto i = _cache.begin();
-                while (i != _cache.end())
+                for (Math::Frame::Index j = min; j <= max; ++j)
                 {
-                    auto j = i;
-                    ++i;
-                    if (!_sequence.contains(j->first))
+                    auto& frame = _cache[j];
+                    if (frame.image)
                     {
-                        _cache.erase(j);
+                        _byteCount -= frame.image->getDataByteCount();
                     }
+                    frame.cached = false;
+                    frame.image.reset();
+                    --_count;
                 }
+                _frames.reset();
             }
 
         } // namespace IO
@@ -12,8 +12,10 @@
 #include <djvMath/Rational.h>
 
 #include <future>
+#include <map>
 #include <queue>
 #include <set>
+#include <vector>
 
 namespace djv
 {
@@ -193,6 +195,11 @@ namespace djv
             };
 
             //! This class provides a frame cache.
+            //!
+            //! Frames are stored in a flat array addressed by the frame index,
+            //! and the ranges of cached frames are updated as frames are added
+            //! and removed. The frame sequences are published as immutable
+            //! snapshots that can be shared between threads without copying.
             class Cache
             {
             public:
@@ -212,9 +219,13 @@ namespace djv
                 //! \name Frames
                 ///@{
 
-                Math::Frame::Sequence getFrames() const;
+                //! Get the cached frames.
+                std::shared_ptr<const Math::Frame::Sequence> getFrames() const;
+
                 size_t getReadBehind() const;
-                const Math::Frame::Sequence& getSequence() const;
+
+                //! Get the frames that should be cached.
+                std::shared_ptr<const Math::Frame::Sequence> getSequence() const;
 
                 void setSequenceSize(size_t);
                 void setInOutPoints(const InOutPoints&);
@@ -225,12 +236,15 @@ namespace djv
                 bool get(Math::Frame::Index, std::shared_ptr<Image::Data>&) const;
 
                 void add(Math::Frame::Index, const std::shared_ptr<Image::Data>&);
+                void remove(Math::Frame::Index);
                 void clear();
 
                 ///@}
 
             private:
                 void _cacheUpdate();
+                void _addRange(Math::Frame::Index);
+                void _removeRange(Math::Frame::Index min, Math::Frame::Index max);
 
                 size_t _max = 0;
                 size_t _sequenceSize = 0;
@@ -239,8 +253,17 @@ namespace djv
                 Math::Frame::Index _currentFrame = 0;
                 //! \todo Should this be configurable?
                 size_t _readBehind = 10;
-                Math::Frame::Sequence _sequence;
-                std::map<Math::Frame::Index, std::shared_ptr<Image::Data> > _cache;
+                std::shared_ptr<const Math::Frame::Sequence> _sequence;
+                struct Frame
+                {
+                    bool cached = false;
+                    std::shared_ptr<Image::Data> image;
+                };
+                std::vector<Frame> _cache;
+                size_t _count = 0;
+                size_t _byteCount = 0;
+                std::map<Math::Frame::Index, Math::Frame::Index> _ranges;
+                mutable std::shared_ptr<const Math::Frame::Sequence> _frames;
             };
 
         } // namespace IO
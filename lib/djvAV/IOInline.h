@@ -127,20 +127,12 @@ namespace djv
             
             inline size_t Cache::getCount() const
             {
-                return _cache.size();
+                return _count;
             }
 
             inline size_t Cache::getTotalByteCount() const
             {
-                size_t out = 0;
-                for (const auto& i : _cache)
-                {
-                    if (i.second)
-                    {
-                        out += i.second->getDataByteCount();
-                    }
-                }
-                return out;
+                return _byteCount;
             }
 
             inline size_t Cache::getReadBehind() const
@@ -148,32 +140,26 @@ namespace djv
                 return _readBehind;
             }
 
-            inline const Math::Frame::Sequence& Cache::getSequence() const
+            inline std::shared_ptr<const Math::Frame::Sequence> Cache::getSequence() const
             {
                 return _sequence;
             }
 
             inline bool Cache::contains(Math::Frame::Index value) const
             {
-                return _cache.find(value) != _cache.end();
+                return value >= 0 && value < static_cast<Math::Frame::Index>(_cache.size()) && _cache[value].cached;
             }
 
             inline bool Cache::get(Math::Frame::Index index, std::shared_ptr<Image::Data>& out) const
             {
-                const auto i = _cache.find(index);
-                const bool found = i != _cache.end();
+                const bool found = contains(index);
                 if (found)
                 {
-                    out = i->second;
+                    out = _cache[index].image;
                 }
                 return found;
             }
 
-            inline void Cache::clear()
-            {
-                _cache.clear();
-            }
-
         } // namespace IO
     } // namespace AV
 } // namespace djv
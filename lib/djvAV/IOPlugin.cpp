@@ -84,14 +84,22 @@ namespace djv
 
             Math::Frame::Sequence IRead::getCacheSequence()
             {
-                std::lock_guard<std::mutex> lock(_mutex);
-                return _cacheSequence;
+                std::shared_ptr<const Math::Frame::Sequence> out;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    out = _cacheSequence;
+                }
+                return out ? *out : Math::Frame::Sequence();
             }
 
             Math::Frame::Sequence IRead::getCachedFrames()
             {
-                std::lock_guard<std::mutex> lock(_mutex);
-                return _cachedFrames;
+                std::shared_ptr<const Math::Frame::Sequence> out;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    out = _cachedFrames;
+                }
+                return out ? *out : Math::Frame::Sequence();
             }
 
             void IRead::setCacheEnabled(bool value)
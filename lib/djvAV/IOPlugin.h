@@ -8,6 +8,8 @@
 
 #include <djvSystem/FileInfo.h>
 
+#include <set>
+
 namespace djv
 {
     namespace System
@@ -88,6 +90,12 @@ namespace djv
                 
                 size_t layer = 0;
                 std::string colorSpace;
+
+                //! The proxy scale factor for reading video frames at a
+                //! reduced resolution, for example a value of 2 halves the
+                //! width and height. The information still describes the
+                //! full resolution.
+                size_t proxy = 1;
             };
 
             //! This class provides the interface for reading.
@@ -109,6 +117,15 @@ namespace djv
 
                 virtual std::future<Info> getInfo() = 0;
 
+                //! Update the file sequence without opening the file again,
+                //! for example when frames are added while the sequence is
+                //! being rendered. The frames that have been modified are
+                //! read again. Returns false if the reader does not support
+                //! updates and the file should be opened again.
+                virtual bool updateSequence(
+                    const System::File::Info&,
+                    const std::set<Math::Frame::Number>& modified);
+
                 ///@}
 
                 //! \name Playback
@@ -148,8 +165,8 @@ namespace djv
                 bool _cacheEnabled = false;
                 size_t _cacheMaxByteCount = 0;
                 size_t _cacheByteCount = 0;
-                Math::Frame::Sequence _cacheSequence;
-                Math::Frame::Sequence _cachedFrames;
+                std::shared_ptr<const Math::Frame::Sequence> _cacheSequence;
+                std::shared_ptr<const Math::Frame::Sequence> _cachedFrames;
                 Cache _cache;
             };
 
@@ -28,6 +28,11 @@ namespace djv
                 return  _audioQueue;
             }
 
+            inline bool IRead::updateSequence(const System::File::Info&, const std::set<Math::Frame::Number>&)
+            {
+                return false;
+            }
+
             inline bool IRead::hasCache() const
             {
                 return false;
@@ -5,39 +5,46 @@
 #include <djvAV/IOSystem.h>
 
 #include <djvAV/Cineon.h>
-#include <djvAV/DPX.h>
+#include <djvAV/DPXFunc.h>
 #include <djvAV/IFF.h>
 #include <djvAV/PFM.h>
-#include <djvAV/PPM.h>
+#include <djvAV/PPMFunc.h>
 #include <djvAV/RLA.h>
 #include <djvAV/SGI.h>
 #include <djvAV/Targa.h>
 
 #if defined(FFmpeg_FOUND)
-#include <djvAV/FFmpeg.h>
+#include <djvAV/FFmpegFunc.h>
 #endif // FFmpeg_FOUND
 #if defined(JPEG_FOUND)
-#include <djvAV/JPEG.h>
+#include <djvAV/JPEGFunc.h>
 #endif // JPEG_FOUND
 #if defined(OpenEXR_FOUND)
-#include <djvAV/OpenEXR.h>
+#include <djvAV/OpenEXRFunc.h>
 #endif // OpenEXR_FOUND
 #if defined(PNG_FOUND)
 #include <djvAV/PNG.h>
 #endif // PNG_FOUND
 #if defined(TIFF_FOUND)
-#include <djvAV/TIFF.h>
+#include <djvAV/TIFFFunc.h>
 #endif // TIFF_FOUND
 
-#include <djvGL/GLFWSystem.h>
-
 #include <djvSystem/Context.h>
 #include <djvSystem/File.h>
+#include <djvSystem/FileIO.h>
+#include <djvSystem/LogSystem.h>
 #include <djvSystem/TextSystem.h>
 
 #include <djvCore/StringFormat.h>
 #include <djvCore/StringFunc.h>
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+
 using namespace djv::Core;
 
 namespace djv
@@ -46,13 +53,143 @@ namespace djv
     {
         namespace IO
         {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const size_t magicSize = 4;
+
+                struct PluginFactory
+                {
+                    std::set<std::string> fileExtensions;
+                    bool sequence = false;
+                    std::function<std::shared_ptr<IPlugin>(const std::shared_ptr<System::Context>&)> create;
+                    std::function<rapidjson::Value(rapidjson::Document::AllocatorType&)> defaultOptions;
+                };
+
+                template<typename T>
+                PluginFactory getPluginFactory(const std::set<std::string>& fileExtensions)
+                {
+                    PluginFactory out;
+                    out.fileExtensions = fileExtensions;
+                    out.sequence = std::is_base_of<ISequencePlugin, T>::value;
+                    out.create = [](const std::shared_ptr<System::Context>& context) -> std::shared_ptr<IPlugin>
+                    {
+                        return T::create(context);
+                    };
+                    out.defaultOptions = [](rapidjson::Document::AllocatorType&)
+                    {
+                        return rapidjson::Value();
+                    };
+                    return out;
+                }
+
+                //! Get a factory for a plugin with options of type U.
+                template<typename T, typename U>
+                PluginFactory getPluginFactory(const std::set<std::string>& fileExtensions)
+                {
+                    PluginFactory out = getPluginFactory<T>(fileExtensions);
+                    out.defaultOptions = [](rapidjson::Document::AllocatorType& allocator)
+                    {
+                        return djv::toJSON(U(), allocator);
+                    };
+                    return out;
+                }
+
+                std::string getExtension(const System::File::Info& fileInfo)
+                {
+                    std::string out = fileInfo.getPath().getExtension();
+                    std::transform(out.begin(), out.end(), out.begin(), tolower);
+                    return out;
+                }
+
+                //! Get the name of the plugin that can read a file by looking at
+                //! the first few bytes. Formats without a reliable signature
+                //! (FFmpeg, RLA, and Targa) are not detected.
+                std::string getPluginNameFromMagic(const System::File::Info& fileInfo)
+                {
+                    std::string out;
+                    uint8_t magic[magicSize];
+                    try
+                    {
+                        auto io = System::File::IO::create();
+                        io->open(fileInfo.getFileName(), System::File::Mode::Read);
+                        if (io->getSize() < magicSize)
+                        {
+                            return out;
+                        }
+                        io->read(magic, magicSize);
+                    }
+                    catch (const std::exception&)
+                    {
+                        return out;
+                    }
+                    if ((0x80 == magic[0] && 0x2a == magic[1] && 0x5f == magic[2] && 0xd7 == magic[3]) ||
+                        (0xd7 == magic[0] && 0x5f == magic[1] && 0x2a == magic[2] && 0x80 == magic[3]))
+                    {
+                        out = Cineon::pluginName;
+                    }
+                    else if (0 == memcmp(magic, "SDPX", 4) || 0 == memcmp(magic, "XPDS", 4))
+                    {
+                        out = DPX::pluginName;
+                    }
+                    else if (0 == memcmp(magic, "FOR4", 4))
+                    {
+                        out = IFF::pluginName;
+                    }
+                    else if ('P' == magic[0] && ('F' == magic[1] || 'f' == magic[1]))
+                    {
+                        out = PFM::pluginName;
+                    }
+                    else if ('P' == magic[0] && ('2' == magic[1] || '3' == magic[1] || '5' == magic[1] || '6' == magic[1]))
+                    {
+                        out = PPM::pluginName;
+                    }
+                    else if (0x01 == magic[0] && 0xda == magic[1])
+                    {
+                        out = SGI::pluginName;
+                    }
+#if defined(JPEG_FOUND)
+                    else if (0xff == magic[0] && 0xd8 == magic[1] && 0xff == magic[2])
+                    {
+                        out = JPEG::pluginName;
+                    }
+#endif // JPEG_FOUND
+#if defined(OpenEXR_FOUND)
+                    else if (0x76 == magic[0] && 0x2f == magic[1] && 0x31 == magic[2] && 0x01 == magic[3])
+                    {
+                        out = OpenEXR::pluginName;
+                    }
+#endif // OpenEXR_FOUND
+#if defined(PNG_FOUND)
+                    else if (0x89 == magic[0] && 'P' == magic[1] && 'N' == magic[2] && 'G' == magic[3])
+                    {
+                        out = PNG::pluginName;
+                    }
+#endif // PNG_FOUND
+#if defined(TIFF_FOUND)
+                    else if (0 == memcmp(magic, "II*\0", 4) || 0 == memcmp(magic, "MM\0*", 4))
+                    {
+                        out = TIFF::pluginName;
+                    }
+#endif // TIFF_FOUND
+                    return out;
+                }
+
+            } // namespace
+
             struct IOSystem::Private
             {
+                std::shared_ptr<System::LogSystem> logSystem;
                 std::shared_ptr<System::TextSystem> textSystem;
                 std::shared_ptr<Observer::ValueSubject<bool> > optionsChanged;
-                std::map<std::string, std::shared_ptr<IPlugin> > plugins;
+                std::map<std::string, PluginFactory> pluginFactories;
+                std::unordered_map<std::string, std::string> extensionToPlugin;
+                std::set<std::string> fileExtensions;
                 std::set<std::string> sequenceExtensions;
                 std::set<std::string> nonSequenceExtensions;
+                std::mutex pluginsMutex;
+                std::map<std::string, std::shared_ptr<IPlugin> > plugins;
+                rapidjson::Document pendingOptions;
             };
 
             void IOSystem::_init(const std::shared_ptr<System::Context>& context)
@@ -61,53 +198,57 @@ namespace djv
 
                 DJV_PRIVATE_PTR();
 
-                addDependency(GL::GLFW::GLFWSystem::create(context));
-
+                p.logSystem = context->getSystemT<System::LogSystem>();
                 p.textSystem = context->getSystemT<System::TextSystem>();
 
                 p.optionsChanged = Observer::ValueSubject<bool>::create();
+                p.pendingOptions.SetObject();
 
-                p.plugins[Cineon::pluginName] = Cineon::Plugin::create(context);
-                p.plugins[DPX::pluginName] = DPX::Plugin::create(context);
-                p.plugins[IFF::pluginName] = IFF::Plugin::create(context);
-                p.plugins[PFM::pluginName] = PFM::Plugin::create(context);
-                p.plugins[PPM::pluginName] = PPM::Plugin::create(context);
-                p.plugins[RLA::pluginName] = RLA::Plugin::create(context);
-                p.plugins[SGI::pluginName] = SGI::Plugin::create(context);
-                p.plugins[Targa::pluginName] = Targa::Plugin::create(context);
+                // The plugins are not created until they are used.
+                p.pluginFactories[Cineon::pluginName] = getPluginFactory<Cineon::Plugin>(Cineon::fileExtensions);
+                p.pluginFactories[DPX::pluginName] = getPluginFactory<DPX::Plugin, DPX::Options>(DPX::fileExtensions);
+                p.pluginFactories[IFF::pluginName] = getPluginFactory<IFF::Plugin>(IFF::fileExtensions);
+                p.pluginFactories[PFM::pluginName] = getPluginFactory<PFM::Plugin>(PFM::fileExtensions);
+                p.pluginFactories[PPM::pluginName] = getPluginFactory<PPM::Plugin, PPM::Options>(PPM::fileExtensions);
+                p.pluginFactories[RLA::pluginName] = getPluginFactory<RLA::Plugin>(RLA::fileExtensions);
+                p.pluginFactories[SGI::pluginName] = getPluginFactory<SGI::Plugin>(SGI::fileExtensions);
+                p.pluginFactories[Targa::pluginName] = getPluginFactory<Targa::Plugin>(Targa::fileExtensions);
 #if defined(FFmpeg_FOUND)
-                p.plugins[FFmpeg::pluginName] = FFmpeg::Plugin::create(context);
+                p.pluginFactories[FFmpeg::pluginName] = getPluginFactory<FFmpeg::Plugin, FFmpeg::Options>(FFmpeg::fileExtensions);
 #endif // FFmpeg_FOUND
 #if defined(JPEG_FOUND)
-                p.plugins[JPEG::pluginName] = JPEG::Plugin::create(context);
+                p.pluginFactories[JPEG::pluginName] = getPluginFactory<JPEG::Plugin, JPEG::Options>(JPEG::fileExtensions);
 #endif // JPEG_FOUND
 #if defined(PNG_FOUND)
-                p.plugins[PNG::pluginName] = PNG::Plugin::create(context);
+                p.pluginFactories[PNG::pluginName] = getPluginFactory<PNG::Plugin>(PNG::fileExtensions);
 #endif // PNG_FOUND
 #if defined(OpenEXR_FOUND)
-                p.plugins[OpenEXR::pluginName] = OpenEXR::Plugin::create(context);
+                p.pluginFactories[OpenEXR::pluginName] = getPluginFactory<OpenEXR::Plugin, OpenEXR::Options>(OpenEXR::fileExtensions);
 #endif // OpenEXR_FOUND
 #if defined(TIFF_FOUND)
-                p.plugins[TIFF::pluginName] = TIFF::Plugin::create(context);
+                p.pluginFactories[TIFF::pluginName] = getPluginFactory<TIFF::Plugin, TIFF::Options>(TIFF::fileExtensions);
 #endif // TIFF_FOUND
 
-                for (const auto& i : p.plugins)
+                for (const auto& i : p.pluginFactories)
                 {
-                    if (i.second->canSequence())
+                    const auto& fileExtensions = i.second.fileExtensions;
+                    for (const auto& j : fileExtensions)
+                    {
+                        p.extensionToPlugin[j] = i.first;
+                    }
+                    p.fileExtensions.insert(fileExtensions.begin(), fileExtensions.end());
+                    if (i.second.sequence)
                     {
-                        const auto& fileExtensions = i.second->getFileExtensions();
                         p.sequenceExtensions.insert(fileExtensions.begin(), fileExtensions.end());
                     }
                     else
                     {
-                        const auto& fileExtensions = i.second->getFileExtensions();
                         p.nonSequenceExtensions.insert(fileExtensions.begin(), fileExtensions.end());
                     }
-                
+
                     std::stringstream ss;
-                    ss << "I/O plugin: " << i.second->getPluginName() << '\n';
-                    ss << "    Information: " << i.second->getPluginInfo() << '\n';
-                    ss << "    File extensions: " << String::joinSet(i.second->getFileExtensions(), ", ") << '\n';
+                    ss << "I/O plugin: " << i.first << '\n';
+                    ss << "    File extensions: " << String::joinSet(fileExtensions, ", ") << '\n';
                     _log(ss.str());
                 }
             }
@@ -134,45 +275,87 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 std::set<std::string> out;
-                for (const auto& i : p.plugins)
+                for (const auto& i : p.pluginFactories)
                 {
-                    out.insert(i.second->getPluginName());
+                    out.insert(i.first);
                 }
                 return out;
             }
 
             std::set<std::string> IOSystem::getFileExtensions() const
             {
-                DJV_PRIVATE_PTR();
-                std::set<std::string> out;
-                for (const auto& i : p.plugins)
-                {
-                    const auto& fileExtensions = i.second->getFileExtensions();
-                    out.insert(fileExtensions.begin(), fileExtensions.end());
-                }
-                return out;
+                return _p->fileExtensions;
             }
 
             rapidjson::Value IOSystem::getOptions(const std::string& pluginName, rapidjson::Document::AllocatorType& allocator) const
             {
+                // Don't create the plugin to get the options, if it has not
+                // been created yet return the pending or default options.
                 DJV_PRIVATE_PTR();
-                const auto i = p.plugins.find(pluginName);
-                if (i != p.plugins.end())
+                std::shared_ptr<IPlugin> plugin;
                 {
-                    return i->second->getOptions(allocator);
+                    std::lock_guard<std::mutex> lock(p.pluginsMutex);
+                    const auto i = p.plugins.find(pluginName);
+                    if (i != p.plugins.end())
+                    {
+                        plugin = i->second;
+                    }
+                    else
+                    {
+                        const auto j = p.pendingOptions.FindMember(pluginName.c_str());
+                        if (j != p.pendingOptions.MemberEnd())
+                        {
+                            return rapidjson::Value(j->value, allocator);
+                        }
+                        const auto k = p.pluginFactories.find(pluginName);
+                        if (k != p.pluginFactories.end())
+                        {
+                            return k->second.defaultOptions(allocator);
+                        }
+                    }
+                }
+                if (plugin)
+                {
+                    return plugin->getOptions(allocator);
                 }
                 return rapidjson::Value();
             }
 
             void IOSystem::setOptions(const std::string& pluginName, const rapidjson::Value& value)
             {
+                // Don't create the plugin to set the options, if it has not
+                // been created yet keep the options until it is.
                 DJV_PRIVATE_PTR();
-                const auto i = p.plugins.find(pluginName);
-                if (i != p.plugins.end())
+                std::shared_ptr<IPlugin> plugin;
                 {
-                    i->second->setOptions(value);
-                    p.optionsChanged->setAlways(true);
+                    std::lock_guard<std::mutex> lock(p.pluginsMutex);
+                    if (p.pluginFactories.find(pluginName) == p.pluginFactories.end())
+                    {
+                        return;
+                    }
+                    const auto i = p.plugins.find(pluginName);
+                    if (i != p.plugins.end())
+                    {
+                        plugin = i->second;
+                    }
+                    else
+                    {
+                        p.pendingOptions.RemoveMember(pluginName.c_str());
+                        if (!value.IsNull())
+                        {
+                            auto& allocator = p.pendingOptions.GetAllocator();
+                            p.pendingOptions.AddMember(
+                                rapidjson::Value(pluginName.c_str(), allocator),
+                                rapidjson::Value(value, allocator),
+                                allocator);
+                        }
+                    }
+                }
+                if (plugin)
+                {
+                    plugin->setOptions(value);
                 }
+                p.optionsChanged->setAlways(true);
             }
 
             std::shared_ptr<Observer::IValueSubject<bool> > IOSystem::observeOptionsChanged() const
@@ -193,36 +376,26 @@ namespace djv
             bool IOSystem::canSequence(const System::File::Info& fileInfo) const
             {
                 DJV_PRIVATE_PTR();
-                return std::find(
-                    p.sequenceExtensions.begin(),
-                    p.sequenceExtensions.end(),
-                    fileInfo.getPath().getExtension()) != p.sequenceExtensions.end();
+                return p.sequenceExtensions.find(fileInfo.getPath().getExtension()) != p.sequenceExtensions.end();
             }
 
             bool IOSystem::canRead(const System::File::Info& fileInfo) const
             {
-                DJV_PRIVATE_PTR();
-                for (const auto& i : p.plugins)
-                {
-                    if (i.second->canRead(fileInfo))
-                    {
-                        return true;
-                    }
-                }
-                return false;
+                return !_getPluginName(fileInfo).empty();
             }
 
             std::shared_ptr<IRead> IOSystem::read(const System::File::Info& fileInfo, const ReadOptions& options)
             {
                 DJV_PRIVATE_PTR();
                 std::shared_ptr<IRead> out;
-                for (const auto& i : p.plugins)
+                std::string pluginName = _getPluginName(fileInfo);
+                if (pluginName.empty() && System::File::Type::File == fileInfo.getType())
                 {
-                    if (i.second->canRead(fileInfo))
-                    {
-                        out = i.second->read(fileInfo, options);
-                        break;
-                    }
+                    pluginName = getPluginNameFromMagic(fileInfo);
+                }
+                if (auto plugin = _getPlugin(pluginName))
+                {
+                    out = plugin->read(fileInfo, options);
                 }
                 if (!out)
                 {
@@ -235,28 +408,22 @@ namespace djv
 
             bool IOSystem::canWrite(const System::File::Info& fileInfo, const Info& info) const
             {
-                DJV_PRIVATE_PTR();
-                for (const auto& i : p.plugins)
+                bool out = false;
+                if (auto plugin = _getPlugin(_getPluginName(fileInfo)))
                 {
-                    if (i.second->canWrite(fileInfo, info))
-                    {
-                        return true;
-                    }
+                    out = plugin->canWrite(fileInfo, info);
                 }
-                return false;
+                return out;
             }
 
             std::shared_ptr<IWrite> IOSystem::write(const System::File::Info& fileInfo, const Info& info, const WriteOptions& options)
             {
                 DJV_PRIVATE_PTR();
                 std::shared_ptr<IWrite> out;
-                for (const auto& i : p.plugins)
+                auto plugin = _getPlugin(_getPluginName(fileInfo));
+                if (plugin && plugin->canWrite(fileInfo, info))
                 {
-                    if (i.second->canWrite(fileInfo, info))
-                    {
-                        out = i.second->write(fileInfo, info, options);
-                        break;
-                    }
+                    out = plugin->write(fileInfo, info, options);
                 }
                 if (!out)
                 {
@@ -267,6 +434,61 @@ namespace djv
                 return out;
             }
 
+            std::string IOSystem::_getPluginName(const System::File::Info& fileInfo) const
+            {
+                DJV_PRIVATE_PTR();
+                std::string out;
+                const auto i = p.extensionToPlugin.find(getExtension(fileInfo));
+                if (i != p.extensionToPlugin.end())
+                {
+                    out = i->second;
+                }
+                return out;
+            }
+
+            std::shared_ptr<IPlugin> IOSystem::_getPlugin(const std::string& pluginName) const
+            {
+                DJV_PRIVATE_PTR();
+                std::shared_ptr<IPlugin> out;
+                const auto i = p.pluginFactories.find(pluginName);
+                if (i != p.pluginFactories.end())
+                {
+                    std::lock_guard<std::mutex> lock(p.pluginsMutex);
+                    const auto j = p.plugins.find(pluginName);
+                    if (j != p.plugins.end())
+                    {
+                        out = j->second;
+                    }
+                    else if (auto context = getContext().lock())
+                    {
+                        out = i->second.create(context);
+                        p.plugins[pluginName] = out;
+
+                        std::stringstream ss;
+                        ss << "Created I/O plugin: " << out->getPluginName() << '\n';
+                        ss << "    Information: " << out->getPluginInfo() << '\n';
+                        p.logSystem->log("djv::AV::IO::IOSystem", ss.str());
+
+                        // Apply the options that were set before the plugin
+                        // was created.
+                        const auto k = p.pendingOptions.FindMember(pluginName.c_str());
+                        if (k != p.pendingOptions.MemberEnd())
+                        {
+                            try
+                            {
+                                out->setOptions(k->value);
+                            }
+                            catch (const std::exception& e)
+                            {
+                                p.logSystem->log("djv::AV::IO::IOSystem", e.what(), System::LogLevel::Error);
+                            }
+                            p.pendingOptions.RemoveMember(k);
+                        }
+                    }
+                }
+                return out;
+            }
+
         } // namespace IO
     } // namespace AV
 } // namespace djv
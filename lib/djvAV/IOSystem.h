@@ -63,8 +63,13 @@ namespace djv
                 //! \name Read
                 ///@{
 
+                //! Get whether a file can be read. Only the file extension is
+                //! checked, the plugin is not created.
                 bool canRead(const System::File::Info&) const;
 
+                //! Read a file. The plugin is found from the file extension,
+                //! or if the extension is unknown, from the first bytes of
+                //! the file.
                 //! Throws:
                 //! - std::exception
                 std::shared_ptr<IRead> read(const System::File::Info&, const ReadOptions& = ReadOptions());
@@ -83,6 +88,9 @@ namespace djv
                 ///@}
 
             private:
+                std::string _getPluginName(const System::File::Info&) const;
+                std::shared_ptr<IPlugin> _getPlugin(const std::string&) const;
+
                 DJV_PRIVATE();
             };
 
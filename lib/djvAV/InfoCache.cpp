@@ -0,0 +1,322 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/InfoCache.h>
+
+#include <djvAV/CacheFilePrivate.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            namespace
+            {
+                const char     fileMagic[]   = "djvInfoCache";
+                const uint32_t fileVersion   = 1;
+
+                //! \todo Should this be configurable?
+                const size_t   infoCacheMax  = 10000;
+
+                struct Entry
+                {
+                    uint64_t             size     = 0;
+                    int64_t              time     = 0;
+                    std::string          sequence;
+                    uint64_t             access   = 0;
+                    std::vector<uint8_t> data;
+                };
+
+                void writeInfo(CacheFileWriter& writer, const Info& info)
+                {
+                    writer.write(info.fileName);
+                    writer.write(static_cast<int32_t>(info.videoSpeed.getNum()));
+                    writer.write(static_cast<int32_t>(info.videoSpeed.getDen()));
+                    const auto& ranges = info.videoSequence.getRanges();
+                    writer.write(static_cast<uint32_t>(ranges.size()));
+                    for (const auto& i : ranges)
+                    {
+                        writer.write(static_cast<int64_t>(i.getMin()));
+                        writer.write(static_cast<int64_t>(i.getMax()));
+                    }
+                    writer.write(static_cast<uint32_t>(info.videoSequence.getPad()));
+                    writer.write(static_cast<uint32_t>(info.video.size()));
+                    for (const auto& i : info.video)
+                    {
+                        writeImageInfo(writer, i);
+                    }
+                    writer.write(info.audio.name);
+                    writer.write(static_cast<uint8_t>(info.audio.channelCount));
+                    writer.write(static_cast<uint8_t>(info.audio.type));
+                    writer.write(static_cast<uint64_t>(info.audio.sampleRate));
+                    writer.write(info.audio.codec);
+                    writer.write(static_cast<uint64_t>(info.audioSampleCount));
+                    writeTags(writer, info.tags);
+                }
+
+                void readInfo(CacheFileReader& reader, Info& info)
+                {
+                    info.fileName = reader.readString();
+                    const int32_t num = reader.read<int32_t>();
+                    const int32_t den = reader.read<int32_t>();
+                    info.videoSpeed = Math::Rational(num, den);
+                    std::vector<Math::Frame::Range> ranges;
+                    const uint32_t rangeCount = reader.read<uint32_t>();
+                    for (uint32_t i = 0; i < rangeCount; ++i)
+                    {
+                        const int64_t min = reader.read<int64_t>();
+                        const int64_t max = reader.read<int64_t>();
+                        ranges.push_back(Math::Frame::Range(min, max));
+                    }
+                    const uint32_t pad = reader.read<uint32_t>();
+                    info.videoSequence = Math::Frame::Sequence(ranges, pad);
+                    const uint32_t videoCount = reader.read<uint32_t>();
+                    for (uint32_t i = 0; i < videoCount; ++i)
+                    {
+                        info.video.push_back(readImageInfo(reader));
+                    }
+                    info.audio.name = reader.readString();
+                    info.audio.channelCount = reader.read<uint8_t>();
+                    info.audio.type = static_cast<Audio::Type>(reader.read<uint8_t>());
+                    info.audio.sampleRate = static_cast<size_t>(reader.read<uint64_t>());
+                    info.audio.codec = reader.readString();
+                    info.audioSampleCount = static_cast<size_t>(reader.read<uint64_t>());
+                    info.tags = readTags(reader);
+                }
+
+            } // namespace
+
+            struct InfoCache::Private
+            {
+                size_t max = infoCacheMax;
+                std::map<std::string, Entry> entries;
+                mutable uint64_t counter = 0;
+                bool dirty = false;
+                mutable std::mutex mutex;
+
+                void maxUpdate();
+            };
+
+            void InfoCache::Private::maxUpdate()
+            {
+                if (entries.size() > max)
+                {
+                    // Remove the least recently used entries. Trim a little
+                    // extra so that this isn't run for every new entry.
+                    std::vector<std::pair<uint64_t, std::string> > sorted;
+                    for (const auto& i : entries)
+                    {
+                        sorted.push_back(std::make_pair(i.second.access, i.first));
+                    }
+                    std::sort(sorted.begin(), sorted.end());
+                    const size_t target = max - max / 10;
+                    for (size_t i = 0; i < sorted.size() && entries.size() > target; ++i)
+                    {
+                        entries.erase(sorted[i].second);
+                    }
+                    dirty = true;
+                }
+            }
+
+            InfoCache::InfoCache() :
+                _p(new Private)
+            {}
+
+            InfoCache::~InfoCache()
+            {}
+
+            std::shared_ptr<InfoCache> InfoCache::create()
+            {
+                return std::shared_ptr<InfoCache>(new InfoCache);
+            }
+
+            size_t InfoCache::getMax() const
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                return _p->max;
+            }
+
+            size_t InfoCache::getCount() const
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                return _p->entries.size();
+            }
+
+            float InfoCache::getPercentageUsed() const
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                return _p->max > 0 ? (_p->entries.size() / static_cast<float>(_p->max) * 100.F) : 0.F;
+            }
+
+            void InfoCache::setMax(size_t value)
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                _p->max = value;
+                _p->maxUpdate();
+            }
+
+            bool InfoCache::get(const System::File::Info& fileInfo, Info& out) const
+            {
+                DJV_PRIVATE_PTR();
+                if (!fileInfo.doesExist())
+                {
+                    return false;
+                }
+                std::vector<uint8_t> data;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    const auto i = p.entries.find(getCacheKey(fileInfo));
+                    if (i == p.entries.end() ||
+                        i->second.size != fileInfo.getSize() ||
+                        i->second.time != static_cast<int64_t>(fileInfo.getTime()) ||
+                        i->second.sequence != getCacheSequence(fileInfo))
+                    {
+                        return false;
+                    }
+                    i->second.access = ++p.counter;
+                    data = i->second.data;
+                }
+                bool r = false;
+                try
+                {
+                    CacheFileReader reader(data.data(), data.size());
+                    Info info;
+                    readInfo(reader, info);
+                    out = info;
+                    r = true;
+                }
+                catch (const std::exception&)
+                {}
+                return r;
+            }
+
+            void InfoCache::add(const System::File::Info& fileInfo, const Info& info)
+            {
+                DJV_PRIVATE_PTR();
+                if (!fileInfo.doesExist())
+                {
+                    return;
+                }
+                Entry entry;
+                entry.size = fileInfo.getSize();
+                entry.time = static_cast<int64_t>(fileInfo.getTime());
+                entry.sequence = getCacheSequence(fileInfo);
+                CacheFileWriter writer(entry.data);
+                writeInfo(writer, info);
+                std::lock_guard<std::mutex> lock(p.mutex);
+                entry.access = ++p.counter;
+                p.entries[getCacheKey(fileInfo)] = std::move(entry);
+                p.dirty = true;
+                p.maxUpdate();
+            }
+
+            void InfoCache::remove(const System::File::Info& fileInfo)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.entries.find(getCacheKey(fileInfo));
+                if (i != p.entries.end())
+                {
+                    p.entries.erase(i);
+                    p.dirty = true;
+                }
+            }
+
+            void InfoCache::clear()
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.entries.clear();
+                p.dirty = true;
+            }
+
+            void InfoCache::read(const std::string& fileName)
+            {
+                DJV_PRIVATE_PTR();
+                std::vector<uint8_t> data;
+                if (!readCacheFile(fileName, data))
+                {
+                    return;
+                }
+                std::map<std::string, Entry> entries;
+                uint64_t counter = 0;
+                try
+                {
+                    CacheFileReader reader(data.data(), data.size());
+                    const uint8_t* magic = reader.read(sizeof(fileMagic));
+                    if (memcmp(magic, fileMagic, sizeof(fileMagic)) != 0 ||
+                        reader.read<uint32_t>() != fileVersion)
+                    {
+                        return;
+                    }
+                    counter = reader.read<uint64_t>();
+                    const uint32_t count = reader.read<uint32_t>();
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        const std::string key = reader.readString();
+                        Entry entry;
+                        entry.size = reader.read<uint64_t>();
+                        entry.time = reader.read<int64_t>();
+                        entry.sequence = reader.readString();
+                        entry.access = reader.read<uint64_t>();
+                        const uint32_t size = reader.read<uint32_t>();
+                        const uint8_t* bytes = reader.read(size);
+                        entry.data = std::vector<uint8_t>(bytes, bytes + size);
+                        entries[key] = std::move(entry);
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    // Ignore corrupt cache files.
+                    return;
+                }
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.entries = std::move(entries);
+                p.counter = counter;
+                p.dirty = false;
+                p.maxUpdate();
+            }
+
+            void InfoCache::write(const std::string& fileName)
+            {
+                DJV_PRIVATE_PTR();
+                std::vector<uint8_t> data;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    CacheFileWriter writer(data);
+                    writer.write(fileMagic, sizeof(fileMagic));
+                    writer.write(fileVersion);
+                    writer.write(static_cast<uint64_t>(p.counter));
+                    writer.write(static_cast<uint32_t>(p.entries.size()));
+                    for (const auto& i : p.entries)
+                    {
+                        writer.write(i.first);
+                        writer.write(static_cast<uint64_t>(i.second.size));
+                        writer.write(static_cast<int64_t>(i.second.time));
+                        writer.write(i.second.sequence);
+                        writer.write(static_cast<uint64_t>(i.second.access));
+                        writer.write(static_cast<uint32_t>(i.second.data.size()));
+                        writer.write(i.second.data.data(), i.second.data.size());
+                    }
+                    p.dirty = false;
+                }
+                writeCacheFile(fileName, data);
+            }
+
+            bool InfoCache::isDirty() const
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                return _p->dirty;
+            }
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
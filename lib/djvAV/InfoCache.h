@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAV/IO.h>
+
+#include <djvSystem/FileInfo.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            //! This constant provides the default information cache file name.
+            const std::string infoCacheFileName = "djvInfoCache.bin";
+
+            //! This class provides a persistent cache of I/O information.
+            //!
+            //! Entries are keyed by the file name and validated against the
+            //! file size and modification time, so changed files are not
+            //! returned from the cache. File sequences are stored with a single
+            //! entry that is also validated against the frame numbers; when a
+            //! sequence gains or loses frames the entry is replaced.
+            //!
+            //! The cache is stored in a single binary file that is read on
+            //! startup and written on shutdown.
+            class InfoCache
+            {
+                DJV_NON_COPYABLE(InfoCache);
+
+            protected:
+                InfoCache();
+
+            public:
+                ~InfoCache();
+
+                //! Create a new information cache.
+                static std::shared_ptr<InfoCache> create();
+
+                //! \name Size
+                ///@{
+
+                size_t getMax() const;
+                size_t getCount() const;
+                float getPercentageUsed() const;
+
+                void setMax(size_t);
+
+                ///@}
+
+                //! \name Contents
+                ///@{
+
+                //! Get the information for a file. Returns false if the file
+                //! is not in the cache or the cache entry is out of date.
+                bool get(const System::File::Info&, Info&) const;
+
+                void add(const System::File::Info&, const Info&);
+                void remove(const System::File::Info&);
+                void clear();
+
+                ///@}
+
+                //! \name Persistence
+                ///@{
+
+                //! Read the cache from a file. Invalid or incompatible cache
+                //! files are ignored.
+                //! Throws:
+                //! - System::File::Error
+                void read(const std::string& fileName);
+
+                //! Write the cache to a file. The file is written to a
+                //! temporary file first and then renamed, so that multiple
+                //! processes never see a partially written cache.
+                //! Throws:
+                //! - System::File::Error
+                void write(const std::string& fileName);
+
+                //! Get whether the cache has changed since it was last read or
+                //! written.
+                bool isDirty() const;
+
+                ///@}
+
+            private:
+                DJV_PRIVATE();
+            };
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
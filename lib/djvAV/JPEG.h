@@ -66,10 +66,11 @@ namespace djv
                 protected:
                     Info _readInfo(const std::string& fileName) override;
                     std::shared_ptr<Image::Data> _readImage(const std::string& fileName) override;
+                    bool _hasProxy() const override;
 
                 private:
                     class File;
-                    Info _open(const std::string&, const std::shared_ptr<File>&);
+                    Info _open(const std::string&, const std::shared_ptr<File>&, size_t scale = 1);
                 };
                 
                 //! This class provides the JPEG file writer.
@@ -4,6 +4,8 @@
 
 #include <djvAV/JPEG.h>
 
+#include <djvImage/DataFunc.h>
+
 #include <djvSystem/File.h>
 #include <djvSystem/FileFunc.h>
 #include <djvSystem/FileIO.h>
@@ -119,9 +121,17 @@ namespace djv
 
                 std::shared_ptr<Image::Data> Read::_readImage(const std::string& fileName)
                 {
+                    // Use the DCT scaling in libjpeg for the largest power
+                    // of two factor of the proxy scale.
+                    size_t scale = 8;
+                    while (scale > 1 && (_options.proxy % scale) != 0)
+                    {
+                        scale /= 2;
+                    }
+
                     // Open the file.
                     auto f = File::create();
-                    const auto info = _open(fileName, f);
+                    const auto info = _open(fileName, f, scale);
 
                     // Read the file.
                     auto out = Image::Data::create(info.video[0]);
@@ -155,15 +165,23 @@ namespace djv
                     }
 
                     // Log any warnings.
-                    for (const auto& i : f->jpegError.messages)
+                    if (_logSystem->isEnabled(System::LogLevel::Warning))
                     {
-                        _logSystem->log(
-                            pluginName,
-                            String::Format("{0}: {1}").arg(fileName).arg(i),
-                            System::LogLevel::Warning);
+                        for (const auto& i : f->jpegError.messages)
+                        {
+                            _logSystem->log(
+                                pluginName,
+                                String::Format("{0}: {1}").arg(fileName).arg(i),
+                                System::LogLevel::Warning);
+                        }
                     }
 
-                    return out;
+                    return Image::getProxy(out, _options.proxy / scale);
+                }
+
+                bool Read::_hasProxy() const
+                {
+                    return true;
                 }
 
                 namespace
@@ -182,6 +200,7 @@ namespace djv
 
                     bool jpegOpen(
                         FILE*                   f,
+                        size_t                  scale,
                         jpeg_decompress_struct* jpeg,
                         JPEGErrorStruct*        error)
                     {
@@ -195,6 +214,8 @@ namespace djv
                         {
                             return false;
                         }
+                        jpeg->scale_num = 1;
+                        jpeg->scale_denom = static_cast<unsigned int>(scale);
                         if (!jpeg_start_decompress(jpeg))
                         {
                             return false;
@@ -204,7 +225,7 @@ namespace djv
 
                 } // namespace
 
-                Info Read::_open(const std::string& fileName, const std::shared_ptr<File>& f)
+                Info Read::_open(const std::string& fileName, const std::shared_ptr<File>& f, size_t scale)
                 {
                     f->jpeg.err = jpeg_std_error(&f->jpegError.pub);
                     f->jpegError.pub.error_exit = djvJPEGError;
@@ -229,7 +250,7 @@ namespace djv
                             arg(fileName).
                             arg(_textSystem->getText(DJV_TEXT("error_file_open"))));
                     }
-                    if (!jpegOpen(f->f, &f->jpeg, &f->jpegError))
+                    if (!jpegOpen(f->f, scale, &f->jpeg, &f->jpegError))
                     {
                         std::vector<std::string> messages;
                         messages.push_back(String::Format("{0}: {1}").
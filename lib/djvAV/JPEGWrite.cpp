@@ -265,12 +265,15 @@ namespace djv
                     }
 
                     // Log any warnings.
-                    for (const auto& i : f->jpegError.messages)
+                    if (_logSystem->isEnabled(System::LogLevel::Warning))
                     {
-                        _logSystem->log(
-                            pluginName,
-                            String::Format("{0}: {1}").arg(fileName).arg(i),
-                            System::LogLevel::Warning);
+                        for (const auto& i : f->jpegError.messages)
+                        {
+                            _logSystem->log(
+                                pluginName,
+                                String::Format("{0}: {1}").arg(fileName).arg(i),
+                                System::LogLevel::Warning);
+                        }
                     }
                 }
 
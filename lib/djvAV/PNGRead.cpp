@@ -234,12 +234,15 @@ namespace djv
                     pngEnd(f->png, f->pngInfoEnd);
 
                     // Log any warnings.
-                    for (const auto& i : f->pngError.messages)
+                    if (_logSystem->isEnabled(System::LogLevel::Warning))
                     {
-                        _logSystem->log(
-                            pluginName,
-                            String::Format("{0}: {1}").arg(fileName).arg(i),
-                            System::LogLevel::Warning);
+                        for (const auto& i : f->pngError.messages)
+                        {
+                            _logSystem->log(
+                                pluginName,
+                                String::Format("{0}: {1}").arg(fileName).arg(i),
+                                System::LogLevel::Warning);
+                        }
                     }
 
                     return out;
@@ -268,12 +268,15 @@ namespace djv
                     }
 
                     // Log any warnings.
-                    for (const auto& i : f->pngError.messages)
+                    if (_logSystem->isEnabled(System::LogLevel::Warning))
                     {
-                        _logSystem->log(
-                            pluginName,
-                            String::Format("{0}: {1}").arg(fileName).arg(i),
-                            System::LogLevel::Warning);
+                        for (const auto& i : f->pngError.messages)
+                        {
+                            _logSystem->log(
+                                pluginName,
+                                String::Format("{0}: {1}").arg(fileName).arg(i),
+                                System::LogLevel::Warning);
+                        }
                     }
                 }
 
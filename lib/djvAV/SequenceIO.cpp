@@ -4,8 +4,11 @@
 
 #include <djvAV/SequenceIO.h>
 
+#include <djvGL/GLFWSystem.h>
 #include <djvGL/ImageConvert.h>
 
+#include <djvImage/DataFunc.h>
+
 #include <djvAV/SpeedFunc.h>
 
 #include <djvSystem/Context.h>
@@ -16,14 +19,18 @@
 #include <djvSystem/TextSystem.h>
 #include <djvSystem/TimerFunc.h>
 
+#include <djvCore/MetricsFunc.h>
 #include <djvCore/OSFunc.h>
 #include <djvCore/String.h>
 #include <djvCore/StringFormat.h>
+#include <djvCore/TraceFunc.h>
 
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+#include <atomic>
 #include <future>
+#include <map>
 
 using namespace djv::Core;
 
@@ -38,11 +45,16 @@ namespace djv
                 //! \todo Should this be configurable?
                 const double infoTimeout = 0.5;
 
+                //! The total size of the caches for all of the readers.
+                std::atomic<int64_t> cacheByteCountTotal(0);
+
             } // namespace
 
             struct ISequenceRead::Future
             {
-                Math::Frame::Number frame = Math::Frame::invalid;
+                Math::Frame::Index frame = Math::Frame::invalid;
+                Math::Frame::Number number = Math::Frame::invalid;
+                uint64_t updateCount = 0;
                 std::shared_ptr<Image::Data> image;
             };
 
@@ -54,9 +66,23 @@ namespace djv
                 std::condition_variable queueCV;
                 Direction direction = Direction::Forward;
                 Math::Frame::Number seek = Math::Frame::invalid;
+                bool sequenceUpdate = false;
+                System::File::Info sequenceFileInfo;
+                std::set<Math::Frame::Number> sequenceModified;
+
+                // The sequence is only used by the reader thread, the frame
+                // count is also used by hasCache().
+                std::atomic<size_t> sequenceFrameCount;
+                uint64_t updateCount = 0;
+                std::map<Math::Frame::Number, uint64_t> frameUpdates;
                 std::thread thread;
                 std::atomic<bool> running;
                 std::chrono::steady_clock::time_point infoTimer;
+                int64_t cacheByteCount = 0;
+
+                //! The byte count of the last image added to the cache. This
+                //! may differ from the information when reading proxies.
+                size_t cacheImageByteCount = 0;
             };
 
             void ISequenceRead::_init(
@@ -68,11 +94,13 @@ namespace djv
             {
                 IRead::_init(fileInfo, options, textSystem, resourceSystem, logSystem);
                 _speed = fromSpeed(getDefaultSpeed());
+                _p->sequenceFrameCount = 0;
                 _p->running = true;
                 _p->thread = std::thread(
                     [this]
                 {
                     DJV_PRIVATE_PTR();
+                    static const auto cacheByteCountGauge = Metrics::getGauge("djv::AV::ISequenceRead::cacheByteCount");
 
                     // Get the sequence.
                     size_t sequenceFrameCount = 0;
@@ -81,6 +109,7 @@ namespace djv
                     {
                         _sequence = _fileInfo.getSequence();
                         sequenceFrameCount = _sequence.getFrameCount();
+                        p.sequenceFrameCount = sequenceFrameCount;
                         if (sequenceFrameCount)
                         {
                             p.frame = 0;
@@ -131,6 +160,9 @@ namespace djv
                         InOutPoints inOutPoints;
                         bool cacheEnabled = false;
                         size_t cacheMaxByteCount = 0;
+                        bool sequenceUpdate = false;
+                        System::File::Info sequenceFileInfo;
+                        std::set<Math::Frame::Number> sequenceModified;
                         {
                             std::lock_guard<std::mutex> lock(_mutex);
                             threadCount = _threadCount;
@@ -139,6 +171,15 @@ namespace djv
                             inOutPoints = _inOutPoints;
                             cacheEnabled = _cacheEnabled;
                             cacheMaxByteCount = _cacheMaxByteCount;
+                            sequenceUpdate = p.sequenceUpdate;
+                            sequenceFileInfo = p.sequenceFileInfo;
+                            sequenceModified = std::move(p.sequenceModified);
+                            p.sequenceModified.clear();
+                            p.sequenceUpdate = false;
+                        }
+                        if (sequenceUpdate)
+                        {
+                            _sequenceUpdate(sequenceFileInfo, sequenceModified, info);
                         }
                         if (!cacheEnabled)
                         {
@@ -146,7 +187,11 @@ namespace djv
                         }
                         if (info.video.size() && _options.layer < info.video.size())
                         {
-                            const size_t dataByteCount = info.video[_options.layer].getDataByteCount();
+                            Image::Info imageInfo = info.video[_options.layer];
+                            imageInfo.size = Image::getProxySize(imageInfo.size, _options.proxy);
+                            const size_t dataByteCount = p.cacheImageByteCount ?
+                                p.cacheImageByteCount :
+                                imageInfo.getDataByteCount();
                             _cache.setMax(dataByteCount ? (cacheMaxByteCount / dataByteCount) : 0);
                             _cache.setSequenceSize(info.videoSequence.getFrameCount());
                             _cache.setInOutPoints(inOutPoints);
@@ -215,17 +260,22 @@ namespace djv
                         {
                             p.infoTimer = now;
                             size_t cacheByteCount = _cache.getTotalByteCount();
+                            const int64_t cacheByteCountDelta = static_cast<int64_t>(cacheByteCount) - p.cacheByteCount;
+                            cacheByteCountGauge->set(cacheByteCountTotal.fetch_add(cacheByteCountDelta) + cacheByteCountDelta);
+                            p.cacheByteCount = static_cast<int64_t>(cacheByteCount);
                             auto cacheSequence = _cache.getSequence();
                             auto cachedFrames = _cache.getFrames();
                             {
                                 std::lock_guard<std::mutex> lock(_mutex);
                                 _cacheByteCount = cacheByteCount;
-                                _cacheSequence = cacheSequence;
+                                _cacheSequence = std::move(cacheSequence);
                                 _cachedFrames = std::move(cachedFrames);
                             }
                         }
                     }
 
+                    cacheByteCountGauge->set(cacheByteCountTotal.fetch_sub(p.cacheByteCount) - p.cacheByteCount);
+                    p.cacheByteCount = 0;
                     p.running = false;
                 });
             }
@@ -247,6 +297,25 @@ namespace djv
                 return _p->infoPromise.get_future();
             }
 
+            bool ISequenceRead::updateSequence(const System::File::Info& value, const std::set<Math::Frame::Number>& modified)
+            {
+                DJV_PRIVATE_PTR();
+                if (System::File::Type::Sequence != _fileInfo.getType() ||
+                    System::File::Type::Sequence != value.getType() ||
+                    !value.getSequence().isValid())
+                {
+                    return false;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    p.sequenceUpdate = true;
+                    p.sequenceFileInfo = value;
+                    p.sequenceModified.insert(modified.begin(), modified.end());
+                }
+                p.queueCV.notify_one();
+                return true;
+            }
+
             void ISequenceRead::seek(Math::Frame::Number value, Direction direction)
             {
                 DJV_PRIVATE_PTR();
@@ -260,7 +329,12 @@ namespace djv
 
             bool ISequenceRead::hasCache() const
             {
-                return _sequence.getFrameCount() > 1;
+                return _p->sequenceFrameCount > 1;
+            }
+
+            bool ISequenceRead::_hasProxy() const
+            {
+                return false;
             }
 
             void ISequenceRead::_finish()
@@ -279,7 +353,7 @@ namespace djv
                 const bool queue = (_videoQueue.getCount() < _videoQueue.getMax()) && !_videoQueue.isFinished();
                 const bool seek = _p->seek != Math::Frame::invalid;
                 const bool direction = _p->direction != _direction;
-                return queue || seek || direction;
+                return queue || seek || direction || _p->sequenceUpdate;
             }
 
             size_t ISequenceRead::_getQueueCount(size_t threadCount) const
@@ -288,17 +362,30 @@ namespace djv
                 return std::min(queueMax, threadCount);
             }
 
-            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(Math::Frame::Number i, std::string fileName)
+            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(
+                Math::Frame::Index i,
+                Math::Frame::Number number,
+                std::string fileName)
             {
+                const uint64_t updateCount = _p->updateCount;
                 return std::async(
                     std::launch::async,
-                    [this, i, fileName]
+                    [this, i, number, fileName, updateCount]
                     {
+                        DJV_TRACE_FRAME("djv::AV::ISequenceRead::decode", i);
+                        static const auto decodeTimeHistogram = Metrics::getHistogram("djv::AV::ISequenceRead::decodeTime");
+                        const auto start = std::chrono::steady_clock::now();
                         Future out;
                         out.frame = i;
+                        out.number = number;
+                        out.updateCount = updateCount;
                         try
                         {
                             out.image = _readImage(fileName);
+                            if (!_hasProxy())
+                            {
+                                out.image = Image::getProxy(out.image, _options.proxy);
+                            }
                         }
                         catch (const std::exception& e)
                         {
@@ -307,14 +394,48 @@ namespace djv
                                 String::Format("{0}: {1}").arg(fileName).arg(e.what()),
                                 System::LogLevel::Error);
                         }
+                        decodeTimeHistogram->record(std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - start).count());
                         return out;
                     });
             }
 
+            void ISequenceRead::_cacheAdd(const Future& value)
+            {
+                DJV_PRIVATE_PTR();
+#if defined(DJV_MMAP)
+                value.image->detach();
+#endif // DJV_MMAP
+                if (value.image)
+                {
+                    p.cacheImageByteCount = value.image->getDataByteCount();
+                }
+                if (value.number != Math::Frame::invalid)
+                {
+                    // The sequence may have been updated since the frame was
+                    // requested, and the frame may have been modified while
+                    // it was being read.
+                    const Math::Frame::Index index = _sequence.getIndex(value.number);
+                    const auto i = p.frameUpdates.find(value.number);
+                    if (index != Math::Frame::invalidIndex &&
+                        (i == p.frameUpdates.end() || i->second <= value.updateCount))
+                    {
+                        _cache.add(index, value.image);
+                    }
+                }
+                else
+                {
+                    _cache.add(value.frame, value.image);
+                }
+            }
+
             size_t ISequenceRead::_readQueue(size_t count, bool loop, bool cacheEnabled)
             {
                 DJV_PRIVATE_PTR();
 
+                static const auto cacheHitCounter = Metrics::getCounter("djv::AV::ISequenceRead::cacheHits");
+                static const auto cacheMissCounter = Metrics::getCounter("djv::AV::ISequenceRead::cacheMisses");
+
                 // Get frames to be added to the queue.
                 const size_t sequenceFrameCount = _sequence.getFrameCount();
                 std::vector<std::pair<Math::Frame::Number, std::shared_ptr<Image::Data> > > images;
@@ -322,7 +443,14 @@ namespace djv
                 for (size_t i = 0; i < count; ++i)
                 {
                     std::shared_ptr<Image::Data> cachedImage;
-                    if (cacheEnabled && _cache.get(p.frame, cachedImage))
+                    bool cached = false;
+                    if (cacheEnabled)
+                    {
+                        DJV_TRACE_FRAME("djv::AV::ISequenceRead::cache", p.frame);
+                        cached = _cache.get(p.frame, cachedImage);
+                        (cached ? cacheHitCounter : cacheMissCounter)->add();
+                    }
+                    if (cached)
                     {
                         images.push_back(std::make_pair(p.frame, cachedImage));
                     }
@@ -334,13 +462,13 @@ namespace djv
                             {
                                 const Math::Frame::Number frameNumber = _sequence.getFrame(p.frame);
                                 const std::string fileName = _fileInfo.getFileName(frameNumber);
-                                futures.push_back(_getFuture(p.frame, fileName));
+                                futures.push_back(_getFuture(p.frame, frameNumber, fileName));
                             }
                         }
                         else
                         {
                             const std::string fileName = _fileInfo.getFileName();
-                            futures.push_back(_getFuture(p.frame, fileName));
+                            futures.push_back(_getFuture(p.frame, Math::Frame::invalid, fileName));
                         }
                     }
 
@@ -370,19 +498,21 @@ namespace djv
                 // Get the results.
                 for (auto& future : futures)
                 {
-                    const auto result = future.get();
+                    Future result;
+                    {
+                        DJV_TRACE("djv::AV::ISequenceRead::wait");
+                        result = future.get();
+                    }
                     images.push_back(std::make_pair(result.frame, result.image));
                     if (cacheEnabled)
                     {
-#if defined(DJV_MMAP)
-                        result.image->detach();
-#endif // DJV_MMAP
-                        _cache.add(result.frame, result.image);
+                        _cacheAdd(result);
                     }
                 }
 
                 // Add the frames to the queue.
                 {
+                    DJV_TRACE("djv::AV::ISequenceRead::queue");
                     std::lock_guard<std::mutex> lock(_mutex);
                     for (const auto& i : images)
                     {
@@ -440,8 +570,9 @@ namespace djv
                         {
                             if (!_cache.contains(frame))
                             {
-                                const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
-                                p.cacheFutures.push_back(_getFuture(frame, fileName));
+                                const Math::Frame::Number frameNumber = _sequence.getFrame(frame);
+                                const std::string fileName = _fileInfo.getFileName(frameNumber);
+                                p.cacheFutures.push_back(_getFuture(frame, frameNumber, fileName));
                             }
                             ++frame;
                             if (frame > range.getMax())
@@ -466,8 +597,9 @@ namespace djv
                         {
                             if (!_cache.contains(frame))
                             {
-                                const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
-                                p.cacheFutures.push_back(_getFuture(frame, fileName));
+                                const Math::Frame::Number frameNumber = _sequence.getFrame(frame);
+                                const std::string fileName = _fileInfo.getFileName(frameNumber);
+                                p.cacheFutures.push_back(_getFuture(frame, frameNumber, fileName));
                             }
                             --frame;
                             if (frame < range.getMin())
@@ -488,11 +620,7 @@ namespace djv
                     if (i->valid() &&
                         i->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                     {
-                        const auto result = i->get();
-#if defined(DJV_MMAP)
-                        result.image->detach();
-#endif // DJV_MMAP
-                        _cache.add(result.frame, result.image);
+                        _cacheAdd(i->get());
                         i = p.cacheFutures.erase(i);
                     }
                     else
@@ -500,12 +628,113 @@ namespace djv
                         ++i;
                     }
                 }
+
+                // Without any frames being read the updates are no longer
+                // needed.
+                if (p.cacheFutures.empty())
+                {
+                    p.frameUpdates.clear();
+                }
+            }
+
+            void ISequenceRead::_sequenceUpdate(
+                const System::File::Info& fileInfo,
+                const std::set<Math::Frame::Number>& modified,
+                Info& info)
+            {
+                DJV_PRIVATE_PTR();
+                if (!fileInfo.isCompatible(_fileInfo))
+                {
+                    return;
+                }
+                const Math::Frame::Sequence sequence = fileInfo.getSequence();
+
+                // Record the update for the modified frames, so that frames
+                // which are being read when they are modified are not added
+                // to the cache.
+                ++p.updateCount;
+                for (const auto i : modified)
+                {
+                    p.frameUpdates[i] = p.updateCount;
+                }
+
+                // The cache is indexed by the position in the sequence, so
+                // the cached frames are moved when frames are inserted or
+                // removed before them. Frames that have been modified are
+                // removed.
+                std::vector<std::pair<Math::Frame::Index, std::shared_ptr<Image::Data> > > moved;
+                if (auto cachedFrames = _cache.getFrames())
+                {
+                    for (const auto i : *cachedFrames)
+                    {
+                        const Math::Frame::Number number = _sequence.getFrame(i);
+                        const Math::Frame::Index index = sequence.getIndex(number);
+                        const bool frameModified = modified.find(number) != modified.end();
+                        if (frameModified || index != i)
+                        {
+                            std::shared_ptr<Image::Data> image;
+                            _cache.get(i, image);
+                            _cache.remove(i);
+                            if (!frameModified && index != Math::Frame::invalidIndex)
+                            {
+                                moved.push_back(std::make_pair(index, image));
+                            }
+                        }
+                    }
+                }
+
+                // Update the sequence.
+                const Math::Frame::Number frameNumber = _sequence.getFrame(p.frame);
+                _sequence = sequence;
+                _fileInfo.setSequence(sequence);
+                p.sequenceFrameCount = sequence.getFrameCount();
+                info.videoSequence = sequence;
+                _cache.setSequenceSize(sequence.getFrameCount());
+                for (const auto& i : moved)
+                {
+                    _cache.add(i.first, i.second);
+                }
+
+                // Keep reading from the same frame. When the end of the
+                // sequence was reached reading continues with the new frames.
+                if (frameNumber != Math::Frame::invalid)
+                {
+                    const Math::Frame::Index index = sequence.getIndex(frameNumber);
+                    if (index != Math::Frame::invalidIndex)
+                    {
+                        p.frame = index;
+                    }
+                }
+
+                // Forget the updates for frames that are no longer in the
+                // sequence.
+                auto i = p.frameUpdates.begin();
+                while (i != p.frameUpdates.end())
+                {
+                    if (sequence.getIndex(i->first) == Math::Frame::invalidIndex)
+                    {
+                        i = p.frameUpdates.erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (p.frame >= 0 && p.frame < static_cast<Math::Frame::Index>(sequence.getFrameCount()))
+                    {
+                        _videoQueue.setFinished(false);
+                    }
+                }
             }
 
             struct ISequenceWrite::Private
             {
                 System::File::Info fileInfo;
                 Math::Frame::Number frameNumber = Math::Frame::invalid;
+                std::shared_ptr<GL::GLFW::GLFWSystem> glfwSystem;
                 GLFWwindow * glfwWindow = nullptr;
                 std::shared_ptr<GL::ImageConvert> convert;
                 std::thread thread;
@@ -540,26 +769,39 @@ namespace djv
                     }
                 }
 
+                // OpenGL is only used to convert images to a type the plugin
+                // can write, so don't initialize it unless it is needed.
+                if (_getImageType(_imageInfo.type) != _imageInfo.type ||
+                    _getImageLayout() != _imageInfo.layout)
+                {
+                    // GLFW is initialized and terminated by the GLFW system.
+                    auto context = textSystem->getContext().lock();
+                    if (!context)
+                    {
+                        throw System::File::Error(_textSystem->getText(DJV_TEXT("error_glfw_window_creation")));
+                    }
+                    p.glfwSystem = GL::GLFW::GLFWSystem::create(context);
 #if defined(DJV_GL_ES2)
-                glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+                    glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
+                    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
+                    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
 #else // DJV_GL_ES2
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
-                glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-                glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+                    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+                    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+                    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+                    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 #endif // DJV_GL_ES2
-                glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
-                int env = 0;
-                if (OS::getIntEnv("DJV_GL_DEBUG", env) && env != 0)
-                {
-                    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
-                }
-                p.glfwWindow = glfwCreateWindow(100, 100, "djv::IO::ISequenceWrite", NULL, NULL);
-                if (!p.glfwWindow)
-                {
-                    throw System::File::Error(_textSystem->getText(DJV_TEXT("error_glfw_window_creation")));
+                    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+                    int env = 0;
+                    if (OS::getIntEnv("DJV_GL_DEBUG", env) && env != 0)
+                    {
+                        glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+                    }
+                    p.glfwWindow = glfwCreateWindow(100, 100, "djv::IO::ISequenceWrite", NULL, NULL);
+                    if (!p.glfwWindow)
+                    {
+                        throw System::File::Error(_textSystem->getText(DJV_TEXT("error_glfw_window_creation")));
+                    }
                 }
 
                 p.running = true;
@@ -569,17 +811,20 @@ namespace djv
                     DJV_PRIVATE_PTR();
                     try
                     {
-                        glfwMakeContextCurrent(p.glfwWindow);
+                        if (p.glfwWindow)
+                        {
+                            glfwMakeContextCurrent(p.glfwWindow);
 #if defined(DJV_GL_ES2)
-                        if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
+                            if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
 #else // DJV_GL_ES2
-                        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+                            if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
 #endif // DJV_GL_ES2
-                        {
-                            throw System::File::Error(_textSystem->getText(DJV_TEXT("error_glad_init")));
-                        }
+                            {
+                                throw System::File::Error(_textSystem->getText(DJV_TEXT("error_glad_init")));
+                            }
 
-                        p.convert = GL::ImageConvert::create(_textSystem, _resourceSystem);
+                            p.convert = GL::ImageConvert::create(_textSystem, _resourceSystem);
+                        }
 
                         const auto timeout = System::getTimerValue(System::TimerValue::VeryFast);
                         while (p.running)
@@ -632,6 +877,12 @@ namespace djv
                                     const Image::Layout imageLayout = _getImageLayout();
                                     if (imageType != image->getType() || imageLayout != image->getLayout())
                                     {
+                                        if (!p.convert)
+                                        {
+                                            throw System::File::Error(String::Format("{0}: {1}").
+                                                arg(fileName).
+                                                arg(_textSystem->getText(DJV_TEXT("error_unsupported_image_type"))));
+                                        }
                                         const Image::Info imageInfo(image->getSize(), imageType, imageLayout);
                                         auto tmp = Image::Data::create(imageInfo);
                                         tmp->setTags(image->getTags());
@@ -13,6 +13,10 @@ namespace djv
         namespace IO
         {
             //! This class provides the interface for reading sequences.
+            //!
+            //! The sequence can be updated while it is being read, for
+            //! example to add frames as they are rendered. Cached frames are
+            //! kept, except for the frames that have been modified.
             class ISequenceRead : public IRead
             {
                 DJV_NON_COPYABLE(ISequenceRead);
@@ -31,12 +35,19 @@ namespace djv
 
                 bool isRunning() const override;
                 std::future<Info> getInfo() override;
+                bool updateSequence(const System::File::Info&, const std::set<Math::Frame::Number>& modified) override;
                 void seek(int64_t, Direction) override;
                 bool hasCache() const override;
 
             protected:
                 virtual Info _readInfo(const std::string& fileName) = 0;
                 virtual std::shared_ptr<Image::Data> _readImage(const std::string& fileName) = 0;
+
+                //! Get whether the reader applies the proxy scale factor
+                //! itself. Otherwise the images are reduced after they are
+                //! read.
+                virtual bool _hasProxy() const;
+
                 void _finish();
 
                 Math::Rational _speed;
@@ -46,9 +57,11 @@ namespace djv
                 bool _hasWork() const;
                 size_t _getQueueCount(size_t threadCount) const;
                 struct Future;
-                std::future<Future> _getFuture(Math::Frame::Number, std::string fileName);
+                std::future<Future> _getFuture(Math::Frame::Index, Math::Frame::Number, std::string fileName);
+                void _cacheAdd(const Future&);
                 size_t _readQueue(size_t count, bool loop, bool cacheEnabled);
                 void _readCache(size_t count, const AV::IO::InOutPoints&);
+                void _sequenceUpdate(const System::File::Info&, const std::set<Math::Frame::Number>& modified, Info&);
 
                 DJV_PRIVATE();
             };
@@ -0,0 +1,543 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/ThumbnailCache.h>
+
+#include <djvAV/CacheFilePrivate.h>
+
+#include <djvImage/Data.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace
+        {
+            const char     indexMagic[]       = "djvThumbnailIndex";
+            const char     packMagic[]        = "djvThumbnailPack";
+            const uint32_t fileVersion        = 2;
+            const size_t   packHeaderSize     = sizeof(packMagic) + sizeof(uint32_t) + sizeof(uint64_t);
+
+            //! \todo Should this be configurable?
+            const size_t   thumbnailCacheMax  = 256 * Memory::megabyte;
+            const size_t   packCountMax       = 8;
+
+            struct Entry
+            {
+                uint64_t                     fileSize   = 0;
+                int64_t                      fileTime   = 0;
+                std::string                  sequence;
+                uint64_t                     access     = 0;
+                Image::Info                  info;
+                std::string                  pluginName;
+                Image::Tags                  tags;
+
+                //! The generation of the pack file containing the image data,
+                //! and the offset of the image data in the pack file.
+                uint64_t                     pack       = 0;
+                uint64_t                     offset     = 0;
+
+                //! Image data that has not been written to the pack file yet.
+                std::shared_ptr<Image::Data> data;
+            };
+
+            std::string getKey(const System::File::Info& fileInfo, const Image::Size& size, Image::Type type)
+            {
+                std::stringstream ss;
+                ss << IO::getCacheKey(fileInfo) << '@' << size.w << 'x' << size.h << ':' << static_cast<int>(type);
+                return ss.str();
+            }
+
+            std::string getIndexFileName(const std::string& fileName)
+            {
+                return fileName + ".idx";
+            }
+
+            std::string getPackFileName(const std::string& fileName, uint64_t generation)
+            {
+                return fileName + "." + std::to_string(generation) + ".pack";
+            }
+
+            std::shared_ptr<System::File::IO> openPack(const std::string& fileName, uint64_t generation)
+            {
+                auto out = System::File::IO::create();
+                out->open(getPackFileName(fileName, generation), System::File::Mode::Read);
+                std::vector<uint8_t> header(packHeaderSize);
+                out->read(header.data(), header.size());
+                IO::CacheFileReader reader(header.data(), header.size());
+                if (memcmp(reader.read(sizeof(packMagic)), packMagic, sizeof(packMagic)) != 0 ||
+                    reader.read<uint32_t>() != fileVersion ||
+                    reader.read<uint64_t>() != generation)
+                {
+                    out.reset();
+                }
+                return out;
+            }
+
+            uint64_t createGeneration()
+            {
+                return static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+            }
+
+        } // namespace
+
+        struct ThumbnailCache::Private
+        {
+            size_t max = thumbnailCacheMax;
+            std::map<std::string, Entry> entries;
+            size_t byteCount = 0;
+            uint64_t counter = 0;
+            std::map<uint64_t, std::shared_ptr<System::File::IO> > packs;
+            bool dirty = false;
+            std::mutex mutex;
+
+            void remove(std::map<std::string, Entry>::iterator);
+            void removeUnloaded();
+            void maxUpdate();
+        };
+
+        void ThumbnailCache::Private::remove(std::map<std::string, Entry>::iterator i)
+        {
+            byteCount -= i->second.info.getDataByteCount();
+            entries.erase(i);
+            dirty = true;
+        }
+
+        void ThumbnailCache::Private::removeUnloaded()
+        {
+            auto i = entries.begin();
+            while (i != entries.end())
+            {
+                if (!i->second.data)
+                {
+                    byteCount -= i->second.info.getDataByteCount();
+                    i = entries.erase(i);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+        }
+
+        void ThumbnailCache::Private::maxUpdate()
+        {
+            if (byteCount > max)
+            {
+                // Remove the least recently used entries. Trim a little extra
+                // so that this isn't run for every new entry.
+                std::vector<std::pair<uint64_t, std::string> > sorted;
+                for (const auto& i : entries)
+                {
+                    sorted.push_back(std::make_pair(i.second.access, i.first));
+                }
+                std::sort(sorted.begin(), sorted.end());
+                const size_t target = max - max / 10;
+                for (size_t i = 0; i < sorted.size() && byteCount > target; ++i)
+                {
+                    remove(entries.find(sorted[i].second));
+                }
+            }
+        }
+
+        ThumbnailCache::ThumbnailCache() :
+            _p(new Private)
+        {}
+
+        ThumbnailCache::~ThumbnailCache()
+        {}
+
+        std::shared_ptr<ThumbnailCache> ThumbnailCache::create()
+        {
+            return std::shared_ptr<ThumbnailCache>(new ThumbnailCache);
+        }
+
+        size_t ThumbnailCache::getMax() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->max;
+        }
+
+        size_t ThumbnailCache::getCount() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->entries.size();
+        }
+
+        size_t ThumbnailCache::getByteCount() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->byteCount;
+        }
+
+        float ThumbnailCache::getPercentageUsed() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->max > 0 ? (_p->byteCount / static_cast<float>(_p->max) * 100.F) : 0.F;
+        }
+
+        void ThumbnailCache::setMax(size_t value)
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            _p->max = value;
+            _p->maxUpdate();
+        }
+
+        std::shared_ptr<Image::Data> ThumbnailCache::get(
+            const System::File::Info& fileInfo,
+            const Image::Size& size,
+            Image::Type type) const
+        {
+            DJV_PRIVATE_PTR();
+            std::shared_ptr<Image::Data> out;
+            if (!fileInfo.doesExist())
+            {
+                return out;
+            }
+            std::lock_guard<std::mutex> lock(p.mutex);
+            const auto i = p.entries.find(getKey(fileInfo, size, type));
+            if (i == p.entries.end())
+            {
+                return out;
+            }
+            if (i->second.fileSize != fileInfo.getSize() ||
+                i->second.fileTime != static_cast<int64_t>(fileInfo.getTime()) ||
+                i->second.sequence != IO::getCacheSequence(fileInfo))
+            {
+                p.remove(i);
+                return out;
+            }
+            i->second.access = ++p.counter;
+            if (i->second.data)
+            {
+                out = i->second.data;
+            }
+            else
+            {
+                const auto j = p.packs.find(i->second.pack);
+                try
+                {
+                    if (j == p.packs.end())
+                    {
+                        throw std::runtime_error("Missing pack file");
+                    }
+                    auto data = Image::Data::create(i->second.info);
+                    data->setPluginName(i->second.pluginName);
+                    data->setTags(i->second.tags);
+                    j->second->setPos(i->second.offset);
+                    j->second->read(data->getData(), data->getDataByteCount());
+                    out = data;
+                }
+                catch (const std::exception&)
+                {
+                    p.remove(i);
+                }
+            }
+            return out;
+        }
+
+        void ThumbnailCache::add(
+            const System::File::Info& fileInfo,
+            const Image::Size& size,
+            Image::Type type,
+            const std::shared_ptr<Image::Data>& data)
+        {
+            DJV_PRIVATE_PTR();
+            if (!fileInfo.doesExist() || !data || data->getDataByteCount() > p.max)
+            {
+                return;
+            }
+            Entry entry;
+            entry.fileSize = fileInfo.getSize();
+            entry.fileTime = static_cast<int64_t>(fileInfo.getTime());
+            entry.sequence = IO::getCacheSequence(fileInfo);
+            entry.info = data->getInfo();
+            entry.pluginName = data->getPluginName();
+            entry.tags = data->getTags();
+            entry.data = data;
+            std::lock_guard<std::mutex> lock(p.mutex);
+            const std::string key = getKey(fileInfo, size, type);
+            const auto i = p.entries.find(key);
+            if (i != p.entries.end())
+            {
+                p.remove(i);
+            }
+            entry.access = ++p.counter;
+            p.byteCount += entry.info.getDataByteCount();
+            p.entries[key] = std::move(entry);
+            p.dirty = true;
+            p.maxUpdate();
+        }
+
+        void ThumbnailCache::clear()
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            p.entries.clear();
+            p.byteCount = 0;
+            p.dirty = true;
+        }
+
+        void ThumbnailCache::read(const std::string& fileName)
+        {
+            DJV_PRIVATE_PTR();
+            std::vector<uint8_t> data;
+            if (!IO::readCacheFile(getIndexFileName(fileName), data))
+            {
+                return;
+            }
+            std::map<std::string, Entry> entries;
+            std::map<uint64_t, std::shared_ptr<System::File::IO> > packs;
+            size_t byteCount = 0;
+            uint64_t counter = 0;
+            try
+            {
+                IO::CacheFileReader reader(data.data(), data.size());
+                if (memcmp(reader.read(sizeof(indexMagic)), indexMagic, sizeof(indexMagic)) != 0 ||
+                    reader.read<uint32_t>() != fileVersion)
+                {
+                    return;
+                }
+                counter = reader.read<uint64_t>();
+
+                // Open the pack files. Pack files that are missing or do not
+                // match the index are ignored, along with their entries.
+                const uint32_t packCount = reader.read<uint32_t>();
+                for (uint32_t i = 0; i < packCount; ++i)
+                {
+                    const uint64_t generation = reader.read<uint64_t>();
+                    try
+                    {
+                        if (auto pack = openPack(fileName, generation))
+                        {
+                            packs[generation] = pack;
+                        }
+                    }
+                    catch (const std::exception&)
+                    {}
+                }
+
+                const uint32_t count = reader.read<uint32_t>();
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    const std::string key = reader.readString();
+                    Entry entry;
+                    entry.fileSize = reader.read<uint64_t>();
+                    entry.fileTime = reader.read<int64_t>();
+                    entry.sequence = reader.readString();
+                    entry.access = reader.read<uint64_t>();
+                    entry.info = IO::readImageInfo(reader);
+                    entry.pluginName = reader.readString();
+                    entry.tags = IO::readTags(reader);
+                    entry.pack = reader.read<uint64_t>();
+                    entry.offset = reader.read<uint64_t>();
+                    const size_t size = entry.info.getDataByteCount();
+                    const auto j = packs.find(entry.pack);
+                    if (j != packs.end() && entry.offset + size <= j->second->getSize())
+                    {
+                        byteCount += size;
+                        entries[key] = std::move(entry);
+                    }
+                }
+            }
+            catch (const std::exception&)
+            {
+                // Ignore corrupt cache files.
+                return;
+            }
+            std::lock_guard<std::mutex> lock(p.mutex);
+            p.entries = std::move(entries);
+            p.byteCount = byteCount;
+            p.counter = counter;
+            p.packs = std::move(packs);
+            p.dirty = false;
+            p.maxUpdate();
+        }
+
+        void ThumbnailCache::write(const std::string& fileName)
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+
+            // Only the new image data is written, unless there are too many
+            // pack files or they contain too much unused data, in which case
+            // all of the image data is copied to the new pack file.
+            uint64_t packByteCount = 0;
+            for (const auto& i : p.packs)
+            {
+                packByteCount += i.second->getSize() - packHeaderSize;
+            }
+            uint64_t usedByteCount = 0;
+            bool newData = false;
+            for (const auto& i : p.entries)
+            {
+                if (i.second.data)
+                {
+                    newData = true;
+                }
+                else
+                {
+                    usedByteCount += i.second.info.getDataByteCount();
+                }
+            }
+            const bool compact =
+                p.packs.size() >= packCountMax ||
+                packByteCount > usedByteCount + usedByteCount / 2;
+
+            // Write the new pack file. The generation must be different from
+            // the pack files that are in use.
+            uint64_t generation = createGeneration();
+            if (!p.packs.empty())
+            {
+                generation = std::max(generation, p.packs.rbegin()->first + 1);
+            }
+            std::vector<std::pair<std::map<std::string, Entry>::iterator, uint64_t> > offsets;
+            if (newData || (compact && usedByteCount > 0))
+            {
+                const std::string packFileName = getPackFileName(fileName, generation);
+                const std::string packTmp = IO::getCacheTempFileName(packFileName);
+                try
+                {
+                    auto io = System::File::IO::create();
+                    io->open(packTmp, System::File::Mode::Write);
+                    std::vector<uint8_t> header;
+                    IO::CacheFileWriter writer(header);
+                    writer.write(packMagic, sizeof(packMagic));
+                    writer.write(fileVersion);
+                    writer.write(generation);
+                    io->write(header.data(), header.size());
+                    std::vector<uint8_t> buf;
+                    auto i = p.entries.begin();
+                    while (i != p.entries.end())
+                    {
+                        const size_t size = i->second.info.getDataByteCount();
+                        const uint64_t offset = io->getPos();
+                        if (i->second.data)
+                        {
+                            io->write(i->second.data->getData(), size);
+                            offsets.push_back(std::make_pair(i, offset));
+                        }
+                        else if (compact)
+                        {
+                            buf.resize(size);
+                            try
+                            {
+                                const auto j = p.packs.find(i->second.pack);
+                                if (j == p.packs.end())
+                                {
+                                    throw std::runtime_error("Missing pack file");
+                                }
+                                j->second->setPos(i->second.offset);
+                                j->second->read(buf.data(), size);
+                            }
+                            catch (const std::exception&)
+                            {
+                                p.byteCount -= size;
+                                i = p.entries.erase(i);
+                                continue;
+                            }
+                            io->write(buf.data(), size);
+                            offsets.push_back(std::make_pair(i, offset));
+                        }
+                        ++i;
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    std::remove(packTmp.c_str());
+                    throw;
+                }
+                IO::renameCacheFile(packTmp, packFileName);
+                auto pack = openPack(fileName, generation);
+                if (!pack)
+                {
+                    std::remove(packFileName.c_str());
+                    //! \todo How can we translate this?
+                    throw System::File::Error(packFileName + ": Cannot read.");
+                }
+
+                // Switch to the new pack file and release the image data.
+                for (const auto& i : offsets)
+                {
+                    i.first->second.pack = generation;
+                    i.first->second.offset = i.second;
+                    i.first->second.data.reset();
+                }
+                p.packs[generation] = pack;
+            }
+
+            // Write the index.
+            std::set<uint64_t> packs;
+            for (const auto& i : p.entries)
+            {
+                packs.insert(i.second.pack);
+            }
+            std::vector<uint8_t> data;
+            IO::CacheFileWriter writer(data);
+            writer.write(indexMagic, sizeof(indexMagic));
+            writer.write(fileVersion);
+            writer.write(static_cast<uint64_t>(p.counter));
+            writer.write(static_cast<uint32_t>(packs.size()));
+            for (const auto i : packs)
+            {
+                writer.write(static_cast<uint64_t>(i));
+            }
+            writer.write(static_cast<uint32_t>(p.entries.size()));
+            for (const auto& i : p.entries)
+            {
+                writer.write(i.first);
+                writer.write(static_cast<uint64_t>(i.second.fileSize));
+                writer.write(static_cast<int64_t>(i.second.fileTime));
+                writer.write(i.second.sequence);
+                writer.write(static_cast<uint64_t>(i.second.access));
+                IO::writeImageInfo(writer, i.second.info);
+                writer.write(i.second.pluginName);
+                IO::writeTags(writer, i.second.tags);
+                writer.write(static_cast<uint64_t>(i.second.pack));
+                writer.write(static_cast<uint64_t>(i.second.offset));
+            }
+            IO::writeCacheFile(getIndexFileName(fileName), data);
+
+            // Remove the pack files that are no longer used. The files must
+            // be closed first since Windows cannot remove a file that is
+            // open.
+            auto i = p.packs.begin();
+            while (i != p.packs.end())
+            {
+                if (packs.find(i->first) == packs.end())
+                {
+                    const uint64_t generation = i->first;
+                    i = p.packs.erase(i);
+                    std::remove(getPackFileName(fileName, generation).c_str());
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+
+            // Remove the pack file from the previous version of the cache.
+            std::remove((fileName + ".pack").c_str());
+
+            p.dirty = false;
+        }
+
+        bool ThumbnailCache::isDirty() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->dirty;
+        }
+
+    } // namespace AV
+} // namespace djv
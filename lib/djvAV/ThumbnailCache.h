@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvImage/Type.h>
+
+#include <djvCore/Core.h>
+
+#include <memory>
+#include <string>
+
+namespace djv
+{
+    namespace System
+    {
+        namespace File
+        {
+            class Info;
+
+        } // namespace File
+    } // namespace System
+
+    namespace Image
+    {
+        class Data;
+        class Size;
+
+    } // namespace Image
+
+    namespace AV
+    {
+        //! This constant provides the default thumbnail cache file name.
+        const std::string thumbnailCacheFileName = "djvThumbnailCache";
+
+        //! This class provides a persistent cache of thumbnail images.
+        //!
+        //! The cache is stored in an index file (".idx") and one or more pack
+        //! files (".pack") containing the image data. The index is read on
+        //! startup and the image data is read from the pack files on demand.
+        //!
+        //! Entries are keyed by the file name, thumbnail size, and image type,
+        //! and validated against the file size, modification time, and
+        //! sequence frame numbers. Out of date entries are removed when they
+        //! are accessed. When the cache exceeds the maximum byte count the
+        //! least recently used entries are removed.
+        //!
+        //! Pack files are never modified in place. New thumbnails are kept in
+        //! memory until the cache is written, at which point they are written
+        //! to a new pack file. When there are too many pack files, or they
+        //! contain too much unused data, all of the image data is copied to a
+        //! single new pack file and the old ones are removed. This allows
+        //! multiple processes to share the cache safely.
+        class ThumbnailCache
+        {
+            DJV_NON_COPYABLE(ThumbnailCache);
+
+        protected:
+            ThumbnailCache();
+
+        public:
+            ~ThumbnailCache();
+
+            //! Create a new thumbnail cache.
+            static std::shared_ptr<ThumbnailCache> create();
+
+            //! \name Size
+            ///@{
+
+            //! Get the maximum byte count.
+            size_t getMax() const;
+
+            size_t getCount() const;
+            size_t getByteCount() const;
+            float getPercentageUsed() const;
+
+            //! Set the maximum byte count.
+            void setMax(size_t);
+
+            ///@}
+
+            //! \name Contents
+            ///@{
+
+            //! Get a thumbnail. Returns a null pointer if the thumbnail is not
+            //! in the cache or the cache entry is out of date.
+            std::shared_ptr<Image::Data> get(
+                const System::File::Info&,
+                const Image::Size&,
+                Image::Type = Image::Type::None) const;
+
+            void add(
+                const System::File::Info&,
+                const Image::Size&,
+                Image::Type,
+                const std::shared_ptr<Image::Data>&);
+            void clear();
+
+            ///@}
+
+            //! \name Persistence
+            ///@{
+
+            //! Read the cache index and open the pack file. Invalid or
+            //! incompatible cache files are ignored.
+            //! Throws:
+            //! - System::File::Error
+            void read(const std::string& fileName);
+
+            //! Write the cache index and pack file.
+            //! Throws:
+            //! - System::File::Error
+            void write(const std::string& fileName);
+
+            //! Get whether the cache has changed since it was last read or
+            //! written.
+            bool isDirty() const;
+
+            ///@}
+
+        private:
+            DJV_PRIVATE();
+        };
+
+    } // namespace AV
+} // namespace djv
@@ -5,7 +5,10 @@
 #include <djvAV/ThumbnailSystem.h>
 
 #include <djvAV/IOSystem.h>
+#include <djvAV/InfoCache.h>
+#include <djvAV/ThumbnailCache.h>
 
+#include <djvGL/GLFWSystem.h>
 #include <djvGL/ImageConvert.h>
 
 #include <djvImage/Data.h>
@@ -17,6 +20,7 @@
 #include <djvSystem/TimerFunc.h>
 
 #include <djvCore/Cache.h>
+#include <djvCore/MetricsFunc.h>
 #include <djvCore/OSFunc.h>
 #include <djvCore/UIDFunc.h>
 
@@ -24,7 +28,9 @@
 #include <GLFW/glfw3.h>
 
 #include <atomic>
+#include <map>
 #include <mutex>
+#include <set>
 #include <thread>
 
 using namespace djv::Core;
@@ -36,8 +42,7 @@ namespace djv
         namespace
         {
             //! \todo Should this be configurable?
-            const size_t infoProcessMax  = 4;
-            const size_t imageProcessMax = 4;
+            const size_t processMin      = 4;
             const size_t infoCacheMax    = 1000;
             const size_t imageCacheMax   = 1000;
 
@@ -118,6 +123,85 @@ namespace djv
                 std::promise<std::shared_ptr<Image::Data> > promise;
             };
 
+            //! This class provides a queue of requests ordered by priority.
+            //! Requests with the same priority are processed in the order
+            //! they were added.
+            template<typename T>
+            class RequestQueue
+            {
+            public:
+                size_t getSize() const
+                {
+                    return _requests.size();
+                }
+
+                void push(T&& request, size_t priority)
+                {
+                    const UID uid = request.uid;
+                    _requests.insert(std::make_pair(std::make_pair(priority, uid), std::move(request)));
+                    _priorities[uid] = priority;
+                }
+
+                bool pop(T& out)
+                {
+                    bool r = false;
+                    const auto i = _requests.begin();
+                    if (i != _requests.end())
+                    {
+                        out = std::move(i->second);
+                        _priorities.erase(i->first.second);
+                        _requests.erase(i);
+                        r = true;
+                    }
+                    return r;
+                }
+
+                bool remove(UID uid)
+                {
+                    bool r = false;
+                    const auto i = _priorities.find(uid);
+                    if (i != _priorities.end())
+                    {
+                        _requests.erase(std::make_pair(i->second, uid));
+                        _priorities.erase(i);
+                        r = true;
+                    }
+                    return r;
+                }
+
+                void setPriority(UID uid, size_t priority)
+                {
+                    const auto i = _priorities.find(uid);
+                    if (i != _priorities.end() && i->second != priority)
+                    {
+                        const auto j = _requests.find(std::make_pair(i->second, uid));
+                        T request = std::move(j->second);
+                        _requests.erase(j);
+                        _requests.insert(std::make_pair(std::make_pair(priority, uid), std::move(request)));
+                        i->second = priority;
+                    }
+                }
+
+            private:
+                std::map<std::pair<size_t, UID>, T> _requests;
+                std::map<UID, size_t> _priorities;
+            };
+
+            size_t getProcessMax()
+            {
+                return std::max(processMin, static_cast<size_t>(std::thread::hardware_concurrency()));
+            }
+
+            size_t getProxy(const Image::Size& imageSize, const Image::Size& size)
+            {
+                size_t out = 1;
+                while (imageSize.w / (out * 2) >= size.w && imageSize.h / (out * 2) >= size.h)
+                {
+                    out *= 2;
+                }
+                return out;
+            }
+
             size_t getInfoCacheKey(const System::File::Info& fileInfo)
             {
                 size_t out = 0;
@@ -135,6 +219,27 @@ namespace djv
                 return out;
             }
 
+            GLFWwindow* createGLFWWindow(const std::string& name)
+            {
+#if defined(DJV_GL_ES2)
+                glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
+                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
+                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+#else // DJV_GL_ES2
+                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+                glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+                glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#endif // DJV_GL_ES2
+                glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+                int env = 0;
+                if (OS::getIntEnv("DJV_GL_DEBUG", env) && env != 0)
+                {
+                    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+                }
+                return glfwCreateWindow(100, 100, name.c_str(), NULL, NULL);
+            }
+
         } // namespace
         
         ThumbnailSystem::InfoFuture::InfoFuture()
@@ -162,20 +267,28 @@ namespace djv
             std::shared_ptr<System::TextSystem> textSystem;
             std::shared_ptr<IO::IOSystem> io;
 
-            std::list<InfoRequest> infoRequests;
-            std::list<ImageRequest> imageRequests;
+            size_t processMax = processMin;
+            RequestQueue<InfoRequest> infoRequests;
+            RequestQueue<ImageRequest> imageRequests;
+            std::set<UID> cancelledInfoRequests;
+            std::set<UID> cancelledImageRequests;
             std::condition_variable requestCV;
             std::mutex requestMutex;
             std::list<InfoRequest> pendingInfoRequests;
             std::list<ImageRequest> pendingImageRequests;
 
             Memory::Cache<size_t, IO::Info> infoCache;
+            std::shared_ptr<IO::InfoCache> infoDiskCache;
+            std::string infoDiskCacheFileName;
             std::atomic<float> infoCachePercentage;
             Memory::Cache<size_t, std::shared_ptr<Image::Data> > imageCache;
+            std::shared_ptr<ThumbnailCache> imageDiskCache;
+            std::string imageDiskCacheFileName;
             std::atomic<float> imageCachePercentage;
             std::atomic<bool> clearCache;
             std::shared_ptr<Observer::Value<bool> > ioOptionsObserver;
 
+            bool glInit = false;
             GLFWwindow * glfwWindow = nullptr;
             std::shared_ptr<System::Timer> statsTimer;
             std::thread thread;
@@ -192,33 +305,37 @@ namespace djv
             p.io = context->getSystemT<IO::IOSystem>();
             addDependency(p.io);
 
+            p.processMax = getProcessMax();
             p.infoCache.setMax(infoCacheMax);
+            p.infoDiskCache = IO::InfoCache::create();
+            auto resourceSystem = context->getSystemT<System::ResourceSystem>();
+            p.infoDiskCacheFileName = System::File::Path(
+                resourceSystem->getPath(System::File::ResourcePath::Documents),
+                IO::infoCacheFileName).get();
+            try
+            {
+                p.infoDiskCache->read(p.infoDiskCacheFileName);
+            }
+            catch (const std::exception& e)
+            {
+                _log(e.what(), System::LogLevel::Error);
+            }
             p.infoCachePercentage = 0.F;
             p.imageCache.setMax(imageCacheMax);
-            p.imageCachePercentage = 0.F;
-            p.clearCache = false;
-
-#if defined(DJV_GL_ES2)
-            glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
-#else // DJV_GL_ES2
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
-            glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-            glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-#endif // DJV_GL_ES2
-            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
-            int env = 0;
-            if (OS::getIntEnv("DJV_GL_DEBUG", env) && env != 0)
+            p.imageDiskCache = ThumbnailCache::create();
+            p.imageDiskCacheFileName = System::File::Path(
+                resourceSystem->getPath(System::File::ResourcePath::Documents),
+                thumbnailCacheFileName).get();
+            try
             {
-                glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+                p.imageDiskCache->read(p.imageDiskCacheFileName);
             }
-            p.glfwWindow = glfwCreateWindow(100, 100, context->getName().c_str(), NULL, NULL);
-            if (!p.glfwWindow)
+            catch (const std::exception& e)
             {
-                throw ThumbnailError(p.textSystem->getText(DJV_TEXT("error_glfw_window_creation")));
+                _log(e.what(), System::LogLevel::Error);
             }
+            p.imageCachePercentage = 0.F;
+            p.clearCache = false;
 
             p.statsTimer = System::Timer::create(context);
             p.statsTimer->setRepeating(true);
@@ -236,7 +353,6 @@ namespace djv
             });
 
             auto logSystem = context->getSystemT<System::LogSystem>();
-            auto resourceSystem = context->getSystemT<System::ResourceSystem>();
             p.running = true;
             p.thread = std::thread(
                 [this, resourceSystem, logSystem]
@@ -244,17 +360,11 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 try
                 {
-                    glfwMakeContextCurrent(p.glfwWindow);
-#if defined(DJV_GL_ES2)
-                    if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
-#else // DJV_GL_ES2
-                    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
-#endif // DJV_GL_ES2
-                    {
-                        throw ThumbnailError(p.textSystem->getText(DJV_TEXT("error_glad_init")));
-                    }
-
-                    auto convert = GL::ImageConvert::create(p.textSystem, resourceSystem);
+                    // The OpenGL context is only needed to resize and convert
+                    // images, so it is not initialized until the first image
+                    // request.
+                    GLFWwindow* glfwWindow = nullptr;
+                    std::shared_ptr<GL::ImageConvert> convert;
 
                     const auto timeout = System::getTimerValue(System::TimerValue::Medium);
                     while (p.running)
@@ -263,8 +373,10 @@ namespace djv
                         {
                             p.clearCache = false;
                             p.infoCache.clear();
+                            p.infoDiskCache->clear();
                             p.infoCachePercentage = 0.F;
                             p.imageCache.clear();
+                            p.imageDiskCache->clear();
                             p.imageCachePercentage = 0.F;
                         }
 
@@ -278,11 +390,15 @@ namespace djv
                                 [this]
                             {
                                 DJV_PRIVATE_PTR();
-                                return p.infoRequests.size() || p.imageRequests.size();
+                                return p.infoRequests.getSize() || p.imageRequests.getSize();
                             }))
                             {
-                                infoRequests  |= p.infoRequests.size () > 0;
-                                imageRequests |= p.imageRequests.size() > 0;
+                                infoRequests  |= p.infoRequests.getSize() > 0;
+                                imageRequests |= p.imageRequests.getSize() > 0;
+                            }
+                            if (!glfwWindow)
+                            {
+                                glfwWindow = p.glfwWindow;
                             }
                         }
                         if (infoRequests)
@@ -291,6 +407,19 @@ namespace djv
                         }
                         if (imageRequests)
                         {
+                            if (glfwWindow && !convert)
+                            {
+                                glfwMakeContextCurrent(glfwWindow);
+#if defined(DJV_GL_ES2)
+                                if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
+#else // DJV_GL_ES2
+                                if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+#endif // DJV_GL_ES2
+                                {
+                                    throw ThumbnailError(p.textSystem->getText(DJV_TEXT("error_glad_init")));
+                                }
+                                convert = GL::ImageConvert::create(p.textSystem, resourceSystem);
+                            }
                             _handleImageRequests(convert);
                         }
                     }
@@ -328,6 +457,28 @@ namespace djv
             {
                 p.thread.join();
             }
+            if (p.infoDiskCache->isDirty())
+            {
+                try
+                {
+                    p.infoDiskCache->write(p.infoDiskCacheFileName);
+                }
+                catch (const std::exception& e)
+                {
+                    _log(e.what(), System::LogLevel::Error);
+                }
+            }
+            if (p.imageDiskCache->isDirty())
+            {
+                try
+                {
+                    p.imageDiskCache->write(p.imageDiskCacheFileName);
+                }
+                catch (const std::exception& e)
+                {
+                    _log(e.what(), System::LogLevel::Error);
+                }
+            }
             if (p.glfwWindow)
             {
                 glfwDestroyWindow(p.glfwWindow);
@@ -345,74 +496,96 @@ namespace djv
             return out;
         }
 
-        ThumbnailSystem::InfoFuture ThumbnailSystem::getInfo(const System::File::Info& fileInfo)
+        ThumbnailSystem::InfoFuture ThumbnailSystem::getInfo(const System::File::Info& fileInfo, size_t priority)
         {
             DJV_PRIVATE_PTR();
             InfoRequest request;
+            const UID uid = request.uid;
             request.fileInfo = fileInfo;
             auto future = request.promise.get_future();
             {
                 std::unique_lock<std::mutex> lock(p.requestMutex);
-                p.infoRequests.push_back(std::move(request));
+                p.infoRequests.push(std::move(request), priority);
             }
             p.requestCV.notify_one();
-            return InfoFuture(future, request.uid);
+            return InfoFuture(future, uid);
+        }
+
+        void ThumbnailSystem::setInfoPriority(UID uid, size_t priority)
+        {
+            DJV_PRIVATE_PTR();
+            std::unique_lock<std::mutex> lock(p.requestMutex);
+            p.infoRequests.setPriority(uid, priority);
         }
         
         void ThumbnailSystem::cancelInfo(UID uid)
         {
             DJV_PRIVATE_PTR();
+            std::unique_lock<std::mutex> lock(p.requestMutex);
+            if (!p.infoRequests.remove(uid))
             {
-                std::unique_lock<std::mutex> lock(p.requestMutex);
-                const auto i = std::find_if(
-                    p.infoRequests.rbegin(),
-                    p.infoRequests.rend(),
-                    [uid](const InfoRequest& value)
-                {
-                    return value.uid == uid;
-                });
-                if (i != p.infoRequests.rend())
-                {
-                    p.infoRequests.erase(--(i.base()));
-                }
+                p.cancelledInfoRequests.insert(uid);
             }
         }
 
         ThumbnailSystem::ImageFuture ThumbnailSystem::getImage(
             const System::File::Info& fileInfo,
             const Image::Size&        size,
-            Image::Type               type)
+            Image::Type               type,
+            size_t                    priority)
         {
             DJV_PRIVATE_PTR();
+            if (!p.glInit)
+            {
+                // GLFW windows need to be created on the main thread.
+                p.glInit = true;
+                if (auto context = getContext().lock())
+                {
+                    try
+                    {
+                        addDependency(GL::GLFW::GLFWSystem::create(context));
+                        GLFWwindow* glfwWindow = createGLFWWindow(context->getName());
+                        if (!glfwWindow)
+                        {
+                            throw ThumbnailError(p.textSystem->getText(DJV_TEXT("error_glfw_window_creation")));
+                        }
+                        std::unique_lock<std::mutex> lock(p.requestMutex);
+                        p.glfwWindow = glfwWindow;
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _log(e.what(), System::LogLevel::Error);
+                    }
+                }
+            }
             ImageRequest request;
+            const UID uid = request.uid;
             request.fileInfo = fileInfo;
             request.size = size;
             request.type = type;
             auto future = request.promise.get_future();
             {
                 std::unique_lock<std::mutex> lock(p.requestMutex);
-                p.imageRequests.push_back(std::move(request));
+                p.imageRequests.push(std::move(request), priority);
             }
             p.requestCV.notify_one();
-            return ImageFuture(future, request.uid);
+            return ImageFuture(future, uid);
+        }
+
+        void ThumbnailSystem::setImagePriority(UID uid, size_t priority)
+        {
+            DJV_PRIVATE_PTR();
+            std::unique_lock<std::mutex> lock(p.requestMutex);
+            p.imageRequests.setPriority(uid, priority);
         }
         
         void ThumbnailSystem::cancelImage(UID uid)
         {
             DJV_PRIVATE_PTR();
+            std::unique_lock<std::mutex> lock(p.requestMutex);
+            if (!p.imageRequests.remove(uid))
             {
-                std::unique_lock<std::mutex> lock(p.requestMutex);
-                const auto i = std::find_if(
-                    p.imageRequests.rbegin(),
-                    p.imageRequests.rend(),
-                    [uid](const ImageRequest& value)
-                {
-                    return value.uid == uid;
-                });
-                if (i != p.imageRequests.rend())
-                {
-                    p.imageRequests.erase(--(i.base()));
-                }
+                p.cancelledImageRequests.insert(uid);
             }
         }
 
@@ -434,32 +607,41 @@ namespace djv
         void ThumbnailSystem::_handleInfoRequests()
         {
             DJV_PRIVATE_PTR();
+            static const auto infoCacheHitCounter = Metrics::getCounter("djv::AV::ThumbnailSystem::infoCacheHits");
+            static const auto infoCacheMissCounter = Metrics::getCounter("djv::AV::ThumbnailSystem::infoCacheMisses");
 
             // Process new requests.
-            while (p.pendingInfoRequests.size() < infoProcessMax)
+            while (p.pendingInfoRequests.size() < p.processMax)
             {
                 InfoRequest i;
                 {
                     std::unique_lock<std::mutex> lock(p.requestMutex);
-                    if (p.infoRequests.size())
-                    {
-                        i = std::move(p.infoRequests.front());
-                        p.infoRequests.pop_front();
-                    }
-                    else
+                    if (!p.infoRequests.pop(i))
                     {
                         break;
                     }
                 }
                 const auto key = getInfoCacheKey(i.fileInfo);
                 IO::Info info;
-                const bool cached = p.infoCache.get(key, info);
-                if (cached)
+                if (p.infoCache.get(key, info))
+                {
+                    infoCacheHitCounter->add();
+                    i.promise.set_value(info);
+                }
+                else if (
+                    // Directory listings may not include the file system
+                    // information that is used to validate the disk cache.
+                    (i.fileInfo.doesExist() || i.fileInfo.stat()) &&
+                    p.infoDiskCache->get(i.fileInfo, info))
                 {
+                    infoCacheHitCounter->add();
+                    p.infoCache.add(key, info);
+                    p.infoCachePercentage = p.infoCache.getPercentageUsed();
                     i.promise.set_value(info);
                 }
                 else
                 {
+                    infoCacheMissCounter->add();
                     try
                     {
                         i.read = p.io->read(i.fileInfo);
@@ -480,6 +662,21 @@ namespace djv
                 }
             }
 
+            // Drop cancelled requests.
+            std::set<UID> cancelled;
+            {
+                std::unique_lock<std::mutex> lock(p.requestMutex);
+                std::swap(cancelled, p.cancelledInfoRequests);
+            }
+            if (cancelled.size())
+            {
+                p.pendingInfoRequests.remove_if(
+                    [&cancelled](const InfoRequest& value)
+                    {
+                        return cancelled.find(value.uid) != cancelled.end();
+                    });
+            }
+
             // Process pending requests.
             auto i = p.pendingInfoRequests.begin();
             while (i != p.pendingInfoRequests.end())
@@ -489,10 +686,11 @@ namespace djv
                 {
                     try
                     {
-                    const auto info = i->infoFuture.get();
-                    p.infoCache.add(getInfoCacheKey(i->fileInfo), info);
-                    p.infoCachePercentage = p.infoCache.getPercentageUsed();
-                    i->promise.set_value(info);
+                        const auto info = i->infoFuture.get();
+                        p.infoCache.add(getInfoCacheKey(i->fileInfo), info);
+                        p.infoDiskCache->add(i->fileInfo, info);
+                        p.infoCachePercentage = p.infoCache.getPercentageUsed();
+                        i->promise.set_value(info);
                     }
                     catch (const std::exception&)
                     {
@@ -517,19 +715,16 @@ namespace djv
         void ThumbnailSystem::_handleImageRequests(const std::shared_ptr<GL::ImageConvert>& convert)
         {
             DJV_PRIVATE_PTR();
+            static const auto imageCacheHitCounter = Metrics::getCounter("djv::AV::ThumbnailSystem::imageCacheHits");
+            static const auto imageCacheMissCounter = Metrics::getCounter("djv::AV::ThumbnailSystem::imageCacheMisses");
 
             // Process new requests.
-            while (p.pendingImageRequests.size() < imageProcessMax)
+            while (p.pendingImageRequests.size() < p.processMax)
             {
                 ImageRequest i;
                 {
                     std::unique_lock<std::mutex> lock(p.requestMutex);
-                    if (p.imageRequests.size())
-                    {
-                        i = std::move(p.imageRequests.front());
-                        p.imageRequests.pop_front();
-                    }
-                    else
+                    if (!p.imageRequests.pop(i))
                     {
                         break;
                     }
@@ -537,16 +732,42 @@ namespace djv
                 const auto key = getImageCacheKey(i.fileInfo, i.size, i.type);
                 std::shared_ptr<Image::Data> image;
                 p.imageCache.get(key, image);
+                if (!image)
+                {
+                    // Directory listings may not include the file system
+                    // information that is used to validate the disk cache.
+                    if (!i.fileInfo.doesExist())
+                    {
+                        i.fileInfo.stat();
+                    }
+                    image = p.imageDiskCache->get(i.fileInfo, i.size, i.type);
+                    if (image)
+                    {
+                        p.imageCache.add(key, image);
+                        p.imageCachePercentage = p.imageCache.getPercentageUsed();
+                    }
+                }
                 if (image)
                 {
+                    imageCacheHitCounter->add();
                     i.promise.set_value(image);
                 }
                 else
                 {
+                    imageCacheMissCounter->add();
                     try
                     {
-                        i.read = p.io->read(i.fileInfo);
-                        const auto info = i.read->getInfo().get();
+                        // If the information is already cached, read the
+                        // image at a reduced resolution.
+                        IO::ReadOptions options;
+                        IO::Info info;
+                        if ((p.infoCache.get(getInfoCacheKey(i.fileInfo), info) || p.infoDiskCache->get(i.fileInfo, info)) &&
+                            info.video.size() > 0)
+                        {
+                            options.proxy = getProxy(info.video[0].size, i.size);
+                        }
+                        i.read = p.io->read(i.fileInfo, options);
+                        info = i.read->getInfo().get();
                         if (info.video.size() > 0)
                         {
                             p.pendingImageRequests.push_back(std::move(i));
@@ -570,6 +791,21 @@ namespace djv
                 }
             }
 
+            // Drop cancelled requests.
+            std::set<UID> cancelled;
+            {
+                std::unique_lock<std::mutex> lock(p.requestMutex);
+                std::swap(cancelled, p.cancelledImageRequests);
+            }
+            if (cancelled.size())
+            {
+                p.pendingImageRequests.remove_if(
+                    [&cancelled](const ImageRequest& value)
+                    {
+                        return cancelled.find(value.uid) != cancelled.end();
+                    });
+            }
+
             // Process pending requests.
             auto i = p.pendingImageRequests.begin();
             while (i != p.pendingImageRequests.end())
@@ -615,10 +851,15 @@ namespace djv
                             auto tmp = Image::Data::create(info);
                             tmp->setPluginName(image->getPluginName());
                             tmp->setTags(image->getTags());
+                            if (!convert)
+                            {
+                                throw ThumbnailError(p.textSystem->getText(DJV_TEXT("error_glfw_window_creation")));
+                            }
                             convert->process(*image, info, *tmp);
                             image = tmp;
                         }
                         p.imageCache.add(getImageCacheKey(i->fileInfo, i->size, i->type), image);
+                        p.imageDiskCache->add(i->fileInfo, i->size, i->type, image);
                         p.imageCachePercentage = p.imageCache.getPercentageUsed();
                         i->promise.set_value(image);
                     }
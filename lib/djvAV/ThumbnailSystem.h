@@ -53,6 +53,10 @@ namespace djv
         };
         
         //! This class provides a system for generating thumbnail images from files.
+        //!
+        //! Requests are processed in priority order, with lower values
+        //! processed first. The priority of a queued request can be changed,
+        //! for example as the user scrolls through a list of files.
         class ThumbnailSystem : public System::ISystem
         {
             DJV_NON_COPYABLE(ThumbnailSystem);
@@ -64,9 +68,8 @@ namespace djv
         public:
             ~ThumbnailSystem() override;
 
-            //! Create a new thumbnail system.
-            //! Throws:
-            //! - ThumbnailError
+            //! Create a new thumbnail system. OpenGL is not initialized until
+            //! the first image is requested.
             static std::shared_ptr<ThumbnailSystem> create(const std::shared_ptr<System::Context>&);
 
             //! This structure provides thumbnail information.
@@ -79,7 +82,10 @@ namespace djv
             };
             
             //! Get information about a file.
-            InfoFuture getInfo(const System::File::Info&);
+            InfoFuture getInfo(const System::File::Info&, size_t priority = 0);
+
+            //! Set the priority of an information request.
+            void setInfoPriority(Core::UID, size_t);
 
             //! Cancel information about a file.
             void cancelInfo(Core::UID);
@@ -93,11 +99,16 @@ namespace djv
                 Core::UID uid = 0;
             };
 
-            //! Get a thumbnail image.
+            //! Get a thumbnail image. This function must be called from the
+            //! main thread.
             ImageFuture getImage(
                 const System::File::Info& path,
                 const Image::Size&        size,
-                Image::Type               type = Image::Type::None);
+                Image::Type               type     = Image::Type::None,
+                size_t                    priority = 0);
+
+            //! Set the priority of a thumbnail image request.
+            void setImagePriority(Core::UID, size_t);
 
             //! Cancel a thumbnail image.
             void cancelImage(Core::UID);
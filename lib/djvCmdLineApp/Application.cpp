@@ -8,17 +8,22 @@
 #include <djvAV/TimeFunc.h>
 
 #include <djvSystem/Context.h>
+#include <djvSystem/FileIO.h>
 #include <djvSystem/LogSystem.h>
 #include <djvSystem/ResourceSystem.h>
 #include <djvSystem/TextSystem.h>
 
 #include <djvCore/ErrorFunc.h>
+#include <djvCore/MetricsFunc.h>
 #include <djvCore/OS.h>
 #include <djvCore/StringFormat.h>
 #include <djvCore/StringFunc.h>
+#include <djvCore/TraceFunc.h>
 
+#include <chrono>
 #include <iostream>
 #include <sstream>
+#include <thread>
 
 using namespace djv::Core;
 
@@ -37,10 +42,14 @@ namespace djv
         {
             bool running = false;
             int exit = 0;
+            std::string metricsFileName;
+            std::string traceFileName;
         };
 
         void Application::_init(std::list<std::string>& args)
         {
+            const auto startTime = std::chrono::steady_clock::now();
+
             std::string argv0;
             if (args.size())
             {
@@ -64,6 +73,40 @@ namespace djv
                     arg = args.erase(arg);
                     logSystem->setConsoleOutput(true);
                 }
+                else if ("-metrics" == *arg)
+                {
+                    arg = args.erase(arg);
+                    if (args.end() == arg)
+                    {
+                        auto textSystem = getSystemT<System::TextSystem>();
+                        throw std::runtime_error(String::Format("{0}: {1}").
+                            arg("-metrics").
+                            arg(textSystem->getText(DJV_TEXT("error_cannot_parse_argument"))));
+                    }
+                    _p->metricsFileName = *arg;
+                    arg = args.erase(arg);
+                }
+                else if ("-trace" == *arg)
+                {
+                    arg = args.erase(arg);
+                    if (args.end() == arg)
+                    {
+                        auto textSystem = getSystemT<System::TextSystem>();
+                        throw std::runtime_error(String::Format("{0}: {1}").
+                            arg("-trace").
+                            arg(textSystem->getText(DJV_TEXT("error_cannot_parse_argument"))));
+                    }
+#if defined(DJV_TRACE_ENABLED)
+                    _p->traceFileName = *arg;
+                    Trace::setEnabled(true);
+#else // DJV_TRACE_ENABLED
+                    logSystem->log(
+                        "djv::CmdLine::Application",
+                        "-trace: Tracing is not enabled in this build, see the DJV_TRACE build option.",
+                        System::LogLevel::Warning);
+#endif // DJV_TRACE_ENABLED
+                    arg = args.erase(arg);
+                }
                 else if ("-version" == *arg)
                 {
                     arg = args.erase(arg);
@@ -79,6 +122,15 @@ namespace djv
 
             // Create the systems.
             AV::AVSystem::create(shared_from_this());
+
+            const auto startupTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - startTime).count();
+            Metrics::getGauge("djv::CmdLine::Application::startupTime")->set(startupTime);
+            {
+                std::stringstream ss;
+                ss << "Startup time: " << startupTime / 1000.F << "ms";
+                logSystem->log("djv::CmdLine::Application", ss.str());
+            }
         }
 
         Application::Application() :
@@ -86,7 +138,35 @@ namespace djv
         {}
 
         Application::~Application()
-        {}
+        {
+            DJV_PRIVATE_PTR();
+            if (!p.metricsFileName.empty())
+            {
+                try
+                {
+                    auto io = System::File::IO::create();
+                    io->open(p.metricsFileName, System::File::Mode::Write);
+                    io->write(Metrics::toJSON());
+                }
+                catch (const std::exception& e)
+                {
+                    std::cout << Error::format(e) << std::endl;
+                }
+            }
+            if (!p.traceFileName.empty())
+            {
+                try
+                {
+                    auto io = System::File::IO::create();
+                    io->open(p.traceFileName, System::File::Mode::Write);
+                    io->write(Trace::toChromeJSON(Trace::getEvents()));
+                }
+                catch (const std::exception& e)
+                {
+                    std::cout << Error::format(e) << std::endl;
+                }
+            }
+        }
 
         std::shared_ptr<Application> Application::create(std::list<std::string>& args)
         {
@@ -98,21 +178,22 @@ namespace djv
         void Application::run()
         {
             DJV_PRIVATE_PTR();
-            auto time = std::chrono::steady_clock::now();
-            Time::Duration delta = Time::Duration::zero();
+            const auto frameTime = std::chrono::microseconds(1000000 / frameRate);
             p.running = true;
             while (p.running)
             {
+                const auto time = std::chrono::steady_clock::now();
                 tick();
 
-                auto end = std::chrono::steady_clock::now();
-                delta = std::chrono::duration_cast<Time::Duration>(end - time);
-                while (delta < std::chrono::microseconds(1000000 / frameRate))
+                // Sleep until a tick is requested or a timer times out, but
+                // do not tick faster than the frame rate.
+                if (p.running)
                 {
-                    end = std::chrono::steady_clock::now();
-                    delta = std::chrono::duration_cast<Time::Duration>(end - time);
+                    Time::TimePoint next = Time::TimePoint::max();
+                    getNextTickTime(next);
+                    waitForTick(std::max(next, time + frameTime));
+                    std::this_thread::sleep_until(time + frameTime);
                 }
-                time = end;
             }
         }
 
@@ -126,6 +207,7 @@ namespace djv
             DJV_PRIVATE_PTR();
             p.running = false;
             p.exit = value;
+            requestTick();
         }
 
         std::list<std::string> Application::args(int argc, char** argv)
@@ -215,6 +297,12 @@ namespace djv
             std::cout << "   " << textSystem->getText(DJV_TEXT("cli_option_log_console")) << std::endl;
             std::cout << "   " << textSystem->getText(DJV_TEXT("cli_option_log_console_description")) << std::endl;
             std::cout << std::endl;
+            std::cout << "   " << textSystem->getText(DJV_TEXT("cli_option_metrics")) << std::endl;
+            std::cout << "   " << textSystem->getText(DJV_TEXT("cli_option_metrics_description")) << std::endl;
+            std::cout << std::endl;
+            std::cout << "   " << textSystem->getText(DJV_TEXT("cli_option_trace")) << std::endl;
+            std::cout << "   " << textSystem->getText(DJV_TEXT("cli_option_trace_description")) << std::endl;
+            std::cout << std::endl;
             std::cout << "   " << textSystem->getText(DJV_TEXT("cli_option_version")) << std::endl;
             std::cout << "   " << textSystem->getText(DJV_TEXT("cli_option_version_description")) << std::endl;
             std::cout << std::endl;
@@ -6,7 +6,12 @@
 
 #include <djvCore/Core.h>
 
-#include <map>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace djv
@@ -15,22 +20,36 @@ namespace djv
     {
         namespace Memory
         {
-            //! This class provides a cache.
+            //! This class provides a least recently used cache.
+            //!
+            //! Getting, adding, and removing values are constant time
+            //! operations. By default each value counts as one towards the
+            //! maximum, a weight function can be set so that the maximum
+            //! applies to the total weight instead (for example the byte
+            //! count).
             //!
             //! \todo Return an iterator from get() instead of a value?
-            template<typename T, typename U>
+            template<typename T, typename U, typename H = std::hash<T> >
             class Cache
             {
+                DJV_NON_COPYABLE(Cache);
+
             public:
+                Cache();
+
                 //! \name Size
                 ///@{
 
                 size_t getMax() const;
                 size_t getSize() const;
+                size_t getWeight() const;
                 float getPercentageUsed() const;
 
                 void setMax(size_t);
 
+                //! Set the function used to get the weight of a value.
+                void setWeightFunc(const std::function<size_t(const U&)>&);
+
                 ///@}
 
                 //! \name Contents
@@ -43,18 +62,85 @@ namespace djv
                 void remove(const T& key);
                 void clear();
 
+                //! Get the keys, ordered from least to most recently used.
                 std::vector<T> getKeys() const;
+
+                //! Get the values, ordered from least to most recently used.
                 std::vector<U> getValues() const;
 
                 ///@}
 
             private:
+                struct Item
+                {
+                    T      key;
+                    U      value;
+                    size_t weight;
+                };
+                typedef std::list<Item> List;
+
                 void _maxUpdate();
 
                 size_t _max = 10000;
-                std::map<T, U> _map;
-                mutable std::map<T, int64_t> _counts;
-                mutable int64_t _counter = 0;
+                size_t _weight = 0;
+                std::function<size_t(const U&)> _weightFunc;
+                mutable List _list;
+                std::unordered_map<T, typename List::iterator, H> _map;
+            };
+
+            //! This class provides a thread safe least recently used cache.
+            //!
+            //! The cache is split into shards that are locked independently,
+            //! the least recently used values are removed per shard. Each
+            //! shard holds an equal part of the maximum. When the maximum is
+            //! smaller than the number of shards, only that many shards are
+            //! used.
+            template<typename T, typename U, typename H = std::hash<T>, size_t N = 16>
+            class ShardedCache
+            {
+                DJV_NON_COPYABLE(ShardedCache);
+
+            public:
+                ShardedCache();
+
+                //! \name Size
+                ///@{
+
+                size_t getMax() const;
+                size_t getSize() const;
+                size_t getWeight() const;
+                float getPercentageUsed() const;
+
+                void setMax(size_t);
+                void setWeightFunc(const std::function<size_t(const U&)>&);
+
+                ///@}
+
+                //! \name Contents
+                ///@{
+
+                bool contains(const T& key) const;
+                bool get(const T& key, U& value) const;
+
+                void add(const T& key, const U& value);
+                void remove(const T& key);
+                void clear();
+
+                ///@}
+
+            private:
+                struct Shard
+                {
+                    Cache<T, U, H>     cache;
+                    mutable std::mutex mutex;
+                };
+
+                Shard& _getShard(const T&) const;
+
+                size_t _max = 10000;
+                std::atomic<size_t> _shardCount;
+                H _hash;
+                mutable std::array<Shard, N> _shards;
             };
 
         } // namespace Memory
@@ -2,144 +2,286 @@
 // Copyright (c) 2004-2020 Darby Johnston
 // All rights reserved.
 
-#include <algorithm>
-
 namespace djv
 {
     namespace Core
     {
         namespace Memory
         {
-            template<typename T, typename U>
-            inline size_t Cache<T, U>::getMax() const
+            template<typename T, typename U, typename H>
+            inline Cache<T, U, H>::Cache()
+            {}
+
+            template<typename T, typename U, typename H>
+            inline size_t Cache<T, U, H>::getMax() const
             {
                 return _max;
             }
 
-            template<typename T, typename U>
-            inline size_t Cache<T, U>::getSize() const
+            template<typename T, typename U, typename H>
+            inline size_t Cache<T, U, H>::getSize() const
             {
                 return _map.size();
             }
 
-            template<typename T, typename U>
-            inline float Cache<T, U>::getPercentageUsed() const
+            template<typename T, typename U, typename H>
+            inline size_t Cache<T, U, H>::getWeight() const
+            {
+                return _weight;
+            }
+
+            template<typename T, typename U, typename H>
+            inline float Cache<T, U, H>::getPercentageUsed() const
             {
-                return _map.size() / static_cast<float>(_max) * 100.F;
+                return _weight / static_cast<float>(_max) * 100.F;
             }
 
-            template<typename T, typename U>
-            inline void Cache<T, U>::setMax(size_t value)
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::setMax(size_t value)
             {
                 _max = value;
                 _maxUpdate();
             }
 
-            template<typename T, typename U>
-            inline bool Cache<T, U>::contains(const T& key) const
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::setWeightFunc(const std::function<size_t(const U&)>& value)
+            {
+                _weightFunc = value;
+                _weight = 0;
+                for (auto& i : _list)
+                {
+                    i.weight = _weightFunc ? _weightFunc(i.value) : 1;
+                    _weight += i.weight;
+                }
+                _maxUpdate();
+            }
+
+            template<typename T, typename U, typename H>
+            inline bool Cache<T, U, H>::contains(const T& key) const
             {
                 return _map.find(key) != _map.end();
             }
 
-            template<typename T, typename U>
-            inline bool Cache<T, U>::get(const T& key, U& value) const
+            template<typename T, typename U, typename H>
+            inline bool Cache<T, U, H>::get(const T& key, U& value) const
             {
-                auto i = _map.find(key);
+                const auto i = _map.find(key);
                 if (i != _map.end())
                 {
-                    value = i->second;
-                    auto j = _counts.find(key);
-                    if (j != _counts.end())
-                    {
-                        ++_counter;
-                        j->second = _counter;
-                    }
+                    _list.splice(_list.end(), _list, i->second);
+                    value = i->second->value;
                     return true;
                 }
-                return i != _map.end();
+                return false;
             }
 
-            template<typename T, typename U>
-            inline void Cache<T, U>::add(const T& key, const U& value)
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::add(const T& key, const U& value)
             {
-                _map[key] = value;
-                ++_counter;
-                _counts[key] = _counter;
+                const size_t weight = _weightFunc ? _weightFunc(value) : 1;
+                const auto i = _map.find(key);
+                if (i != _map.end())
+                {
+                    _weight -= i->second->weight;
+                    i->second->value = value;
+                    i->second->weight = weight;
+                    _list.splice(_list.end(), _list, i->second);
+                }
+                else
+                {
+                    _list.push_back(Item({ key, value, weight }));
+                    _map[key] = std::prev(_list.end());
+                }
+                _weight += weight;
                 _maxUpdate();
             }
 
-            template<typename T, typename U>
-            inline void Cache<T, U>::remove(const T& key)
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::remove(const T& key)
             {
                 const auto i = _map.find(key);
                 if (i != _map.end())
                 {
+                    _weight -= i->second->weight;
+                    _list.erase(i->second);
                     _map.erase(i);
                 }
-                const auto j = _counts.find(key);
-                if (j != _counts.end())
-                {
-                    _counts.erase(j);
-                }
-                _maxUpdate();
             }
             
-            template<typename T, typename U>
-            inline void Cache<T, U>::clear()
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::clear()
             {
                 _map.clear();
+                _list.clear();
+                _weight = 0;
             }
 
-            template<typename T, typename U>
-            inline std::vector<T> Cache<T, U>::getKeys() const
+            template<typename T, typename U, typename H>
+            inline std::vector<T> Cache<T, U, H>::getKeys() const
             {
                 std::vector<T> out;
-                for (const auto& i : _map)
+                out.reserve(_list.size());
+                for (const auto& i : _list)
                 {
-                    out.push_back(i.first);
+                    out.push_back(i.key);
                 }
                 return out;
             }
 
-            template<typename T, typename U>
-            inline std::vector<U> Cache<T, U>::getValues() const
+            template<typename T, typename U, typename H>
+            inline std::vector<U> Cache<T, U, H>::getValues() const
             {
                 std::vector<U> out;
-                for (const auto& i : _map)
+                out.reserve(_list.size());
+                for (const auto& i : _list)
                 {
-                    out.push_back(i.second);
+                    out.push_back(i.value);
                 }
                 return out;
             }
 
-            template<typename T, typename U>
-            inline void Cache<T, U>::_maxUpdate()
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::_maxUpdate()
             {
-                if (_map.size() > _max)
+                while (_weight > _max && !_list.empty())
                 {
-                    std::map<int64_t, T> sorted;
-                    for (const auto& i : _counts)
-                    {
-                        sorted[i.second] = i.first;
-                    }
-                    while (_map.size() > _max)
+                    const auto& item = _list.front();
+                    _weight -= item.weight;
+                    _map.erase(item.key);
+                    _list.pop_front();
+                }
+            }
+
+            template<typename T, typename U, typename H, size_t N>
+            inline ShardedCache<T, U, H, N>::ShardedCache() :
+                _shardCount(N)
+            {
+                setMax(_max);
+            }
+
+            template<typename T, typename U, typename H, size_t N>
+            inline size_t ShardedCache<T, U, H, N>::getMax() const
+            {
+                return _max;
+            }
+
+            template<typename T, typename U, typename H, size_t N>
+            inline size_t ShardedCache<T, U, H, N>::getSize() const
+            {
+                size_t out = 0;
+                for (const auto& i : _shards)
+                {
+                    std::lock_guard<std::mutex> lock(i.mutex);
+                    out += i.cache.getSize();
+                }
+                return out;
+            }
+
+            template<typename T, typename U, typename H, size_t N>
+            inline size_t ShardedCache<T, U, H, N>::getWeight() const
+            {
+                size_t out = 0;
+                for (const auto& i : _shards)
+                {
+                    std::lock_guard<std::mutex> lock(i.mutex);
+                    out += i.cache.getWeight();
+                }
+                return out;
+            }
+
+            template<typename T, typename U, typename H, size_t N>
+            inline float ShardedCache<T, U, H, N>::getPercentageUsed() const
+            {
+                return getWeight() / static_cast<float>(_max) * 100.F;
+            }
+
+            template<typename T, typename U, typename H, size_t N>
+            inline void ShardedCache<T, U, H, N>::setMax(size_t value)
+            {
+                _max = value;
+
+                // Use fewer shards when the maximum is smaller than the
+                // number of shards, so that the total is not exceeded. The
+                // values are cleared when the number of shards changes since
+                // their keys map to different shards.
+                const size_t shardCount = std::max(std::min(value, N), static_cast<size_t>(1));
+                if (shardCount != _shardCount)
+                {
+                    _shardCount = shardCount;
+                    clear();
+                }
+                for (size_t i = 0; i < N; ++i)
+                {
+                    // Spread the remainder across the shards.
+                    size_t shardMax = 0;
+                    if (i < shardCount)
                     {
-                        auto begin = sorted.begin();
-                        auto i = _map.find(begin->second);
-                        if (i != _map.end())
-                        {
-                            _map.erase(i);
-                        }
-                        auto j = _counts.find(begin->second);
-                        if (j != _counts.end())
-                        {
-                            _counts.erase(j);
-                        }
-                        sorted.erase(begin);
+                        shardMax = value / shardCount + (i < value % shardCount ? 1 : 0);
                     }
+                    auto& shard = _shards[i];
+                    std::lock_guard<std::mutex> lock(shard.mutex);
+                    shard.cache.setMax(shardMax);
+                }
+            }
+
+            template<typename T, typename U, typename H, size_t N>
+            inline void ShardedCache<T, U, H, N>::setWeightFunc(const std::function<size_t(const U&)>& value)
+            {
+                for (auto& i : _shards)
+                {
+                    std::lock_guard<std::mutex> lock(i.mutex);
+                    i.cache.setWeightFunc(value);
                 }
             }
 
+            template<typename T, typename U, typename H, size_t N>
+            inline bool ShardedCache<T, U, H, N>::contains(const T& key) const
+            {
+                auto& shard = _getShard(key);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                return shard.cache.contains(key);
+            }
+
+            template<typename T, typename U, typename H, size_t N>
+            inline bool ShardedCache<T, U, H, N>::get(const T& key, U& value) const
+            {
+                auto& shard = _getShard(key);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                return shard.cache.get(key, value);
+            }
+
+            template<typename T, typename U, typename H, size_t N>
+            inline void ShardedCache<T, U, H, N>::add(const T& key, const U& value)
+            {
+                auto& shard = _getShard(key);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                shard.cache.add(key, value);
+            }
+
+            template<typename T, typename U, typename H, size_t N>
+            inline void ShardedCache<T, U, H, N>::remove(const T& key)
+            {
+                auto& shard = _getShard(key);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                shard.cache.remove(key);
+            }
+
+            template<typename T, typename U, typename H, size_t N>
+            inline void ShardedCache<T, U, H, N>::clear()
+            {
+                for (auto& i : _shards)
+                {
+                    std::lock_guard<std::mutex> lock(i.mutex);
+                    i.cache.clear();
+                }
+            }
+
+            template<typename T, typename U, typename H, size_t N>
+            inline typename ShardedCache<T, U, H, N>::Shard& ShardedCache<T, U, H, N>::_getShard(const T& key) const
+            {
+                return _shards[_hash(key) % _shardCount];
+            }
+
         } // namespace Memory
     } // namespace Core
 } // namespace djv
@@ -51,11 +51,12 @@ namespace djv
             private:
                 std::function<void(const std::vector<T>&)> _callback;
                 std::weak_ptr<IListSubject<T> > _subject;
+                SlotID _slotID = invalidSlotID;
             };
 
             //! This class provides the interface for a list subject.
             template<typename T>
-            class IListSubject
+            class IListSubject : public ISubject
             {
             public:
                 virtual ~IListSubject() = 0;
@@ -82,10 +83,10 @@ namespace djv
                 size_t getObserversCount() const;
 
             protected:
-                void _add(const std::weak_ptr<List<T> >&);
-                void _removeExpired();
+                SlotID _add(const std::weak_ptr<List<T> >&);
+                void _remove(SlotID);
 
-                std::vector<std::weak_ptr<List<T> > > _observers;
+                Slots<List<T> > _observers;
 
                 friend List<T>;
             };
@@ -135,6 +136,9 @@ namespace djv
                 bool contains(const T&) const override;
                 size_t indexOf(const T&) const override;
 
+            protected:
+                void _doNotifyObservers() override;
+
             private:
                 std::vector<T> _value;
             };
@@ -20,7 +20,7 @@ namespace djv
                 _callback = callback;
                 if (auto subject = value.lock())
                 {
-                    subject->_add(List<T>::shared_from_this());
+                    _slotID = subject->_add(List<T>::shared_from_this());
                     if (CallbackAction::Trigger == action)
                     {
                         _callback(subject->get());
@@ -37,7 +37,7 @@ namespace djv
             {
                 if (auto subject = _subject.lock())
                 {
-                    subject->_removeExpired();
+                    subject->_remove(_slotID);
                 }
             }
 
@@ -65,30 +65,19 @@ namespace djv
             template<typename T>
             inline size_t IListSubject<T>::getObserversCount() const
             {
-                return _observers.size();
+                return _observers.getCount();
             }
 
             template<typename T>
-            inline void IListSubject<T>::_add(const std::weak_ptr<List<T> >& observer)
+            inline SlotID IListSubject<T>::_add(const std::weak_ptr<List<T> >& observer)
             {
-                _observers.push_back(observer);
+                return _observers.add(observer);
             }
 
             template<typename T>
-            inline void IListSubject<T>::_removeExpired()
+            inline void IListSubject<T>::_remove(SlotID id)
             {
-                auto i = _observers.begin();
-                while (i != _observers.end())
-                {
-                    if (i->expired())
-                    {
-                        i = _observers.erase(i);
-                    }
-                    else
-                    {
-                        ++i;
-                    }
-                }
+                _observers.remove(id);
             }
 
             template<typename T>
@@ -116,13 +105,7 @@ namespace djv
             inline void ListSubject<T>::setAlways(const std::vector<T>& value)
             {
                 _value = value;
-                for (const auto& s : IListSubject<T>::_observers)
-                {
-                    if (auto observer = s.lock())
-                    {
-                        observer->doCallback(_value);
-                    }
-                }
+                IListSubject<T>::_notifyObservers();
             }
 
             template<typename T>
@@ -131,13 +114,7 @@ namespace djv
                 if (value == _value)
                     return false;
                 _value = value;
-                for (const auto& s : IListSubject<T>::_observers)
-                {
-                    if (auto observer = s.lock())
-                    {
-                        observer->doCallback(_value);
-                    }
-                }
+                IListSubject<T>::_notifyObservers();
                 return true;
             }
 
@@ -147,13 +124,7 @@ namespace djv
                 if (_value.size())
                 {
                     _value.clear();
-                    for (const auto& s : IListSubject<T>::_observers)
-                    {
-                        if (auto observer = s.lock())
-                        {
-                            observer->doCallback(_value);
-                        }
-                    }
+                    IListSubject<T>::_notifyObservers();
                 }
             }
 
@@ -161,13 +132,7 @@ namespace djv
             inline void ListSubject<T>::setItem(size_t index, const T& value)
             {
                 _value[index] = value;
-                for (const auto& s : IListSubject<T>::_observers)
-                {
-                    if (auto observer = s.lock())
-                    {
-                        observer->doCallback(_value);
-                    }
-                }
+                IListSubject<T>::_notifyObservers();
             }
 
             template<typename T>
@@ -176,39 +141,31 @@ namespace djv
                 if (value == _value[index])
                     return;
                 _value[index] = value;
-                for (const auto& s : IListSubject<T>::_observers)
-                {
-                    if (auto observer = s.lock())
-                    {
-                        observer->doCallback(_value);
-                    }
-                }
+                IListSubject<T>::_notifyObservers();
             }
 
             template<typename T>
             inline void ListSubject<T>::pushBack(const T& value)
             {
                 _value.push_back(value);
-                for (const auto& s : IListSubject<T>::_observers)
-                {
-                    if (auto observer = s.lock())
-                    {
-                        observer->doCallback(_value);
-                    }
-                }
+                IListSubject<T>::_notifyObservers();
             }
 
             template<typename T>
             inline void ListSubject<T>::removeItem(size_t index)
             {
                 _value.erase(_value.begin() + index);
-                for (const auto& s : IListSubject<T>::_observers)
-                {
-                    if (auto observer = s.lock())
+                IListSubject<T>::_notifyObservers();
+            }
+
+            template<typename T>
+            inline void ListSubject<T>::_doNotifyObservers()
+            {
+                IListSubject<T>::_observers.forEach(
+                    [this](const std::shared_ptr<List<T> >& observer)
                     {
                         observer->doCallback(_value);
-                    }
-                }
+                    });
             }
 
             template<typename T>
@@ -48,11 +48,12 @@ namespace djv
             private:
                 std::function<void(const std::map<T, U>&)> _callback;
                 std::weak_ptr<IMapSubject<T, U> > _subject;
+                SlotID _slotID = invalidSlotID;
             };
 
             //! This class provides the interface for a map subject.
             template<typename T, typename U>
-            class IMapSubject
+            class IMapSubject : public ISubject
             {
             public:
                 virtual ~IMapSubject() = 0;
@@ -76,10 +77,10 @@ namespace djv
                 size_t getObserversCount() const;
 
             protected:
-                void _add(const std::weak_ptr<Map<T, U> >&);
-                void _removeExpired();
+                SlotID _add(const std::weak_ptr<Map<T, U> >&);
+                void _remove(SlotID);
 
-                std::vector<std::weak_ptr<Map<T, U> > > _observers;
+                Slots<Map<T, U> > _observers;
 
                 friend Map<T, U>;
             };
@@ -121,6 +122,9 @@ namespace djv
                 bool hasKey(const T&) override;
                 const U& getItem(const T&) const override;
 
+            protected:
+                void _doNotifyObservers() override;
+
             private:
                 std::map<T, U> _value;
             };
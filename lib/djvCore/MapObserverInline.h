@@ -20,7 +20,7 @@ namespace djv
                 _callback = callback;
                 if (auto subject = value.lock())
                 {
-                    subject->_add(Map<T, U>::shared_from_this());
+                    _slotID = subject->_add(Map<T, U>::shared_from_this());
                     if (CallbackAction::Trigger == action)
                     {
                         _callback(subject->get());
@@ -37,7 +37,7 @@ namespace djv
             {
                 if (auto subject = _subject.lock())
                 {
-                    subject->_removeExpired();
+                    subject->_remove(_slotID);
                 }
             }
 
@@ -65,30 +65,19 @@ namespace djv
             template<typename T, typename U>
             inline size_t IMapSubject<T, U>::getObserversCount() const
             {
-                return _observers.size();
+                return _observers.getCount();
             }
 
             template<typename T, typename U>
-            inline void IMapSubject<T, U>::_add(const std::weak_ptr<Map<T, U> >& observer)
+            inline SlotID IMapSubject<T, U>::_add(const std::weak_ptr<Map<T, U> >& observer)
             {
-                _observers.push_back(observer);
+                return _observers.add(observer);
             }
 
             template<typename T, typename U>
-            inline void IMapSubject<T, U>::_removeExpired()
+            inline void IMapSubject<T, U>::_remove(SlotID id)
             {
-                auto i = _observers.begin();
-                while (i != _observers.end())
-                {
-                    if (i->expired())
-                    {
-                        i = _observers.erase(i);
-                    }
-                    else
-                    {
-                        ++i;
-                    }
-                }
+                _observers.remove(id);
             }
 
             template<typename T, typename U>
@@ -116,13 +105,7 @@ namespace djv
             inline void MapSubject<T, U>::setAlways(const std::map<T, U>& value)
             {
                 _value = value;
-                for (const auto& s : IMapSubject<T, U>::_observers)
-                {
-                    if (auto observer = s.lock())
-                    {
-                        observer->doCallback(_value);
-                    }
-                }
+                IMapSubject<T, U>::_notifyObservers();
             }
 
             template<typename T, typename U>
@@ -131,13 +114,7 @@ namespace djv
                 if (value == _value)
                     return false;
                 _value = value;
-                for (const auto& s : IMapSubject<T, U>::_observers)
-                {
-                    if (auto observer = s.lock())
-                    {
-                        observer->doCallback(_value);
-                    }
-                }
+                IMapSubject<T, U>::_notifyObservers();
                 return true;
             }
 
@@ -147,13 +124,7 @@ namespace djv
                 if (_value.size())
                 {
                     _value.clear();
-                    for (const auto& s : IMapSubject<T, U>::_observers)
-                    {
-                        if (auto observer = s.lock())
-                        {
-                            observer->doCallback(_value);
-                        }
-                    }
+                    IMapSubject<T, U>::_notifyObservers();
                 }
             }
 
@@ -162,13 +133,7 @@ namespace djv
             {
                 _value[key] = value;
 
-                for (const auto& s : IMapSubject<T, U>::_observers)
-                {
-                    if (auto observer = s.lock())
-                    {
-                        observer->doCallback(_value);
-                    }
-                }
+                IMapSubject<T, U>::_notifyObservers();
             }
 
             template<typename T, typename U>
@@ -178,13 +143,17 @@ namespace djv
                 if (i != _value.end() && i->second == value)
                     return;
                 _value[key] = value;
-                for (const auto& s : IMapSubject<T, U>::_observers)
-                {
-                    if (auto observer = s.lock())
+                IMapSubject<T, U>::_notifyObservers();
+            }
+
+            template<typename T, typename U>
+            inline void MapSubject<T, U>::_doNotifyObservers()
+            {
+                IMapSubject<T, U>::_observers.forEach(
+                    [this](const std::shared_ptr<Map<T, U> >& observer)
                     {
                         observer->doCallback(_value);
-                    }
-                }
+                    });
             }
 
             template<typename T, typename U>
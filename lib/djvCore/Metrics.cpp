@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCore/Metrics.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace Metrics
+        {
+            Histogram::Histogram()
+            {
+                reset();
+            }
+
+            int64_t Histogram::getPercentile(float value) const
+            {
+                return _getPercentile(value, getCount());
+            }
+
+            HistogramData Histogram::getData() const
+            {
+                HistogramData out;
+                out.count = getCount();
+                if (out.count > 0)
+                {
+                    out.min = _min.load(std::memory_order_relaxed);
+                    out.max = _max.load(std::memory_order_relaxed);
+                    out.mean = _sum.load(std::memory_order_relaxed) / static_cast<double>(out.count);
+                    out.p50 = _getPercentile(50.F, out.count);
+                    out.p90 = _getPercentile(90.F, out.count);
+                    out.p99 = _getPercentile(99.F, out.count);
+                }
+                return out;
+            }
+
+            void Histogram::reset()
+            {
+                for (auto& i : _buckets)
+                {
+                    i = 0;
+                }
+                _count = 0;
+                _sum = 0;
+                _min = std::numeric_limits<int64_t>::max();
+                _max = 0;
+            }
+
+            int64_t Histogram::_getPercentile(float value, uint64_t count) const
+            {
+                int64_t out = 0;
+                if (count > 0)
+                {
+                    // The buckets may be updated while they are being read.
+                    const int64_t max = _max.load(std::memory_order_relaxed);
+                    out = max;
+                    const uint64_t target = std::max(
+                        static_cast<uint64_t>(std::ceil(std::min(std::max(value, 0.F), 100.F) / 100.F * count)),
+                        static_cast<uint64_t>(1));
+                    uint64_t sum = 0;
+                    for (size_t i = 0; i < bucketCount; ++i)
+                    {
+                        sum += _buckets[i].load(std::memory_order_relaxed);
+                        if (sum >= target)
+                        {
+                            out = std::min(getBucketMax(i), max);
+                            break;
+                        }
+                    }
+                }
+                return out;
+            }
+
+        } // namespace Metrics
+    } // namespace Core
+} // namespace djv
@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <array>
+#include <atomic>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace djv
+{
+    namespace Core
+    {
+        //! This namespace provides process-wide metrics.
+        //!
+        //! Metrics are created by name from the registry (see MetricsFunc.h)
+        //! which requires locking, so callers should keep the returned
+        //! pointer. Updating a metric only uses atomic operations.
+        namespace Metrics
+        {
+            //! This class provides a counter that is only incremented.
+            class Counter
+            {
+                DJV_NON_COPYABLE(Counter);
+
+            public:
+                Counter();
+
+                //! Add to the counter, negative values are ignored.
+                void add(int64_t = 1);
+
+                int64_t get() const;
+
+                void reset();
+
+            private:
+                std::atomic<int64_t> _value;
+            };
+
+            //! This class provides a gauge that can go up and down.
+            class Gauge
+            {
+                DJV_NON_COPYABLE(Gauge);
+
+            public:
+                Gauge();
+
+                void set(int64_t);
+                void add(int64_t);
+
+                int64_t get() const;
+
+                void reset();
+
+            private:
+                std::atomic<int64_t> _value;
+            };
+
+            //! This struct provides histogram statistics.
+            struct HistogramData
+            {
+                uint64_t count = 0;
+                int64_t  min   = 0;
+                int64_t  max   = 0;
+                double   mean  = 0.0;
+                int64_t  p50   = 0;
+                int64_t  p90   = 0;
+                int64_t  p99   = 0;
+            };
+
+            //! This class provides a histogram of non-negative values (for
+            //! example latencies in microseconds). Values are recorded into
+            //! logarithmic buckets with eight linear sub-buckets, so the
+            //! percentiles are accurate to within 12.5%.
+            class Histogram
+            {
+                DJV_NON_COPYABLE(Histogram);
+
+            public:
+                Histogram();
+
+                void record(int64_t);
+
+                uint64_t getCount() const;
+
+                //! Get a percentile, the value is in the range [0.0, 100.0].
+                int64_t getPercentile(float) const;
+
+                HistogramData getData() const;
+
+                void reset();
+
+                static const size_t bucketCount = 488;
+
+                static size_t getBucket(int64_t);
+                static int64_t getBucketMax(size_t);
+
+            private:
+                int64_t _getPercentile(float, uint64_t count) const;
+
+                std::array<std::atomic<uint64_t>, bucketCount> _buckets;
+                std::atomic<uint64_t> _count;
+                std::atomic<int64_t> _sum;
+                std::atomic<int64_t> _min;
+                std::atomic<int64_t> _max;
+            };
+
+        } // namespace Metrics
+    } // namespace Core
+} // namespace djv
+
+#include <djvCore/MetricsInline.h>
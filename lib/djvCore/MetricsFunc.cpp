@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCore/MetricsFunc.h>
+
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <mutex>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace Metrics
+        {
+            namespace
+            {
+                struct Registry
+                {
+                    std::mutex mutex;
+                    std::map<std::string, std::shared_ptr<Counter> > counters;
+                    std::map<std::string, std::shared_ptr<Gauge> > gauges;
+                    std::map<std::string, std::shared_ptr<Histogram> > histograms;
+                };
+
+                Registry& getRegistry()
+                {
+                    static Registry registry;
+                    return registry;
+                }
+
+                template<typename T>
+                std::shared_ptr<T> getMetric(
+                    std::map<std::string, std::shared_ptr<T> >& metrics,
+                    const std::string& name)
+                {
+                    std::shared_ptr<T> out;
+                    const auto i = metrics.find(name);
+                    if (i != metrics.end())
+                    {
+                        out = i->second;
+                    }
+                    else
+                    {
+                        out = std::make_shared<T>();
+                        metrics[name] = out;
+                    }
+                    return out;
+                }
+
+            } // namespace
+
+            std::shared_ptr<Counter> getCounter(const std::string& name)
+            {
+                auto& registry = getRegistry();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                return getMetric(registry.counters, name);
+            }
+
+            std::shared_ptr<Gauge> getGauge(const std::string& name)
+            {
+                auto& registry = getRegistry();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                return getMetric(registry.gauges, name);
+            }
+
+            std::shared_ptr<Histogram> getHistogram(const std::string& name)
+            {
+                auto& registry = getRegistry();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                return getMetric(registry.histograms, name);
+            }
+
+            void reset()
+            {
+                auto& registry = getRegistry();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                for (const auto& i : registry.counters)
+                {
+                    i.second->reset();
+                }
+                for (const auto& i : registry.gauges)
+                {
+                    i.second->reset();
+                }
+                for (const auto& i : registry.histograms)
+                {
+                    i.second->reset();
+                }
+            }
+
+            std::map<std::string, int64_t> getCounterValues()
+            {
+                std::map<std::string, int64_t> out;
+                auto& registry = getRegistry();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                for (const auto& i : registry.counters)
+                {
+                    out[i.first] = i.second->get();
+                }
+                return out;
+            }
+
+            std::map<std::string, int64_t> getGaugeValues()
+            {
+                std::map<std::string, int64_t> out;
+                auto& registry = getRegistry();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                for (const auto& i : registry.gauges)
+                {
+                    out[i.first] = i.second->get();
+                }
+                return out;
+            }
+
+            std::map<std::string, HistogramData> getHistogramValues()
+            {
+                std::map<std::string, HistogramData> out;
+                auto& registry = getRegistry();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                for (const auto& i : registry.histograms)
+                {
+                    out[i.first] = i.second->getData();
+                }
+                return out;
+            }
+
+            std::string toJSON()
+            {
+                rapidjson::StringBuffer buffer;
+                rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+                writer.StartObject();
+                writer.Key("counters");
+                writer.StartObject();
+                for (const auto& i : getCounterValues())
+                {
+                    writer.Key(i.first.c_str());
+                    writer.Int64(i.second);
+                }
+                writer.EndObject();
+                writer.Key("gauges");
+                writer.StartObject();
+                for (const auto& i : getGaugeValues())
+                {
+                    writer.Key(i.first.c_str());
+                    writer.Int64(i.second);
+                }
+                writer.EndObject();
+                writer.Key("histograms");
+                writer.StartObject();
+                for (const auto& i : getHistogramValues())
+                {
+                    writer.Key(i.first.c_str());
+                    writer.StartObject();
+                    writer.Key("count");
+                    writer.Uint64(i.second.count);
+                    writer.Key("min");
+                    writer.Int64(i.second.min);
+                    writer.Key("max");
+                    writer.Int64(i.second.max);
+                    writer.Key("mean");
+                    writer.Double(i.second.mean);
+                    writer.Key("p50");
+                    writer.Int64(i.second.p50);
+                    writer.Key("p90");
+                    writer.Int64(i.second.p90);
+                    writer.Key("p99");
+                    writer.Int64(i.second.p99);
+                    writer.EndObject();
+                }
+                writer.EndObject();
+                writer.EndObject();
+                return buffer.GetString();
+            }
+
+        } // namespace Metrics
+    } // namespace Core
+} // namespace djv
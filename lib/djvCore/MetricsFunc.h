@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/Metrics.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace Metrics
+        {
+            //! \name Registry
+            ///@{
+
+            //! Get a counter, it is created if it does not exist.
+            std::shared_ptr<Counter> getCounter(const std::string&);
+
+            //! Get a gauge, it is created if it does not exist.
+            std::shared_ptr<Gauge> getGauge(const std::string&);
+
+            //! Get a histogram, it is created if it does not exist.
+            std::shared_ptr<Histogram> getHistogram(const std::string&);
+
+            //! Reset all of the metrics.
+            void reset();
+
+            ///@}
+
+            //! \name Values
+            ///@{
+
+            std::map<std::string, int64_t> getCounterValues();
+            std::map<std::string, int64_t> getGaugeValues();
+            std::map<std::string, HistogramData> getHistogramValues();
+
+            ///@}
+
+            //! \name Conversion
+            ///@{
+
+            //! Convert the metrics to JSON.
+            std::string toJSON();
+
+            ///@}
+
+        } // namespace Metrics
+    } // namespace Core
+} // namespace djv
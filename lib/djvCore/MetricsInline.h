@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace Metrics
+        {
+            inline Counter::Counter() :
+                _value(0)
+            {}
+
+            inline void Counter::add(int64_t value)
+            {
+                if (value > 0)
+                {
+                    _value.fetch_add(value, std::memory_order_relaxed);
+                }
+            }
+
+            inline int64_t Counter::get() const
+            {
+                return _value.load(std::memory_order_relaxed);
+            }
+
+            inline void Counter::reset()
+            {
+                _value = 0;
+            }
+
+            inline Gauge::Gauge() :
+                _value(0)
+            {}
+
+            inline void Gauge::set(int64_t value)
+            {
+                _value.store(value, std::memory_order_relaxed);
+            }
+
+            inline void Gauge::add(int64_t value)
+            {
+                _value.fetch_add(value, std::memory_order_relaxed);
+            }
+
+            inline int64_t Gauge::get() const
+            {
+                return _value.load(std::memory_order_relaxed);
+            }
+
+            inline void Gauge::reset()
+            {
+                _value = 0;
+            }
+
+            inline void Histogram::record(int64_t value)
+            {
+                if (value < 0)
+                {
+                    value = 0;
+                }
+                _buckets[getBucket(value)].fetch_add(1, std::memory_order_relaxed);
+                _count.fetch_add(1, std::memory_order_relaxed);
+                _sum.fetch_add(value, std::memory_order_relaxed);
+                int64_t min = _min.load(std::memory_order_relaxed);
+                while (value < min && !_min.compare_exchange_weak(min, value, std::memory_order_relaxed))
+                    ;
+                int64_t max = _max.load(std::memory_order_relaxed);
+                while (value > max && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+                    ;
+            }
+
+            inline uint64_t Histogram::getCount() const
+            {
+                return _count.load(std::memory_order_relaxed);
+            }
+
+            inline size_t Histogram::getBucket(int64_t value)
+            {
+                if (value < 8)
+                {
+                    return value > 0 ? static_cast<size_t>(value) : 0;
+                }
+
+                // Find the most significant bit.
+                uint64_t v = static_cast<uint64_t>(value);
+                size_t bit = 0;
+                if (v >> 32) { v >>= 32; bit += 32; }
+                if (v >> 16) { v >>= 16; bit += 16; }
+                if (v >> 8)  { v >>= 8;  bit += 8; }
+                if (v >> 4)  { v >>= 4;  bit += 4; }
+                if (v >> 2)  { v >>= 2;  bit += 2; }
+                if (v >> 1)  { bit += 1; }
+
+                const size_t sub = static_cast<size_t>(value >> (bit - 3)) & 7;
+                return (bit - 2) * 8 + sub;
+            }
+
+            inline int64_t Histogram::getBucketMax(size_t value)
+            {
+                if (value < 8)
+                {
+                    return static_cast<int64_t>(value);
+                }
+                const size_t bit = value / 8 + 2;
+                const int64_t sub = static_cast<int64_t>(value % 8);
+                const int64_t width = static_cast<int64_t>(1) << (bit - 3);
+                return ((8 + sub) << (bit - 3)) + (width - 1);
+            }
+
+        } // namespace Metrics
+    } // namespace Core
+} // namespace djv
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCore/Observer.h>
+
+#include <djvCore/MetricsFunc.h>
+
+#include <algorithm>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace Observer
+        {
+            namespace
+            {
+                //! \todo Should this be per-thread?
+                std::vector<ISubject*>& getPending()
+                {
+                    static std::vector<ISubject*> pending;
+                    return pending;
+                }
+
+            } // namespace
+
+            ISubject::ISubject()
+            {}
+
+            ISubject::~ISubject()
+            {
+                if (_pending)
+                {
+                    // Clear the entry instead of erasing it since the list
+                    // may be flushing.
+                    auto& pending = getPending();
+                    const auto i = std::find(pending.begin(), pending.end(), this);
+                    if (i != pending.end())
+                    {
+                        *i = nullptr;
+                    }
+                }
+            }
+
+            void ISubject::setCoalescing(bool value)
+            {
+                if (value == _coalescing)
+                    return;
+                _coalescing = value;
+                if (!_coalescing && _pending)
+                {
+                    auto& pending = getPending();
+                    const auto i = std::find(pending.begin(), pending.end(), this);
+                    if (i != pending.end())
+                    {
+                        *i = nullptr;
+                    }
+                    _pending = false;
+                    _doNotifyObservers();
+                }
+            }
+
+            void ISubject::_notifyObservers()
+            {
+                if (_coalescing)
+                {
+                    static const auto coalescedCounter = Metrics::getCounter("djv::Core::Observer::coalesced");
+                    coalescedCounter->add();
+                    if (!_pending)
+                    {
+                        _pending = true;
+                        getPending().push_back(this);
+                    }
+                }
+                else
+                {
+                    _doNotifyObservers();
+                }
+            }
+
+            void flushPending()
+            {
+                // Subjects that change while flushing are added to the end of
+                // the list and notified in the same flush.
+                auto& pending = getPending();
+                for (size_t i = 0; i < pending.size(); ++i)
+                {
+                    if (auto subject = pending[i])
+                    {
+                        pending[i] = nullptr;
+                        subject->_pending = false;
+                        subject->_doNotifyObservers();
+                    }
+                }
+                pending.clear();
+            }
+
+            size_t getPendingCount()
+            {
+                const auto& pending = getPending();
+                return std::count_if(
+                    pending.begin(),
+                    pending.end(),
+                    [](const ISubject* value)
+                    {
+                        return value != nullptr;
+                    });
+            }
+
+        } // namespace Observer
+    } // namespace Core
+} // namespace djv
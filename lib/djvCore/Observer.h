@@ -6,6 +6,11 @@
 
 #include <djvCore/Core.h>
 
+#include <memory>
+#include <vector>
+
+#include <stdint.h>
+
 namespace djv
 {
     namespace Core
@@ -20,6 +25,119 @@ namespace djv
                 Suppress
             };
 
+            //! This typedef provides an observer slot ID. The ID contains the
+            //! slot index and the slot generation.
+            typedef uint64_t SlotID;
+
+            //! This value represents an invalid slot ID.
+            const SlotID invalidSlotID = 0;
+
+            //! This class provides a compact array of observer slots.
+            //!
+            //! Slots are reused when observers are removed, and each slot
+            //! has a generation that is incremented when it is reused. An
+            //! observer can be removed in constant time, and a stale ID does
+            //! not remove a newer observer in the same slot.
+            //!
+            //! Observers can be added and removed from within a callback.
+            //! Observers added during iteration are not called until the
+            //! next iteration.
+            template<typename T>
+            class Slots
+            {
+                DJV_NON_COPYABLE(Slots);
+
+            public:
+                Slots();
+
+                //! Get the number of observers.
+                size_t getCount() const;
+
+                //! Add an observer.
+                SlotID add(const std::weak_ptr<T>&);
+
+                //! Remove an observer.
+                void remove(SlotID);
+
+                //! Call a function for each observer. The function is called
+                //! with a shared pointer to the observer.
+                template<typename F>
+                void forEach(F);
+
+            private:
+                struct Slot
+                {
+                    std::weak_ptr<T> observer;
+                    uint32_t generation = 0;
+                    bool used = false;
+                };
+
+                std::vector<Slot> _slots;
+                std::vector<uint32_t> _free;
+                size_t _count = 0;
+                size_t _iterating = 0;
+            };
+
+            //! This class provides the base class for subjects.
+            //!
+            //! By default observers are notified immediately when a subject
+            //! changes. When coalescing is enabled, changes are recorded and
+            //! the observers are notified once with the latest value when
+            //! flushPending() is called, which the context does once per
+            //! tick. Coalescing is useful for subjects that may change several
+            //! times per tick and whose observers only need the latest value.
+            //! It adds a delay of up to one tick, so it should not be used
+            //! for values that other code reads back immediately.
+            //!
+            //! Subjects are not thread safe, coalescing subjects should only
+            //! be used from the thread that calls flushPending().
+            class ISubject
+            {
+                DJV_NON_COPYABLE(ISubject);
+
+            protected:
+                ISubject();
+
+            public:
+                virtual ~ISubject() = 0;
+
+                //! \name Coalescing
+                ///@{
+
+                bool isCoalescing() const;
+
+                //! Set whether coalescing is enabled. Disabling coalescing
+                //! notifies the observers of any pending changes.
+                void setCoalescing(bool);
+
+                //! Get whether there are pending changes.
+                bool isPending() const;
+
+                ///@}
+
+            protected:
+                //! Notify the observers, or defer the notification if
+                //! coalescing is enabled.
+                void _notifyObservers();
+
+                //! Notify the observers immediately.
+                virtual void _doNotifyObservers() = 0;
+
+            private:
+                bool _coalescing = false;
+                bool _pending = false;
+
+                friend void flushPending();
+            };
+
+            //! Notify the observers of all the subjects with pending changes.
+            void flushPending();
+
+            //! Get the number of subjects with pending changes.
+            size_t getPendingCount();
+
         } // namespace Observer
     } // namespace Core
 } // namespace djv
+
+#include <djvCore/ObserverInline.h>
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace Observer
+        {
+            template<typename T>
+            inline Slots<T>::Slots()
+            {}
+
+            template<typename T>
+            inline size_t Slots<T>::getCount() const
+            {
+                return _count;
+            }
+
+            template<typename T>
+            inline SlotID Slots<T>::add(const std::weak_ptr<T>& observer)
+            {
+                // Don't reuse slots while iterating so that new observers are
+                // not called until the next iteration.
+                uint32_t index = 0;
+                if (!_free.empty() && !_iterating)
+                {
+                    index = _free.back();
+                    _free.pop_back();
+                }
+                else
+                {
+                    index = static_cast<uint32_t>(_slots.size());
+                    _slots.push_back(Slot());
+                }
+                auto& slot = _slots[index];
+                slot.observer = observer;
+                // The generation starts at one so that a valid ID is never
+                // zero.
+                ++slot.generation;
+                slot.used = true;
+                ++_count;
+                return (static_cast<SlotID>(slot.generation) << 32) | index;
+            }
+
+            template<typename T>
+            inline void Slots<T>::remove(SlotID id)
+            {
+                const uint32_t index = static_cast<uint32_t>(id & 0xffffffff);
+                const uint32_t generation = static_cast<uint32_t>(id >> 32);
+                if (index < _slots.size())
+                {
+                    auto& slot = _slots[index];
+                    if (slot.used && generation == slot.generation)
+                    {
+                        slot.observer.reset();
+                        slot.used = false;
+                        _free.push_back(index);
+                        --_count;
+                    }
+                }
+            }
+
+            template<typename T>
+            template<typename F>
+            inline void Slots<T>::forEach(F f)
+            {
+                // Index the slots since callbacks may add observers and
+                // reallocate the array.
+                struct Iterating
+                {
+                    explicit Iterating(size_t& value) : value(value) { ++value; }
+                    ~Iterating() { --value; }
+                    size_t& value;
+                };
+                const Iterating iterating(_iterating);
+                const size_t size = _slots.size();
+                for (size_t i = 0; i < size; ++i)
+                {
+                    if (_slots[i].used)
+                    {
+                        // Keep a reference to the observer in case the
+                        // callback releases it.
+                        if (auto observer = _slots[i].observer.lock())
+                        {
+                            f(observer);
+                        }
+                    }
+                }
+            }
+
+            inline bool ISubject::isCoalescing() const
+            {
+                return _coalescing;
+            }
+
+            inline bool ISubject::isPending() const
+            {
+                return _pending;
+            }
+
+        } // namespace Observer
+    } // namespace Core
+} // namespace djv
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <stdint.h>
+
+namespace djv
+{
+    namespace Core
+    {
+        //! This namespace provides tracing functionality.
+        //!
+        //! Trace events are recorded into a ring buffer for each thread so
+        //! that recording does not require locking. The events can be
+        //! written as Chrome trace event JSON and viewed with
+        //! chrome://tracing or Perfetto.
+        //!
+        //! Tracing is only compiled in when DJV_TRACE_ENABLED is defined (the
+        //! DJV_TRACE build option), and then only recorded when it has been
+        //! enabled at runtime.
+        namespace Trace
+        {
+            //! This constant provides the frame value for events that are not
+            //! associated with a frame.
+            const int64_t noFrame = -1;
+
+            //! This struct provides a trace event. Times are in microseconds.
+            struct Event
+            {
+                const char* name    = nullptr;
+                int64_t     frame   = noFrame;
+                int64_t     begin   = 0;
+                int64_t     end     = 0;
+                uint32_t    thread  = 0;
+                bool        instant = false;
+            };
+
+            //! This class provides a scoped trace span (for convenience use
+            //! the DJV_TRACE macros). The name must be a string literal.
+            class Span
+            {
+                DJV_NON_COPYABLE(Span);
+
+            public:
+                explicit Span(const char* name, int64_t frame = noFrame);
+                ~Span();
+
+            private:
+                const char* _name  = nullptr;
+                int64_t     _frame = noFrame;
+                int64_t     _begin = -1;
+            };
+
+        } // namespace Trace
+    } // namespace Core
+} // namespace djv
+
+#define DJV_TRACE_CAT_(a, b) a##b
+#define DJV_TRACE_CAT(a, b) DJV_TRACE_CAT_(a, b)
+
+//! These macros provide tracing.
+//!
+//! Required includes:
+//! - djvCore/TraceFunc.h
+#if defined(DJV_TRACE_ENABLED)
+#define DJV_TRACE(name) \
+    djv::Core::Trace::Span DJV_TRACE_CAT(_djvTraceSpan, __LINE__)(name)
+#define DJV_TRACE_FRAME(name, frame) \
+    djv::Core::Trace::Span DJV_TRACE_CAT(_djvTraceSpan, __LINE__)(name, frame)
+#define DJV_TRACE_INSTANT(name, frame) \
+    djv::Core::Trace::addInstant(name, frame)
+#else // DJV_TRACE_ENABLED
+#define DJV_TRACE(name)
+#define DJV_TRACE_FRAME(name, frame)
+#define DJV_TRACE_INSTANT(name, frame)
+#endif // DJV_TRACE_ENABLED
@@ -0,0 +1,247 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCore/TraceFunc.h>
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace Trace
+        {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const size_t bufferSize = 16384;
+
+                std::atomic<bool> enabled(false);
+
+                const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+                //! This struct provides a ring buffer of events. The buffer is
+                //! only written by a single thread.
+                struct Buffer
+                {
+                    Buffer() :
+                        events(bufferSize),
+                        count(0),
+                        start(0)
+                    {}
+
+                    std::vector<Event> events;
+                    std::atomic<size_t> count;
+                    std::atomic<size_t> start;
+                    uint32_t thread = 0;
+                };
+
+                //! This struct provides the list of buffers. Buffers are
+                //! kept when their thread exits so that the events are not
+                //! lost, and are re-used by new threads.
+                struct Registry
+                {
+                    std::mutex mutex;
+                    std::vector<std::shared_ptr<Buffer> > buffers;
+                    std::vector<std::shared_ptr<Buffer> > unused;
+                    uint32_t threadCount = 0;
+                };
+
+                Registry& getRegistry()
+                {
+                    static Registry registry;
+                    return registry;
+                }
+
+                class ThreadBuffer
+                {
+                public:
+                    ThreadBuffer()
+                    {
+                        auto& registry = getRegistry();
+                        std::lock_guard<std::mutex> lock(registry.mutex);
+                        if (registry.unused.size())
+                        {
+                            buffer = registry.unused.back();
+                            registry.unused.pop_back();
+                        }
+                        else
+                        {
+                            buffer = std::make_shared<Buffer>();
+                            registry.buffers.push_back(buffer);
+                        }
+                        buffer->thread = ++registry.threadCount;
+                    }
+
+                    ~ThreadBuffer()
+                    {
+                        auto& registry = getRegistry();
+                        std::lock_guard<std::mutex> lock(registry.mutex);
+                        registry.unused.push_back(buffer);
+                    }
+
+                    std::shared_ptr<Buffer> buffer;
+                };
+
+                Buffer& getThreadBuffer()
+                {
+                    thread_local ThreadBuffer threadBuffer;
+                    return *threadBuffer.buffer;
+                }
+
+                void add(const Event& event)
+                {
+                    auto& buffer = getThreadBuffer();
+                    const size_t count = buffer.count.load(std::memory_order_relaxed);
+                    Event& out = buffer.events[count % bufferSize];
+                    out = event;
+                    out.thread = buffer.thread;
+                    buffer.count.store(count + 1, std::memory_order_release);
+                }
+
+            } // namespace
+
+            bool isEnabled()
+            {
+                return enabled.load(std::memory_order_relaxed);
+            }
+
+            void setEnabled(bool value)
+            {
+                enabled = value;
+            }
+
+            int64_t getTime()
+            {
+                return std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - epoch).count();
+            }
+
+            void addEvent(const char* name, int64_t frame, int64_t begin, int64_t end)
+            {
+                if (isEnabled())
+                {
+                    Event event;
+                    event.name = name;
+                    event.frame = frame;
+                    event.begin = begin;
+                    event.end = end;
+                    add(event);
+                }
+            }
+
+            void addInstant(const char* name, int64_t frame)
+            {
+                if (isEnabled())
+                {
+                    Event event;
+                    event.name = name;
+                    event.frame = frame;
+                    event.begin = event.end = getTime();
+                    event.instant = true;
+                    add(event);
+                }
+            }
+
+            std::vector<Event> getEvents()
+            {
+                std::vector<Event> out;
+                auto& registry = getRegistry();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                for (const auto& buffer : registry.buffers)
+                {
+                    const size_t count = buffer->count.load(std::memory_order_acquire);
+                    const size_t start = std::max(
+                        buffer->start.load(),
+                        count > bufferSize ? count - bufferSize : 0);
+                    const size_t outSize = out.size();
+                    for (size_t i = start; i < count; ++i)
+                    {
+                        out.push_back(buffer->events[i % bufferSize]);
+                    }
+
+                    // Discard the events that were overwritten while they were
+                    // being copied, including the slot that may be being
+                    // written now.
+                    const size_t count2 = buffer->count.load(std::memory_order_acquire);
+                    if (count2 + 1 > bufferSize)
+                    {
+                        const size_t end = std::min(count2 + 1 - bufferSize, count);
+                        if (end > start)
+                        {
+                            out.erase(out.begin() + outSize, out.begin() + outSize + (end - start));
+                        }
+                    }
+                }
+                std::stable_sort(
+                    out.begin(),
+                    out.end(),
+                    [](const Event& a, const Event& b)
+                    {
+                        return a.begin < b.begin;
+                    });
+                return out;
+            }
+
+            void clear()
+            {
+                auto& registry = getRegistry();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                for (const auto& buffer : registry.buffers)
+                {
+                    buffer->start = buffer->count.load();
+                }
+            }
+
+            std::string toChromeJSON(const std::vector<Event>& value)
+            {
+                rapidjson::Document document;
+                document.SetObject();
+                auto& allocator = document.GetAllocator();
+                rapidjson::Value events(rapidjson::kArrayType);
+                for (const auto& i : value)
+                {
+                    rapidjson::Value event(rapidjson::kObjectType);
+                    event.AddMember("name", rapidjson::StringRef(i.name), allocator);
+                    event.AddMember("cat", "djv", allocator);
+                    if (i.instant)
+                    {
+                        event.AddMember("ph", "i", allocator);
+                        event.AddMember("s", "t", allocator);
+                    }
+                    else
+                    {
+                        event.AddMember("ph", "X", allocator);
+                        event.AddMember("dur", static_cast<int64_t>(i.end - i.begin), allocator);
+                    }
+                    event.AddMember("ts", static_cast<int64_t>(i.begin), allocator);
+                    event.AddMember("pid", 1, allocator);
+                    event.AddMember("tid", i.thread, allocator);
+                    if (i.frame != noFrame)
+                    {
+                        rapidjson::Value args(rapidjson::kObjectType);
+                        args.AddMember("frame", static_cast<int64_t>(i.frame), allocator);
+                        event.AddMember("args", args, allocator);
+                    }
+                    events.PushBack(event, allocator);
+                }
+                document.AddMember("traceEvents", events, allocator);
+                document.AddMember("displayTimeUnit", "ms", allocator);
+                rapidjson::StringBuffer buffer;
+                rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+                document.Accept(writer);
+                return buffer.GetString();
+            }
+
+        } // namespace Trace
+    } // namespace Core
+} // namespace djv
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/Trace.h>
+
+#include <string>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace Trace
+        {
+            //! \name Recording
+            ///@{
+
+            //! Get whether tracing is enabled.
+            bool isEnabled();
+
+            //! Set whether tracing is enabled.
+            void setEnabled(bool);
+
+            //! Get the current trace time in microseconds.
+            int64_t getTime();
+
+            //! Add an event. The name must be a string literal.
+            void addEvent(const char* name, int64_t frame, int64_t begin, int64_t end);
+
+            //! Add an instant event. The name must be a string literal.
+            void addInstant(const char* name, int64_t frame = noFrame);
+
+            ///@}
+
+            //! \name Events
+            ///@{
+
+            //! Get the recorded events sorted by time. Events that are
+            //! recorded while this function is running may be missed.
+            std::vector<Event> getEvents();
+
+            //! Clear the recorded events.
+            void clear();
+
+            ///@}
+
+            //! \name Conversion
+            ///@{
+
+            //! Convert events to Chrome trace event JSON.
+            std::string toChromeJSON(const std::vector<Event>&);
+
+            ///@}
+
+        } // namespace Trace
+    } // namespace Core
+} // namespace djv
+
+#include <djvCore/TraceFuncInline.h>
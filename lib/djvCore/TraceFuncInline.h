@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace Trace
+        {
+            inline Span::Span(const char* name, int64_t frame) :
+                _name(name),
+                _frame(frame)
+            {
+                if (isEnabled())
+                {
+                    _begin = getTime();
+                }
+            }
+
+            inline Span::~Span()
+            {
+                if (_begin >= 0)
+                {
+                    addEvent(_name, _frame, _begin, getTime());
+                }
+            }
+
+        } // namespace Trace
+    } // namespace Core
+} // namespace djv
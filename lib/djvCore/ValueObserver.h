@@ -48,11 +48,12 @@ namespace djv
             private:
                 std::function<void(const T&)> _callback;
                 std::weak_ptr<IValueSubject<T> > _subject;
+                SlotID _slotID = invalidSlotID;
             };
 
             //! This class provides the interface for a value subject.
             template<typename T>
-            class IValueSubject
+            class IValueSubject : public ISubject
             {
             public:
                 virtual ~IValueSubject() = 0;
@@ -64,10 +65,10 @@ namespace djv
                 size_t getObserversCount() const;
 
             protected:
-                void _add(const std::weak_ptr<Value<T> >&);
-                void _removeExpired();
+                SlotID _add(const std::weak_ptr<Value<T> >&);
+                void _remove(SlotID);
 
-                std::vector<std::weak_ptr<Value<T> > > _observers;
+                Slots<Value<T> > _observers;
 
                 friend class Value<T>;
             };
@@ -97,6 +98,9 @@ namespace djv
 
                 const T& get() const override;
 
+            protected:
+                void _doNotifyObservers() override;
+
             private:
                 T _value = T();
             };
@@ -20,7 +20,7 @@ namespace djv
                 _callback = callback;
                 if (auto subject = value.lock())
                 {
-                    subject->_add(Value<T>::shared_from_this());
+                    _slotID = subject->_add(Value<T>::shared_from_this());
                     if (CallbackAction::Trigger == action)
                     {
                         _callback(subject->get());
@@ -37,7 +37,7 @@ namespace djv
             {
                 if (auto subject = _subject.lock())
                 {
-                    subject->_removeExpired();
+                    subject->_remove(_slotID);
                 }
             }
 
@@ -54,30 +54,19 @@ namespace djv
             template<typename T>
             inline size_t IValueSubject<T>::getObserversCount() const
             {
-                return _observers.size();
+                return _observers.getCount();
             }
 
             template<typename T>
-            inline void IValueSubject<T>::_add(const std::weak_ptr<Value<T> >& observer)
+            inline SlotID IValueSubject<T>::_add(const std::weak_ptr<Value<T> >& observer)
             {
-                _observers.push_back(observer);
+                return _observers.add(observer);
             }
 
             template<typename T>
-            inline void IValueSubject<T>::_removeExpired()
+            inline void IValueSubject<T>::_remove(SlotID id)
             {
-                auto i = _observers.begin();
-                while (i != _observers.end())
-                {
-                    if (i->expired())
-                    {
-                        i = _observers.erase(i);
-                    }
-                    else
-                    {
-                        ++i;
-                    }
-                }
+                _observers.remove(id);
             }
 
             template<typename T>
@@ -116,13 +105,7 @@ namespace djv
             inline void ValueSubject<T>::setAlways(const T& value)
             {
                 _value = value;
-                for (const auto& s : IValueSubject<T>::_observers)
-                {
-                    if (auto observer = s.lock())
-                    {
-                        observer->doCallback(_value);
-                    }
-                }
+                IValueSubject<T>::_notifyObservers();
             }
 
             template<typename T>
@@ -131,14 +114,18 @@ namespace djv
                 if (value == _value)
                     return false;
                 _value = value;
-                for (const auto& s : IValueSubject<T>::_observers)
-                {
-                    if (auto observer = s.lock())
+                IValueSubject<T>::_notifyObservers();
+                return true;
+            }
+
+            template<typename T>
+            inline void ValueSubject<T>::_doNotifyObservers()
+            {
+                IValueSubject<T>::_observers.forEach(
+                    [this](const std::shared_ptr<Value<T> >& observer)
                     {
                         observer->doCallback(_value);
-                    }
-                }
-                return true;
+                    });
             }
 
             template<typename T>
@@ -15,6 +15,7 @@ PYBIND11_MODULE(djvCorePy, m)
     wrapContext(m);
     wrapIObject(m);
     wrapFrame(m);
+    wrapMetrics(m);
     wrapVector(m);
 
     auto mFileSystem = m.def_submodule("FileSystem");
@@ -14,5 +14,6 @@ void wrapContext(pybind11::module&);
 void wrapFileInfo(pybind11::module&);
 void wrapFrame(pybind11::module&);
 void wrapIObject(pybind11::module&);
+void wrapMetrics(pybind11::module&);
 void wrapPath(pybind11::module&);
 void wrapVector(pybind11::module&);
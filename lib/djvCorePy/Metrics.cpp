@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCorePy/CorePy.h>
+
+#include <djvCore/MetricsFunc.h>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+using namespace djv::Core;
+
+namespace py = pybind11;
+
+void wrapMetrics(pybind11::module& m)
+{
+    auto mMetrics = m.def_submodule("Metrics");
+
+    py::class_<Metrics::Counter, std::shared_ptr<Metrics::Counter> >(mMetrics, "Counter")
+        .def("add", &Metrics::Counter::add, py::arg("value") = 1)
+        .def("get", &Metrics::Counter::get)
+        .def("reset", &Metrics::Counter::reset);
+
+    py::class_<Metrics::Gauge, std::shared_ptr<Metrics::Gauge> >(mMetrics, "Gauge")
+        .def("set", &Metrics::Gauge::set)
+        .def("add", &Metrics::Gauge::add)
+        .def("get", &Metrics::Gauge::get)
+        .def("reset", &Metrics::Gauge::reset);
+
+    py::class_<Metrics::HistogramData>(mMetrics, "HistogramData")
+        .def(py::init<>())
+        .def_readonly("count", &Metrics::HistogramData::count)
+        .def_readonly("min", &Metrics::HistogramData::min)
+        .def_readonly("max", &Metrics::HistogramData::max)
+        .def_readonly("mean", &Metrics::HistogramData::mean)
+        .def_readonly("p50", &Metrics::HistogramData::p50)
+        .def_readonly("p90", &Metrics::HistogramData::p90)
+        .def_readonly("p99", &Metrics::HistogramData::p99);
+
+    py::class_<Metrics::Histogram, std::shared_ptr<Metrics::Histogram> >(mMetrics, "Histogram")
+        .def("record", &Metrics::Histogram::record)
+        .def("getCount", &Metrics::Histogram::getCount)
+        .def("getPercentile", &Metrics::Histogram::getPercentile)
+        .def("getData", &Metrics::Histogram::getData)
+        .def("reset", &Metrics::Histogram::reset);
+
+    mMetrics.def("getCounter", &Metrics::getCounter);
+    mMetrics.def("getGauge", &Metrics::getGauge);
+    mMetrics.def("getHistogram", &Metrics::getHistogram);
+    mMetrics.def("reset", &Metrics::reset);
+    mMetrics.def("getCounterValues", &Metrics::getCounterValues);
+    mMetrics.def("getGaugeValues", &Metrics::getGaugeValues);
+    mMetrics.def("getHistogramValues", &Metrics::getHistogramValues);
+    mMetrics.def("toJSON", &Metrics::toJSON);
+}
@@ -60,7 +60,7 @@ namespace djv
 
             p.monitorInfo = Observer::ListSubject<MonitorInfo>::create();
 
-            auto avGLFWSystem = context->getSystemT<GL::GLFW::GLFWSystem>();
+            auto avGLFWSystem = GL::GLFW::GLFWSystem::create(context);
             addDependency(avGLFWSystem);
 
             // Poll for monitor information.
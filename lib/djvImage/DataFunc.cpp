@@ -7,6 +7,13 @@
 #include <djvImage/Color.h>
 #include <djvImage/Data.h>
 
+#include <djvCore/MemoryFunc.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace djv::Core;
+
 namespace djv
 {
     namespace Image
@@ -55,6 +62,94 @@ namespace djv
                 outP->b = static_cast<uint32_t>(static_cast<float>(average[2]) / static_cast<float>(width * height));
             }
 
+            template<typename T, typename T2>
+            void getProxy(const Data& in, size_t scale, Data& out)
+            {
+                const uint16_t w = in.getWidth();
+                const uint16_t h = in.getHeight();
+                const uint16_t outW = out.getWidth();
+                const uint16_t outH = out.getHeight();
+                const uint8_t channels = getChannelCount(in.getType());
+                std::vector<T2> sum(channels);
+                for (uint16_t y = 0; y < outH; ++y)
+                {
+                    const uint16_t y0 = static_cast<uint16_t>(y * scale);
+                    const uint16_t y1 = static_cast<uint16_t>(std::min(y0 + scale, static_cast<size_t>(h)));
+                    T* outP = reinterpret_cast<T*>(out.getData(y));
+                    for (uint16_t x = 0; x < outW; ++x)
+                    {
+                        const uint16_t x0 = static_cast<uint16_t>(x * scale);
+                        const uint16_t x1 = static_cast<uint16_t>(std::min(x0 + scale, static_cast<size_t>(w)));
+                        std::fill(sum.begin(), sum.end(), T2(0));
+                        for (uint16_t j = y0; j < y1; ++j)
+                        {
+                            const T* p = reinterpret_cast<const T*>(in.getData(x0, j));
+                            for (uint16_t i = x0; i < x1; ++i)
+                            {
+                                for (uint8_t c = 0; c < channels; ++c)
+                                {
+                                    sum[c] += *p++;
+                                }
+                            }
+                        }
+                        const T2 count = static_cast<T2>((x1 - x0) * (y1 - y0));
+                        for (uint8_t c = 0; c < channels; ++c)
+                        {
+                            *outP++ = static_cast<T>(sum[c] / count);
+                        }
+                    }
+                }
+            }
+
+            void getProxyU10(const Data& in, size_t scale, Data& out)
+            {
+                const uint16_t w = in.getWidth();
+                const uint16_t h = in.getHeight();
+                const uint16_t outW = out.getWidth();
+                const uint16_t outH = out.getHeight();
+                for (uint16_t y = 0; y < outH; ++y)
+                {
+                    const uint16_t y0 = static_cast<uint16_t>(y * scale);
+                    const uint16_t y1 = static_cast<uint16_t>(std::min(y0 + scale, static_cast<size_t>(h)));
+                    U10_S_LSB* outP = reinterpret_cast<U10_S_LSB*>(out.getData(y));
+                    for (uint16_t x = 0; x < outW; ++x, ++outP)
+                    {
+                        const uint16_t x0 = static_cast<uint16_t>(x * scale);
+                        const uint16_t x1 = static_cast<uint16_t>(std::min(x0 + scale, static_cast<size_t>(w)));
+                        uint64_t sum[3] = { 0, 0, 0 };
+                        for (uint16_t j = y0; j < y1; ++j)
+                        {
+                            const U10_S_LSB* p = reinterpret_cast<const U10_S_LSB*>(in.getData(x0, j));
+                            for (uint16_t i = x0; i < x1; ++i, ++p)
+                            {
+                                sum[0] += p->r;
+                                sum[1] += p->g;
+                                sum[2] += p->b;
+                            }
+                        }
+                        const uint64_t count = (x1 - x0) * (y1 - y0);
+                        outP->r = static_cast<uint32_t>(sum[0] / count);
+                        outP->g = static_cast<uint32_t>(sum[1] / count);
+                        outP->b = static_cast<uint32_t>(sum[2] / count);
+                    }
+                }
+            }
+
+            void getProxyNearest(const Data& in, size_t scale, Data& out)
+            {
+                const uint16_t outW = out.getWidth();
+                const uint16_t outH = out.getHeight();
+                const uint8_t pixelByteCount = in.getPixelByteCount();
+                for (uint16_t y = 0; y < outH; ++y)
+                {
+                    uint8_t* outP = out.getData(y);
+                    for (uint16_t x = 0; x < outW; ++x, outP += pixelByteCount)
+                    {
+                        memcpy(outP, in.getData(static_cast<uint16_t>(x * scale), static_cast<uint16_t>(y * scale)), pixelByteCount);
+                    }
+                }
+            }
+
         } // namespace
 
         Color getAverageColor(const std::shared_ptr<Data>& data)
@@ -82,6 +177,49 @@ namespace djv
             return out;
         }
 
+        Size getProxySize(const Size& size, size_t scale)
+        {
+            return scale > 1 ?
+                Size(
+                    static_cast<uint16_t>((size.w + scale - 1) / scale),
+                    static_cast<uint16_t>((size.h + scale - 1) / scale)) :
+                size;
+        }
+
+        std::shared_ptr<Data> getProxy(const std::shared_ptr<Data>& data, size_t scale)
+        {
+            if (!data || !data->isValid() || scale < 2)
+            {
+                return data;
+            }
+            const auto& info = data->getInfo();
+            Info outInfo = info;
+            outInfo.size = getProxySize(info.size, scale);
+            auto out = Data::create(outInfo);
+            out->setPluginName(data->getPluginName());
+            out->setTags(data->getTags());
+            if (info.layout.endian != Memory::getEndian())
+            {
+                // Averaging requires native byte order, so fall back to
+                // nearest neighbor sampling.
+                getProxyNearest(*data, scale, *out);
+            }
+            else
+            {
+                switch (getDataType(info.type))
+                {
+                case DataType::U8:  getProxy<U8_T, uint32_t>(*data, scale, *out); break;
+                case DataType::U16: getProxy<U16_T, uint32_t>(*data, scale, *out); break;
+                case DataType::U10: getProxyU10(*data, scale, *out); break;
+                case DataType::U32: getProxy<U32_T, uint64_t>(*data, scale, *out); break;
+                case DataType::F16: getProxy<F16_T, float>(*data, scale, *out); break;
+                case DataType::F32: getProxy<F32_T, float>(*data, scale, *out); break;
+                default: getProxyNearest(*data, scale, *out); break;
+                }
+            }
+            return out;
+        }
+
     } // namespace Image
 } // namespace djv
 
@@ -12,12 +12,22 @@ namespace djv
     {
         class Color;
         class Data;
+        class Size;
 
         //! \name Utility
         ///@{
 
         Color getAverageColor(const std::shared_ptr<Data>&);
 
+        //! Get the size of a reduced resolution proxy.
+        Size getProxySize(const Size&, size_t scale);
+
+        //! Get a reduced resolution proxy of the image data. The width and
+        //! height are divided by the scale factor, and each output pixel is
+        //! the average of the input pixels it covers. The input data is
+        //! returned unchanged if the scale factor is less than two.
+        std::shared_ptr<Data> getProxy(const std::shared_ptr<Data>&, size_t scale);
+
         ///@}
     
     } // namespace Image
@@ -22,18 +22,21 @@ namespace djv
             Sequence::Sequence(Number number)
             {
                 _ranges.push_back(Range(number));
+                _indexUpdate(0);
             }
        
             Sequence::Sequence(Number min, Number max, size_t pad) :
                 _pad(pad)
             {
                 _ranges.push_back(Range(min, max));
+                _indexUpdate(0);
             }
 
             Sequence::Sequence(const Range& range, size_t pad) :
                 _pad(pad)
             {
                 _ranges.push_back(range);
+                _indexUpdate(0);
             }
 
             Sequence::Sequence(const std::vector<Range>& ranges, size_t pad) :
@@ -47,72 +50,57 @@ namespace djv
             
             void Sequence::add(const Range& value)
             {
+                // Find the first range that intersects or is adjacent to the
+                // new range, and merge it with any following ranges.
                 Range newRange(value);
-                auto i = _ranges.begin();
-                while (i != _ranges.end())
-                {
-                    if (newRange.intersects(*i))
-                    {
-                        newRange.expand(*i);
-                        i = _ranges.erase(i);
-                    }
-                    else if (newRange.getMin() == i->getMax() + 1)
-                    {
-                        newRange = Range(i->getMin(), newRange.getMax());
-                        i = _ranges.erase(i);
-                    }
-                    else if (newRange.getMax() == i->getMin() - 1)
+                auto i = std::lower_bound(
+                    _ranges.begin(),
+                    _ranges.end(),
+                    newRange.getMin(),
+                    [](const Range& range, Number value)
                     {
-                        newRange = Range(newRange.getMin(), i->getMax());
-                        i = _ranges.erase(i);
-                    }
-                    else
-                    {
-                        ++i;
-                    }
+                        return range.getMax() + 1 < value;
+                    });
+                const size_t index = i - _ranges.begin();
+                auto j = i;
+                for (; j != _ranges.end() && j->getMin() <= newRange.getMax() + 1; ++j)
+                {
+                    newRange = Range(
+                        std::min(newRange.getMin(), j->getMin()),
+                        std::max(newRange.getMax(), j->getMax()));
                 }
-                i = _ranges.begin();
-                for (; i != _ranges.end() && *i < newRange; ++i)
-                    ;
-                _ranges.insert(i, newRange);
-            }
-
-            bool Sequence::contains(Index value) const noexcept
-            {
-                bool out = false;
-                for (const auto& i : _ranges)
+                if (i == j)
                 {
-                    if (i.contains(value))
-                    {
-                        out = true;
-                        break;
-                    }
+                    _ranges.insert(i, newRange);
                 }
-                return out;
+                else
+                {
+                    *i = newRange;
+                    _ranges.erase(i + 1, j);
+                }
+                _indexUpdate(index);
             }
 
-            size_t Sequence::getFrameCount() const noexcept
+            bool Sequence::contains(Index value) const noexcept
             {
-                size_t out = 0;
-                for (const auto& i : _ranges)
-                {
-                    out += i.getMax() - i.getMin() + 1;
-                }
-                return out;
+                const auto i = std::upper_bound(
+                    _ranges.begin(),
+                    _ranges.end(),
+                    value,
+                    [](Number value, const Range& range)
+                    {
+                        return value < range.getMin();
+                    });
+                return i != _ranges.begin() && (i - 1)->contains(value);
             }
 
             Number Sequence::getFrame(Index value) const noexcept
             {
                 Number out = invalid;
-                for (const auto& j : _ranges)
+                if (value >= 0 && value < static_cast<Index>(_frameCount))
                 {
-                    const size_t size = j.getMax() - j.getMin() + 1;
-                    if (value < size)
-                    {
-                        out = j.getMin() + value;
-                        break;
-                    }
-                    value -= size;
+                    const auto i = std::upper_bound(_indexes.begin(), _indexes.end(), value) - 1;
+                    out = _ranges[i - _indexes.begin()].getMin() + value - *i;
                 }
                 return out;
             }
@@ -120,27 +108,33 @@ namespace djv
             Index Sequence::getIndex(Number value) const noexcept
             {
                 Index out = invalidIndex;
-                Index tmp = 0;
-                for (const auto& j : _ranges)
-                {
-                    if (j.contains(value))
+                const auto i = std::upper_bound(
+                    _ranges.begin(),
+                    _ranges.end(),
+                    value,
+                    [](Number value, const Range& range)
                     {
-                        out = tmp + value - j.getMin();
-                        break;
-                    }
-                    tmp += j.getMax() - j.getMin() + 1;
+                        return value < range.getMin();
+                    });
+                if (i != _ranges.begin() && (i - 1)->contains(value))
+                {
+                    const size_t range = i - 1 - _ranges.begin();
+                    out = _indexes[range] + value - _ranges[range].getMin();
                 }
                 return out;
             }
 
-            Index Sequence::getLastIndex() const noexcept
+            void Sequence::_indexUpdate(size_t value)
             {
-                Index tmp = 0;
-                for (const auto& i : _ranges)
+                const size_t size = _ranges.size();
+                _indexes.resize(size);
+                Index index = value > 0 ? (_indexes[value - 1] + _ranges[value - 1].getMax() - _ranges[value - 1].getMin() + 1) : 0;
+                for (size_t i = value; i < size; ++i)
                 {
-                    tmp += i.getMax() - i.getMin() + 1;
+                    _indexes[i] = index;
+                    index += _ranges[i].getMax() - _ranges[i].getMin() + 1;
                 }
-                return _ranges.size() ? (tmp - 1) : invalidIndex;
+                _frameCount = static_cast<size_t>(index);
             }
             
         } // namespace Frame
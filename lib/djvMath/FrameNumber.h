@@ -6,6 +6,7 @@
 
 #include <djvMath/Range.h>
 
+#include <iterator>
 #include <vector>
 
 namespace djv
@@ -32,9 +33,15 @@ namespace djv
             
             //! This class provides a sequence of frame numbers. A sequence is
             //! composed of multiple frame number ranges (e.g., 1-10,20-30).
+            //!
+            //! The ranges are kept sorted along with the index of the first
+            //! frame in each range, so that frame and index lookups are a
+            //! binary search over the ranges.
             class Sequence
             {
             public:
+                class Iterator;
+
                 Sequence();
                 explicit Sequence(Number);
                 Sequence(Number min, Number max, size_t pad = 0);
@@ -72,14 +79,50 @@ namespace djv
                 Index getIndex(Number) const noexcept;
                 Index getLastIndex() const noexcept;
 
+                //! Iterate over the frame numbers without converting them to
+                //! a list.
+                Iterator begin() const noexcept;
+                Iterator end() const noexcept;
+
                 ///@}
 
                 bool operator == (const Sequence&) const;
                 bool operator != (const Sequence&) const;
 
             private:
+                void _indexUpdate(size_t);
+
                 std::vector<Range>  _ranges;
-                size_t              _pad    = 0;
+                std::vector<Index>  _indexes;
+                size_t              _frameCount = 0;
+                size_t              _pad        = 0;
+            };
+
+            //! This class provides an iterator over the frame numbers in a
+            //! sequence.
+            class Sequence::Iterator
+            {
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef Number value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef const Number* pointer;
+                typedef Number reference;
+
+                Iterator() noexcept;
+                Iterator(const std::vector<Range>*, size_t range) noexcept;
+
+                Number operator * () const noexcept;
+                Iterator& operator ++ () noexcept;
+                Iterator operator ++ (int) noexcept;
+
+                bool operator == (const Iterator&) const noexcept;
+                bool operator != (const Iterator&) const noexcept;
+
+            private:
+                const std::vector<Range>* _ranges = nullptr;
+                size_t _range = 0;
+                Number _frame = 0;
             };
 
         } // namespace Frame
@@ -19,6 +19,7 @@ namespace djv
             std::vector<Number> toFrames(const Range& value)
             {
                 std::vector<Number> out;
+                out.reserve(value.getMax() - value.getMin() + 1);
                 for (auto i = value.getMin(); i <= value.getMax(); ++i)
                 {
                     out.push_back(i);
@@ -29,12 +30,10 @@ namespace djv
             std::vector<Number> toFrames(const Sequence& value)
             {
                 std::vector<Number> out;
-                for (const auto& range : value.getRanges())
+                out.reserve(value.getFrameCount());
+                for (const auto i : value)
                 {
-                    for (const auto& i : toFrames(range))
-                    {
-                        out.push_back(i);
-                    }
+                    out.push_back(i);
                 }
                 return out;
             }
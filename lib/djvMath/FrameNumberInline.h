@@ -28,6 +28,26 @@ namespace djv
                 _pad = value;
             }
 
+            inline size_t Sequence::getFrameCount() const noexcept
+            {
+                return _frameCount;
+            }
+
+            inline Index Sequence::getLastIndex() const noexcept
+            {
+                return _frameCount > 0 ? (static_cast<Index>(_frameCount) - 1) : invalidIndex;
+            }
+
+            inline Sequence::Iterator Sequence::begin() const noexcept
+            {
+                return Iterator(&_ranges, 0);
+            }
+
+            inline Sequence::Iterator Sequence::end() const noexcept
+            {
+                return Iterator(&_ranges, _ranges.size());
+            }
+
             inline bool Sequence::operator == (const Sequence& value) const
             {
                 return _ranges == value._ranges && _pad == value._pad;
@@ -37,7 +57,52 @@ namespace djv
             {
                 return !(*this == value);
             }
-        
+
+            inline Sequence::Iterator::Iterator() noexcept
+            {}
+
+            inline Sequence::Iterator::Iterator(const std::vector<Range>* ranges, size_t range) noexcept :
+                _ranges(ranges),
+                _range(range),
+                _frame(range < ranges->size() ? (*ranges)[range].getMin() : 0)
+            {}
+
+            inline Number Sequence::Iterator::operator * () const noexcept
+            {
+                return _frame;
+            }
+
+            inline Sequence::Iterator& Sequence::Iterator::operator ++ () noexcept
+            {
+                if (_frame < (*_ranges)[_range].getMax())
+                {
+                    ++_frame;
+                }
+                else
+                {
+                    ++_range;
+                    _frame = _range < _ranges->size() ? (*_ranges)[_range].getMin() : 0;
+                }
+                return *this;
+            }
+
+            inline Sequence::Iterator Sequence::Iterator::operator ++ (int) noexcept
+            {
+                Iterator out = *this;
+                ++(*this);
+                return out;
+            }
+
+            inline bool Sequence::Iterator::operator == (const Iterator& value) const noexcept
+            {
+                return _ranges == value._ranges && _range == value._range && _frame == value._frame;
+            }
+
+            inline bool Sequence::Iterator::operator != (const Iterator& value) const noexcept
+            {
+                return !(*this == value);
+            }
+
         } // namespace Frame
     } // namespace Math
 } // namespace djv
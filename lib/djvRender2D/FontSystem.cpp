@@ -4,21 +4,26 @@
 
 #include <djvRender2D/FontSystem.h>
 
+#include <djvRender2D/GlyphCache.h>
+
 #include <djvSystem/Context.h>
 #include <djvSystem/CoreSystem.h>
 #include <djvSystem/FileInfoFunc.h>
+#include <djvSystem/LogSystem.h>
 #include <djvSystem/ResourceSystem.h>
 #include <djvSystem/TimerFunc.h>
 
 #include <djvImage/Data.h>
 
 #include <djvCore/Cache.h>
+#include <djvCore/MetricsFunc.h>
 #include <djvCore/StringFunc.h>
 
 #include <freetype2/ft2build.h>
 #include FT_FREETYPE_H
 #include FT_GLYPH_H
 
+#include <algorithm>
 #include <atomic>
 #include <codecvt>
 #include <condition_variable>
@@ -26,6 +31,7 @@
 #include <locale>
 #include <mutex>
 #include <thread>
+#include <unordered_map>
 
 using namespace djv::Core;
 
@@ -77,6 +83,7 @@ namespace djv
             {
                 //! \todo Should this be configurable?
                 const size_t glyphCacheMax = 10000;
+                const size_t threadCountMax = 4;
 
                 class MetricsRequest
                 {
@@ -200,6 +207,64 @@ namespace djv
                     return out;
                 }
 
+                size_t getThreadCount()
+                {
+                    return std::max(
+                        static_cast<size_t>(1),
+                        std::min(threadCountMax, static_cast<size_t>(std::thread::hardware_concurrency())));
+                }
+
+                //! Move a share of the queued requests so that the other
+                //! threads can work on the rest.
+                template<typename T>
+                void takeRequests(std::list<T>& queue, std::list<T>& requests, size_t threadCount)
+                {
+                    const size_t count = (queue.size() + threadCount - 1) / threadCount;
+                    auto end = queue.begin();
+                    std::advance(end, count);
+                    requests.splice(requests.end(), queue, queue.begin(), end);
+                }
+
+                struct FontFile
+                {
+                    FamilyID    family = 0;
+                    FaceID      face   = 0;
+                    std::string fileName;
+                    std::string cacheKey;
+                };
+
+                //! This struct provides the data for a rasterizer thread. FreeType
+                //! faces cannot be shared between threads so each one has its own.
+                struct Worker
+                {
+                    FT_Library ftLibrary = nullptr;
+                    std::map<FamilyID, std::map<FaceID, FT_Face> > fontFaces;
+                    std::wstring_convert<std::codecvt_utf8<djv_char_t>, djv_char_t> utf32Convert;
+
+                    std::list<MetricsRequest> metricsRequests;
+                    std::list<MeasureRequest> measureRequests;
+                    std::list<MeasureGlyphsRequest> measureGlyphsRequests;
+                    std::list<GlyphsRequest> glyphsRequests;
+                    std::list<TextLinesRequest> textLinesRequests;
+
+                    std::thread thread;
+
+                    FT_Face getFace(FamilyID family, FaceID face) const
+                    {
+                        FT_Face out = nullptr;
+                        const auto i = fontFaces.find(family);
+                        if (i != fontFaces.end())
+                        {
+                            const auto j = i->second.find(face);
+                            if (j != i->second.end())
+                            {
+                                out = j->second;
+                            }
+                        }
+                        return out;
+                    }
+                };
+
             } // namespace
 
             std::shared_ptr<Glyph> Glyph::create()
@@ -213,21 +278,20 @@ namespace djv
 
             struct FontSystem::Private
             {
-                bool lcdRendering = true;
-                bool lcdRenderingThread = lcdRendering;
+                std::shared_ptr<System::LogSystem> logSystem;
+
+                std::atomic<bool> lcdRendering;
 
-                FT_Library ftLibrary = nullptr;
                 System::File::Path fontPath;
-                std::map<FamilyID, std::string> fontFileNames;
+                std::vector<FontFile> fontFiles;
+                std::promise<void> fontFilesPromise;
+                std::shared_future<void> fontFilesFuture;
                 std::map<FamilyID, std::string> fontNames;
                 std::shared_ptr<Observer::MapSubject<FamilyID, std::string> > fontNamesSubject;
                 std::mutex fontNamesMutex;
                 std::shared_ptr<System::Timer> fontNamesTimer;
                 std::map<FamilyID, std::map<FaceID, std::string> > fontFaceNames;
                 std::shared_ptr<Observer::MapSubject<FamilyID, std::map<FaceID, std::string> > > fontFaceNamesSubject;
-                std::map<FamilyID, std::map<FaceID, FT_Face> > fontFaces;
-                std::map<std::string, FamilyID> fontNameToID;
-                std::map<std::pair<FamilyID, std::string>, FamilyID> fontFaceNameToID;
                 std::vector< std::pair<FamilyID, FaceID> > symbolFonts;
 
                 std::list<MetricsRequest> metricsQueue;
@@ -237,28 +301,49 @@ namespace djv
                 std::list<TextLinesRequest> textLinesQueue;
                 std::condition_variable requestCV;
                 std::mutex requestMutex;
-                std::list<MetricsRequest> metricsRequests;
-                std::list<MeasureRequest> measureRequests;
-                std::list<MeasureGlyphsRequest> measureGlyphsRequests;
-                std::list<GlyphsRequest> glyphsRequests;
-                std::list<TextLinesRequest> textLinesRequests;
 
-                std::wstring_convert<std::codecvt_utf8<djv_char_t>, djv_char_t> utf32Convert;
-                Memory::Cache<GlyphInfo, std::shared_ptr<Glyph> > glyphCache;
-                std::atomic<size_t> glyphCacheSize;
-                std::atomic<float> glyphCachePercentageUsed;
+                // The glyph cache can be read by all of the threads at once. The
+                // generation is incremented when the cache is cleared so that
+                // glyphs rendered with the previous options are not added.
+                Memory::ShardedCache<GlyphInfo, std::shared_ptr<Glyph> > glyphCache;
+                std::atomic<size_t> glyphCacheGeneration;
+
+                // The glyph disk cache is read on startup and written when the
+                // system is destroyed.
+                std::shared_ptr<GlyphCache> glyphDiskCache;
+                std::string glyphDiskCacheFileName;
+
+                // Glyphs that are being rendered, so that other threads can wait
+                // for them instead of rendering them again.
+                std::unordered_map<GlyphInfo, std::shared_future<std::shared_ptr<Glyph> > > inFlightGlyphs;
+                std::mutex inFlightGlyphsMutex;
 
                 std::shared_ptr<System::Timer> statsTimer;
-                std::thread thread;
+                size_t threadCount = 1;
+                std::vector<std::unique_ptr<Worker> > workers;
                 std::atomic<bool> running;
 
+                void log(const std::string&, System::LogLevel = System::LogLevel::Information);
+
+                void run(Worker&, bool findFonts);
+
+                void initFreeType(Worker&, bool findFonts);
+                void delFreeType(Worker&);
+
+                void handleMetricsRequests(Worker&);
+                void handleMeasureRequests(Worker&);
+                void handleMeasureGlyphsRequests(Worker&);
+                void handleGlyphsRequests(Worker&);
+                void handleTextLinesRequests(Worker&);
+
                 std::vector<FontInfo> getFontInfoList(const FontInfo&) const;
+                std::string getFontCacheKey(const FontInfo&) const;
 
-                FT_Face getFace(FamilyID, FaceID) const;
+                std::shared_ptr<Glyph> getGlyph(Worker&, uint32_t, const std::vector<FontInfo>&);
+                std::shared_ptr<Glyph> renderGlyph(FT_Face, FT_UInt ftGlyphIndex, const GlyphInfo&, bool lcdRendering);
 
-                std::shared_ptr<Glyph> getGlyph(uint32_t, const std::vector<FontInfo>&);
-                
                 void measure(
+                    Worker&,
                     const std::basic_string<djv_char_t>& utf32,
                     const std::vector<FontInfo>&,
                     uint16_t maxLineWidth,
@@ -274,12 +359,26 @@ namespace djv
 
                 addDependency(context->getSystemT<System::CoreSystem>());
 
+                p.logSystem = context->getSystemT<System::LogSystem>();
+                p.lcdRendering = true;
                 p.fontPath = _getResourceSystem()->getPath(System::File::ResourcePath::Fonts);
+                p.fontFilesFuture = p.fontFilesPromise.get_future().share();
                 p.fontNamesSubject = Observer::MapSubject<FamilyID, std::string>::create();
                 p.fontFaceNamesSubject = Observer::MapSubject<FamilyID, std::map<FaceID, std::string> >::create();
                 p.glyphCache.setMax(glyphCacheMax);
-                p.glyphCacheSize = 0;
-                p.glyphCachePercentageUsed = 0.F;
+                p.glyphCacheGeneration = 0;
+                p.glyphDiskCache = GlyphCache::create();
+                p.glyphDiskCacheFileName = System::File::Path(
+                    _getResourceSystem()->getPath(System::File::ResourcePath::Documents),
+                    glyphCacheFileName).get();
+                try
+                {
+                    p.glyphDiskCache->read(p.glyphDiskCacheFileName);
+                }
+                catch (const std::exception& e)
+                {
+                    _log(e.what(), System::LogLevel::Error);
+                }
 
                 p.fontNamesTimer = System::Timer::create(context);
                 p.fontNamesTimer->setRepeating(true);
@@ -307,75 +406,30 @@ namespace djv
                 {
                     DJV_PRIVATE_PTR();
                     std::stringstream ss;
-                    ss << "Glyph cache: " << p.glyphCacheSize << ", " << p.glyphCachePercentageUsed << "%";
+                    ss << "Glyph cache: " << p.glyphCache.getSize() << ", " << p.glyphCache.getPercentageUsed() << "%";
                     _log(ss.str());
                 });
 
+                // The first thread finds the fonts, the other threads wait for
+                // it and then open their own copies.
                 p.running = true;
-                p.thread = std::thread(
-                    [this]
+                p.threadCount = getThreadCount();
                 {
-                    DJV_PRIVATE_PTR();
-                    _initFreeType();
-                    bool lcdRenderingChanged = false;
-                    const Time::Duration threadTimerDuration = System::getTimerDuration(System::TimerValue::Fast);
-                    while (p.running)
-                    {
-                        {
-                            std::unique_lock<std::mutex> lock(p.requestMutex);
-                            p.requestCV.wait_for(
-                                lock,
-                                threadTimerDuration,
-                                [this]
-                            {
-                                DJV_PRIVATE_PTR();
-                                return
-                                    p.lcdRendering != p.lcdRenderingThread ||
-                                    p.metricsQueue.size() ||
-                                    p.measureQueue.size() ||
-                                    p.glyphsQueue.size() ||
-                                    p.textLinesQueue.size();
-                            });
-                            if (p.lcdRendering != p.lcdRenderingThread)
-                            {
-                                p.lcdRenderingThread = p.lcdRendering;
-                                lcdRenderingChanged = true;
-                            }
-                            p.metricsRequests = std::move(p.metricsQueue);
-                            p.measureRequests = std::move(p.measureQueue);
-                            p.measureGlyphsRequests = std::move(p.measureGlyphsQueue);
-                            p.glyphsRequests = std::move(p.glyphsQueue);
-                            p.textLinesRequests = std::move(p.textLinesQueue);
-                        }
-                        if (lcdRenderingChanged)
-                        {
-                            p.glyphCache.clear();
-                            p.glyphCacheSize = 0;
-                            p.glyphCachePercentageUsed = 0.F;
-                        }
-                        if (p.metricsRequests.size())
-                        {
-                            _handleMetricsRequests();
-                        }
-                        if (p.measureRequests.size())
-                        {
-                            _handleMeasureRequests();
-                        }
-                        if (p.measureGlyphsRequests.size())
-                        {
-                            _handleMeasureGlyphsRequests();
-                        }
-                        if (p.glyphsRequests.size())
-                        {
-                            _handleGlyphsRequests();
-                        }
-                        if (p.textLinesRequests.size())
+                    std::stringstream ss;
+                    ss << "Thread count: " << p.threadCount;
+                    _log(ss.str());
+                }
+                for (size_t i = 0; i < p.threadCount; ++i)
+                {
+                    std::unique_ptr<Worker> worker(new Worker);
+                    Worker* workerP = worker.get();
+                    worker->thread = std::thread(
+                        [this, workerP, i]
                         {
-                            _handleTextLinesRequests();
-                        }
-                    }
-                    _delFreeType();
-                });
+                            _p->run(*workerP, 0 == i);
+                        });
+                    p.workers.push_back(std::move(worker));
+                }
             }
 
             FontSystem::FontSystem() :
@@ -386,9 +440,24 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.running = false;
-                if (p.thread.joinable())
+                p.requestCV.notify_all();
+                for (const auto& i : p.workers)
                 {
-                    p.thread.join();
+                    if (i->thread.joinable())
+                    {
+                        i->thread.join();
+                    }
+                }
+                if (p.glyphDiskCache->isDirty())
+                {
+                    try
+                    {
+                        p.glyphDiskCache->write(p.glyphDiskCacheFileName);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _log(e.what(), System::LogLevel::Error);
+                    }
                 }
             }
 
@@ -415,21 +484,24 @@ namespace djv
 
             size_t FontSystem::getGlyphCacheSize() const
             {
-                return _p->glyphCacheSize;
+                return _p->glyphCache.getSize();
             }
 
             float FontSystem::getGlyphCachePercentage() const
             {
-                return _p->glyphCachePercentageUsed;
+                return _p->glyphCache.getPercentageUsed();
             }
 
             void FontSystem::setLCDRendering(bool value)
             {
                 DJV_PRIVATE_PTR();
                 if (value == p.lcdRendering)
+                {
                     return;
-                std::unique_lock<std::mutex> lock(p.requestMutex);
+                }
                 p.lcdRendering = value;
+                ++p.glyphCacheGeneration;
+                p.glyphCache.clear();
             }
 
             std::future<Metrics> FontSystem::getMetrics(const FontInfo& fontInfo)
@@ -536,133 +608,227 @@ namespace djv
                 p.requestCV.notify_one();
             }
 
-            void FontSystem::_initFreeType()
+            void FontSystem::Private::log(const std::string& value, System::LogLevel level)
             {
-                DJV_PRIVATE_PTR();
-                try
+                logSystem->log("djv::Render2D::Font::FontSystem", value, level);
+            }
+
+            void FontSystem::Private::run(Worker& worker, bool findFonts)
+            {
+                initFreeType(worker, findFonts);
+                const Time::Duration threadTimerDuration = System::getTimerDuration(System::TimerValue::Fast);
+                while (running)
                 {
-                    FT_Error ftError = FT_Init_FreeType(&p.ftLibrary);
-                    if (ftError)
+                    bool notify = false;
                     {
-                        throw Error("FreeType cannot be initialized.");
+                        std::unique_lock<std::mutex> lock(requestMutex);
+                        requestCV.wait_for(
+                            lock,
+                            threadTimerDuration,
+                            [this]
+                        {
+                            return
+                                !running ||
+                                metricsQueue.size() ||
+                                measureQueue.size() ||
+                                measureGlyphsQueue.size() ||
+                                glyphsQueue.size() ||
+                                textLinesQueue.size();
+                        });
+                        takeRequests(metricsQueue, worker.metricsRequests, threadCount);
+                        takeRequests(measureQueue, worker.measureRequests, threadCount);
+                        takeRequests(measureGlyphsQueue, worker.measureGlyphsRequests, threadCount);
+                        takeRequests(glyphsQueue, worker.glyphsRequests, threadCount);
+                        takeRequests(textLinesQueue, worker.textLinesRequests, threadCount);
+                        notify =
+                            metricsQueue.size() ||
+                            measureQueue.size() ||
+                            measureGlyphsQueue.size() ||
+                            glyphsQueue.size() ||
+                            textLinesQueue.size();
                     }
-                    int versionMajor = 0;
-                    int versionMinor = 0;
-                    int versionPatch = 0;
-                    FT_Library_Version(p.ftLibrary, &versionMajor, &versionMinor, &versionPatch);
+                    if (notify)
                     {
-                        std::stringstream ss;
-                        ss << "FreeType version: " << versionMajor << "." << versionMinor << "." << versionPatch;
-                        _log(ss.str());
+                        requestCV.notify_one();
                     }
-                    for (const auto& i : System::File::directoryList(p.fontPath))
+                    if (worker.metricsRequests.size())
                     {
-                        const std::string& fileName = i.getFileName();
-                        {
-                            std::stringstream ss;
-                            ss << "Loading font: " << fileName;
-                            _log(ss.str());
-                        }
+                        handleMetricsRequests(worker);
+                    }
+                    if (worker.measureRequests.size())
+                    {
+                        handleMeasureRequests(worker);
+                    }
+                    if (worker.measureGlyphsRequests.size())
+                    {
+                        handleMeasureGlyphsRequests(worker);
+                    }
+                    if (worker.glyphsRequests.size())
+                    {
+                        handleGlyphsRequests(worker);
+                    }
+                    if (worker.textLinesRequests.size())
+                    {
+                        handleTextLinesRequests(worker);
+                    }
+                }
+                delFreeType(worker);
+            }
 
-                        FT_Face ftFace;
-                        ftError = FT_New_Face(p.ftLibrary, fileName.c_str(), 0, &ftFace);
-                        if (ftError)
+            void FontSystem::Private::initFreeType(Worker& worker, bool findFonts)
+            {
+                bool fontFilesReady = false;
+                try
+                {
+                    FT_Error ftError = FT_Init_FreeType(&worker.ftLibrary);
+                    if (ftError)
+                    {
+                        throw Error("FreeType cannot be initialized.");
+                    }
+                    if (findFonts)
+                    {
+                        int versionMajor = 0;
+                        int versionMinor = 0;
+                        int versionPatch = 0;
+                        FT_Library_Version(worker.ftLibrary, &versionMajor, &versionMinor, &versionPatch);
                         {
                             std::stringstream ss;
-                            ss << "Cannot load font: " << fileName;
-                            _log(ss.str(), System::LogLevel::Error);
+                            ss << "FreeType version: " << versionMajor << "." << versionMinor << "." << versionPatch;
+                            log(ss.str());
                         }
-                        else
+                        std::map<std::string, FamilyID> fontNameToID;
+                        std::map<std::pair<FamilyID, std::string>, FaceID> fontFaceNameToID;
+                        for (const auto& i : System::File::directoryList(fontPath))
                         {
-                            std::stringstream ss;
-                            ss << "    Family: " << ftFace->family_name << '\n';
-                            ss << "    Style: " << ftFace->style_name << '\n';
-                            ss << "    Number of glyphs: " << static_cast<int>(ftFace->num_glyphs) << '\n';
-                            ss << "    Scalable: " << (FT_IS_SCALABLE(ftFace) ? "true" : "false") << '\n';
-                            ss << "    Kerning: " << (FT_HAS_KERNING(ftFace) ? "true" : "false");
-                            _log(ss.str());
-
-                            FamilyID familyID = 0;
-                            auto j = p.fontNameToID.find(ftFace->family_name);
-                            if (j != p.fontNameToID.end())
-                            {
-                                familyID = j->second;
-                            }
-                            else
+                            const std::string& fileName = i.getFileName();
                             {
-                                for (auto k : p.fontNameToID)
-                                {
-                                    familyID = std::max(familyID, k.second);
-                                }
-                                ++familyID;
-                                p.fontNameToID[ftFace->family_name] = familyID;
+                                std::stringstream ss;
+                                ss << "Loading font: " << fileName;
+                                log(ss.str());
                             }
 
-                            FaceID faceID = 0;
-                            auto k = p.fontFaceNameToID.find(std::make_pair(familyID, ftFace->style_name));
-                            if (k != p.fontFaceNameToID.end())
+                            FT_Face ftFace;
+                            ftError = FT_New_Face(worker.ftLibrary, fileName.c_str(), 0, &ftFace);
+                            if (ftError)
                             {
-                                faceID = k->second;
+                                std::stringstream ss;
+                                ss << "Cannot load font: " << fileName;
+                                log(ss.str(), System::LogLevel::Error);
                             }
                             else
                             {
-                                for (auto l : p.fontFaceNameToID)
+                                std::stringstream ss;
+                                ss << "    Family: " << ftFace->family_name << '\n';
+                                ss << "    Style: " << ftFace->style_name << '\n';
+                                ss << "    Number of glyphs: " << static_cast<int>(ftFace->num_glyphs) << '\n';
+                                ss << "    Scalable: " << (FT_IS_SCALABLE(ftFace) ? "true" : "false") << '\n';
+                                ss << "    Kerning: " << (FT_HAS_KERNING(ftFace) ? "true" : "false");
+                                log(ss.str());
+
+                                FamilyID familyID = 0;
+                                auto j = fontNameToID.find(ftFace->family_name);
+                                if (j != fontNameToID.end())
                                 {
-                                    faceID = std::max(faceID, l.second);
+                                    familyID = j->second;
+                                }
+                                else
+                                {
+                                    for (auto k : fontNameToID)
+                                    {
+                                        familyID = std::max(familyID, k.second);
+                                    }
+                                    ++familyID;
+                                    fontNameToID[ftFace->family_name] = familyID;
                                 }
-                                ++faceID;
-                                p.fontFaceNameToID[std::make_pair(familyID, ftFace->style_name)] = faceID;
-                            }
 
-                            p.fontFileNames[familyID] = fileName;
-                            //! \bug Probably not the best way to do this...
-                            if (String::match(ftFace->family_name, "Symbols"))
-                            {
-                                p.symbolFonts.push_back(std::make_pair(familyID, faceID));
-                            }
-                            else
-                            {
-                                std::unique_lock<std::mutex> lock(p.fontNamesMutex);
-                                p.fontNames[familyID] = ftFace->family_name;
-                                p.fontFaceNames[familyID][faceID] = ftFace->style_name;
+                                FaceID faceID = 0;
+                                auto k = fontFaceNameToID.find(std::make_pair(familyID, ftFace->style_name));
+                                if (k != fontFaceNameToID.end())
+                                {
+                                    faceID = k->second;
+                                }
+                                else
+                                {
+                                    for (auto l : fontFaceNameToID)
+                                    {
+                                        faceID = std::max(faceID, l.second);
+                                    }
+                                    ++faceID;
+                                    fontFaceNameToID[std::make_pair(familyID, ftFace->style_name)] = faceID;
+                                }
+
+                                FontFile fontFile;
+                                fontFile.family = familyID;
+                                fontFile.face = faceID;
+                                fontFile.fileName = fileName;
+                                fontFile.cacheKey = getGlyphCacheFontKey(i);
+                                fontFiles.push_back(fontFile);
+                                //! \bug Probably not the best way to do this...
+                                if (String::match(ftFace->family_name, "Symbols"))
+                                {
+                                    symbolFonts.push_back(std::make_pair(familyID, faceID));
+                                }
+                                else
+                                {
+                                    std::unique_lock<std::mutex> lock(fontNamesMutex);
+                                    fontNames[familyID] = ftFace->family_name;
+                                    fontFaceNames[familyID][faceID] = ftFace->style_name;
+                                }
+                                worker.fontFaces[familyID][faceID] = ftFace;
                             }
-                            p.fontFaces[familyID][faceID] = ftFace;
+                        }
+                        fontFilesPromise.set_value();
+                        fontFilesReady = true;
+                        if (!worker.fontFaces.size())
+                        {
+                            throw Error("No fonts were found.");
                         }
                     }
-                    if (!p.fontFaces.size())
+                    else
                     {
-                        throw Error("No fonts were found.");
+                        fontFilesFuture.wait();
+                        for (const auto& i : fontFiles)
+                        {
+                            FT_Face ftFace;
+                            ftError = FT_New_Face(worker.ftLibrary, i.fileName.c_str(), 0, &ftFace);
+                            if (!ftError)
+                            {
+                                worker.fontFaces[i.family][i.face] = ftFace;
+                            }
+                        }
                     }
                 }
                 catch (const std::exception& e)
                 {
-                    _log(e.what());
+                    log(e.what());
+                }
+                if (findFonts && !fontFilesReady)
+                {
+                    fontFilesPromise.set_value();
                 }
             }
 
-            void FontSystem::_delFreeType()
+            void FontSystem::Private::delFreeType(Worker& worker)
             {
-                DJV_PRIVATE_PTR();
-                if (p.ftLibrary)
+                if (worker.ftLibrary)
                 {
-                    for (const auto& i : p.fontFaces)
+                    for (const auto& i : worker.fontFaces)
                     {
                         for (const auto& j : i.second)
                         {
                             FT_Done_Face(j.second);
                         }
                     }
-                    FT_Done_FreeType(p.ftLibrary);
+                    FT_Done_FreeType(worker.ftLibrary);
                 }
             }
 
-            void FontSystem::_handleMetricsRequests()
+            void FontSystem::Private::handleMetricsRequests(Worker& worker)
             {
-                DJV_PRIVATE_PTR();
-                for (auto& request : p.metricsRequests)
+                for (auto& request : worker.metricsRequests)
                 {
                     Metrics metrics;
-                    if (auto ftFace = p.getFace(request.fontInfo.getFamily(), request.fontInfo.getFace()))
+                    if (auto ftFace = worker.getFace(request.fontInfo.getFamily(), request.fontInfo.getFace()))
                     {
                         /*FT_Error ftError = FT_Set_Char_Size(
                             ftFace->second,
@@ -683,18 +849,17 @@ namespace djv
                     }
                     request.promise.set_value(std::move(metrics));
                 }
-                p.metricsRequests.clear();
+                worker.metricsRequests.clear();
             }
 
-            void FontSystem::_handleMeasureRequests()
+            void FontSystem::Private::handleMeasureRequests(Worker& worker)
             {
-                DJV_PRIVATE_PTR();
-                for (auto& request : p.measureRequests)
+                for (auto& request : worker.measureRequests)
                 {
                     glm::vec2 size = glm::vec2(0.F, 0.F);
                     try
                     {
-                        auto utf32 = p.utf32Convert.from_bytes(request.text);
+                        auto utf32 = worker.utf32Convert.from_bytes(request.text);
                         const size_t inSize = utf32.size();
                         const size_t outSize = request.elide > 0 ? std::min(inSize, static_cast<size_t>(request.elide)) : inSize;
                         while (utf32.size() > outSize)
@@ -707,29 +872,28 @@ namespace djv
                             utf32.push_back('.');
                             utf32.push_back('.');
                         }
-                        p.measure(utf32, p.getFontInfoList(request.fontInfo), request.maxLineWidth, size);
+                        measure(worker, utf32, getFontInfoList(request.fontInfo), request.maxLineWidth, size);
                     }
                     catch (const std::exception& e)
                     {
                         std::stringstream ss;
                         ss << "Error converting string" << " '" << request.text << "': " << e.what();
-                        _log(ss.str(), System::LogLevel::Error);
+                        log(ss.str(), System::LogLevel::Error);
                     }
                     request.promise.set_value(size);
                 }
-                p.measureRequests.clear();
+                worker.measureRequests.clear();
             }
 
-            void FontSystem::_handleMeasureGlyphsRequests()
+            void FontSystem::Private::handleMeasureGlyphsRequests(Worker& worker)
             {
-                DJV_PRIVATE_PTR();
-                for (auto& request : p.measureGlyphsRequests)
+                for (auto& request : worker.measureGlyphsRequests)
                 {
                     glm::vec2 size = glm::vec2(0.F, 0.F);
                     std::vector<Math::BBox2f> glyphGeom;
                     try
                     {
-                        auto utf32 = p.utf32Convert.from_bytes(request.text);
+                        auto utf32 = worker.utf32Convert.from_bytes(request.text);
                         const size_t inSize = utf32.size();
                         const size_t outSize = request.elide > 0 ? std::min(inSize, static_cast<size_t>(request.elide)) : inSize;
                         while (utf32.size() > outSize)
@@ -742,44 +906,43 @@ namespace djv
                             utf32.push_back('.');
                             utf32.push_back('.');
                         }
-                        p.measure(utf32, p.getFontInfoList(request.fontInfo), request.maxLineWidth, size, &glyphGeom);
+                        measure(worker, utf32, getFontInfoList(request.fontInfo), request.maxLineWidth, size, &glyphGeom);
                     }
                     catch (const std::exception& e)
                     {
                         std::stringstream ss;
                         ss << "Error converting string" << " '" << request.text << "': " << e.what();
-                        _log(ss.str(), System::LogLevel::Error);
+                        log(ss.str(), System::LogLevel::Error);
                     }
                     request.promise.set_value(glyphGeom);
                 }
-                p.measureGlyphsRequests.clear();
+                worker.measureGlyphsRequests.clear();
             }
 
-            void FontSystem::_handleGlyphsRequests()
+            void FontSystem::Private::handleGlyphsRequests(Worker& worker)
             {
-                DJV_PRIVATE_PTR();
-                for (auto& request : p.glyphsRequests)
+                for (auto& request : worker.glyphsRequests)
                 {
                     std::basic_string<djv_char_t> utf32;
                     try
                     {
-                        utf32 = p.utf32Convert.from_bytes(request.text);
+                        utf32 = worker.utf32Convert.from_bytes(request.text);
                     }
                     catch (const std::exception& e)
                     {
                         std::stringstream ss;
                         ss << "Error converting string" << " '" << request.text << "': " << e.what();
-                        _log(ss.str(), System::LogLevel::Error);
+                        log(ss.str(), System::LogLevel::Error);
                     }
                     const size_t inSize = utf32.size();
                     const size_t outSize = request.elide > 0 ? std::min(inSize, static_cast<size_t>(request.elide)) : inSize;
                     const bool elided = outSize < inSize;
-                    const auto fontInfoList = p.getFontInfoList(request.fontInfo);
+                    const auto fontInfoList = getFontInfoList(request.fontInfo);
                     if (request.cacheOnly)
                     {
                         for (size_t i = 0; i < inSize; ++i)
                         {
-                            p.getGlyph(utf32[i], fontInfoList);
+                            getGlyph(worker, utf32[i], fontInfoList);
                         }
                     }
                     else
@@ -788,24 +951,22 @@ namespace djv
                         size_t i = 0;
                         for (; i < outSize; ++i)
                         {
-                            glyphs[i] = p.getGlyph(utf32[i], fontInfoList);
+                            glyphs[i] = getGlyph(worker, utf32[i], fontInfoList);
                         }
                         if (elided)
                         {
-                            glyphs[i] = p.getGlyph('.', fontInfoList);
-                            glyphs[i + 1] = p.getGlyph('.', fontInfoList);
-                            glyphs[i + 2] = p.getGlyph('.', fontInfoList);
+                            glyphs[i] = getGlyph(worker, '.', fontInfoList);
+                            glyphs[i + 1] = getGlyph(worker, '.', fontInfoList);
+                            glyphs[i + 2] = getGlyph(worker, '.', fontInfoList);
                         }
                         request.promise.set_value(std::move(glyphs));
                     }
                 }
-                p.glyphsRequests.clear();
+                worker.glyphsRequests.clear();
             }
 
-            void FontSystem::_handleTextLinesRequests()
+            void FontSystem::Private::handleTextLinesRequests(Worker& worker)
             {
-                DJV_PRIVATE_PTR();
-
                 // Input:
                 //   Speckled Dace are capable of |living in an array of habitats
                 //                                ^
@@ -821,10 +982,10 @@ namespace djv
                 //   "living in an array of"
                 //   "habitats"
 
-                for (auto& request : p.textLinesRequests)
+                for (auto& request : worker.textLinesRequests)
                 {
                     std::vector<TextLine> lines;
-                    if (FT_Face ftFace = p.getFace(request.fontInfo.getFamily(), request.fontInfo.getFace()))
+                    if (FT_Face ftFace = worker.getFace(request.fontInfo.getFamily(), request.fontInfo.getFace()))
                     {
                         /*FT_Error ftError = FT_Set_Char_Size(
                             ftFace->second,
@@ -840,27 +1001,27 @@ namespace djv
                         {
                             std::stringstream ss;
                             ss << "Error setting font size" << " '" << request.text << "': " << request.fontInfo.getSize();
-                            _log(ss.str(), System::LogLevel::Error);
+                            log(ss.str(), System::LogLevel::Error);
                         }
 
                         // Get the glyphs.
                         std::basic_string<djv_char_t> utf32;
                         try
                         {
-                            utf32 = p.utf32Convert.from_bytes(request.text);
+                            utf32 = worker.utf32Convert.from_bytes(request.text);
                         }
                         catch (const std::exception& e)
                         {
                             std::stringstream ss;
                             ss << "Error converting string" << " '" << request.text << "': " << e.what();
-                            _log(ss.str(), System::LogLevel::Error);
+                            log(ss.str(), System::LogLevel::Error);
                         }
                         const auto utf32Begin = utf32.begin();
                         std::vector<std::shared_ptr<Glyph> > glyphs(utf32.size());
-                        const auto fontInfoList = p.getFontInfoList(request.fontInfo);
+                        const auto fontInfoList = getFontInfoList(request.fontInfo);
                         for (auto i = utf32Begin; i != utf32.end(); ++i)
                         {
-                            glyphs[i - utf32Begin] = p.getGlyph(*i, fontInfoList);
+                            glyphs[i - utf32Begin] = getGlyph(worker, *i, fontInfoList);
                         }
 
                         glm::vec2 pos = glm::vec2(0.F, static_cast<float>(ftFace->size->metrics.height) / 64.F);
@@ -899,7 +1060,7 @@ namespace djv
                                     const size_t offset = lineBegin - utf32.begin();
                                     const size_t size = i - lineBegin;
                                     TextLine line;
-                                    line.text = p.utf32Convert.to_bytes(utf32.substr(offset, size));
+                                    line.text = worker.utf32Convert.to_bytes(utf32.substr(offset, size));
                                     line.size = glm::vec2(pos.x, static_cast<float>(ftFace->size->metrics.height) / 64.F);
                                     line.glyphs = std::vector<std::shared_ptr<Glyph> >(glyphs.begin() + offset, glyphs.begin() + offset + size);
                                     lines.push_back(line);
@@ -908,7 +1069,7 @@ namespace djv
                                 {
                                     std::stringstream ss;
                                     ss << "Error converting string" << " '" << request.text << "': " << e.what();
-                                    _log(ss.str(), System::LogLevel::Error);
+                                    log(ss.str(), System::LogLevel::Error);
                                 }
                                 pos.x = 0.F;
                                 pos.y += static_cast<float>(ftFace->size->metrics.height) / 64.F;
@@ -931,7 +1092,7 @@ namespace djv
                                         const size_t offset = lineBegin - utf32.begin();
                                         const size_t size = i - lineBegin;
                                         TextLine line;
-                                        line.text = p.utf32Convert.to_bytes(utf32.substr(offset, size));
+                                        line.text = worker.utf32Convert.to_bytes(utf32.substr(offset, size));
                                         line.size = glm::vec2(lineBreakPos, static_cast<float>(ftFace->size->metrics.height) / 64.F);
                                         line.glyphs = std::vector<std::shared_ptr<Glyph> >(glyphs.begin() + offset, glyphs.begin() + offset + size);
                                         lines.push_back(line);
@@ -940,7 +1101,7 @@ namespace djv
                                     {
                                         std::stringstream ss;
                                         ss << "Error converting string" << " '" << request.text << "': " << e.what();
-                                        _log(ss.str(), System::LogLevel::Error);
+                                        log(ss.str(), System::LogLevel::Error);
                                     }
                                     pos.x = 0.F;
                                     pos.y += static_cast<float>(ftFace->size->metrics.height / 64.F);
@@ -954,7 +1115,7 @@ namespace djv
                                         const size_t offset = lineBegin - utf32.begin();
                                         const size_t size = i - lineBegin;
                                         TextLine line;
-                                        line.text = p.utf32Convert.to_bytes(utf32.substr(offset, size));
+                                        line.text = worker.utf32Convert.to_bytes(utf32.substr(offset, size));
                                         line.size = glm::vec2(pos.x, static_cast<float>(ftFace->size->metrics.height) / 64.F);
                                         line.glyphs = std::vector<std::shared_ptr<Glyph> >(glyphs.begin() + offset, glyphs.begin() + offset + size);
                                         lines.push_back(line);
@@ -963,7 +1124,7 @@ namespace djv
                                     {
                                         std::stringstream ss;
                                         ss << "Error converting string" << " '" << request.text << "': " << e.what();
-                                        _log(ss.str(), System::LogLevel::Error);
+                                        log(ss.str(), System::LogLevel::Error);
                                     }
                                     pos.x = advance;
                                     pos.y += static_cast<float>(ftFace->size->metrics.height) / 64.F;
@@ -991,7 +1152,7 @@ namespace djv
                                 const size_t offset = lineBegin - utf32.begin();
                                 const size_t size = i - lineBegin;
                                 TextLine textLine;
-                                textLine.text = p.utf32Convert.to_bytes(utf32.substr(offset, size));
+                                textLine.text = worker.utf32Convert.to_bytes(utf32.substr(offset, size));
                                 textLine.size = glm::vec2(pos.x, static_cast<float>(ftFace->size->metrics.height) / 64.F);
                                 textLine.glyphs = std::vector<std::shared_ptr<Glyph> >(glyphs.begin() + offset, glyphs.begin() + offset + size);
                                 lines.push_back(textLine);
@@ -1000,13 +1161,13 @@ namespace djv
                             {
                                 std::stringstream ss;
                                 ss << "Error converting string" << " '" << request.text << "': " << e.what();
-                                _log(ss.str(), System::LogLevel::Error);
+                                log(ss.str(), System::LogLevel::Error);
                             }
                         }
                     }
                     request.promise.set_value(lines);
                 }
-                p.textLinesRequests.clear();
+                worker.textLinesRequests.clear();
             }
 
             std::vector<FontInfo> FontSystem::Private::getFontInfoList(const FontInfo& fontInfo) const
@@ -1020,94 +1181,95 @@ namespace djv
                 return out;
             }
 
-            FT_Face FontSystem::Private::getFace(FamilyID family, FaceID face) const
+            std::string FontSystem::Private::getFontCacheKey(const FontInfo& fontInfo) const
             {
-                FT_Face out = nullptr;
-                const auto i = fontFaces.find(family);
-                if (i != fontFaces.end())
+                std::string out;
+                for (const auto& i : fontFiles)
                 {
-                    const auto j = i->second.find(face);
-                    if (j != i->second.end())
+                    if (i.family == fontInfo.getFamily() && i.face == fontInfo.getFace())
                     {
-                        out = j->second;
+                        out = i.cacheKey;
+                        break;
                     }
                 }
                 return out;
             }
 
-            std::shared_ptr<Glyph> FontSystem::Private::getGlyph(uint32_t code, const std::vector<FontInfo>& fontInfoList)
+            std::shared_ptr<Glyph> FontSystem::Private::getGlyph(Worker& worker, uint32_t code, const std::vector<FontInfo>& fontInfoList)
             {
+                static const auto glyphCacheHitCounter = Core::Metrics::getCounter("djv::Render2D::Font::FontSystem::glyphCacheHits");
+                static const auto glyphCacheMissCounter = Core::Metrics::getCounter("djv::Render2D::Font::FontSystem::glyphCacheMisses");
+                static const auto glyphInFlightCounter = Core::Metrics::getCounter("djv::Render2D::Font::FontSystem::glyphInFlightWaits");
+                static const auto glyphDiskCacheHitCounter = Core::Metrics::getCounter("djv::Render2D::Font::FontSystem::glyphDiskCacheHits");
                 std::shared_ptr<Glyph> out;
                 for (const auto& fontInfo : fontInfoList)
                 {
-                    if (glyphCache.get(GlyphInfo(code, fontInfo), out))
+                    const GlyphInfo glyphInfo(code, fontInfo);
+                    if (glyphCache.get(glyphInfo, out))
                     {
+                        glyphCacheHitCounter->add();
                         break;
                     }
-                    else if (auto ftFace = getFace(fontInfo.getFamily(), fontInfo.getFace()))
+                    else if (auto ftFace = worker.getFace(fontInfo.getFamily(), fontInfo.getFace()))
                     {
                         if (auto ftGlyphIndex = FT_Get_Char_Index(ftFace, code))
                         {
-                            FT_Error ftError = FT_Set_Pixel_Sizes(
-                                ftFace,
-                                0,
-                                static_cast<int>(fontInfo.getSize()));
-                            if (ftError)
-                            {
-                                //std::cout << "FT_Set_Pixel_Sizes error: " << ftError << std::endl;
-                                return nullptr;
-                            }
-
-                            ftError = FT_Load_Glyph(ftFace, ftGlyphIndex, FT_LOAD_FORCE_AUTOHINT);
-                            if (ftError)
+                            // Wait if another thread is already rendering the glyph.
+                            std::promise<std::shared_ptr<Glyph> > promise;
+                            std::shared_future<std::shared_ptr<Glyph> > future;
                             {
-                                //std::cout << "FT_Load_Glyph error: " << ftError << std::endl;
-                                return nullptr;
-                            }
-                            FT_Render_Mode renderMode = FT_RENDER_MODE_NORMAL;
-                            uint8_t renderModeChannels = 1;
-                            if (lcdRenderingThread)
-                            {
-                                renderMode = FT_RENDER_MODE_LCD;
-                                renderModeChannels = 3;
+                                std::unique_lock<std::mutex> lock(inFlightGlyphsMutex);
+                                const auto i = inFlightGlyphs.find(glyphInfo);
+                                if (i != inFlightGlyphs.end())
+                                {
+                                    future = i->second;
+                                }
+                                else
+                                {
+                                    inFlightGlyphs[glyphInfo] = promise.get_future().share();
+                                }
                             }
-                            ftError = FT_Render_Glyph(ftFace->glyph, renderMode);
-                            if (ftError)
+                            if (future.valid())
                             {
-                                //std::cout << "FT_Render_Glyph error: " << ftError << std::endl;
-                                return nullptr;
+                                glyphInFlightCounter->add();
+                                out = future.get();
+                                break;
                             }
-                            FT_Glyph ftGlyph;
-                            ftError = FT_Get_Glyph(ftFace->glyph, &ftGlyph);
-                            if (ftError)
+
+                            // The glyph may have been added while the lock was not held.
+                            if (!glyphCache.get(glyphInfo, out))
                             {
-                                //std::cout << "FT_Get_Glyph error: " << ftError << std::endl;
-                                return nullptr;
+                                glyphCacheMissCounter->add();
+                                const size_t generation = glyphCacheGeneration;
+                                const bool lcd = lcdRendering;
+                                const std::string fontCacheKey = getFontCacheKey(fontInfo);
+                                out = glyphDiskCache->get(fontCacheKey, glyphInfo, lcd);
+                                if (out)
+                                {
+                                    glyphDiskCacheHitCounter->add();
+                                }
+                                else
+                                {
+                                    out = renderGlyph(ftFace, ftGlyphIndex, glyphInfo, lcd);
+                                    if (out)
+                                    {
+                                        glyphDiskCache->add(fontCacheKey, lcd, out);
+                                    }
+                                }
+                                if (out)
+                                {
+                                    glyphCache.add(glyphInfo, out);
+                                    if (generation != glyphCacheGeneration)
+                                    {
+                                        glyphCache.remove(glyphInfo);
+                                    }
+                                }
                             }
-                            FT_Vector v;
-                            v.x = 0;
-                            v.y = 0;
-                            ftError = FT_Glyph_To_Bitmap(&ftGlyph, renderMode, &v, 0);
-                            if (ftError)
+                            promise.set_value(out);
                             {
-                                //std::cout << "FT_Glyph_To_Bitmap error: " << ftError << std::endl;
-                                FT_Done_Glyph(ftGlyph);
-                                return nullptr;
+                                std::unique_lock<std::mutex> lock(inFlightGlyphsMutex);
+                                inFlightGlyphs.erase(glyphInfo);
                             }
-
-                            out = Glyph::create();
-                            out->glyphInfo = GlyphInfo(code, fontInfo);
-                            out->imageData = convert(reinterpret_cast<FT_BitmapGlyph>(ftGlyph)->bitmap, renderModeChannels);
-                            out->offset = glm::vec2(ftFace->glyph->bitmap_left, ftFace->glyph->bitmap_top);
-                            out->advance = static_cast<float>(ftFace->glyph->advance.x / 64.F);
-                            out->lsbDelta = ftFace->glyph->lsb_delta;
-                            out->rsbDelta = ftFace->glyph->rsb_delta;
-                            FT_Done_Glyph(ftGlyph);
-
-                            glyphCache.add(out->glyphInfo, out);
-                            glyphCacheSize = glyphCache.getSize();
-                            glyphCachePercentageUsed = glyphCache.getPercentageUsed();
-
                             break;
                         }
                     }
@@ -1115,7 +1277,72 @@ namespace djv
                 return out;
             }
 
+            std::shared_ptr<Glyph> FontSystem::Private::renderGlyph(
+                FT_Face ftFace,
+                FT_UInt ftGlyphIndex,
+                const GlyphInfo& glyphInfo,
+                bool lcdRendering)
+            {
+                FT_Error ftError = FT_Set_Pixel_Sizes(
+                    ftFace,
+                    0,
+                    static_cast<int>(glyphInfo.fontInfo.getSize()));
+                if (ftError)
+                {
+                    //std::cout << "FT_Set_Pixel_Sizes error: " << ftError << std::endl;
+                    return nullptr;
+                }
+
+                ftError = FT_Load_Glyph(ftFace, ftGlyphIndex, FT_LOAD_FORCE_AUTOHINT);
+                if (ftError)
+                {
+                    //std::cout << "FT_Load_Glyph error: " << ftError << std::endl;
+                    return nullptr;
+                }
+                FT_Render_Mode renderMode = FT_RENDER_MODE_NORMAL;
+                uint8_t renderModeChannels = 1;
+                if (lcdRendering)
+                {
+                    renderMode = FT_RENDER_MODE_LCD;
+                    renderModeChannels = 3;
+                }
+                ftError = FT_Render_Glyph(ftFace->glyph, renderMode);
+                if (ftError)
+                {
+                    //std::cout << "FT_Render_Glyph error: " << ftError << std::endl;
+                    return nullptr;
+                }
+                FT_Glyph ftGlyph;
+                ftError = FT_Get_Glyph(ftFace->glyph, &ftGlyph);
+                if (ftError)
+                {
+                    //std::cout << "FT_Get_Glyph error: " << ftError << std::endl;
+                    return nullptr;
+                }
+                FT_Vector v;
+                v.x = 0;
+                v.y = 0;
+                ftError = FT_Glyph_To_Bitmap(&ftGlyph, renderMode, &v, 0);
+                if (ftError)
+                {
+                    //std::cout << "FT_Glyph_To_Bitmap error: " << ftError << std::endl;
+                    FT_Done_Glyph(ftGlyph);
+                    return nullptr;
+                }
+
+                auto out = Glyph::create();
+                out->glyphInfo = glyphInfo;
+                out->imageData = convert(reinterpret_cast<FT_BitmapGlyph>(ftGlyph)->bitmap, renderModeChannels);
+                out->offset = glm::vec2(ftFace->glyph->bitmap_left, ftFace->glyph->bitmap_top);
+                out->advance = static_cast<float>(ftFace->glyph->advance.x / 64.F);
+                out->lsbDelta = ftFace->glyph->lsb_delta;
+                out->rsbDelta = ftFace->glyph->rsb_delta;
+                FT_Done_Glyph(ftGlyph);
+                return out;
+            }
+
             void FontSystem::Private::measure(
+                Worker& worker,
                 const std::basic_string<djv_char_t>& utf32,
                 const std::vector<FontInfo>& fontInfoList,
                 uint16_t maxLineWidth,
@@ -1125,7 +1352,7 @@ namespace djv
                 glm::vec2 pos(0.F, 0.F);
                 for (const auto& fontInfo : fontInfoList)
                 {
-                    if (auto ftFace = getFace(fontInfo.getFamily(), fontInfo.getFace()))
+                    if (auto ftFace = worker.getFace(fontInfo.getFamily(), fontInfo.getFace()))
                     {
                         /*FT_Error ftError = FT_Set_Char_Size(
                             ftFace->second,
@@ -1149,7 +1376,7 @@ namespace djv
                         int32_t rsbDeltaPrev = 0;
                         for (auto i = utf32.begin(); i != utf32.end(); ++i)
                         {
-                            const auto glyph = getGlyph(*i, fontInfoList);
+                            const auto glyph = getGlyph(worker, *i, fontInfoList);
                             if (glyph && glyphGeom)
                             {
                                 glyphGeom->push_back(Math::BBox2f(
@@ -54,6 +54,7 @@ namespace djv
                 FaceID   getFace() const noexcept;
                 uint16_t getSize() const noexcept;
                 uint16_t getDPI() const noexcept;
+                size_t   getHash() const noexcept;
 
                 bool operator == (const FontInfo&) const noexcept;
                 bool operator < (const FontInfo&) const noexcept;
@@ -131,6 +132,9 @@ namespace djv
 
             //! This class provides a font system.
             //!
+            //! Requests are handled by a pool of threads, each with its own
+            //! FreeType faces. The glyph cache is shared between the threads.
+            //!
             //! \todo Add support for gamma correction?
             //! - https://www.freetype.org/freetype2/docs/text-rendering-general.html
             class FontSystem : public System::ISystem
@@ -216,14 +220,6 @@ namespace djv
                 ///@}
             
             private:
-                void _initFreeType();
-                void _delFreeType();
-                void _handleMetricsRequests();
-                void _handleMeasureRequests();
-                void _handleTextLinesRequests();
-                void _handleMeasureGlyphsRequests();
-                void _handleGlyphsRequests();
-
                 DJV_PRIVATE();
             };
 
@@ -231,4 +227,20 @@ namespace djv
     } // namespace Render2D
 } // namespace djv
 
+namespace std
+{
+    template<>
+    struct hash<djv::Render2D::Font::FontInfo>
+    {
+        std::size_t operator() (const djv::Render2D::Font::FontInfo&) const noexcept;
+    };
+
+    template<>
+    struct hash<djv::Render2D::Font::GlyphInfo>
+    {
+        std::size_t operator() (const djv::Render2D::Font::GlyphInfo&) const noexcept;
+    };
+
+} // namespace std
+
 #include <djvRender2D/FontSystemInline.h>
@@ -3,6 +3,7 @@
 // All rights reserved.
 
 #include <djvCore/Memory.h>
+#include <djvCore/MemoryFunc.h>
 
 namespace djv
 {
@@ -30,6 +31,11 @@ namespace djv
                 return _dpi;
             }
 
+            inline size_t FontInfo::getHash() const noexcept
+            {
+                return _hash;
+            }
+
             inline bool FontInfo::operator == (const FontInfo& other) const noexcept
             {
                 return _hash == other._hash;
@@ -55,3 +61,19 @@ namespace djv
         } // namespace Font
     } // namespace Render2D
 } // namespace djv
+
+namespace std
+{
+    inline std::size_t hash<djv::Render2D::Font::FontInfo>::operator() (const djv::Render2D::Font::FontInfo& value) const noexcept
+    {
+        return value.getHash();
+    }
+
+    inline std::size_t hash<djv::Render2D::Font::GlyphInfo>::operator() (const djv::Render2D::Font::GlyphInfo& value) const noexcept
+    {
+        size_t hash = value.fontInfo.getHash();
+        djv::Core::Memory::hashCombine(hash, value.code);
+        return hash;
+    }
+
+} // namespace std
@@ -0,0 +1,560 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvRender2D/GlyphCache.h>
+
+#include <djvSystem/File.h>
+#include <djvSystem/FileIO.h>
+#include <djvSystem/FileInfo.h>
+
+#include <djvImage/Data.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace Render2D
+    {
+        namespace Font
+        {
+            namespace
+            {
+                const char     fileMagic[]   = "djvGlyphCache";
+                const uint32_t fileVersion   = 1;
+                const size_t   headerSize    = sizeof(fileMagic) + sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint64_t);
+
+                //! \todo Should this be configurable?
+                const size_t   glyphCacheMax = 16 * Memory::megabyte;
+
+                struct Entry
+                {
+                    uint64_t                     access   = 0;
+                    Image::Info                  info;
+                    glm::vec2                    offset   = glm::vec2(0.F, 0.F);
+                    uint16_t                     advance  = 0;
+                    int32_t                      lsbDelta = 0;
+                    int32_t                      rsbDelta = 0;
+
+                    //! The offset of the image data in the cache file, relative
+                    //! to the end of the index.
+                    uint64_t                     dataOffset = 0;
+
+                    //! Image data that has not been written to the cache file yet.
+                    std::shared_ptr<Image::Data> data;
+                };
+
+                std::string getKey(const std::string& fontKey, const GlyphInfo& glyphInfo, bool lcdRendering)
+                {
+                    std::stringstream ss;
+                    ss << fontKey << '@' << glyphInfo.fontInfo.getSize() << ':' << glyphInfo.fontInfo.getDPI() << ':' <<
+                        (lcdRendering ? 1 : 0) << ':' << glyphInfo.code;
+                    return ss.str();
+                }
+
+                //! The cache file is local to a machine so values are written
+                //! in the native byte order.
+                class Writer
+                {
+                public:
+                    explicit Writer(std::vector<uint8_t>& data) :
+                        _data(data)
+                    {}
+
+                    template<typename T>
+                    void write(T value)
+                    {
+                        write(&value, sizeof(T));
+                    }
+
+                    void write(const void* value, size_t byteCount)
+                    {
+                        const size_t size = _data.size();
+                        _data.resize(size + byteCount);
+                        if (byteCount)
+                        {
+                            memcpy(_data.data() + size, value, byteCount);
+                        }
+                    }
+
+                    void write(const std::string& value)
+                    {
+                        write(static_cast<uint32_t>(value.size()));
+                        write(value.data(), value.size());
+                    }
+
+                private:
+                    std::vector<uint8_t>& _data;
+                };
+
+                class Reader
+                {
+                public:
+                    Reader(const uint8_t* data, size_t size) :
+                        _p(data),
+                        _end(data + size)
+                    {}
+
+                    template<typename T>
+                    T read()
+                    {
+                        T out;
+                        memcpy(&out, read(sizeof(T)), sizeof(T));
+                        return out;
+                    }
+
+                    const uint8_t* read(size_t byteCount)
+                    {
+                        if (byteCount > static_cast<size_t>(_end - _p))
+                        {
+                            //! \todo How can we translate this?
+                            throw System::File::Error("Unexpected end of cache file.");
+                        }
+                        const uint8_t* out = _p;
+                        _p += byteCount;
+                        return out;
+                    }
+
+                    std::string readString()
+                    {
+                        const size_t size = read<uint32_t>();
+                        const uint8_t* p = read(size);
+                        return std::string(reinterpret_cast<const char*>(p), size);
+                    }
+
+                private:
+                    const uint8_t* _p   = nullptr;
+                    const uint8_t* _end = nullptr;
+                };
+
+                //! The cache file. Reads are serialized by the file mutex
+                //! instead of the cache mutex so that glyph look ups are not
+                //! blocked by file I/O.
+                struct CacheFile
+                {
+                    std::shared_ptr<System::File::IO> io;
+                    uint64_t                          dataStart = 0;
+                    std::mutex                        mutex;
+
+                    //! Throws:
+                    //! - System::File::Error
+                    void read(uint64_t dataOffset, void*, size_t byteCount);
+                };
+
+                void CacheFile::read(uint64_t dataOffset, void* out, size_t byteCount)
+                {
+#if defined(DJV_MMAP)
+                    const uint8_t* p = io->mmapStart() + dataStart + dataOffset;
+                    if (p + byteCount > io->mmapEnd())
+                    {
+                        //! \todo How can we translate this?
+                        throw System::File::Error("Unexpected end of cache file.");
+                    }
+                    memcpy(out, p, byteCount);
+#else // DJV_MMAP
+                    std::lock_guard<std::mutex> lock(mutex);
+                    io->setPos(dataStart + dataOffset);
+                    io->read(out, byteCount);
+#endif // DJV_MMAP
+                }
+
+                void renameFile(const std::string& tmp, const std::string& fileName)
+                {
+                    if (std::rename(tmp.c_str(), fileName.c_str()) != 0)
+                    {
+                        // Windows cannot rename over an existing file.
+                        std::remove(fileName.c_str());
+                        if (std::rename(tmp.c_str(), fileName.c_str()) != 0)
+                        {
+                            std::remove(tmp.c_str());
+                            //! \todo How can we translate this?
+                            throw System::File::Error(fileName + ": Cannot write.");
+                        }
+                    }
+                }
+
+            } // namespace
+
+            std::string getGlyphCacheFontKey(const System::File::Info& fileInfo)
+            {
+                std::stringstream ss;
+                ss << fileInfo.getFileName(Math::Frame::invalid, false) << ':' << fileInfo.getSize() << ':' <<
+                    static_cast<int64_t>(fileInfo.getTime());
+                return ss.str();
+            }
+
+            struct GlyphCache::Private
+            {
+                size_t max = glyphCacheMax;
+                std::map<std::string, Entry> entries;
+                size_t byteCount = 0;
+                uint64_t counter = 0;
+                std::shared_ptr<CacheFile> file;
+                bool dirty = false;
+                std::mutex mutex;
+
+                void remove(std::map<std::string, Entry>::iterator);
+                void maxUpdate();
+            };
+
+            void GlyphCache::Private::remove(std::map<std::string, Entry>::iterator i)
+            {
+                byteCount -= i->second.info.getDataByteCount();
+                entries.erase(i);
+                dirty = true;
+            }
+
+            void GlyphCache::Private::maxUpdate()
+            {
+                if (byteCount > max)
+                {
+                    // Remove the least recently used entries. Trim a little extra
+                    // so that this isn't run for every new entry.
+                    std::vector<std::pair<uint64_t, std::string> > sorted;
+                    for (const auto& i : entries)
+                    {
+                        sorted.push_back(std::make_pair(i.second.access, i.first));
+                    }
+                    std::sort(sorted.begin(), sorted.end());
+                    const size_t target = max - max / 10;
+                    for (size_t i = 0; i < sorted.size() && byteCount > target; ++i)
+                    {
+                        remove(entries.find(sorted[i].second));
+                    }
+                }
+            }
+
+            GlyphCache::GlyphCache() :
+                _p(new Private)
+            {}
+
+            GlyphCache::~GlyphCache()
+            {}
+
+            std::shared_ptr<GlyphCache> GlyphCache::create()
+            {
+                return std::shared_ptr<GlyphCache>(new GlyphCache);
+            }
+
+            size_t GlyphCache::getMax() const
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                return _p->max;
+            }
+
+            size_t GlyphCache::getCount() const
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                return _p->entries.size();
+            }
+
+            size_t GlyphCache::getByteCount() const
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                return _p->byteCount;
+            }
+
+            void GlyphCache::setMax(size_t value)
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                _p->max = value;
+                _p->maxUpdate();
+            }
+
+            std::shared_ptr<Glyph> GlyphCache::get(
+                const std::string& fontKey,
+                const GlyphInfo& glyphInfo,
+                bool lcdRendering) const
+            {
+                DJV_PRIVATE_PTR();
+                std::shared_ptr<Glyph> out;
+                const std::string key = getKey(fontKey, glyphInfo, lcdRendering);
+
+                // Copy the entry and the cache file so the image data can be
+                // read without holding the lock.
+                Entry entry;
+                std::shared_ptr<CacheFile> file;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    const auto i = p.entries.find(key);
+                    if (i == p.entries.end())
+                    {
+                        return out;
+                    }
+                    i->second.access = ++p.counter;
+                    entry = i->second;
+                    file = p.file;
+                }
+                std::shared_ptr<Image::Data> data = entry.data;
+                if (!data && file)
+                {
+                    try
+                    {
+                        data = Image::Data::create(entry.info);
+                        file->read(entry.dataOffset, data->getData(), data->getDataByteCount());
+                    }
+                    catch (const std::exception&)
+                    {
+                        // Only remove the entry if it has not been replaced
+                        // or rewritten in the meantime.
+                        std::lock_guard<std::mutex> lock(p.mutex);
+                        const auto i = p.entries.find(key);
+                        if (i != p.entries.end() &&
+                            !i->second.data &&
+                            p.file == file &&
+                            i->second.dataOffset == entry.dataOffset)
+                        {
+                            p.remove(i);
+                        }
+                        return out;
+                    }
+                }
+                if (data)
+                {
+                    out = Glyph::create();
+                    out->glyphInfo = glyphInfo;
+                    out->imageData = data;
+                    out->offset = entry.offset;
+                    out->advance = entry.advance;
+                    out->lsbDelta = entry.lsbDelta;
+                    out->rsbDelta = entry.rsbDelta;
+                }
+                return out;
+            }
+
+            void GlyphCache::add(
+                const std::string& fontKey,
+                bool lcdRendering,
+                const std::shared_ptr<Glyph>& glyph)
+            {
+                DJV_PRIVATE_PTR();
+                if (!glyph || !glyph->imageData || glyph->imageData->getDataByteCount() > p.max)
+                {
+                    return;
+                }
+                Entry entry;
+                entry.info = glyph->imageData->getInfo();
+                entry.offset = glyph->offset;
+                entry.advance = glyph->advance;
+                entry.lsbDelta = glyph->lsbDelta;
+                entry.rsbDelta = glyph->rsbDelta;
+                entry.data = glyph->imageData;
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const std::string key = getKey(fontKey, glyph->glyphInfo, lcdRendering);
+                const auto i = p.entries.find(key);
+                if (i != p.entries.end())
+                {
+                    p.remove(i);
+                }
+                entry.access = ++p.counter;
+                p.byteCount += entry.info.getDataByteCount();
+                p.entries[key] = std::move(entry);
+                p.dirty = true;
+                p.maxUpdate();
+            }
+
+            void GlyphCache::clear()
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.entries.clear();
+                p.byteCount = 0;
+                p.dirty = true;
+            }
+
+            void GlyphCache::read(const std::string& fileName)
+            {
+                DJV_PRIVATE_PTR();
+                if (!System::File::Info(fileName).doesExist())
+                {
+                    return;
+                }
+                auto io = System::File::IO::create();
+                io->open(fileName, System::File::Mode::Read);
+                std::map<std::string, Entry> entries;
+                size_t byteCount = 0;
+                uint64_t counter = 0;
+                uint64_t dataStart = 0;
+                try
+                {
+                    // Read the header.
+                    std::vector<uint8_t> header(headerSize);
+                    io->read(header.data(), header.size());
+                    Reader headerReader(header.data(), header.size());
+                    if (memcmp(headerReader.read(sizeof(fileMagic)), fileMagic, sizeof(fileMagic)) != 0 ||
+                        headerReader.read<uint32_t>() != fileVersion)
+                    {
+                        return;
+                    }
+                    counter = headerReader.read<uint64_t>();
+                    const uint64_t indexByteCount = headerReader.read<uint64_t>();
+                    if (headerSize + indexByteCount > io->getSize())
+                    {
+                        return;
+                    }
+                    dataStart = headerSize + indexByteCount;
+                    const uint64_t dataByteCount = io->getSize() - dataStart;
+
+                    // Read the index.
+                    std::vector<uint8_t> index(indexByteCount);
+                    io->read(index.data(), index.size());
+                    Reader reader(index.data(), index.size());
+                    const uint32_t count = reader.read<uint32_t>();
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        const std::string key = reader.readString();
+                        Entry entry;
+                        entry.access = reader.read<uint64_t>();
+                        const uint16_t w = reader.read<uint16_t>();
+                        const uint16_t h = reader.read<uint16_t>();
+                        const uint8_t type = reader.read<uint8_t>();
+                        entry.offset.x = reader.read<float>();
+                        entry.offset.y = reader.read<float>();
+                        entry.advance = reader.read<uint16_t>();
+                        entry.lsbDelta = reader.read<int32_t>();
+                        entry.rsbDelta = reader.read<int32_t>();
+                        entry.dataOffset = reader.read<uint64_t>();
+                        if (type < static_cast<uint8_t>(Image::Type::Count))
+                        {
+                            entry.info = Image::Info(w, h, static_cast<Image::Type>(type));
+                            const size_t size = entry.info.getDataByteCount();
+                            if (entry.dataOffset + size <= dataByteCount)
+                            {
+                                byteCount += size;
+                                entries[key] = std::move(entry);
+                            }
+                        }
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    // Ignore corrupt cache files.
+                    return;
+                }
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.entries = std::move(entries);
+                p.byteCount = byteCount;
+                p.counter = counter;
+                p.file = std::make_shared<CacheFile>();
+                p.file->io = io;
+                p.file->dataStart = dataStart;
+                p.dirty = false;
+                p.maxUpdate();
+            }
+
+            void GlyphCache::write(const std::string& fileName)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+
+                // Remove entries that can no longer be read and assign the
+                // data offsets.
+                uint64_t dataOffset = 0;
+                auto i = p.entries.begin();
+                while (i != p.entries.end())
+                {
+                    const size_t size = i->second.info.getDataByteCount();
+                    if (!i->second.data)
+                    {
+                        if (!p.file)
+                        {
+                            p.byteCount -= size;
+                            i = p.entries.erase(i);
+                            continue;
+                        }
+                        auto imageData = Image::Data::create(i->second.info);
+                        try
+                        {
+                            p.file->read(i->second.dataOffset, imageData->getData(), size);
+                        }
+                        catch (const std::exception&)
+                        {
+                            p.byteCount -= size;
+                            i = p.entries.erase(i);
+                            continue;
+                        }
+                        i->second.data = imageData;
+                    }
+                    i->second.dataOffset = dataOffset;
+                    dataOffset += size;
+                    ++i;
+                }
+
+                // Write the index.
+                std::vector<uint8_t> index;
+                Writer indexWriter(index);
+                indexWriter.write(static_cast<uint32_t>(p.entries.size()));
+                for (const auto& i : p.entries)
+                {
+                    indexWriter.write(i.first);
+                    indexWriter.write(static_cast<uint64_t>(i.second.access));
+                    indexWriter.write(static_cast<uint16_t>(i.second.info.size.w));
+                    indexWriter.write(static_cast<uint16_t>(i.second.info.size.h));
+                    indexWriter.write(static_cast<uint8_t>(i.second.info.type));
+                    indexWriter.write(static_cast<float>(i.second.offset.x));
+                    indexWriter.write(static_cast<float>(i.second.offset.y));
+                    indexWriter.write(static_cast<uint16_t>(i.second.advance));
+                    indexWriter.write(static_cast<int32_t>(i.second.lsbDelta));
+                    indexWriter.write(static_cast<int32_t>(i.second.rsbDelta));
+                    indexWriter.write(static_cast<uint64_t>(i.second.dataOffset));
+                }
+                std::vector<uint8_t> header;
+                Writer headerWriter(header);
+                headerWriter.write(fileMagic, sizeof(fileMagic));
+                headerWriter.write(fileVersion);
+                headerWriter.write(static_cast<uint64_t>(p.counter));
+                headerWriter.write(static_cast<uint64_t>(index.size()));
+
+                // Write to a temporary file first and then rename it so that
+                // other processes never read a partially written file.
+                const std::string tmp = fileName + "." +
+                    std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".tmp";
+                try
+                {
+                    auto io = System::File::IO::create();
+                    io->open(tmp, System::File::Mode::Write);
+                    io->write(header.data(), header.size());
+                    io->write(index.data(), index.size());
+                    for (const auto& i : p.entries)
+                    {
+                        io->write(i.second.data->getData(), i.second.data->getDataByteCount());
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    std::remove(tmp.c_str());
+                    throw;
+                }
+                p.file.reset();
+                renameFile(tmp, fileName);
+
+                // Switch to the new file and release the image data.
+                auto io = System::File::IO::create();
+                io->open(fileName, System::File::Mode::Read);
+                p.file = std::make_shared<CacheFile>();
+                p.file->io = io;
+                p.file->dataStart = header.size() + index.size();
+                for (auto& i : p.entries)
+                {
+                    i.second.data.reset();
+                }
+                p.dirty = false;
+            }
+
+            bool GlyphCache::isDirty() const
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                return _p->dirty;
+            }
+
+        } // namespace Font
+    } // namespace Render2D
+} // namespace djv
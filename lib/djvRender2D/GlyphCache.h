@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvRender2D/FontSystem.h>
+
+#include <memory>
+#include <string>
+
+namespace djv
+{
+    namespace System
+    {
+        namespace File
+        {
+            class Info;
+
+        } // namespace File
+    } // namespace System
+
+    namespace Render2D
+    {
+        namespace Font
+        {
+            //! This constant provides the default glyph cache file name.
+            const std::string glyphCacheFileName = "djvGlyphCache";
+
+            //! Get the key used to identify a font file in the glyph cache.
+            //! The key is made from the file name, size, and modification
+            //! time so that glyphs are not used when a font file changes.
+            std::string getGlyphCacheFontKey(const System::File::Info&);
+
+            //! This class provides a persistent cache of rendered glyphs.
+            //!
+            //! Font family and face IDs are assigned when the fonts are loaded
+            //! so they are not stable between runs. Instead entries are keyed
+            //! by the font key (see getGlyphCacheFontKey()), glyph code, font
+            //! size, DPI, and whether LCD rendering is enabled.
+            //!
+            //! The cache is stored in a single file containing an index and
+            //! the glyph image data. The index is read on startup and the image
+            //! data is read from the (memory-mapped) file on demand. New glyphs
+            //! are kept in memory until the cache is written, at which point a
+            //! new file is written and renamed over the old one.
+            class GlyphCache
+            {
+                DJV_NON_COPYABLE(GlyphCache);
+
+            protected:
+                GlyphCache();
+
+            public:
+                ~GlyphCache();
+
+                //! Create a new glyph cache.
+                static std::shared_ptr<GlyphCache> create();
+
+                //! \name Size
+                ///@{
+
+                //! Get the maximum byte count.
+                size_t getMax() const;
+
+                size_t getCount() const;
+                size_t getByteCount() const;
+
+                //! Set the maximum byte count.
+                void setMax(size_t);
+
+                ///@}
+
+                //! \name Contents
+                ///@{
+
+                //! Get a glyph. Returns a null pointer if the glyph is not in
+                //! the cache. The glyph information of the returned glyph is
+                //! set from the given glyph information.
+                std::shared_ptr<Glyph> get(
+                    const std::string& fontKey,
+                    const GlyphInfo&,
+                    bool lcdRendering) const;
+
+                void add(
+                    const std::string& fontKey,
+                    bool lcdRendering,
+                    const std::shared_ptr<Glyph>&);
+                void clear();
+
+                ///@}
+
+                //! \name Persistence
+                ///@{
+
+                //! Read the cache index and open the cache file. Invalid or
+                //! incompatible cache files are ignored.
+                //! Throws:
+                //! - System::File::Error
+                void read(const std::string& fileName);
+
+                //! Write the cache file.
+                //! Throws:
+                //! - System::File::Error
+                void write(const std::string& fileName);
+
+                //! Get whether the cache has changed since it was last read or
+                //! written.
+                bool isDirty() const;
+
+                ///@}
+
+            private:
+                DJV_PRIVATE();
+            };
+
+        } // namespace Font
+    } // namespace Render2D
+} // namespace djv
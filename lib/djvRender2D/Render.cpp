@@ -29,6 +29,7 @@
 #include <djvMath/Range.h>
 
 #include <djvCore/Cache.h>
+#include <djvCore/TraceFunc.h>
 
 #include <OpenColorIO/OpenColorIO.h>
 
@@ -1279,7 +1280,10 @@ namespace djv
                         {
                             texture = GL::Texture::create(image->getInfo(), GL_LINEAR, GL_NEAREST);
                         }
-                        texture->copy(*image);
+                        {
+                            DJV_TRACE("djv::Render2D::Render::drawImage upload");
+                            texture->copy(*image);
+                        }
                         dynamicTextureCache[uid] = texture;
                         primitive->textureID = texture->getID();
                     }
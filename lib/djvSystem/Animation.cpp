@@ -155,6 +155,25 @@ namespace djv
                 }
             }
 
+            bool AnimationSystem::hasActive() const
+            {
+                DJV_PRIVATE_PTR();
+                for (const auto* i : { &p.animations, &p.newAnimations })
+                {
+                    for (const auto& j : *i)
+                    {
+                        if (auto animation = j.lock())
+                        {
+                            if (animation->isActive())
+                            {
+                                return true;
+                            }
+                        }
+                    }
+                }
+                return false;
+            }
+
             void AnimationSystem::_addAnimation(const std::weak_ptr<Animation>& value)
             {
                 _p->newAnimations.push_back(value);
@@ -4,6 +4,7 @@
 
 #include <djvSystem/Context.h>
 
+#include <djvSystem/Animation.h>
 #include <djvSystem/CoreSystem.h>
 #include <djvSystem/FileIOFunc.h>
 #include <djvSystem/IObject.h>
@@ -14,7 +15,9 @@
 #include <djvSystem/TimerFunc.h>
 
 #include <djvCore/MemoryFunc.h>
+#include <djvCore/MetricsFunc.h>
 #include <djvCore/OSFunc.h>
+#include <djvCore/Observer.h>
 #include <djvCore/Time.h>
 
 #include <iostream>
@@ -173,11 +176,23 @@ namespace djv
 
             _calcFPS();
 
+            static const auto tickTimeHistogram = Metrics::getHistogram("djv::System::Context::tickTime");
             const bool doStats = 0 == _tickCount % statsRate;
             TickTimes tickTimes;
-            auto start = std::chrono::steady_clock::now();
-            for (const auto& system : _systems)
+            const auto tickStart = std::chrono::steady_clock::now();
+            auto start = tickStart;
+
+            // Notify the observers of subjects that changed since the last
+            // tick.
+            Observer::flushPending();
+
+            // Systems may be created while ticking (for example the GLFW
+            // system is created on demand), so only tick the systems that
+            // existed at the start; new systems are ticked from the next tick.
+            const size_t systemsCount = _systems.size();
+            for (size_t i = 0; i < systemsCount && i < _systems.size(); ++i)
             {
+                const auto system = _systems[i];
                 system->tick();
                 
                 if (doStats)
@@ -195,10 +210,62 @@ namespace djv
                 //tickTimes.print();
                 _systemTickTimes = tickTimes.times;
             }
+            tickTimeHistogram->record(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - tickStart).count());
             
             ++_tickCount;
         }
 
+        void Context::requestTick()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_tickMutex);
+                _tickRequested = true;
+            }
+            _tickCV.notify_one();
+        }
+
+        bool Context::waitForTick(const Time::TimePoint& value)
+        {
+            std::unique_lock<std::mutex> lock(_tickMutex);
+            if (Time::TimePoint::max() == value)
+            {
+                _tickCV.wait(
+                    lock,
+                    [this]
+                    {
+                        return _tickRequested;
+                    });
+            }
+            else
+            {
+                _tickCV.wait_until(
+                    lock,
+                    value,
+                    [this]
+                    {
+                        return _tickRequested;
+                    });
+            }
+            const bool out = _tickRequested;
+            _tickRequested = false;
+            return out;
+        }
+
+        bool Context::getNextTickTime(Time::TimePoint& value) const
+        {
+            bool out = _timerSystem->getNextTimeout(value);
+            if (auto animationSystem = getSystemT<Animation::AnimationSystem>())
+            {
+                if (animationSystem->hasActive())
+                {
+                    value = std::chrono::steady_clock::now();
+                    out = true;
+                }
+            }
+            return out;
+        }
+
         void Context::_addSystem(const std::shared_ptr<ISystemBase>& system)
         {
             _systems.push_back(system);
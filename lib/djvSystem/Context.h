@@ -7,8 +7,10 @@
 #include <djvCore/Time.h>
 
 #include <chrono>
+#include <condition_variable>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -73,6 +75,18 @@ namespace djv
             //! This function is called by the application event loop.
             virtual void tick();
 
+            //! Request a tick. This function is thread safe, it wakes the
+            //! application event loop when it is waiting.
+            void requestTick();
+
+            //! Wait until a tick is requested or the deadline is reached.
+            //! Returns true if a tick was requested.
+            bool waitForTick(const Core::Time::TimePoint&);
+
+            //! Get the time when the next tick is needed for the active
+            //! timers and animations. Returns false if nothing is active.
+            bool getNextTickTime(Core::Time::TimePoint&) const;
+
             //! Get the average tick FPS.
             float getFPSAverage() const;
 
@@ -104,6 +118,9 @@ namespace djv
             float _fpsAverage = 0.F;
             std::shared_ptr<Timer> _fpsTimer;
             int _debugEnv = 0;
+            std::mutex _tickMutex;
+            std::condition_variable _tickCV;
+            bool _tickRequested = false;
 
             friend class ISystemBase;
         };
@@ -6,9 +6,11 @@
 
 #include <djvSystem/DirectoryWatcher.h>
 #include <djvSystem/FileInfoFunc.h>
+#include <djvSystem/FileInfoPrivate.h>
 #include <djvSystem/TimerFunc.h>
 #include <djvSystem/PathFunc.h>
 
+#include <djvCore/Cache.h>
 #include <djvCore/OS.h>
 
 #include <future>
@@ -21,6 +23,26 @@ namespace djv
     {
         namespace File
         {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const size_t cacheMax = 10;
+
+                typedef std::pair<std::vector<Info>, std::vector<std::string> > Listing;
+
+                std::vector<std::string> getFileNames(const std::vector<Info>& value)
+                {
+                    std::vector<std::string> out;
+                    out.reserve(value.size());
+                    for (const auto& info : value)
+                    {
+                        out.push_back(info.getFileName(-1, false));
+                    }
+                    return out;
+                }
+
+            } // namespace
+
             struct DirectoryModel::Private
             {
                 std::shared_ptr<Observer::ValueSubject<Path> > path;
@@ -33,8 +55,13 @@ namespace djv
                 std::shared_ptr<Observer::ValueSubject<bool> > hasBack;
                 std::shared_ptr<Observer::ValueSubject<bool> > hasForward;
                 std::shared_ptr<Observer::ValueSubject<DirectoryListOptions> > options;
-                std::future<std::pair<std::vector<Info>, std::vector<std::string> > > future;
+                Path listPath;
+                std::future<Listing> future;
                 std::shared_ptr<Timer> futureTimer;
+                bool reloadPending = false;
+                std::vector<DirectoryChange> changes;
+                std::shared_ptr<FrameSizes> frameSizes;
+                Memory::Cache<std::string, std::shared_ptr<Listing> > cache;
                 std::shared_ptr<DirectoryWatcher> directoryWatcher;
             };
 
@@ -54,15 +81,17 @@ namespace djv
                 p.futureTimer = Timer::create(context);
                 p.futureTimer->setRepeating(true);
 
+                p.cache.setMax(cacheMax);
+
                 p.directoryWatcher = DirectoryWatcher::create(context);
 
                 auto weak = std::weak_ptr<DirectoryModel>(shared_from_this());
-                p.directoryWatcher->setCallback(
-                    [weak]
+                p.directoryWatcher->setChangesCallback(
+                    [weak](const std::vector<DirectoryChange>& value)
                 {
                     if (auto model = weak.lock())
                     {
-                        model->reload();
+                        model->_changesUpdate(value);
                     }
                 });
             }
@@ -230,28 +259,95 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 if (_p->options->setIfChanged(value))
                 {
+                    p.cache.clear();
                     _pathUpdate();
                 }
             }
 
             void DirectoryModel::_pathUpdate()
+            {
+                DJV_PRIVATE_PTR();
+                const Path path = p.path->get();
+
+                // Show the cached listing while the directory is listed again.
+                std::shared_ptr<Listing> cached;
+                if (p.cache.get(path.get(), cached))
+                {
+                    p.info->setIfChanged(cached->first);
+                    p.fileNames->setIfChanged(cached->second);
+                }
+
+                _listStart();
+
+                p.directoryWatcher->setPath(path);
+            }
+
+            void DirectoryModel::_listStart()
+            {
+                DJV_PRIVATE_PTR();
+                const Path path = p.path->get();
+                const auto options = p.options->get();
+                p.listPath = path;
+                p.reloadPending = false;
+                p.changes.clear();
+                p.frameSizes = std::make_shared<FrameSizes>();
+                const auto frameSizes = p.frameSizes;
+                p.future = std::async(
+                    std::launch::async,
+                    [path, options, frameSizes]
+                {
+                    // Keep the sizes of the sequence frames so that changes
+                    // to the frames don't need the whole sequence stat'ed.
+                    Listing out;
+                    out.first = directoryList(path, options, frameSizes.get());
+                    out.second = getFileNames(out.first);
+                    return out;
+                });
+                _futureWait();
+            }
+
+            void DirectoryModel::_updateStart()
             {
                 DJV_PRIVATE_PTR();
                 const Path path = p.path->get();
                 const auto options = p.options->get();
+                const auto info = p.info->get();
+                const auto changes = std::move(p.changes);
+                p.changes.clear();
+                const auto frameSizes = p.frameSizes;
+                p.listPath = path;
                 p.future = std::async(
                     std::launch::async,
-                    [path, options]
+                    [path, options, info, changes, frameSizes]
                 {
-                    std::pair<std::vector<Info>, std::vector<std::string> > out;
-                    out.first = directoryList(path, options);
-                    for (const auto& info : out.first)
+                    DirectoryListUpdater updater(path, options, info, *frameSizes);
+                    for (const auto& i : changes)
                     {
-                        out.second.push_back(info.getFileName(-1, false));
+                        switch (i.type)
+                        {
+                        case DirectoryChangeType::Added:    updater.add(i.fileName, i.directory); break;
+                        case DirectoryChangeType::Removed:  updater.remove(i.fileName); break;
+                        case DirectoryChangeType::Modified: updater.modify(i.fileName); break;
+                        default: break;
+                        }
                     }
+                    Listing out;
+                    out.first = updater.get();
+                    out.second = getFileNames(out.first);
                     return out;
                 });
+                _futureWait();
+            }
 
+            void DirectoryModel::_futureWait()
+            {
+                // Don't restart the timer if it is already active, this may be
+                // called from the timer callback.
+                DJV_PRIVATE_PTR();
+                if (p.futureTimer->isActive())
+                {
+                    return;
+                }
                 p.futureTimer->start(
                     getTimerDuration(TimerValue::Medium),
                     [this](const std::chrono::steady_clock::time_point&, const Time::Duration&)
@@ -260,15 +356,55 @@ namespace djv
                     if (p.future.valid() &&
                         p.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                     {
-                        p.futureTimer->stop();
-
-                        const auto& out = p.future.get();
-                        p.info->setIfChanged(out.first);
-                        p.fileNames->setIfChanged(out.second);
+                        auto out = std::make_shared<Listing>(p.future.get());
+                        p.info->setIfChanged(out->first);
+                        p.fileNames->setIfChanged(out->second);
+                        p.cache.add(p.listPath.get(), out);
+
+                        // List the directory again, or apply the changes, if
+                        // it changed while it was being listed.
+                        if (p.reloadPending)
+                        {
+                            _listStart();
+                        }
+                        else if (!p.changes.empty())
+                        {
+                            _updateStart();
+                        }
+                        else
+                        {
+                            p.futureTimer->stop();
+                        }
                     }
                 });
+            }
 
-                p.directoryWatcher->setPath(p.path->get());
+            void DirectoryModel::_changesUpdate(const std::vector<DirectoryChange>& changes)
+            {
+                // The changes are applied with a future since getting the
+                // file system information can take a while, for example when
+                // a file sequence is being written.
+                DJV_PRIVATE_PTR();
+                if (changes.empty() || p.changes.size() + changes.size() > directoryChangesMax)
+                {
+                    if (p.future.valid())
+                    {
+                        p.reloadPending = true;
+                        p.changes.clear();
+                    }
+                    else
+                    {
+                        _pathUpdate();
+                    }
+                }
+                else if (!p.reloadPending)
+                {
+                    p.changes.insert(p.changes.end(), changes.begin(), changes.end());
+                    if (!p.future.valid())
+                    {
+                        _updateStart();
+                    }
+                }
             }
 
         } // namespace File
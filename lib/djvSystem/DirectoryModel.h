@@ -17,7 +17,15 @@ namespace djv
 
         namespace File
         {
+            struct DirectoryChange;
+
             //! This class provides a directory model.
+            //!
+            //! Changes to the directory are applied to the listing as they
+            //! occur, without listing the directory again. Recent listings are
+            //! cached so that they can be shown immediately when navigating
+            //! back to a directory, while the directory is listed again in
+            //! the background.
             class DirectoryModel : public std::enable_shared_from_this<DirectoryModel>
             {
                 DJV_NON_COPYABLE(DirectoryModel);
@@ -85,6 +93,10 @@ namespace djv
 
             private:
                 void _pathUpdate();
+                void _listStart();
+                void _updateStart();
+                void _futureWait();
+                void _changesUpdate(const std::vector<DirectoryChange>&);
 
                 DJV_PRIVATE();
             };
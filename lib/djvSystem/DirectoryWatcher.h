@@ -8,6 +8,8 @@
 
 #include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace djv
 {
@@ -19,6 +21,28 @@ namespace djv
         {
             class Path;
 
+            //! This enumeration provides the types of directory changes.
+            enum class DirectoryChangeType
+            {
+                Added,
+                Removed,
+                Modified
+            };
+
+            //! This struct provides a change to a file in a directory.
+            struct DirectoryChange
+            {
+                DirectoryChangeType type        = DirectoryChangeType::Modified;
+                std::string         fileName;
+                bool                directory   = false;
+            };
+
+            //! The maximum number of pending directory changes. When there are
+            //! more changes than this the directory is listed again instead.
+            //!
+            //! \todo Should this be configurable?
+            const size_t directoryChangesMax = 1000;
+
             //! This class provides functionality for watching directory changes.
             //!
             //! \bug What do we do about changes to the directory path (like deletion or moving)?
@@ -45,8 +69,17 @@ namespace djv
                 //! \name Callback
                 ///@{
 
+                //! Set a callback that is called when the directory changes.
                 void setCallback(const std::function<void(void)>&);
 
+                //! Set a callback that is given the changes to the files in
+                //! the directory, in the order they occurred. The changes are
+                //! empty when they are not available, for example when the
+                //! platform only reports that the directory has changed or
+                //! too many changes occurred; in that case the directory
+                //! should be listed again.
+                void setChangesCallback(const std::function<void(const std::vector<DirectoryChange>&)>&);
+
                 ///!@}
 
             private:
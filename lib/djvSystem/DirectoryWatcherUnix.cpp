@@ -8,7 +8,6 @@
 #include <djvSystem/Path.h>
 #include <djvSystem/TimerFunc.h>
 
-#include <ctime>
 #include <mutex>
 #include <thread>
 
@@ -66,18 +65,19 @@ namespace djv
                         }
                     }
                                         
-                    ::time_t poll()
+                    //! The kqueue events do not include the file names, so
+                    //! only a reload is requested.
+                    void poll(std::vector<DirectoryChange>&, bool& reload)
                     {
                         struct kevent eventData[1];
                         timespec _timeout;
                         _timeout.tv_sec = 0;
                         _timeout.tv_nsec = getTimerValue(TimerValue::Medium) * 1000000;
                         int eventCount = ::kevent(_kq, _eventsToMonitor, 1, eventData, 1, &_timeout);
-                        if (eventCount)
+                        if (eventCount > 0)
                         {
-                            _lastModified = time(nullptr);
+                            reload = true;
                         }
-                        return _lastModified;
                     }
                     
                 private:
@@ -85,7 +85,6 @@ namespace djv
                     int _kq = 0;
                     int _fd = 0;
                     struct kevent _eventsToMonitor[1];
-                    ::time_t _lastModified = 0;
                 };
 
 #else // DJV_PLATFORM_MACOS
@@ -99,15 +98,19 @@ namespace djv
                         _fd = ::inotify_init1(IN_NONBLOCK);
                         if (_fd)
                         {
-                            _wd = ::inotify_add_watch(_fd, _path.get().c_str(), IN_CREATE | IN_DELETE | IN_MODIFY | IN_ATTRIB);
+                            _wd = ::inotify_add_watch(
+                                _fd,
+                                _path.get().c_str(),
+                                IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+                                IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB |
+                                IN_DELETE_SELF | IN_MOVE_SELF);
                         }
                     }
 
                     Notify(Notify&& other) noexcept :
                         _path(other._path),
                         _fd(other._fd),
-                        _wd(other._wd),
-                        _lastModified(other._lastModified)
+                        _wd(other._wd)
                     {}
                     
                     ~Notify()
@@ -131,43 +134,67 @@ namespace djv
                             _path = other._path;
                             _fd = other._fd;
                             _wd = other._wd;
-                            _lastModified = other._lastModified;
                         }
                         return *this;
                     }
                                         
-                    ::time_t poll()
+                    void poll(std::vector<DirectoryChange>& changes, bool& reload)
                     {
                         if (_fd && _wd)
                         {
                             static const size_t bufferSize = 1024 * (sizeof(::inotify_event) + 16);
-                            char buffer[bufferSize];
-                            const int length = ::read(_fd, buffer, bufferSize);
-                            int i = 0;
-                            while (i < length)
+                            alignas(::inotify_event) char buffer[bufferSize];
+                            int length = 0;
+                            while ((length = ::read(_fd, buffer, bufferSize)) > 0)
                             {
-                                ::inotify_event* event = (::inotify_event*)&buffer[i];
-                                if (event->len)
+                                int i = 0;
+                                while (i < length)
                                 {
-                                    if (event->mask & IN_CREATE ||
-                                        event->mask & IN_DELETE ||
-                                        event->mask & IN_MODIFY)
+                                    const ::inotify_event* event = (const ::inotify_event*)&buffer[i];
+                                    if (event->mask & (IN_Q_OVERFLOW | IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED))
                                     {
-                                        _lastModified = time(nullptr);
-                                        break;
+                                        // Events were lost or the directory
+                                        // itself changed.
+                                        reload = true;
                                     }
+                                    else if (event->len)
+                                    {
+                                        DirectoryChange change;
+                                        change.fileName = event->name;
+                                        change.directory = (event->mask & IN_ISDIR) != 0;
+                                        if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                                        {
+                                            change.type = DirectoryChangeType::Added;
+                                            changes.push_back(change);
+                                        }
+                                        else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+                                        {
+                                            change.type = DirectoryChangeType::Removed;
+                                            changes.push_back(change);
+                                        }
+                                        else if (event->mask & (IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB))
+                                        {
+                                            // Consecutive modifications to the
+                                            // same file are combined.
+                                            change.type = DirectoryChangeType::Modified;
+                                            if (changes.empty() ||
+                                                changes.back().type != change.type ||
+                                                changes.back().fileName != change.fileName)
+                                            {
+                                                changes.push_back(change);
+                                            }
+                                        }
+                                    }
+                                    i += sizeof(::inotify_event) + event->len;
                                 }
-                                i += sizeof(::inotify_event) + event->len;
                             }
                         }
-                        return _lastModified;
                     }
                     
                 private:
                     Path _path;
                     int _fd = 0;
                     int _wd = 0;
-                    ::time_t _lastModified = 0;
                 };
 #endif // DJV_PLATFORM_MACOS
 
@@ -179,10 +206,12 @@ namespace djv
                 bool running = false;
                 std::thread thread;
                 std::timed_mutex mutex;
-                ::time_t lastModified = 0;
-                ::time_t threadModified = 0;
+                bool changed = false;
+                std::vector<DirectoryChange> changes;
+                bool reload = false;
                 std::shared_ptr<Timer> timer;
                 std::function<void(void)> callback;
+                std::function<void(const std::vector<DirectoryChange>&)> changesCallback;
             };
 
             void DirectoryWatcher::_init(const std::shared_ptr<Context>& context)
@@ -197,7 +226,8 @@ namespace djv
                     Path path;
                     bool pathInit = false;
                     std::unique_ptr<Notify> notify;
-                    ::time_t lastModified = 0;                    
+                    std::vector<DirectoryChange> changes;
+                    bool reload = false;
                     bool running = true;
                     while (running)
                     {
@@ -206,14 +236,27 @@ namespace djv
                             auto & p = *watcher->_p;
                             if (p.mutex.try_lock_for(timeout))
                             {
-                                // Synchronize with the main thread.
+                                // Synchronize with the main thread. Changes
+                                // for the previous path are discarded.
                                 running = p.running;
                                 if (path != p.path)
                                 {
                                     path = p.path;
                                     pathInit = true;
                                 }
-                                p.threadModified = lastModified;                                                        
+                                else if (!changes.empty() || reload)
+                                {
+                                    p.changed = true;
+                                    p.changes.insert(p.changes.end(), changes.begin(), changes.end());
+                                    p.reload |= reload;
+                                    if (p.changes.size() > directoryChangesMax)
+                                    {
+                                        p.changes.clear();
+                                        p.reload = true;
+                                    }
+                                }
+                                changes.clear();
+                                reload = false;
                                 p.mutex.unlock();
                             }
                         }
@@ -233,7 +276,7 @@ namespace djv
                         if (notify)
                         {
                             // Poll for events.
-                            lastModified = notify->poll();
+                            notify->poll(changes, reload);
                         }
                         
                         std::this_thread::sleep_for(timeout);
@@ -249,19 +292,31 @@ namespace djv
                     if (auto watcher = weak.lock())
                     {
                         auto & p = *watcher->_p;
+                        bool changed = false;
+                        std::vector<DirectoryChange> changes;
                         if (p.mutex.try_lock_for(timeout))
                         {
-                            if (p.threadModified != p.lastModified)
-                            {                            
-                                p.lastModified = p.threadModified;
-                                
-                                if (p.callback)
-                                {
-                                    p.callback();
-                                }
+                            changed = p.changed;
+                            if (!p.reload)
+                            {
+                                changes = std::move(p.changes);
                             }
+                            p.changed = false;
+                            p.changes.clear();
+                            p.reload = false;
                             p.mutex.unlock();
                         }
+                        if (changed)
+                        {
+                            if (p.callback)
+                            {
+                                p.callback();
+                            }
+                            if (p.changesCallback)
+                            {
+                                p.changesCallback(changes);
+                            }
+                        }
                     }
                 });
             }
@@ -293,7 +348,12 @@ namespace djv
 
             void DirectoryWatcher::setPath(const Path& value)
             {
-                _p->path = value;
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::timed_mutex> lock(p.mutex);
+                p.path = value;
+                p.changed = false;
+                p.changes.clear();
+                p.reload = false;
             }
 
             void DirectoryWatcher::setCallback(const std::function<void(void)>& value)
@@ -301,6 +361,11 @@ namespace djv
                 _p->callback = value;
             }
 
+            void DirectoryWatcher::setChangesCallback(const std::function<void(const std::vector<DirectoryChange>&)>& value)
+            {
+                _p->changesCallback = value;
+            }
+
         } // namespace File
     } // namespace System
 } // namespace djv
@@ -38,11 +38,13 @@ namespace djv
             {
                 Path path;
                 bool changed = false;
+                bool reload = false;
                 std::condition_variable changedCV;
                 std::mutex mutex;
                 std::thread thread;
                 std::atomic<bool> running = true;
                 std::function<void(void)> callback;
+                std::function<void(const std::vector<DirectoryChange>&)> changesCallback;
                 std::shared_ptr<Timer> timer;
             };
 
@@ -123,6 +125,7 @@ namespace djv
                                 {
                                     std::lock_guard<std::mutex> lock(p.mutex);
                                     p.changed = true;
+                                    p.reload = true;
                                 }
                                 break;
                             }
@@ -146,6 +149,7 @@ namespace djv
                 {
                     DJV_PRIVATE_PTR();
                     bool changed = false;
+                    bool reload = false;
                     {
                         std::unique_lock<std::mutex> lock(p.mutex);
                         if (p.changedCV.wait_for(
@@ -157,12 +161,23 @@ namespace djv
                         }))
                         {
                             changed = true;
+                            reload = p.reload;
                             p.changed = false;
+                            p.reload = false;
                         }
                     }
-                    if (changed && p.callback)
+                    if (changed)
                     {
-                        p.callback();
+                        if (p.callback)
+                        {
+                            p.callback();
+                        }
+                        if (reload && p.changesCallback)
+                        {
+                            //! \todo Use ReadDirectoryChangesW() to get the
+                            //! individual changes.
+                            p.changesCallback(std::vector<DirectoryChange>());
+                        }
                     }
                 });
             }
@@ -202,6 +217,7 @@ namespace djv
                     std::lock_guard<std::mutex> lock(p.mutex);
                     p.path = value;
                     p.changed = true;
+                    p.reload = false;
                 }
                 if (p.callback)
                 {
@@ -214,6 +230,11 @@ namespace djv
                 _p->callback = value;
             }
 
+            void DirectoryWatcher::setChangesCallback(const std::function<void(const std::vector<DirectoryChange>&)>& value)
+            {
+                _p->changesCallback = value;
+            }
+
         } // namespace File
     } // namespace System
 } // namespace djv
@@ -152,6 +152,9 @@ namespace djv
                 ///@{
 
 #if defined(DJV_MMAP)
+                //! Get a pointer to the start of the memory-map.
+                const uint8_t* mmapStart() const;
+
                 //! Get the current memory-map position.
                 const uint8_t* mmapP() const;
 
@@ -24,6 +24,11 @@ namespace djv
             }
                     
 #if defined(DJV_MMAP)
+            inline const uint8_t* IO::mmapStart() const
+            {
+                return _mmapStart;
+            }
+
             inline const uint8_t* IO::mmapP() const
             {
                 return _mmapP;
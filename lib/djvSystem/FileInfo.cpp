@@ -151,6 +151,49 @@ namespace djv
                 return false;
             }
             
+            bool Info::stat(std::string* error)
+            {
+                _exists      = false;
+                _size        = 0;
+                _user        = 0;
+                _permissions = 0;
+                _time        = 0;
+                FileStat fileStat;
+                if (Type::Sequence == _type)
+                {
+                    if (!_sequence.isValid())
+                    {
+                        return true;
+                    }
+                    for (const auto i : _sequence)
+                    {
+                        FileStat frameStat;
+                        if (!statFile(getFileName(i), frameStat, error))
+                        {
+                            return false;
+                        }
+                        mergeFileStat(fileStat, frameStat);
+                    }
+                }
+                else
+                {
+                    if (!statFile(_path.get(), fileStat, error))
+                    {
+                        return false;
+                    }
+                    if (fileStat.directory)
+                    {
+                        _type = Type::Directory;
+                    }
+                }
+                _exists      = true;
+                _size        = fileStat.size;
+                _user        = fileStat.user;
+                _permissions = fileStat.permissions;
+                _time        = fileStat.time;
+                return true;
+            }
+
             Math::Frame::Sequence Info::_parseSequence(const std::string& number)
             {
                 Math::Frame::Sequence out;
@@ -64,9 +64,16 @@ namespace djv
                 bool                        sortDirectoriesFirst    = true;
                 std::string                 filter;
 
+                //! Get file system information (size, time, etc.) for the
+                //! items. This is always enabled when sorting by size or time.
+                bool                        stat                    = true;
+
                 bool operator == (const DirectoryListOptions&) const;
             };
 
+            class DirectoryListBuilder;
+            class DirectoryListUpdater;
+
             //! This class provides information about files and file sequences.
             //!
             //! A file sequence is a list of file names that share a common name and
@@ -143,6 +150,9 @@ namespace djv
 
             private:
                 static Math::Frame::Sequence _parseSequence(const std::string&);
+
+                friend class DirectoryListBuilder;
+                friend class DirectoryListUpdater;
                 
                 Path                  _path;
                 bool                  _exists      = false;
@@ -11,6 +11,8 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <thread>
 
 //#pragma optimize("", off)
 
@@ -31,12 +33,18 @@ namespace djv
                 return !value.empty() && i == end;
             }
 
-            Info getSequence(const Path& path, const std::set<std::string>& extensions)
+            std::vector<Info> directoryList(const Path& path, const DirectoryListOptions& options)
+            {
+                return directoryList(path, options, nullptr);
+            }
+
+            Info getSequence(const Path& path, const std::set<std::string>& extensions, bool stat)
             {
                 Info out(path);
                 DirectoryListOptions options;
                 options.sequences = true;
                 options.sequenceExtensions = extensions;
+                options.stat = stat;
                 std::string dir = path.getDirectoryName();
                 if (dir.empty())
                 {
@@ -69,34 +77,549 @@ namespace djv
                 return data[in];
             }
 
-            void sequence(Info& info, const DirectoryListOptions& options, std::vector<Info>& out)
+            void mergeFileStat(FileStat& out, const FileStat& value)
+            {
+                out.size        += value.size;
+                out.user         = std::max(out.user, value.user);
+                out.permissions |= value.permissions;
+                out.time         = std::max(out.time, value.time);
+            }
+
+            DirectoryListBuilder::DirectoryListBuilder(const DirectoryListOptions& options) :
+                _options(options)
+            {
+                if (!options.filter.empty())
+                {
+                    try
+                    {
+                        _filter = std::regex(options.filter, std::regex_constants::icase);
+                    }
+                    catch (const std::exception&)
+                    {
+                        _filterValid = false;
+                    }
+                }
+                for (const auto& i : options.extensions)
+                {
+                    std::string extension = i;
+                    std::transform(extension.begin(), extension.end(), extension.begin(), tolower);
+                    _extensions.push_back(extension);
+                }
+            }
+
+            bool DirectoryListBuilder::isMatch(const std::string& fileName, bool directory) const
+            {
+                if (!_options.filter.empty() && (!_filterValid || !std::regex_search(fileName, _filter)))
+                {
+                    return false;
+                }
+                if (!directory && !_extensions.empty())
+                {
+                    bool match = false;
+                    const size_t fileNameSize = fileName.size();
+                    for (const auto& i : _extensions)
+                    {
+                        const size_t size = i.size();
+                        if (fileNameSize >= size)
+                        {
+                            size_t j = 0;
+                            for (; j < size && tolower(fileName[fileNameSize - size + j]) == i[j]; ++j)
+                                ;
+                            if (size == j)
+                            {
+                                match = true;
+                                break;
+                            }
+                        }
+                    }
+                    if (!match)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            void DirectoryListBuilder::add(const Info& info)
+            {
+                const Path& path = info.getPath();
+                if (_options.sequences && !path.getNumber().empty())
+                {
+                    std::string extension = path.getExtension();
+                    std::transform(extension.begin(), extension.end(), extension.begin(), tolower);
+                    if (_options.sequenceExtensions.find(extension) != _options.sequenceExtensions.end())
+                    {
+                        // The key matches the requirements of Info::isCompatible().
+                        const std::string key = path.getDirectoryName() + '\0' + path.getBaseName() + '\0' + path.getExtension();
+                        const auto i = _groups.find(key);
+                        if (i == _groups.end())
+                        {
+                            Group group;
+                            group.index = _out.size();
+                            _groups[key] = std::move(group);
+                            _out.push_back(info);
+                        }
+                        else
+                        {
+                            const auto sequence = Info::_parseSequence(path.getNumber());
+                            for (const auto& range : sequence.getRanges())
+                            {
+                                i->second.ranges.push_back(range);
+                            }
+                            i->second.pad   = std::max(i->second.pad, sequence.getPad());
+                            i->second.size += info._size;
+                            i->second.user  = std::max(i->second.user, info._user);
+                            i->second.time  = std::max(i->second.time, info._time);
+                        }
+                        return;
+                    }
+                }
+                _out.push_back(info);
+            }
+
+            std::vector<Info> DirectoryListBuilder::get()
+            {
+                for (auto& i : _groups)
+                {
+                    auto& group = i.second;
+                    if (!group.ranges.empty())
+                    {
+                        // Add the frames in order so that the sequence ranges
+                        // are appended instead of inserted.
+                        auto& info = _out[group.index];
+                        Math::Frame::Sequence sequence = Info::_parseSequence(info._path.getNumber());
+                        std::sort(group.ranges.begin(), group.ranges.end());
+                        for (const auto& range : group.ranges)
+                        {
+                            sequence.add(range);
+                        }
+                        sequence.setPad(std::max(sequence.getPad(), group.pad));
+                        if (sequence.isValid())
+                        {
+                            info._type = Type::Sequence;
+                        }
+                        info._sequence = sequence;
+                        std::stringstream ss;
+                        ss << sequence;
+                        info._path.setNumber(ss.str());
+                        info._size += group.size;
+                        info._user = std::max(info._user, group.user);
+                        info._time = std::max(info._time, group.time);
+                    }
+                }
+                _groups.clear();
+                if (_options.stat ||
+                    DirectoryListSort::Size == _options.sort ||
+                    DirectoryListSort::Time == _options.sort)
+                {
+                    stat(_out, _frameSizes);
+                }
+                return std::move(_out);
+            }
+
+            void DirectoryListBuilder::setFrameSizes(FrameSizes* value)
+            {
+                _frameSizes = value;
+            }
+
+            void DirectoryListBuilder::stat(std::vector<Info>& out, FrameSizes* frameSizes)
+            {
+                // Collect the files, including each frame of the sequences.
+                struct Request
+                {
+                    size_t      index   = 0;
+                    std::string fileName;
+                    FileStat    fileStat;
+                    bool        result  = false;
+                };
+                std::vector<Request> requests;
+                const size_t size = out.size();
+                for (size_t i = 0; i < size; ++i)
+                {
+                    const auto& info = out[i];
+                    if (Type::Sequence == info._type)
+                    {
+                        for (const auto frame : info._sequence)
+                        {
+                            Request request;
+                            request.index = i;
+                            request.fileName = info.getFileName(frame);
+                            requests.push_back(std::move(request));
+                        }
+                    }
+                    else if (!info._exists)
+                    {
+                        Request request;
+                        request.index = i;
+                        request.fileName = info._path.get();
+                        requests.push_back(std::move(request));
+                    }
+                }
+
+                // Get the information with multiple threads. The number of
+                // threads is not limited to the number of cores since most of
+                // the time is spent waiting on the file system.
+                //! \todo Should this be configurable?
+                const size_t requestsPerThread = 64;
+                const size_t threadCount = std::min(
+                    std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(4)) * 2,
+                    (requests.size() + requestsPerThread - 1) / requestsPerThread);
+                std::atomic<size_t> next(0);
+                auto func = [&requests, &next]
+                {
+                    const size_t size = requests.size();
+                    for (size_t i = next++; i < size; i = next++)
+                    {
+                        requests[i].result = statFile(requests[i].fileName, requests[i].fileStat);
+                    }
+                };
+                if (threadCount > 1)
+                {
+                    std::vector<std::thread> threads;
+                    for (size_t i = 0; i < threadCount; ++i)
+                    {
+                        threads.push_back(std::thread(func));
+                    }
+                    for (auto& i : threads)
+                    {
+                        i.join();
+                    }
+                }
+                else
+                {
+                    func();
+                }
+
+                // Update the items. Sequences with missing frames are marked
+                // as not existing, the same as Info::stat().
+                std::vector<FileStat> fileStats(size);
+                std::vector<int> results(size, -1);
+                for (const auto& i : requests)
+                {
+                    int& result = results[i.index];
+                    result = (result != 0 && i.result) ? 1 : 0;
+                    if (i.result)
+                    {
+                        mergeFileStat(fileStats[i.index], i.fileStat);
+                        fileStats[i.index].directory = i.fileStat.directory;
+                        if (frameSizes && Type::Sequence == out[i.index]._type)
+                        {
+                            (*frameSizes)[i.fileName] = i.fileStat.size;
+                        }
+                    }
+                }
+                for (size_t i = 0; i < size; ++i)
+                {
+                    if (1 == results[i])
+                    {
+                        auto& info = out[i];
+                        const auto& fileStat = fileStats[i];
+                        if (Type::Sequence != info._type && fileStat.directory)
+                        {
+                            info._type = Type::Directory;
+                        }
+                        info._exists      = true;
+                        info._size        = fileStat.size;
+                        info._user        = fileStat.user;
+                        info._permissions = fileStat.permissions;
+                        info._time        = fileStat.time;
+                    }
+                }
+            }
+
+            DirectoryListUpdater::DirectoryListUpdater(
+                const Path& path,
+                const DirectoryListOptions& options,
+                const std::vector<Info>& value,
+                FrameSizes& frameSizes) :
+                _path(path),
+                _options(options),
+                _builder(options),
+                _out(value),
+                _removed(value.size(), false),
+                _dirty(value.size(), false),
+                _frameSizes(frameSizes)
+            {
+                const size_t size = _out.size();
+                for (size_t i = 0; i < size; ++i)
+                {
+                    const auto& info = _out[i];
+                    _index[_getKey(info._path, Type::Directory == info._type)] = i;
+                }
+            }
+
+            void DirectoryListUpdater::add(const std::string& fileName, bool directory)
+            {
+                if (fileName.empty() ||
+                    "." == fileName ||
+                    ".." == fileName ||
+                    ('.' == fileName[0] && !_options.showHidden))
+                {
+                    return;
+                }
+                const Path path(_path, fileName);
+                Info info(path, directory ? Type::Directory : Type::File, Math::Frame::Sequence(), false);
+                if (!info.stat())
+                {
+                    // The file has been removed already.
+                    return;
+                }
+                directory = Type::Directory == info._type;
+                if (!_builder.isMatch(fileName, directory))
+                {
+                    return;
+                }
+                const std::string key = _getKey(path, directory);
+                const auto i = _index.find(key);
+                if (i != _index.end() && !_removed[i->second])
+                {
+                    auto& item = _out[i->second];
+                    if (_isSequence(path, directory))
+                    {
+                        const auto sequence = Info::_parseSequence(path.getNumber());
+                        if (Type::Sequence == item._type &&
+                            sequence.isValid() &&
+                            item._sequence.contains(sequence.getFrame(0)))
+                        {
+                            if (_isStat())
+                            {
+                                FileStat fileStat;
+                                fileStat.size        = info._size;
+                                fileStat.user        = info._user;
+                                fileStat.permissions = info._permissions;
+                                fileStat.time        = info._time;
+                                _frameUpdate(i->second, path.get(), fileStat);
+                            }
+                        }
+                        else if (item._path.getNumber() == path.getNumber())
+                        {
+                            _dirty[i->second] = true;
+                        }
+                        else
+                        {
+                            item.addToSequence(info);
+                            if (_isStat())
+                            {
+                                _frameSizes[path.get()] = info._size;
+                            }
+                        }
+                    }
+                    else
+                    {
+                        item = info;
+                    }
+                }
+                else
+                {
+                    _insert(key, info);
+                }
+            }
+
+            void DirectoryListUpdater::remove(const std::string& fileName)
+            {
+                const Path path(_path, fileName);
+                const auto i = _index.find(_getKey(path, false));
+                if (i == _index.end() || _removed[i->second])
+                {
+                    return;
+                }
+                auto& item = _out[i->second];
+                if (Type::Sequence == item._type && _isSequence(path, false))
+                {
+                    // Remove the frame from the sequence.
+                    const auto sequence = Info::_parseSequence(path.getNumber());
+                    if (!sequence.isValid())
+                    {
+                        return;
+                    }
+                    const Math::Frame::Number frame = sequence.getFrame(0);
+                    if (!item._sequence.contains(frame))
+                    {
+                        return;
+                    }
+                    std::vector<Math::Frame::Range> ranges;
+                    for (const auto& range : item._sequence.getRanges())
+                    {
+                        if (frame >= range.getMin() && frame <= range.getMax())
+                        {
+                            if (frame > range.getMin())
+                            {
+                                ranges.push_back(Math::Frame::Range(range.getMin(), frame - 1));
+                            }
+                            if (frame < range.getMax())
+                            {
+                                ranges.push_back(Math::Frame::Range(frame + 1, range.getMax()));
+                            }
+                        }
+                        else
+                        {
+                            ranges.push_back(range);
+                        }
+                    }
+                    const size_t pad = item._sequence.getPad();
+                    const Math::Frame::Sequence tmp(ranges, pad);
+                    const size_t frameCount = tmp.getFrameCount();
+                    const auto j = _frameSizes.find(path.get());
+                    if (frameCount > 1)
+                    {
+                        item.setSequence(tmp);
+                        if (j != _frameSizes.end() && item._size >= j->second)
+                        {
+                            // Subtract the size of the frame instead of
+                            // getting the information for the whole sequence.
+                            item._size -= j->second;
+                        }
+                        else
+                        {
+                            _dirty[i->second] = true;
+                        }
+                    }
+                    else if (1 == frameCount)
+                    {
+                        // A single frame is listed as a file.
+                        Path itemPath = item._path;
+                        itemPath.setNumber(Math::Frame::toString(tmp.getFrame(0), pad));
+                        item.setPath(itemPath, false);
+                        _dirty[i->second] = true;
+                    }
+                    else
+                    {
+                        _removed[i->second] = true;
+                        _index.erase(i);
+                    }
+                    if (j != _frameSizes.end())
+                    {
+                        _frameSizes.erase(j);
+                    }
+                }
+                else if (item._path.getNumber() == path.getNumber())
+                {
+                    _removed[i->second] = true;
+                    _index.erase(i);
+                }
+            }
+
+            void DirectoryListUpdater::modify(const std::string& fileName)
+            {
+                if (_isStat())
+                {
+                    const Path path(_path, fileName);
+                    const auto i = _index.find(_getKey(path, false));
+                    if (i != _index.end() && !_removed[i->second])
+                    {
+                        const auto& item = _out[i->second];
+                        if (Type::Sequence == item._type && _isSequence(path, false))
+                        {
+                            // Only get the information for the modified frame.
+                            const auto sequence = Info::_parseSequence(path.getNumber());
+                            FileStat fileStat;
+                            if (sequence.isValid() &&
+                                item._sequence.contains(sequence.getFrame(0)) &&
+                                statFile(path.get(), fileStat))
+                            {
+                                _frameUpdate(i->second, path.get(), fileStat);
+                            }
+                        }
+                        else
+                        {
+                            _dirty[i->second] = true;
+                        }
+                    }
+                }
+            }
+
+            std::vector<Info> DirectoryListUpdater::get()
             {
-                std::string extension = info.getPath().getExtension();
-                std::transform(extension.begin(), extension.end(), extension.begin(), tolower);
-                const auto i = std::find(
-                    options.sequenceExtensions.begin(),
-                    options.sequenceExtensions.end(),
-                    extension);
-                if (options.sequences && i != options.sequenceExtensions.end())
-                {
-                    const size_t size = out.size();
-                    size_t j = 0;
-                    for (; j < size; ++j)
+                std::vector<Info> out;
+                std::vector<Info> items;
+                std::vector<size_t> indexes;
+                const size_t size = _out.size();
+                for (size_t i = 0; i < size; ++i)
+                {
+                    if (!_removed[i])
                     {
-                        if (out[j].addToSequence(info))
+                        if (_dirty[i] && _isStat())
                         {
-                            break;
+                            auto& info = _out[i];
+                            info.setPath(info._path, info._type, info._sequence, false);
+                            items.push_back(std::move(info));
+                            indexes.push_back(out.size());
                         }
+                        out.push_back(std::move(_out[i]));
                     }
-                    if (size == j)
+                }
+                if (!items.empty())
+                {
+                    DirectoryListBuilder::stat(items, &_frameSizes);
+                    for (size_t i = 0; i < items.size(); ++i)
                     {
-                        out.push_back(info);
+                        out[indexes[i]] = std::move(items[i]);
                     }
                 }
+                _out.clear();
+                _removed.clear();
+                _dirty.clear();
+                _index.clear();
+                sort(_options, out);
+                return out;
+            }
+
+            bool DirectoryListUpdater::_isSequence(const Path& path, bool directory) const
+            {
+                bool out = false;
+                if (_options.sequences && !directory && !path.getNumber().empty())
+                {
+                    std::string extension = path.getExtension();
+                    std::transform(extension.begin(), extension.end(), extension.begin(), tolower);
+                    out = _options.sequenceExtensions.find(extension) != _options.sequenceExtensions.end();
+                }
+                return out;
+            }
+
+            std::string DirectoryListUpdater::_getKey(const Path& path, bool directory) const
+            {
+                // File sequences use the same key as DirectoryListBuilder,
+                // other files use the file name.
+                return _isSequence(path, directory) ?
+                    (path.getDirectoryName() + '\0' + path.getBaseName() + '\0' + path.getExtension()) :
+                    path.getFileName();
+            }
+
+            bool DirectoryListUpdater::_isStat() const
+            {
+                return
+                    _options.stat ||
+                    DirectoryListSort::Size == _options.sort ||
+                    DirectoryListSort::Time == _options.sort;
+            }
+
+            void DirectoryListUpdater::_insert(const std::string& key, const Info& info)
+            {
+                _index[key] = _out.size();
+                _out.push_back(info);
+                _removed.push_back(false);
+                _dirty.push_back(false);
+            }
+
+            void DirectoryListUpdater::_frameUpdate(size_t index, const std::string& fileName, const FileStat& fileStat)
+            {
+                // If the previous size of the frame is known update the
+                // sequence with the difference, otherwise get the information
+                // for the whole sequence.
+                auto& item = _out[index];
+                const auto i = _frameSizes.find(fileName);
+                if (i != _frameSizes.end() && item._size >= i->second)
+                {
+                    item._size         = item._size - i->second + fileStat.size;
+                    item._user         = std::max(item._user, fileStat.user);
+                    item._permissions |= fileStat.permissions;
+                    item._time         = std::max(item._time, fileStat.time);
+                }
                 else
                 {
-                    out.push_back(info);
+                    _dirty[index] = true;
                 }
+                _frameSizes[fileName] = fileStat.size;
             }
 
             void sort(const DirectoryListOptions& options, std::vector<Info>& out)
@@ -105,12 +628,9 @@ namespace djv
                 {
                     if (Type::Sequence == i.getType())
                     {
-                        const auto sequence = i.getSequence();
-                        std::stringstream s;
-                        s << sequence;
-                        Path path = i.getPath();
-                        path.setNumber(s.str());
-                        i.setPath(path, Type::Sequence, sequence, false);
+                        // Update the path without resetting the file
+                        // system information.
+                        i.setSequence(i.getSequence());
                     }
                 }
 
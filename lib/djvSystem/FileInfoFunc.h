@@ -31,8 +31,10 @@ namespace djv
             //! Test whether the string contains all '#' characters.
             bool isSequenceWildcard(const std::string&) noexcept;
 
-            //! Get the file sequence for the given file.
-            Info getSequence(const Path&, const std::set<std::string>& extensions);
+            //! Get the file sequence for the given file. Getting the file
+            //! system information can be disabled with the stat argument
+            //! (see DirectoryListOptions).
+            Info getSequence(const Path&, const std::set<std::string>& extensions, bool stat = true);
 
             ///@}
 
@@ -6,8 +6,6 @@
 
 #include <djvSystem/FileInfoPrivate.h>
 
-#include <djvCore/StringFunc.h>
-
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <dirent.h>
@@ -23,19 +21,17 @@ namespace djv
     {
         namespace File
         {
-            std::vector<Info> directoryList(const Path& value, const DirectoryListOptions& options)
+            std::vector<Info> directoryList(const Path& value, const DirectoryListOptions& options, FrameSizes* frameSizes)
             {
-                std::vector<Info> out;
-                
                 // List the directory contents.
+                DirectoryListBuilder builder(options);
+                builder.setFrameSizes(frameSizes);
                 if (auto dir = opendir(value.get().c_str()))
                 {
                     dirent* de = nullptr;
                     while ((de = readdir(dir)))
                     {
-                        Info info(Path(value, de->d_name));
-                        
-                        const std::string fileName = info.getFileName(-1, false);
+                        const std::string fileName(de->d_name);
                         
                         bool filter = false;
                         if (fileName.size() > 0 && '.' == fileName[0])
@@ -50,34 +46,34 @@ namespace djv
                         {
                             filter = true;
                         }
-                        if (options.filter.size() && !String::match(fileName, options.filter))
-                        {
-                            filter = true;
-                        }
-                        if (!filter && !(de->d_type & DT_DIR) && options.extensions.size())
+
+                        if (!filter)
                         {
-                            bool match = false;
-                            for (const auto& i : options.extensions)
+                            // Use the type from the directory entry when it is
+                            // available, the rest of the file system
+                            // information is requested by the builder.
+                            Info info;
+                            switch (de->d_type)
                             {
-                                if (String::match(fileName, '\\' + i + '$'))
-                                {
-                                    match = true;
-                                    break;
-                                }
+                            case DT_DIR:
+                                info = Info(Path(value, fileName), Type::Directory, Math::Frame::Sequence(), false);
+                                break;
+                            case DT_REG:
+                                info = Info(Path(value, fileName), false);
+                                break;
+                            default:
+                                info = Info(Path(value, fileName));
+                                break;
                             }
-                            if (!match)
+                            if (builder.isMatch(fileName, Type::Directory == info.getType()))
                             {
-                                filter = true;
+                                builder.add(info);
                             }
                         }
-
-                        if (!filter)
-                        {
-                            sequence(info, options, out);
-                        }
                     }
                     closedir(dir);
                 }
+                std::vector<Info> out = builder.get();
                     
                 // Sort the items.
                 sort(options, out);
@@ -120,7 +120,7 @@ namespace djv
 
             } // namespace
 
-            std::vector<Info> directoryList(const Path& value, const DirectoryListOptions& options)
+            std::vector<Info> directoryList(const Path& value, const DirectoryListOptions& options, FrameSizes* frameSizes)
             {
                 std::vector<Info> out;
                 if (!value.isEmpty())
@@ -135,6 +135,8 @@ namespace djv
                     // List the directory contents.
                     std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> utf16;
                     WIN32_FIND_DATAW ffd;
+                    DirectoryListBuilder builder(options);
+                    builder.setFrameSizes(frameSizes);
                     HANDLE hFind = FindFirstFileW(pathBuf, &ffd);
                     if (hFind != INVALID_HANDLE_VALUE)
                     {
@@ -157,31 +159,21 @@ namespace djv
                                 {
                                     filter = true;
                                 }
-                                if (options.filter.size() && !String::match(fileName, options.filter))
+                                const bool directory = (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+                                if (!filter && !builder.isMatch(fileName, directory))
                                 {
                                     filter = true;
                                 }
-                                if (!filter && !(ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) && options.extensions.size())
-                                {
-                                    bool match = false;
-                                    for (const auto& i : options.extensions)
-                                    {
-                                        if (String::match(fileName, '\\' + i + '$'))
-                                        {
-                                            match = true;
-                                            break;
-                                        }
-                                    }
-                                    if (!match)
-                                    {
-                                        filter = true;
-                                    }
-                                }
 
                                 if (!filter)
                                 {
-                                    Info info(Path(value, fileName));
-                                    sequence(info, options, out);
+                                    // The file system information is requested
+                                    // by the builder.
+                                    builder.add(Info(
+                                        Path(value, fileName),
+                                        directory ? Type::Directory : Type::File,
+                                        Math::Frame::Sequence(),
+                                        false));
                                 }
                             } while (FindNextFileW(hFind, &ffd) != 0);
                         }
@@ -190,6 +182,7 @@ namespace djv
                             //! \bug How should we handle this error?
                         }
                         FindClose(hFind);
+                        out = builder.get();
                     }
                     else if (value.isServer())
                     {
@@ -18,7 +18,8 @@ namespace djv
                     sort == other.sort &&
                     reverseSort == other.reverseSort &&
                     sortDirectoriesFirst == other.sortDirectoriesFirst &&
-                    filter == other.filter;
+                    filter == other.filter &&
+                    stat == other.stat;
             }
 
             inline const Path& Info::getPath() const noexcept
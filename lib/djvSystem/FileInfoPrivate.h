@@ -6,13 +6,141 @@
 
 #include <djvSystem/FileInfo.h>
 
+#include <regex>
+#include <unordered_map>
+
 namespace djv
 {
     namespace System
     {
         namespace File
         {
-            void sequence(Info&, const DirectoryListOptions&, std::vector<Info>&);
+            //! This struct provides file system information for a single file.
+            struct FileStat
+            {
+                bool     directory   = false;
+                uint64_t size        = 0;
+                uid_t    user        = 0;
+                int      permissions = 0;
+                time_t   time        = 0;
+            };
+
+            //! Get file system information for a single file. Only the fields
+            //! in FileStat are requested from the file system where supported.
+            //! Returns false if the file does not exist.
+            bool statFile(const std::string& fileName, FileStat&, std::string* error = nullptr);
+
+            //! Combine the information for the frames of a file sequence.
+            void mergeFileStat(FileStat&, const FileStat&);
+
+            //! This typedef provides the sizes of sequence frames, keyed by
+            //! the file name.
+            typedef std::unordered_map<std::string, uint64_t> FrameSizes;
+
+            //! This class builds a directory listing.
+            //!
+            //! The filter and extensions are prepared once for the listing
+            //! instead of for each file. File sequences are grouped with a hash
+            //! table keyed by the file name without the frame number, and the
+            //! frames of each sequence are merged when the listing is finished.
+            class DirectoryListBuilder
+            {
+            public:
+                explicit DirectoryListBuilder(const DirectoryListOptions&);
+
+                //! Get whether a file name matches the filter and extensions.
+                bool isMatch(const std::string& fileName, bool directory) const;
+
+                void add(const Info&);
+
+                //! Set where the sizes of the sequence frames are stored when
+                //! file system information is requested.
+                void setFrameSizes(FrameSizes*);
+
+                //! Get the listing. The listing is not sorted.
+                //!
+                //! If the options require file system information it is
+                //! requested for all of the files at once, including each frame
+                //! of the file sequences, using multiple threads.
+                std::vector<Info> get();
+
+                //! Get file system information for the items in a listing that
+                //! are file sequences or do not exist yet, using multiple
+                //! threads. The sizes of the sequence frames are stored in the
+                //! given frame sizes if it is not null.
+                static void stat(std::vector<Info>&, FrameSizes* = nullptr);
+
+            private:
+
+                struct Group
+                {
+                    size_t                          index   = 0;
+                    std::vector<Math::Frame::Range> ranges;
+                    size_t                          pad     = 0;
+                    uint64_t                        size    = 0;
+                    uid_t                           user    = 0;
+                    time_t                          time    = 0;
+                };
+
+                const DirectoryListOptions&             _options;
+                bool                                    _filterValid = true;
+                std::regex                              _filter;
+                std::vector<std::string>                _extensions;
+                std::vector<Info>                       _out;
+                std::unordered_map<std::string, Group>  _groups;
+                FrameSizes*                             _frameSizes = nullptr;
+            };
+
+            //! List the directory contents, storing the sizes of the sequence
+            //! frames in the given frame sizes if file system information is
+            //! requested.
+            std::vector<Info> directoryList(const Path&, const DirectoryListOptions&, FrameSizes*);
+
+            //! This class applies changes to a directory listing, so that the
+            //! directory does not need to be listed again when a few files
+            //! change.
+            //!
+            //! Frames that are added or removed are merged into the existing
+            //! file sequences. File system information is only requested for
+            //! the changed items.
+            //!
+            //! The sizes of the sequence frames are kept between updates
+            //! (starting with the sizes from the directory listing), so that
+            //! when a frame changes only that frame needs to be stat'ed
+            //! instead of the whole sequence.
+            class DirectoryListUpdater
+            {
+            public:
+                DirectoryListUpdater(
+                    const Path&,
+                    const DirectoryListOptions&,
+                    const std::vector<Info>&,
+                    FrameSizes&);
+
+                void add(const std::string& fileName, bool directory);
+                void remove(const std::string& fileName);
+                void modify(const std::string& fileName);
+
+                //! Get the sorted listing.
+                std::vector<Info> get();
+
+            private:
+                bool _isSequence(const Path&, bool directory) const;
+                std::string _getKey(const Path&, bool directory) const;
+                bool _isStat() const;
+                void _insert(const std::string& key, const Info&);
+                void _frameUpdate(size_t index, const std::string& fileName, const FileStat&);
+
+                Path                                    _path;
+                const DirectoryListOptions&             _options;
+                DirectoryListBuilder                    _builder;
+                std::vector<Info>                       _out;
+                std::vector<bool>                       _removed;
+                std::vector<bool>                       _dirty;
+                std::unordered_map<std::string, size_t> _index;
+                FrameSizes&                             _frameSizes;
+            };
+
             void sort(const DirectoryListOptions&, std::vector<Info>&);
 
         } // namespace File
@@ -4,11 +4,12 @@
 
 #include <djvSystem/FileInfoPrivate.h>
 
-#include <djvMath/FrameNumberFunc.h>
-
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <stdlib.h>
+#include <string.h>
 
 //#pragma optimize("", off)
 
@@ -29,63 +30,47 @@ namespace djv
     {
         namespace File
         {
-            bool Info::stat(std::string*)
+            bool statFile(const std::string& fileName, FileStat& out, std::string* error)
             {
-                _exists      = false;
-                _size        = 0;
-                _user        = 0;
-                _permissions = 0;
-                _time        = 0;
-                if (Type::Sequence == _type)
+#if defined(DJV_PLATFORM_LINUX) && defined(STATX_BASIC_STATS)
+                // Only request the fields that we need, this allows network
+                // file systems to skip fetching the other attributes.
+                struct ::statx info;
+                memset(&info, 0, sizeof(struct ::statx));
+                if (::statx(AT_FDCWD, fileName.c_str(), 0, STATX_TYPE | STATX_MODE | STATX_UID | STATX_SIZE | STATX_MTIME, &info) != 0)
                 {
-                    bool     exists      = false;
-                    uint64_t size        = 0;
-                    uid_t    user        = 0;
-                    int      permissions = 0;
-                    time_t   time        = 0;
-                    for (auto i : Math::Frame::toFrames(_sequence))
+                    if (error)
                     {
-                        _STAT info;
-                        memset(&info, 0, sizeof(_STAT));
-                        const std::string fileName = getFileName(i);
-                        if (_STAT_FNC(fileName.c_str(), &info) != 0)
-                        {
-                            return false;
-                        }
-                        exists       = true;
-                        size        += info.st_size;
-                        user         = std::min(_user, static_cast<uid_t>(info.st_uid));
-                        permissions |= (info.st_mode & S_IRUSR) ? static_cast<int>(Permissions::Read)  : 0;
-                        permissions |= (info.st_mode & S_IWUSR) ? static_cast<int>(Permissions::Write) : 0;
-                        permissions |= (info.st_mode & S_IXUSR) ? static_cast<int>(Permissions::Exec)  : 0;
-                        time         = std::max(_time, info.st_mtime);
+                        *error = strerror(errno);
                     }
-                    _exists      = exists;
-                    _size        = size;
-                    _user        = user;
-                    _permissions = permissions;
-                    _time        = time;
+                    return false;
                 }
-                else
+                const auto mode = info.stx_mode;
+                out.directory    = S_ISDIR(mode);
+                out.size         = info.stx_size;
+                out.user         = info.stx_uid;
+                out.time         = info.stx_mtime.tv_sec;
+#else // DJV_PLATFORM_LINUX
+                _STAT info;
+                memset(&info, 0, sizeof(_STAT));
+                if (_STAT_FNC(fileName.c_str(), &info) != 0)
                 {
-                    _STAT info;
-                    memset(&info, 0, sizeof(_STAT));
-                    if (_STAT_FNC(_path.get().c_str(), &info) != 0)
-                    {
-                        return false;
-                    }
-                    _exists		  = true;
-                    if (S_ISDIR(info.st_mode))
+                    if (error)
                     {
-                        _type     = Type::Directory;
+                        *error = strerror(errno);
                     }
-                    _size         = info.st_size;
-                    _user         = info.st_uid;
-                    _permissions |= (info.st_mode & S_IRUSR) ? static_cast<int>(Permissions::Read)  : 0;
-                    _permissions |= (info.st_mode & S_IWUSR) ? static_cast<int>(Permissions::Write) : 0;
-                    _permissions |= (info.st_mode & S_IXUSR) ? static_cast<int>(Permissions::Exec)  : 0;
-                    _time         = info.st_mtime;
+                    return false;
                 }
+                const auto mode = info.st_mode;
+                out.directory    = S_ISDIR(mode);
+                out.size         = info.st_size;
+                out.user         = info.st_uid;
+                out.time         = info.st_mtime;
+#endif // DJV_PLATFORM_LINUX
+                out.permissions  = 0;
+                out.permissions |= (mode & S_IRUSR) ? static_cast<int>(Permissions::Read)  : 0;
+                out.permissions |= (mode & S_IWUSR) ? static_cast<int>(Permissions::Write) : 0;
+                out.permissions |= (mode & S_IXUSR) ? static_cast<int>(Permissions::Exec)  : 0;
                 return true;
             }
 
@@ -4,8 +4,6 @@
 
 #include <djvSystem/FileInfoPrivate.h>
 
-#include <djvMath/FrameNumberFunc.h>
-
 #include <djvCore/Memory.h>
 #include <djvCore/StringFunc.h>
 
@@ -15,6 +13,7 @@
 #ifndef NOMINMAX
 #define NOMINMAX
 #endif // NOMINMAX
+#include <string.h>
 #include <sys/stat.h>
 #include <windows.h>
 
@@ -34,80 +33,33 @@ namespace djv
     {
         namespace File
         {
-            bool Info::stat(std::string* error)
+            bool statFile(const std::string& fileName, FileStat& out, std::string* error)
             {
-                _exists      = false;
-                _size        = 0;
-                _user        = 0;
-                _permissions = 0;
-                _time        = 0;
-                _permissions = 0;
-                if (Type::Sequence == _type)
-                {
-                    bool     exists      = false;
-                    uint64_t size        = 0;
-                    uid_t    user        = 0;
-                    int      permissions = 0;
-                    time_t   time        = 0;
-                    for (auto i : Math::Frame::toFrames(_sequence))
-                    {
-                        _STAT info;
-                        memset(&info, 0, sizeof(_STAT));
-                        if (_STAT_FNC(String::toWide(getFileName(i)).c_str(), &info) != 0)
-                        {
-                            if (error)
-                            {
-                                char tmp[String::cStringLength] = "";
-                                strerror_s(tmp, String::cStringLength, errno);
-                                *error = tmp;
-                            }
-                            return false;
-                        }
-                        exists       = true;
-                        size        += info.st_size;
-                        user         = std::min(_user, static_cast<uid_t>(info.st_uid));
-                        permissions |= (info.st_mode & _S_IREAD)  ? static_cast<int>(Permissions::Read)  : 0;
-                        permissions |= (info.st_mode & _S_IWRITE) ? static_cast<int>(Permissions::Write) : 0;
-                        permissions |= (info.st_mode & _S_IEXEC)  ? static_cast<int>(Permissions::Exec)  : 0;
-                        time         = std::max(_time, info.st_mtime);
-                    }
-                    _exists      = exists;
-                    _size        = size;
-                    _user        = user;
-                    _permissions = permissions;
-                    _time        = time;
-                }
-                else if (_path.isServer())
+                if (Path(fileName).isServer())
                 {
                     //! \todo What about servers?
-                    _exists = true;
+                    return true;
                 }
-                else
+                _STAT info;
+                memset(&info, 0, sizeof(_STAT));
+                if (_STAT_FNC(String::toWide(fileName).c_str(), &info) != 0)
                 {
-                    _STAT info;
-                    memset(&info, 0, sizeof(_STAT));
-                    if (_STAT_FNC(String::toWide(_path.get()).c_str(), &info) != 0)
-                    {
-                        if (error)
-                        {
-                            char tmp[String::cStringLength] = "";
-                            strerror_s(tmp, String::cStringLength, errno);
-                            *error = tmp;
-                        }
-                        return false;
-                    }
-                    _exists       = true;
-                    if (info.st_mode & _S_IFDIR)
+                    if (error)
                     {
-                        _type     = Type::Directory;
+                        char tmp[String::cStringLength] = "";
+                        strerror_s(tmp, String::cStringLength, errno);
+                        *error = tmp;
                     }
-                    _size         = info.st_size;
-                    _user         = info.st_uid;
-                    _permissions |= (info.st_mode & _S_IREAD)  ? static_cast<int>(Permissions::Read)  : 0;
-                    _permissions |= (info.st_mode & _S_IWRITE) ? static_cast<int>(Permissions::Write) : 0;
-                    _permissions |= (info.st_mode & _S_IEXEC)  ? static_cast<int>(Permissions::Exec)  : 0;
-                    _time         = info.st_mtime;
+                    return false;
                 }
+                out.directory    = (info.st_mode & _S_IFDIR) != 0;
+                out.size         = info.st_size;
+                out.user         = info.st_uid;
+                out.permissions  = 0;
+                out.permissions |= (info.st_mode & _S_IREAD)  ? static_cast<int>(Permissions::Read)  : 0;
+                out.permissions |= (info.st_mode & _S_IWRITE) ? static_cast<int>(Permissions::Write) : 0;
+                out.permissions |= (info.st_mode & _S_IEXEC)  ? static_cast<int>(Permissions::Exec)  : 0;
+                out.time         = info.st_mtime;
                 return true;
             }
 
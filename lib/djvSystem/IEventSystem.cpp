@@ -10,6 +10,8 @@
 #include <djvSystem/TextSystem.h>
 #include <djvSystem/TimerFunc.h>
 
+#include <djvCore/MetricsFunc.h>
+
 #include <map>
 #include <sstream>
 
@@ -37,6 +39,7 @@ namespace djv
                 std::shared_ptr<Observer::Value<std::string> > localeObserver;
                 std::shared_ptr<Observer::Value<bool> > textChangedObserver;
                 std::shared_ptr<Timer> statsTimer;
+                std::vector<std::shared_ptr<IObject> > updateObjects;
             };
 
             void IEventSystem::_init(const std::string& systemName, const std::shared_ptr<Context>& context)
@@ -182,9 +185,17 @@ namespace djv
                     _init(event);
                 }
 
-                // Update event.
+                // Update event. Objects that request another update while
+                // handling the event are added to the list for the next tick.
+                static const auto updateObjectsGauge = Metrics::getGauge("djv::System::Event::IEventSystem::updateObjects");
+                IObject::_takeUpdateRequests(p.updateObjects);
+                updateObjectsGauge->set(static_cast<int64_t>(p.updateObjects.size()));
                 Update updateEvent(p.t, dt);
-                _update(updateEvent);
+                for (const auto& object : p.updateObjects)
+                {
+                    object->event(updateEvent);
+                }
+                p.updateObjects.clear();
 
                 // Pointer move event.
                 PointerMove moveEvent(p.keyModifiers, p.pointerInfo);
@@ -269,17 +280,6 @@ namespace djv
                 }
             }
 
-            void IEventSystem::_updateRecursive(const std::shared_ptr<IObject>& object, Update& event)
-            {
-                object->event(event);
-                const auto children = object->_children;
-                for (const auto& child : children)
-                {
-                    child->_parentsEnabled = object->_enabled && object->_parentsEnabled;
-                    _updateRecursive(child, event);
-                }
-            }
-
             void IEventSystem::_pointerMove(const PointerInfo& info)
             {
                 DJV_PRIVATE_PTR();
@@ -18,6 +18,11 @@ namespace djv
         namespace Event
         {
             //! This class provides the base functionality for event systems.
+            //!
+            //! Update events are only sent to the objects that have requested
+            //! them (see IObject::_requestUpdate()), so the cost of a tick is
+            //! proportional to the number of active objects rather than the
+            //! size of the object hierarchy.
             class IEventSystem : public ISystem
             {
                 DJV_NON_COPYABLE(IEventSystem);
@@ -64,8 +69,6 @@ namespace djv
             protected:
                 virtual void _init(Init&) = 0;
                 void _initRecursive(const std::shared_ptr<IObject>&, Init&);
-                virtual void _update(Update&) = 0;
-                void _updateRecursive(const std::shared_ptr<IObject>&, Update&);
 
                 void _pointerMove(const PointerInfo&);
                 void _buttonPress(int);
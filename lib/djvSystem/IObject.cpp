@@ -20,6 +20,10 @@ namespace djv
         {
             size_t globalObjectCount = 0;
 
+            //! \todo Should this be per-event system?
+            IObject* updateRequestsHead = nullptr;
+            IObject* updateRequestsTail = nullptr;
+
         } // namespace
 
         void IObject::_init(const std::shared_ptr<Context>& context)
@@ -29,6 +33,10 @@ namespace djv
             _context   = context;
             _className = "djv::System::IObject";
 
+            // Objects are owned by a shared pointer before they are
+            // initialized.
+            _updateObject = shared_from_this();
+
             _resourceSystem = context->getSystemT<ResourceSystem>();
             _logSystem = context->getSystemT<LogSystem>();
             _textSystem = context->getSystemT<TextSystem>();
@@ -41,6 +49,7 @@ namespace djv
         IObject::~IObject()
         {
             --globalObjectCount;
+            _removeUpdateRequest();
         }
         
         void IObject::installEventFilter(const std::weak_ptr<IObject>& value)
@@ -85,6 +94,8 @@ namespace djv
 
             value->_parent = shared_from_this();
             _children.push_back(value);
+            value->_parentsEnabled = _enabled && _parentsEnabled;
+            value->_setParentsEnabledRecursive();
             
             Event::ChildAdded childAddedEvent(value);
             event(childAddedEvent);
@@ -102,6 +113,8 @@ namespace djv
                 _children.erase(i);
 
                 child->_parent.reset();
+                child->_parentsEnabled = true;
+                child->_setParentsEnabledRecursive();
 
                 Event::ChildRemoved childRemovedEvent(child);
                 event(childRemovedEvent);
@@ -111,6 +124,14 @@ namespace djv
             }
         }
 
+        void IObject::setEnabled(bool value)
+        {
+            if (value == _enabled)
+                return;
+            _enabled = value;
+            _setParentsEnabledRecursive();
+        }
+
         void IObject::clearChildren()
         {
             while (_children.size())
@@ -223,6 +244,24 @@ namespace djv
             }
         }
 
+        void IObject::_requestUpdate()
+        {
+            if (_updateRequested)
+                return;
+            _updateRequested = true;
+            _updatePrev = updateRequestsTail;
+            _updateNext = nullptr;
+            if (updateRequestsTail)
+            {
+                updateRequestsTail->_updateNext = this;
+            }
+            else
+            {
+                updateRequestsHead = this;
+            }
+            updateRequestsTail = this;
+        }
+
         void IObject::_parentChangedEvent(System::Event::ParentChanged&)
         {
             // Default implementation does nothing.
@@ -300,5 +339,64 @@ namespace djv
             return filtered;
         }
 
+        void IObject::_setParentsEnabledRecursive()
+        {
+            const bool enabled = _enabled && _parentsEnabled;
+            for (const auto& i : _children)
+            {
+                if (i->_parentsEnabled != enabled)
+                {
+                    i->_parentsEnabled = enabled;
+                    i->_setParentsEnabledRecursive();
+                }
+            }
+        }
+
+        void IObject::_removeUpdateRequest()
+        {
+            if (!_updateRequested)
+                return;
+            _updateRequested = false;
+            if (_updatePrev)
+            {
+                _updatePrev->_updateNext = _updateNext;
+            }
+            else
+            {
+                updateRequestsHead = _updateNext;
+            }
+            if (_updateNext)
+            {
+                _updateNext->_updatePrev = _updatePrev;
+            }
+            else
+            {
+                updateRequestsTail = _updatePrev;
+            }
+            _updatePrev = nullptr;
+            _updateNext = nullptr;
+        }
+
+        void IObject::_takeUpdateRequests(std::vector<std::shared_ptr<IObject> >& out)
+        {
+            IObject* object = updateRequestsHead;
+            while (object)
+            {
+                IObject* next = object->_updateNext;
+                object->_updateRequested = false;
+                object->_updatePrev = nullptr;
+                object->_updateNext = nullptr;
+                // The object may not be initialized yet, or it may be in the
+                // process of being destroyed.
+                if (auto shared = object->_updateObject.lock())
+                {
+                    out.push_back(shared);
+                }
+                object = next;
+            }
+            updateRequestsHead = nullptr;
+            updateRequestsTail = nullptr;
+        }
+
     } // namespace System
 } // namespace djv
@@ -150,6 +150,20 @@ namespace djv
 
             ///@}
 
+            //! \name Update Events
+            //! Objects only receive an update event on the next tick when
+            //! they have requested it, so objects with active animations,
+            //! timers, or pending futures should request an update each tick
+            //! until they are finished.
+            ///@{
+
+            //! Request an update event on the next tick.
+            void _requestUpdate();
+
+            bool _isUpdateRequested() const;
+
+            ///@}
+
             //! \name Convenience Functions
             ///@{
 
@@ -166,6 +180,9 @@ namespace djv
         private:
             void _eventInitRecursive(const std::shared_ptr<IObject>&, Event::Init&);
             bool _eventFilter(System::Event::Event&);
+            void _setParentsEnabledRecursive();
+            void _removeUpdateRequest();
+            static void _takeUpdateRequests(std::vector<std::shared_ptr<IObject> >&);
 
             template<typename T>
             static void _getChildrenRecursiveT(const std::shared_ptr<IObject>&, std::vector<std::shared_ptr<T> >&);
@@ -185,6 +202,17 @@ namespace djv
 
             std::vector<std::weak_ptr<IObject> > _filters;
 
+            //! The objects that have requested an update are kept in an
+            //! intrusive list.
+            IObject* _updatePrev      = nullptr;
+            IObject* _updateNext      = nullptr;
+            bool     _updateRequested = false;
+
+            //! This pointer is used to take the update requests, since
+            //! shared_from_this() cannot be called on an object that is not
+            //! owned by a shared pointer.
+            std::weak_ptr<IObject> _updateObject;
+
             std::shared_ptr<ResourceSystem> _resourceSystem;
             std::shared_ptr<LogSystem>      _logSystem;
             std::shared_ptr<TextSystem>     _textSystem;
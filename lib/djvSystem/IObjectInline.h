@@ -112,9 +112,9 @@ namespace djv
             return parents ? (_parentsEnabled && _enabled) : _enabled;
         }
 
-        inline void IObject::setEnabled(bool value)
+        inline bool IObject::_isUpdateRequested() const
         {
-            _enabled = value;
+            return _updateRequested;
         }
 
         inline const std::shared_ptr<ResourceSystem>& IObject::_getResourceSystem() const
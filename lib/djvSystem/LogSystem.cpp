@@ -14,10 +14,15 @@
 #include <djvCore/OSFunc.h>
 #include <djvCore/TimeFunc.h>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstring>
+#include <ctime>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <list>
 #include <map>
 #include <mutex>
@@ -33,20 +38,144 @@ namespace djv
         {
             const std::string name = "djv::System::LogSystem";
 
+            //! \todo Should this be configurable?
+            const size_t ringSize       = 1024;
+            const size_t prefixSizeMax  = 64;
+            const size_t textSizeMax    = 256;
+
             struct Message
             {
+                Message()
+                {}
+
                 Message(
+                    uint64_t           id,
                     const std::string& prefix,
                     const std::string& text,
-                    LogLevel level) :
+                    LogLevel           level,
+                    std::time_t        time) :
+                    id(id),
                     prefix(prefix),
                     text(text),
-                    level(level)
+                    level(level),
+                    time(time)
                 {}
 
+                uint64_t id = 0;
                 std::string prefix;
                 std::string text;
                 LogLevel level = LogLevel::Information;
+                std::time_t time = 0;
+            };
+
+            //! This struct provides a fixed size log record. The record only
+            //! holds the raw message, formatting is done by the writer thread.
+            struct Record
+            {
+                std::atomic<size_t> sequence;
+                uint64_t            id          = 0;
+                LogLevel            level       = LogLevel::Information;
+                std::time_t         time        = 0;
+                uint8_t             prefixSize  = 0;
+                char                prefix[prefixSizeMax];
+                uint16_t            textSize    = 0;
+                char                text[textSizeMax];
+            };
+
+            //! This class provides a bounded lock-free queue of log records
+            //! with multiple producers and a single consumer.
+            //!
+            //! References:
+            //! - Dmitry Vyukov, "Bounded MPMC queue"
+            class Ring
+            {
+            public:
+                Ring() :
+                    _records(new Record[ringSize]),
+                    _enqueuePos(0)
+                {
+                    for (size_t i = 0; i < ringSize; ++i)
+                    {
+                        _records[i].sequence.store(i, std::memory_order_relaxed);
+                    }
+                }
+
+                //! Add a message. Returns false if the queue is full or the
+                //! message does not fit in a record.
+                bool push(uint64_t id, const std::string& prefix, const std::string& text, LogLevel level, std::time_t time)
+                {
+                    if (prefix.size() > prefixSizeMax || text.size() > textSizeMax)
+                    {
+                        return false;
+                    }
+                    Record* record = nullptr;
+                    size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+                    while (true)
+                    {
+                        record = &_records[pos & (ringSize - 1)];
+                        const size_t sequence = record->sequence.load(std::memory_order_acquire);
+                        const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+                        if (0 == diff)
+                        {
+                            if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                            {
+                                break;
+                            }
+                        }
+                        else if (diff < 0)
+                        {
+                            return false;
+                        }
+                        else
+                        {
+                            pos = _enqueuePos.load(std::memory_order_relaxed);
+                        }
+                    }
+                    record->id = id;
+                    record->level = level;
+                    record->time = time;
+                    record->prefixSize = static_cast<uint8_t>(prefix.size());
+                    memcpy(record->prefix, prefix.data(), prefix.size());
+                    record->textSize = static_cast<uint16_t>(text.size());
+                    memcpy(record->text, text.data(), text.size());
+                    record->sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+
+                //! Get whether there are messages available. This should only
+                //! be called by the consumer.
+                bool isEmpty() const
+                {
+                    const Record& record = _records[_dequeuePos & (ringSize - 1)];
+                    return record.sequence.load(std::memory_order_acquire) != _dequeuePos + 1;
+                }
+
+                //! Move the available messages to the list. This should only
+                //! be called by the consumer.
+                void pop(std::vector<Message>& out)
+                {
+                    while (true)
+                    {
+                        Record& record = _records[_dequeuePos & (ringSize - 1)];
+                        if (record.sequence.load(std::memory_order_acquire) != _dequeuePos + 1)
+                        {
+                            break;
+                        }
+                        out.push_back(Message(
+                            record.id,
+                            std::string(record.prefix, record.prefixSize),
+                            std::string(record.text, record.textSize),
+                            record.level,
+                            record.time));
+                        record.sequence.store(_dequeuePos + ringSize, std::memory_order_release);
+                        ++_dequeuePos;
+                    }
+                }
+
+            private:
+                std::unique_ptr<Record[]> _records;
+                std::atomic<size_t> _enqueuePos;
+                size_t _dequeuePos = 0;
             };
 
         } // namespace
@@ -55,13 +184,23 @@ namespace djv
         {
             File::Path path;
             std::atomic<bool> consoleOutput;
+            std::atomic<int> level;
             std::vector<std::string> warnings;
             std::shared_ptr<Observer::ListSubject<std::string> > warningsSubject;
             std::vector<std::string> errors;
             std::shared_ptr<Observer::ListSubject<std::string> > errorsSubject;
+
+            // Messages are added to the ring without locking. Messages that
+            // do not fit in a record, or that are added when the ring is
+            // full, are added to the queue instead.
+            Ring ring;
+            std::atomic<uint64_t> messageID;
             std::list<Message> queue;
             std::condition_variable queueCV;
-            std::list<Message> messages;
+            std::vector<Message> messages;
+            uint64_t nextID = 0;
+            uint64_t gapID = std::numeric_limits<uint64_t>::max();
+            std::chrono::steady_clock::time_point gapTime;
             std::mutex mutex;
             std::thread thread;
             std::atomic<bool> running;
@@ -78,6 +217,15 @@ namespace djv
             
             p.path = resourceSystem->getPath(File::ResourcePath::LogFile);
             p.consoleOutput = false;
+            p.level = static_cast<int>(LogLevel::Information);
+            int env = 0;
+            if (OS::getIntEnv("DJV_LOG_LEVEL", env))
+            {
+                p.level = std::max(
+                    static_cast<int>(LogLevel::Information),
+                    std::min(env, static_cast<int>(LogLevel::Error)));
+            }
+            p.messageID = 0;
             p.warningsSubject = Observer::ListSubject<std::string>::create();
             p.errorsSubject = Observer::ListSubject<std::string>::create();
 
@@ -110,23 +258,36 @@ namespace djv
                 while (p.running)
                 {
                     {
+                        // Producers do not hold the mutex when they notify, so
+                        // a wakeup can be missed, in which case the messages
+                        // are written after the timeout.
                         std::unique_lock<std::mutex> lock(p.mutex);
                         p.queueCV.wait_for(
                             lock,
                             std::chrono::milliseconds(timeout),
                             [this]
                         {
-                            return _p->queue.size();
+                            return _p->queue.size() || !_p->ring.isEmpty();
                         });
-                        p.messages = std::move(p.queue);
+                        p.messages.insert(
+                            p.messages.end(),
+                            std::make_move_iterator(p.queue.begin()),
+                            std::make_move_iterator(p.queue.end()));
+                        p.queue.clear();
                     }
-                    _writeMessages();
+                    p.ring.pop(p.messages);
+                    _writeMessages(false);
                 }
                 {
                     std::unique_lock<std::mutex> lock(p.mutex);
-                    p.messages = std::move(p.queue);
+                    p.messages.insert(
+                        p.messages.end(),
+                        std::make_move_iterator(p.queue.begin()),
+                        std::make_move_iterator(p.queue.end()));
+                    p.queue.clear();
                 }
-                _writeMessages();
+                p.ring.pop(p.messages);
+                _writeMessages(true);
             });
 
             p.warningsAndErrorsTimer = Timer::create(context);
@@ -185,13 +346,35 @@ namespace djv
         void LogSystem::log(const std::string& prefix, const std::string& message, LogLevel level)
         {
             DJV_PRIVATE_PTR();
+            if (!isEnabled(level))
+            {
+                return;
+            }
+            const uint64_t id = p.messageID.fetch_add(1, std::memory_order_relaxed);
+            const std::time_t time = std::time(nullptr);
+            if (!p.ring.push(id, prefix, message, level, time))
             {
                 std::unique_lock<std::mutex> lock(p.mutex);
-                p.queue.push_back(Message(prefix, message, level));
+                p.queue.push_back(Message(id, prefix, message, level, time));
             }
             p.queueCV.notify_one();
         }
 
+        bool LogSystem::isEnabled(LogLevel value) const
+        {
+            return static_cast<int>(value) >= _p->level.load(std::memory_order_relaxed);
+        }
+
+        LogLevel LogSystem::getLevel() const
+        {
+            return static_cast<LogLevel>(_p->level.load());
+        }
+
+        void LogSystem::setLevel(LogLevel value)
+        {
+            _p->level = static_cast<int>(value);
+        }
+
         bool LogSystem::hasConsoleOutput() const
         {
             return _p->consoleOutput;
@@ -212,7 +395,7 @@ namespace djv
             return _p->errorsSubject;
         }
 
-        void LogSystem::_writeMessages()
+        void LogSystem::_writeMessages(bool flush)
         {
             DJV_PRIVATE_PTR();
             try
@@ -231,8 +414,48 @@ namespace djv
                     { LogLevel::Error, "[ERROR]" }
                 };
 
-                for (const auto& message : p.messages)
+                // Messages from the ring and the queue may be interleaved.
+                std::sort(
+                    p.messages.begin(),
+                    p.messages.end(),
+                    [](const Message& a, const Message& b)
+                    {
+                        return a.id < b.id;
+                    });
+
+                // A producer may have taken an ID but not added its message
+                // yet, so messages after a gap in the IDs are held back until
+                // the next pass. A gap that lasts longer than the timeout is
+                // skipped, and a message that arrives after its gap was
+                // skipped is written immediately.
+                const auto now = std::chrono::steady_clock::now();
+                const auto gapTimeout = std::chrono::milliseconds(getTimerValue(TimerValue::Slow));
+                size_t count = 0;
+                for (; count < p.messages.size(); ++count)
                 {
+                    const uint64_t id = p.messages[count].id;
+                    if (id > p.nextID && !flush)
+                    {
+                        if (p.nextID != p.gapID)
+                        {
+                            p.gapID = p.nextID;
+                            p.gapTime = now;
+                            break;
+                        }
+                        else if (now - p.gapTime < gapTimeout)
+                        {
+                            break;
+                        }
+                    }
+                    p.nextID = std::max(p.nextID, id + 1);
+                }
+
+                std::string buf;
+                std::time_t time = 0;
+                std::string timeString;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const auto& message = p.messages[i];
                     switch (message.level)
                     {
                     case LogLevel::Warning: warnings.push_back(message.text); break;
@@ -244,11 +467,17 @@ namespace djv
                     std::stringstream s(message.text);
                     while (std::getline(s, line))
                     {
+                        if (message.time != time || timeString.empty())
+                        {
+                            time = message.time;
+                            std::tm tm;
+                            Time::localtime(&time, &tm);
+                            std::stringstream s3;
+                            s3 << std::put_time(&tm, "%c");
+                            timeString = s3.str();
+                        }
                         std::stringstream s2;
-                        const std::time_t t = std::time(nullptr);
-                        std::tm tm;
-                        Time::localtime(&t, &tm);
-                        s2 << std::put_time(&tm, "%c") << " ";
+                        s2 << timeString << " ";
                         s2 << std::setfill(' ');
                         s2 << std::right;
                         s2 << std::setw(32);
@@ -260,14 +489,17 @@ namespace djv
                             s2 << label << " ";
                         }
                         s2 << line << std::endl;
-                        io->write(s2.str());
-                        if (p.consoleOutput)
-                        {
-                            std::cerr << s2.str();
-                        }
+                        buf += s2.str();
                     }
                 }
-                p.messages.clear();
+                p.messages.erase(p.messages.begin(), p.messages.begin() + count);
+
+                // Write the batch of messages at once.
+                io->write(buf);
+                if (p.consoleOutput)
+                {
+                    std::cerr << buf;
+                }
                 if (warnings.size() || errors.size())
                 {
                     std::unique_lock<std::mutex> lock(p.mutex);
@@ -283,6 +515,7 @@ namespace djv
             }
             catch (const std::exception& e)
             {
+                p.messages.clear();
                 std::cerr << name << ": " << e.what() << std::endl;
             }
         }
@@ -17,6 +17,13 @@ namespace djv
         //! Logging output is written to the given file, and can also be written to
         //! std::cout if the environment variable DJV_LOG_CONSOLE is set to a non-zero
         //! value.
+        //!
+        //! Messages are added to a lock-free queue and written in batches by a
+        //! separate thread. Messages below the log level are discarded, the
+        //! level can also be set with the environment variable DJV_LOG_LEVEL
+        //! (0 = information, 1 = warning, 2 = error). Callers that format
+        //! messages in performance sensitive code should check isEnabled()
+        //! first.
         class LogSystem : public ISystemBase
         {
             DJV_NON_COPYABLE(LogSystem);
@@ -32,9 +39,12 @@ namespace djv
             //! \name Messages
             ///@{
 
-            //! Log a message.
+            //! Log a message. This function is thread safe.
             void log(const std::string& prefix, const std::string& message, LogLevel = LogLevel::Information);
 
+            //! Get whether messages with the given level are logged.
+            bool isEnabled(LogLevel) const;
+
             ///@}
 
             //! \name Warning and Errors
@@ -51,11 +61,17 @@ namespace djv
             bool hasConsoleOutput() const;
             
             void setConsoleOutput(bool);
+
+            //! Get the minimum level of messages that are logged.
+            LogLevel getLevel() const;
+
+            //! Set the minimum level of messages that are logged.
+            void setLevel(LogLevel);
             
             ///@}
 
         private:
-            void _writeMessages();
+            void _writeMessages(bool flush);
 
             DJV_PRIVATE();
         };
@@ -25,6 +25,7 @@
 #include <map>
 #include <mutex>
 #include <set>
+#include <unordered_map>
 
 //#pragma optimize("", off)
 
@@ -51,20 +52,26 @@ namespace djv
             std::string systemLocale;
             std::shared_ptr<Observer::ValueSubject<std::string> > currentLocale;
 
-            typedef std::map<std::string, std::map<std::string, std::string> > TextMap;
-            TextMap text;
+            // Only the text for the locales that have been used is loaded.
+            typedef std::unordered_map<std::string, std::string> TextMap;
+            typedef std::pair<std::string, TextMap> LocaleTextMap;
+            std::set<std::string> loadedLocales;
+            std::map<std::string, TextMap> text;
+            const TextMap* currentText = nullptr;
             std::shared_ptr<Observer::ValueSubject<bool> > textChanged;
 
             mutable std::mutex mutex;
-            std::vector<std::future<TextMap> > readFutures;
+            std::vector<std::future<LocaleTextMap> > readFutures;
             std::shared_ptr<Timer> timer;
             std::shared_ptr<File::DirectoryWatcher> directoryWatcher;
 
             std::vector<File::Info> getTextFiles() const;
 
+            void load(const std::string& locale);
             void reload(const File::Info&);
 
-            TextMap readText(const File::Info&);
+            LocaleTextMap readText(const File::Info&);
+            bool addText(const LocaleTextMap&);
             void readAllFutures();
 
             void startTimer();
@@ -73,6 +80,16 @@ namespace djv
 
         namespace
         {
+            std::string getLocale(const File::Info& textFile)
+            {
+                std::string out = File::Path(textFile.getPath().getBaseName()).getExtension();
+                if (out.size() && '.' == out[0])
+                {
+                    out.erase(out.begin());
+                }
+                return out;
+            }
+
             std::string parseLocale(const std::string& value)
             {
                 std::string locale = value;
@@ -163,14 +180,10 @@ namespace djv
             std::set<std::string> localeSet;
             for (const auto& textFile : p.textFiles)
             {
-                std::string temp = File::Path(textFile.getPath().getBaseName()).getExtension();
-                if (temp.size() && '.' == temp[0])
+                const std::string locale = getLocale(textFile);
+                if (locale != "all")
                 {
-                    temp.erase(temp.begin());
-                }
-                if (temp != "all")
-                {
-                    localeSet.insert(temp);
+                    localeSet.insert(locale);
                 }
             }
             for (const auto& locale : localeSet)
@@ -240,11 +253,12 @@ namespace djv
                 p.logSystem->log(getSystemName(), ss.str());
             }
 
-            // Load the text.
-            for (const auto& j : p.textFiles)
-            {
-                p.reload(j);
-            }
+            // Create a timer to wait for text files to be read.
+            p.timer = Timer::create(context);
+            p.timer->setRepeating(true);
+
+            // Load the text for the current locale.
+            p.load(p.currentLocale->get());
 
             // Start a directory watcher to check for changes to the text files.
             p.directoryWatcher = File::DirectoryWatcher::create(context);
@@ -254,14 +268,13 @@ namespace djv
                 {
                     for (const auto& j : _p->textFiles)
                     {
-                        _p->reload(j);
+                        if (_p->loadedLocales.find(getLocale(j)) != _p->loadedLocales.end())
+                        {
+                            _p->reload(j);
+                        }
                     }
                     _p->startTimer();
                 });
-            
-            // Create a timer to wait for text files to be read.
-            p.timer = Timer::create(context);
-            p.timer->setRepeating(true);
         }
 
         TextSystem::TextSystem() :
@@ -302,6 +315,12 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (p.currentLocale->setIfChanged(value))
             {
+                p.load(value);
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex);
+                    const auto i = p.text.find(value);
+                    p.currentText = i != p.text.end() ? &i->second : nullptr;
+                }
                 p.textChanged->setAlways(true);
             }
         }
@@ -309,16 +328,18 @@ namespace djv
         const std::string& TextSystem::getText(const std::string& id)
         {
             DJV_PRIVATE_PTR();
-            p.readAllFutures();
+            if (!p.readFutures.empty())
+            {
+                p.readAllFutures();
+            }
             {
                 std::unique_lock<std::mutex> lock(p.mutex);
-                const auto i = p.text.find(p.currentLocale->get());
-                if (i != p.text.end())
+                if (p.currentText)
                 {
-                    const auto j = i->second.find(id);
-                    if (j != i->second.end())
+                    const auto i = p.currentText->find(id);
+                    if (i != p.currentText->end())
                     {
-                        return j->second;
+                        return i->second;
                     }
                 }
             }
@@ -328,17 +349,19 @@ namespace djv
         const std::string& TextSystem::getID(const std::string& text)
         {
             DJV_PRIVATE_PTR();
-            p.readAllFutures();
+            if (!p.readFutures.empty())
+            {
+                p.readAllFutures();
+            }
             {
                 std::unique_lock<std::mutex> lock(p.mutex);
-                const auto i = p.text.find(p.currentLocale->get());
-                if (i != p.text.end())
+                if (p.currentText)
                 {
-                    for (const auto& j : i->second)
+                    for (const auto& i : *p.currentText)
                     {
-                        if (text == j.second)
+                        if (text == i.second)
                         {
-                            return j.first;
+                            return i.first;
                         }
                     }
                 }
@@ -387,6 +410,22 @@ namespace djv
             return out;
         }
         
+        void TextSystem::Private::load(const std::string& locale)
+        {
+            if (loadedLocales.find(locale) == loadedLocales.end())
+            {
+                loadedLocales.insert(locale);
+                for (const auto& i : textFiles)
+                {
+                    if (locale == getLocale(i))
+                    {
+                        reload(i);
+                    }
+                }
+                startTimer();
+            }
+        }
+
         void TextSystem::Private::reload(const File::Info& value)
         {
             auto info = value;
@@ -398,19 +437,14 @@ namespace djv
                 }));
         }
 
-        TextSystem::Private::TextMap TextSystem::Private::readText(const File::Info& textFile)
+        TextSystem::Private::LocaleTextMap TextSystem::Private::readText(const File::Info& textFile)
         {
-            TextMap out;
+            LocaleTextMap out;
+            out.first = getLocale(textFile);
             try
             {
                 const auto& path = textFile.getPath();
-                const auto& baseName = path.getBaseName();
-                std::string locale;
-                for (auto j = baseName.rbegin(); j != baseName.rend() && *j != '.'; ++j)
-                {
-                    locale.insert(locale.begin(), *j);
-                }
-                
+
                 auto fileIO = File::IO::create();
                 fileIO->open(path.get(), File::Mode::Read);
                 size_t bufSize = 0;
@@ -442,16 +476,17 @@ namespace djv
                         arg("Character").
                         arg(character));
                 }
+                out.second.reserve(document.MemberCount());
                 for (const auto& i: document.GetObject())
                 {
                     if (i.value.IsString())
                     {
-                        out[locale][i.name.GetString()] = i.value.GetString();
+                        out.second[i.name.GetString()] = i.value.GetString();
                     }
                 }
                 {
                     std::stringstream ss;
-                    ss << textFile.getPath().get() << "' strings: " << out[locale].size();
+                    ss << textFile.getPath().get() << "' strings: " << out.second.size();
                     logSystem->log(p.getSystemName(), ss.str());
                 }
             }
@@ -462,21 +497,26 @@ namespace djv
             return out;
         }
         
+        bool TextSystem::Private::addText(const LocaleTextMap& value)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            auto& localeText = text[value.first];
+            for (const auto& i : value.second)
+            {
+                localeText[i.first] = i.second;
+            }
+            const auto i = text.find(currentLocale->get());
+            currentText = i != text.end() ? &i->second : nullptr;
+            return !value.second.empty();
+        }
+
         void TextSystem::Private::readAllFutures()
         {
             timer->stop();
             bool textChanged = false;
             for (auto& j : readFutures)
             {
-                for (const auto& k : j.get())
-                {
-                    std::unique_lock<std::mutex> lock(mutex);
-                    for (const auto& l : k.second)
-                    {
-                        text[k.first][l.first] = l.second;
-                        textChanged = true;
-                    }
-                }
+                textChanged |= addText(j.get());
             }
             readFutures.clear();
             if (textChanged)
@@ -498,15 +538,7 @@ namespace djv
                         if (j->valid() &&
                             j->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                         {
-                            for (const auto& k : j->get())
-                            {
-                                std::unique_lock<std::mutex> lock(mutex);
-                                for (const auto& l : k.second)
-                                {
-                                    text[k.first][l.first] = l.second;
-                                    textChanged = true;
-                                }
-                            }
+                            textChanged |= addText(j->get());
                             j = readFutures.erase(j);
                         }
                         else
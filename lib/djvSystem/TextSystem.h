@@ -25,6 +25,9 @@ namespace djv
         //! - File::ResourcePath::Documents
         //! - DJV_TEXT environment variable, a list of colon (Linux/macOS)
         //!   or semicolon (Windows) separated paths to search
+        //!
+        //! Only the text files for the current locale are read, the text for
+        //! other locales is read when they are first made current.
         class TextSystem : public ISystemBase
         {
             DJV_NON_COPYABLE(TextSystem);
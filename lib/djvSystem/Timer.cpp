@@ -113,6 +113,31 @@ namespace djv
             }
         }
 
+        bool TimerSystem::getNextTimeout(Time::TimePoint& value) const
+        {
+            DJV_PRIVATE_PTR();
+            bool out = false;
+            for (const auto* i : { &p.timers, &p.newTimers })
+            {
+                for (const auto& j : *i)
+                {
+                    if (auto timer = j.lock())
+                    {
+                        if (timer->isActive())
+                        {
+                            const auto timeout = timer->_start + timer->_timeout;
+                            if (!out || timeout < value)
+                            {
+                                value = timeout;
+                                out = true;
+                            }
+                        }
+                    }
+                }
+            }
+            return out;
+        }
+
         void TimerSystem::_addTimer(const std::weak_ptr<Timer>& value)
         {
             _p->newTimers.push_back(value);
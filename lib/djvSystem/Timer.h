@@ -94,6 +94,10 @@ namespace djv
 
             void tick() override;
 
+            //! Get the time when the next active timer times out. Returns
+            //! false if there are no active timers.
+            bool getNextTimeout(Core::Time::TimePoint&) const;
+
         private:
             void _addTimer(const std::weak_ptr<Timer>&);
 
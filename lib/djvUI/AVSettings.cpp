@@ -83,7 +83,12 @@ namespace djv
                 rapidjson::Value out(rapidjson::kObjectType);
                 for (const auto& i : p.ioSystem->getPluginNames())
                 {
-                    out.AddMember(rapidjson::Value(i.c_str(), allocator), p.ioSystem->getOptions(i, allocator), allocator);
+                    // Plugins that have not been used have no options.
+                    auto options = p.ioSystem->getOptions(i, allocator);
+                    if (!options.IsNull())
+                    {
+                        out.AddMember(rapidjson::Value(i.c_str(), allocator), options, allocator);
+                    }
                 }
                 write("TimeUnits", p.avSystem->observeTimeUnits()->get(), out, allocator);
                 write("DefaultSpeed", p.avSystem->observeDefaultSpeed()->get(), out, allocator);
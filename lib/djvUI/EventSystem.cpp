@@ -322,16 +322,5 @@ namespace djv
             }
         }
 
-        void EventSystem::_update(System::Event::Update& event)
-        {
-            for (const auto& i : _p->windows)
-            {
-                if (auto window = i.lock())
-                {
-                    _updateRecursive(window, event);
-                }
-            }
-        }
-
     } // namespace UI
 } // namespace djv
@@ -63,7 +63,6 @@ namespace djv
                 System::Event::PaintOverlay&);
 
             void _init(System::Event::Init&) override;
-            void _update(System::Event::Update&) override;
 
         private:
             DJV_PRIVATE();
@@ -75,6 +75,7 @@ namespace djv
                     auto iconSystem = context->getSystemT<IconSystem>();
                     const auto& style = _getStyle();
                     p.imageFuture = iconSystem->getIcon(p.name, style->getMetric(MetricsRole::Icon));
+                    _requestUpdate();
                 }
                 else
                 {
@@ -208,6 +209,7 @@ namespace djv
                         auto iconSystem = context->getSystemT<IconSystem>();
                         const auto& style = _getStyle();
                         p.imageFuture = iconSystem->getIcon(p.name, style->getMetric(MetricsRole::Icon));
+                        _requestUpdate();
                     }
                 }
             }
@@ -230,6 +232,10 @@ namespace djv
                 }
                 _resize();
             }
+            if (p.imageFuture.valid())
+            {
+                _requestUpdate();
+            }
         }
             
     } // namespace UI
@@ -0,0 +1,295 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvUI/IconPack.h>
+
+#include <djvImage/Data.h>
+
+#include <djvSystem/File.h>
+#include <djvSystem/FileIO.h>
+
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <set>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace UI
+    {
+        namespace
+        {
+            const char     fileMagic[] = "djvIconPack";
+            const uint32_t fileVersion = 1;
+            const size_t   headerSize  = sizeof(fileMagic) + sizeof(uint32_t) + sizeof(uint64_t);
+
+            typedef std::pair<std::string, uint16_t> Key;
+
+            struct Entry
+            {
+                Image::Info info;
+
+                //! The offset of the image data in the pack file, relative to
+                //! the end of the index.
+                uint64_t dataOffset = 0;
+
+                //! Image data that has not been written to the pack file yet.
+                std::shared_ptr<Image::Data> data;
+            };
+
+            //! The pack file is created on the machine it is used on, so
+            //! values are written in the native byte order.
+            template<typename T>
+            void writeValue(std::vector<uint8_t>& data, T value)
+            {
+                const size_t size = data.size();
+                data.resize(size + sizeof(T));
+                memcpy(data.data() + size, &value, sizeof(T));
+            }
+
+            void writeString(std::vector<uint8_t>& data, const std::string& value)
+            {
+                writeValue(data, static_cast<uint32_t>(value.size()));
+                data.insert(data.end(), value.begin(), value.end());
+            }
+
+            std::string getErrorMessage(const std::string& fileName)
+            {
+                //! \todo How can we translate this?
+                return fileName + ": Invalid icon pack.";
+            }
+
+            //! Throws:
+            //! - System::File::Error
+            template<typename T>
+            T readValue(const uint8_t*& p, const uint8_t* end, const std::string& fileName)
+            {
+                if (sizeof(T) > static_cast<size_t>(end - p))
+                {
+                    throw System::File::Error(getErrorMessage(fileName));
+                }
+                T out;
+                memcpy(&out, p, sizeof(T));
+                p += sizeof(T);
+                return out;
+            }
+
+            //! Throws:
+            //! - System::File::Error
+            std::string readString(const uint8_t*& p, const uint8_t* end, const std::string& fileName)
+            {
+                const size_t size = readValue<uint32_t>(p, end, fileName);
+                if (size > static_cast<size_t>(end - p))
+                {
+                    throw System::File::Error(getErrorMessage(fileName));
+                }
+                const std::string out(reinterpret_cast<const char*>(p), size);
+                p += size;
+                return out;
+            }
+
+        } // namespace
+
+        struct IconPack::Private
+        {
+            std::map<Key, Entry> entries;
+            std::set<uint16_t> dpiSet;
+            std::shared_ptr<System::File::IO> io;
+            uint64_t dataStart = 0;
+            std::mutex mutex;
+        };
+
+        IconPack::IconPack() :
+            _p(new Private)
+        {}
+
+        IconPack::~IconPack()
+        {}
+
+        std::shared_ptr<IconPack> IconPack::create()
+        {
+            return std::shared_ptr<IconPack>(new IconPack);
+        }
+
+        std::vector<uint16_t> IconPack::getDPIList() const
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            return std::vector<uint16_t>(p.dpiSet.begin(), p.dpiSet.end());
+        }
+
+        size_t IconPack::getCount() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->entries.size();
+        }
+
+        std::shared_ptr<Image::Data> IconPack::getIcon(const std::string& name, uint16_t dpi) const
+        {
+            DJV_PRIVATE_PTR();
+            std::shared_ptr<Image::Data> out;
+            std::lock_guard<std::mutex> lock(p.mutex);
+            const auto i = p.entries.find(Key(name, dpi));
+            if (i != p.entries.end())
+            {
+                if (i->second.data)
+                {
+                    out = i->second.data;
+                }
+                else if (p.io)
+                {
+                    auto data = Image::Data::create(i->second.info);
+                    p.io->setPos(p.dataStart + i->second.dataOffset);
+                    p.io->read(data->getData(), data->getDataByteCount());
+                    out = data;
+                }
+            }
+            return out;
+        }
+
+        void IconPack::addIcon(const std::string& name, uint16_t dpi, const std::shared_ptr<Image::Data>& data)
+        {
+            DJV_PRIVATE_PTR();
+            if (!data)
+            {
+                return;
+            }
+            Entry entry;
+            entry.info = data->getInfo();
+            entry.data = data;
+            std::lock_guard<std::mutex> lock(p.mutex);
+            p.entries[Key(name, dpi)] = std::move(entry);
+            p.dpiSet.insert(dpi);
+        }
+
+        void IconPack::read(const std::string& fileName)
+        {
+            DJV_PRIVATE_PTR();
+            auto io = System::File::IO::create();
+            io->open(fileName, System::File::Mode::Read);
+
+            // Read the header.
+            std::vector<uint8_t> header(headerSize);
+            io->read(header.data(), header.size());
+            const uint8_t* headerP = header.data();
+            const uint8_t* headerEnd = headerP + header.size();
+            if (memcmp(headerP, fileMagic, sizeof(fileMagic)) != 0)
+            {
+                throw System::File::Error(getErrorMessage(fileName));
+            }
+            headerP += sizeof(fileMagic);
+            if (readValue<uint32_t>(headerP, headerEnd, fileName) != fileVersion)
+            {
+                throw System::File::Error(getErrorMessage(fileName));
+            }
+            const uint64_t indexByteCount = readValue<uint64_t>(headerP, headerEnd, fileName);
+            if (headerSize + indexByteCount > io->getSize())
+            {
+                throw System::File::Error(getErrorMessage(fileName));
+            }
+            const uint64_t dataStart = headerSize + indexByteCount;
+            const uint64_t dataByteCount = io->getSize() - dataStart;
+
+            // Read the index.
+            std::vector<uint8_t> index(indexByteCount);
+            io->read(index.data(), index.size());
+            const uint8_t* indexP = index.data();
+            const uint8_t* indexEnd = indexP + index.size();
+            std::map<Key, Entry> entries;
+            std::set<uint16_t> dpiSet;
+            const uint32_t count = readValue<uint32_t>(indexP, indexEnd, fileName);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const std::string name = readString(indexP, indexEnd, fileName);
+                const uint16_t dpi = readValue<uint16_t>(indexP, indexEnd, fileName);
+                Entry entry;
+                entry.info.size.w = readValue<uint16_t>(indexP, indexEnd, fileName);
+                entry.info.size.h = readValue<uint16_t>(indexP, indexEnd, fileName);
+                const uint8_t type = readValue<uint8_t>(indexP, indexEnd, fileName);
+                entry.info.layout.mirror.x = readValue<uint8_t>(indexP, indexEnd, fileName) != 0;
+                entry.info.layout.mirror.y = readValue<uint8_t>(indexP, indexEnd, fileName) != 0;
+                entry.info.layout.alignment = readValue<int32_t>(indexP, indexEnd, fileName);
+                const uint8_t endian = readValue<uint8_t>(indexP, indexEnd, fileName);
+                entry.dataOffset = readValue<uint64_t>(indexP, indexEnd, fileName);
+                if (type >= static_cast<uint8_t>(Image::Type::Count) ||
+                    endian >= static_cast<uint8_t>(Memory::Endian::Count))
+                {
+                    throw System::File::Error(getErrorMessage(fileName));
+                }
+                entry.info.type = static_cast<Image::Type>(type);
+                entry.info.layout.endian = static_cast<Memory::Endian>(endian);
+                if (entry.dataOffset + entry.info.getDataByteCount() > dataByteCount)
+                {
+                    throw System::File::Error(getErrorMessage(fileName));
+                }
+                entries[Key(name, dpi)] = std::move(entry);
+                dpiSet.insert(dpi);
+            }
+
+            std::lock_guard<std::mutex> lock(p.mutex);
+            p.entries = std::move(entries);
+            p.dpiSet = std::move(dpiSet);
+            p.io = io;
+            p.dataStart = dataStart;
+        }
+
+        void IconPack::write(const std::string& fileName)
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+
+            // Read any image data that is only in the current pack file and
+            // assign the data offsets.
+            uint64_t dataOffset = 0;
+            for (auto& i : p.entries)
+            {
+                if (!i.second.data && p.io)
+                {
+                    auto data = Image::Data::create(i.second.info);
+                    p.io->setPos(p.dataStart + i.second.dataOffset);
+                    p.io->read(data->getData(), data->getDataByteCount());
+                    i.second.data = data;
+                }
+                i.second.dataOffset = dataOffset;
+                dataOffset += i.second.info.getDataByteCount();
+            }
+
+            // Write the index.
+            std::vector<uint8_t> index;
+            writeValue(index, static_cast<uint32_t>(p.entries.size()));
+            for (const auto& i : p.entries)
+            {
+                writeString(index, i.first.first);
+                writeValue(index, static_cast<uint16_t>(i.first.second));
+                writeValue(index, static_cast<uint16_t>(i.second.info.size.w));
+                writeValue(index, static_cast<uint16_t>(i.second.info.size.h));
+                writeValue(index, static_cast<uint8_t>(i.second.info.type));
+                writeValue(index, static_cast<uint8_t>(i.second.info.layout.mirror.x));
+                writeValue(index, static_cast<uint8_t>(i.second.info.layout.mirror.y));
+                writeValue(index, static_cast<int32_t>(i.second.info.layout.alignment));
+                writeValue(index, static_cast<uint8_t>(i.second.info.layout.endian));
+                writeValue(index, static_cast<uint64_t>(i.second.dataOffset));
+            }
+            std::vector<uint8_t> header(fileMagic, fileMagic + sizeof(fileMagic));
+            writeValue(header, fileVersion);
+            writeValue(header, static_cast<uint64_t>(index.size()));
+
+            p.io.reset();
+            auto io = System::File::IO::create();
+            io->open(fileName, System::File::Mode::Write);
+            io->write(header.data(), header.size());
+            io->write(index.data(), index.size());
+            for (const auto& i : p.entries)
+            {
+                if (i.second.data)
+                {
+                    io->write(i.second.data->getData(), i.second.data->getDataByteCount());
+                }
+            }
+        }
+
+    } // namespace UI
+} // namespace djv
@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace djv
+{
+    namespace Image
+    {
+        class Data;
+
+    } // namespace Image
+
+    namespace UI
+    {
+        //! This constant provides the icon pack file name.
+        const std::string iconPackFileName = "djvIcons.pack";
+
+        //! This class provides a pack of decoded icon images.
+        //!
+        //! The icon pack is created at build time by the djv_icon_pack tool
+        //! from the icons in the DPI directories. The pack is a single file
+        //! containing an index and the uncompressed image data, so icons can
+        //! be read without opening or decoding individual image files. The
+        //! index is read when the pack is opened and the image data is read
+        //! from the (memory-mapped) file on demand.
+        class IconPack
+        {
+            DJV_NON_COPYABLE(IconPack);
+
+        protected:
+            IconPack();
+
+        public:
+            ~IconPack();
+
+            //! Create a new icon pack.
+            static std::shared_ptr<IconPack> create();
+
+            //! \name Contents
+            ///@{
+
+            //! Get the DPI values.
+            std::vector<uint16_t> getDPIList() const;
+
+            //! Get the number of icons.
+            size_t getCount() const;
+
+            //! Get an icon. Returns a null pointer if the icon is not in the
+            //! pack.
+            std::shared_ptr<Image::Data> getIcon(const std::string& name, uint16_t dpi) const;
+
+            void addIcon(const std::string& name, uint16_t dpi, const std::shared_ptr<Image::Data>&);
+
+            ///@}
+
+            //! \name Persistence
+            ///@{
+
+            //! Read the icon pack index and open the pack file.
+            //! Throws:
+            //! - System::File::Error
+            void read(const std::string& fileName);
+
+            //! Write the icon pack.
+            //! Throws:
+            //! - System::File::Error
+            void write(const std::string& fileName);
+
+            ///@}
+
+        private:
+            DJV_PRIVATE();
+        };
+
+    } // namespace UI
+} // namespace djv
@@ -4,6 +4,8 @@
 
 #include <djvUI/IconSystem.h>
 
+#include <djvUI/IconPack.h>
+
 #include <djvAV/AVSystem.h>
 #include <djvAV/IOSystem.h>
 
@@ -11,6 +13,7 @@
 
 #include <djvSystem/Context.h>
 #include <djvSystem/File.h>
+#include <djvSystem/FileInfo.h>
 #include <djvSystem/FileInfoFunc.h>
 #include <djvSystem/LogSystem.h>
 #include <djvSystem/ResourceSystem.h>
@@ -82,6 +85,7 @@ namespace djv
         struct IconSystem::Private
         {
             System::File::Path iconPath;
+            std::shared_ptr<IconPack> iconPack;
             std::vector<uint16_t> dpiList;
             std::shared_ptr<AV::IO::IOSystem> io;
             std::list<ImageRequest> imageQueue;
@@ -91,6 +95,7 @@ namespace djv
             std::list<ImageRequest> pendingImageRequests;
 
             Memory::Cache<size_t, std::shared_ptr<Image::Data> > imageCache;
+            std::mutex imageCacheMutex;
             std::atomic<float> imageCachePercentage;
 
             std::shared_ptr<System::Timer> statsTimer;
@@ -110,7 +115,35 @@ namespace djv
             addDependency(AV::AVSystem::create(context));
 
             p.iconPath = context->getSystemT<System::ResourceSystem>()->getPath(System::File::ResourcePath::Icons);
-                        
+
+            // Use the icon pack if it is available, otherwise fall back to
+            // reading the individual icon files.
+            const System::File::Path iconPackPath(p.iconPath, iconPackFileName);
+            if (System::File::Info(iconPackPath).doesExist())
+            {
+                try
+                {
+                    auto iconPack = IconPack::create();
+                    iconPack->read(iconPackPath.get());
+                    std::stringstream ss;
+                    ss << "Icon pack: " << iconPack->getCount() << " icons";
+                    _log(ss.str());
+
+                    // An empty icon pack is ignored so the icon files are
+                    // still found.
+                    const auto dpiList = iconPack->getDPIList();
+                    if (!dpiList.empty())
+                    {
+                        p.dpiList = dpiList;
+                        p.iconPack = iconPack;
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    _log(e.what(), System::LogLevel::Error);
+                }
+            }
+
             p.io = context->getSystemT<AV::IO::IOSystem>();
 
             p.imageCache.setMax(imageCacheMax);
@@ -137,20 +170,23 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 try
                 {
-                    // Find the DPI values.
-                    for (const auto& i : System::File::directoryList(p.iconPath))
+                    // Find the DPI values if the icon pack did not provide them.
+                    if (p.dpiList.empty())
                     {
-                        const std::string fileName = i.getFileName(Math::Frame::invalid, false);
-                        const size_t size = fileName.size();
-                        if (size > 3 &&
-                            fileName[size - 3] == 'D' &&
-                            fileName[size - 2] == 'P' &&
-                            fileName[size - 1] == 'I')
+                        for (const auto& i : System::File::directoryList(p.iconPath))
                         {
-                            p.dpiList.push_back(std::stoi(fileName.substr(0, size - 3)));
+                            const std::string fileName = i.getFileName(Math::Frame::invalid, false);
+                            const size_t size = fileName.size();
+                            if (size > 3 &&
+                                fileName[size - 3] == 'D' &&
+                                fileName[size - 2] == 'P' &&
+                                fileName[size - 1] == 'I')
+                            {
+                                p.dpiList.push_back(std::stoi(fileName.substr(0, size - 3)));
+                            }
                         }
+                        std::sort(p.dpiList.begin(), p.dpiList.end());
                     }
-                    std::sort(p.dpiList.begin(), p.dpiList.end());
                     for (const auto& i : p.dpiList)
                     {
                         std::stringstream ss;
@@ -218,6 +254,38 @@ namespace djv
             DJV_PRIVATE_PTR();
             ImageRequest request(name, static_cast<uint16_t>(Math::clamp(size, 0.F, 65535.F)));
             auto future = request.promise.get_future();
+            if (p.iconPack)
+            {
+                // Icons in the pack are read directly instead of going
+                // through the thread.
+                std::shared_ptr<Image::Data> image;
+                {
+                    std::lock_guard<std::mutex> lock(p.imageCacheMutex);
+                    p.imageCache.get(request.key, image);
+                }
+                if (!image)
+                {
+                    try
+                    {
+                        image = p.iconPack->getIcon(name, p.findClosestDPI(request.size));
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _log(e.what(), System::LogLevel::Error);
+                    }
+                    if (image)
+                    {
+                        std::lock_guard<std::mutex> lock(p.imageCacheMutex);
+                        p.imageCache.add(request.key, image);
+                        p.imageCachePercentage = p.imageCache.getPercentageUsed();
+                    }
+                }
+                if (image)
+                {
+                    request.promise.set_value(image);
+                    return future;
+                }
+            }
             {
                 std::unique_lock<std::mutex> lock(p.requestMutex);
                 p.imageQueue.push_back(std::move(request));
@@ -239,7 +307,10 @@ namespace djv
             for (auto& i : p.newImageRequests)
             {
                 std::shared_ptr<Image::Data> image;
-                p.imageCache.get(i.key, image);
+                {
+                    std::lock_guard<std::mutex> lock(p.imageCacheMutex);
+                    p.imageCache.get(i.key, image);
+                }
                 if (!image)
                 {
                     try
@@ -288,8 +359,11 @@ namespace djv
                 }
                 if (image)
                 {
-                    p.imageCache.add(i->key, image);
-                    p.imageCachePercentage = p.imageCache.getPercentageUsed();
+                    {
+                        std::lock_guard<std::mutex> lock(p.imageCacheMutex);
+                        p.imageCache.add(i->key, image);
+                        p.imageCachePercentage = p.imageCache.getPercentageUsed();
+                    }
                     i->promise.set_value(image);
                     i = p.pendingImageRequests.erase(i);
                 }
@@ -21,6 +21,10 @@ namespace djv
     namespace UI
     {
         //! This class provides an icon system.
+        //!
+        //! Icons are read from the icon pack (see IconPack) when it is
+        //! available. Icons that are not in the pack are read from the
+        //! individual image files on a separate thread.
         class IconSystem : public System::ISystem
         {
             DJV_NON_COPYABLE(IconSystem);
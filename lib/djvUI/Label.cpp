@@ -382,6 +382,13 @@ namespace djv
                         _log(e.what(), System::LogLevel::Error);
                     }
                 }
+                if (p.fontMetricsFuture.valid() ||
+                    p.textSizeFuture.valid() ||
+                    p.sizeStringFuture.valid() ||
+                    p.glyphsFuture.valid())
+                {
+                    _requestUpdate();
+                }
             }
 
             void Label::_textUpdate()
@@ -393,6 +400,7 @@ namespace djv
                     p.glyphs.clear();
                 }
                 p.glyphsFuture = p.fontSystem->getGlyphs(p.text, p.fontInfo, p.textElide);
+                _requestUpdate();
             }
 
             void Label::_sizeStringUpdate()
@@ -401,6 +409,7 @@ namespace djv
                 if (!p.sizeString.empty())
                 {
                     p.sizeStringFuture = p.fontSystem->measure(p.sizeString, p.fontInfo);
+                    _requestUpdate();
                 }
             }
 
@@ -412,6 +421,7 @@ namespace djv
                     style->getFontInfo(p.fontFace, p.fontSizeRole) :
                     style->getFontInfo(p.fontFamily, p.fontFace, p.fontSizeRole);
                 p.fontMetricsFuture = p.fontSystem->getMetrics(p.fontInfo);
+                _requestUpdate();
                 _textUpdate();
                 _sizeStringUpdate();
             }
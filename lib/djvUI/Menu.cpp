@@ -35,6 +35,19 @@ namespace djv
     {
         namespace
         {
+            template<typename T>
+            bool hasValidFutures(const T& value)
+            {
+                for (const auto& i : value)
+                {
+                    if (i.second.valid())
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
             class MenuWidget : public Widget
             {
                 DJV_NON_COPYABLE(MenuWidget);
@@ -565,6 +578,16 @@ namespace djv
                         }
                     }
                 }
+                if (_textUpdateRequest ||
+                    hasValidFutures(_iconFutures) ||
+                    hasValidFutures(_fontMetricsFutures) ||
+                    hasValidFutures(_textSizeFutures) ||
+                    hasValidFutures(_textGlyphsFutures) ||
+                    hasValidFutures(_shortcutSizeFutures) ||
+                    hasValidFutures(_shortcutGlyphsFutures))
+                {
+                    _requestUpdate();
+                }
             }
 
             std::shared_ptr<MenuWidget::Item> MenuWidget::_getItem(const glm::vec2& pos) const
@@ -649,6 +672,7 @@ namespace djv
                                             auto iconSystem = context->getSystemT<IconSystem>();
                                             auto style = widget->_getStyle();
                                             widget->_iconFutures[item] = iconSystem->getIcon(value, style->getMetric(MetricsRole::Icon));
+                                            widget->_requestUpdate();
                                             widget->_resize();
                                         }
                                     }
@@ -662,6 +686,7 @@ namespace djv
                                 {
                                     item->text = value;
                                     widget->_textUpdateRequest = true;
+                                    widget->_requestUpdate();
                                 }
                             });
                         _fontObservers[item] = Observer::Value<std::string>::create(
@@ -672,6 +697,7 @@ namespace djv
                             {
                                 item->font = value;
                                 widget->_textUpdateRequest = true;
+                                widget->_requestUpdate();
                             }
                         });
                         _shortcutsObservers[item] = Observer::List<std::shared_ptr<Shortcut> >::create(
@@ -694,6 +720,7 @@ namespace djv
                                     }
                                     item->shortcutLabel = String::join(labels, ", ");
                                     widget->_textUpdateRequest = true;
+                                    widget->_requestUpdate();
                                 }
                             }
                         });
@@ -733,6 +760,7 @@ namespace djv
                     _shortcutGlyphsFutures[i.second] = _fontSystem->getGlyphs(i.second->shortcutLabel, i.second->fontInfo);
                     _hasShortcuts |= i.second->shortcutLabel.size() > 0;
                 }
+                _requestUpdate();
             }
 
             class MenuPopupWidget : public Widget
@@ -15,6 +15,7 @@
 
 #include <djvCore/Cache.h>
 #include <djvCore/Memory.h>
+#include <djvCore/MemoryFunc.h>
 
 //#pragma optimize("", off)
 
@@ -26,6 +27,22 @@ namespace djv
     {
         namespace Text
         {
+            namespace
+            {
+                typedef std::pair<Render2D::Font::FontInfo, float> TextCacheKey;
+
+                struct TextCacheKeyHash
+                {
+                    size_t operator() (const TextCacheKey& value) const noexcept
+                    {
+                        size_t out = value.first.getHash();
+                        Memory::hashCombine(out, value.second);
+                        return out;
+                    }
+                };
+
+            } // namespace
+
             struct Block::Private
             {
                 std::shared_ptr<Render2D::Font::FontSystem> fontSystem;
@@ -44,9 +61,8 @@ namespace djv
 
                 bool wordWrap = true;
 
-                typedef std::pair<Render2D::Font::FontInfo, float> TextCacheKey;
                 typedef std::pair<std::vector<Render2D::Font::TextLine>, glm::vec2> TextCacheValue;
-                Memory::Cache<TextCacheKey, TextCacheValue> textCache;
+                Memory::Cache<TextCacheKey, TextCacheValue, TextCacheKeyHash> textCache;
 
                 Math::BBox2f clipRect;
 
@@ -298,6 +314,10 @@ namespace djv
                         _log(e.what(), System::LogLevel::Error);
                     }
                 }
+                if (p.fontMetricsFuture.valid())
+                {
+                    _requestUpdate();
+                }
             }
 
             void Block::_textUpdate()
@@ -308,6 +328,7 @@ namespace djv
                     style->getFontInfo(p.fontFace, p.fontSizeRole) :
                     style->getFontInfo(p.fontFamily, p.fontFace, p.fontSizeRole);
                 p.fontMetricsFuture = p.fontSystem->getMetrics(p.fontInfo);
+                _requestUpdate();
                 p.fontSystem->cacheGlyphs(p.text, p.fontInfo);
                 p.textCache.clear();
                 _resize();
@@ -452,6 +452,10 @@ namespace djv
 
         bool Widget::event(System::Event::Event& event)
         {
+            if (System::Event::Type::Update == event.getEventType())
+            {
+                _updateTime = static_cast<System::Event::Update&>(event).getTime();
+            }
             bool out = IObject::event(event);
             if (!out)
             {
@@ -518,9 +522,6 @@ namespace djv
                     break;
                 case System::Event::Type::Update:
                 {
-                    auto& updateEvent = static_cast<System::Event::Update&>(event);
-                    _updateTime = updateEvent.getTime();
-
                     _tooltipsToDelete.clear();
                     if (!_pointerToTooltips.empty())
                     {
@@ -558,6 +559,16 @@ namespace djv
                                 }
                             }
                         }
+
+                        // Keep updating while waiting to show a tooltip.
+                        for (const auto& i : _pointerToTooltips)
+                        {
+                            if (!i.second.tooltip)
+                            {
+                                _requestUpdate();
+                                break;
+                            }
+                        }
                     }
                     break;
                 }
@@ -593,11 +604,16 @@ namespace djv
                     }
                     if (_clipped)
                     {
+                        const auto now = std::chrono::steady_clock::now();
                         for (auto& i : _pointerToTooltips)
                         {
                             _tooltipsToDelete.insert(i.second.tooltip);
                             i.second.tooltip.reset();
-                            i.second.timer = _updateTime;
+                            i.second.timer = now;
+                        }
+                        if (!_pointerToTooltips.empty())
+                        {
+                            _requestUpdate();
                         }
                         releaseTextFocus();
                     }
@@ -639,7 +655,8 @@ namespace djv
                     const auto id = info.id;
                     _pointerHover[id] = info.projectedPos;
                     _pointerToTooltips[id] = TooltipData();
-                    _pointerToTooltips[id].timer = _updateTime;
+                    _pointerToTooltips[id].timer = std::chrono::steady_clock::now();
+                    _requestUpdate();
                     _pointerEnterEvent(static_cast<System::Event::PointerEnter&>(event));
                     break;
                 }
@@ -674,7 +691,8 @@ namespace djv
                         {
                             _tooltipsToDelete.insert(i->second.tooltip);
                             i->second.tooltip.reset();
-                            i->second.timer = _updateTime;
+                            i->second.timer = std::chrono::steady_clock::now();
+                            _requestUpdate();
                         }
                     }
                     _pointerHover[id] = info.projectedPos;
@@ -54,6 +54,7 @@ namespace djv
             struct FileBrowser::Private
             {
                 System::File::DirectoryListOptions options;
+                UI::ViewType viewType = UI::ViewType::First;
                 std::shared_ptr<System::File::DirectoryModel> directoryModel;
                 System::File::Path path;
                 size_t itemCount = 0;
@@ -669,6 +670,8 @@ namespace djv
                         widget->_p->viewTypeActionGroup->setChecked(static_cast<int>(value));
                         widget->_p->listViewHeader->setVisible(UI::ViewType::List == value);
                         widget->_p->itemView->setViewType(value);
+                        widget->_p->viewType = value;
+                        widget->_optionsUpdate();
                     }
                 });
 
@@ -1078,7 +1081,12 @@ namespace djv
 
             void FileBrowser::_optionsUpdate()
             {
-                _p->directoryModel->setOptions(_p->options);
+                DJV_PRIVATE_PTR();
+                // The file system information is only needed for the list
+                // view columns. Getting it for large file sequences on network
+                // file systems can be slow, since each frame is a separate file.
+                p.options.stat = UI::ViewType::List == p.viewType;
+                p.directoryModel->setOptions(p.options);
             }
 
             void FileBrowser::_selectedUpdate()
@@ -354,6 +354,9 @@ namespace djv
                         auto& item = p.items[i];
                         if (item.geometry.intersects(clipRect))
                         {
+                            // Items closer to the top of the view are given
+                            // a higher thumbnail priority.
+                            const size_t priority = static_cast<size_t>(std::max(0.F, item.geometry.min.y - clipRect.min.y));
                             if (item.nameLinesInit)
                             {
                                 item.nameLinesInit = false;
@@ -367,6 +370,7 @@ namespace djv
                                         item.name,
                                         p.thumbnailSize.w - static_cast<uint16_t>(m * 2.F),
                                         fontInfo);
+                                    _requestUpdate();
                                 }
                             }
                             if (item.ioInfoInit)
@@ -380,11 +384,20 @@ namespace djv
                                     {
                                         if (ioSystem->canRead(item.info))
                                         {
-                                            p.ioInfoFutures[i] = thumbnailSystem->getInfo(item.info);
+                                            p.ioInfoFutures[i] = thumbnailSystem->getInfo(item.info, priority);
+                                            _requestUpdate();
                                         }
                                     }
                                 }
                             }
+                            else if (auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>())
+                            {
+                                const auto j = p.ioInfoFutures.find(i);
+                                if (j != p.ioInfoFutures.end())
+                                {
+                                    thumbnailSystem->setInfoPriority(j->second.uid, priority);
+                                }
+                            }
                             if (item.thumbnailInit)
                             {
                                 item.thumbnailInit = false;
@@ -394,10 +407,23 @@ namespace djv
                                     auto ioSystem = context->getSystemT<AV::IO::IOSystem>();
                                     if (thumbnailSystem && ioSystem && ioSystem->canRead(item.info))
                                     {
-                                        p.thumbnailFutures[i] = thumbnailSystem->getImage(item.info, p.thumbnailSize);
+                                        p.thumbnailFutures[i] = thumbnailSystem->getImage(
+                                            item.info,
+                                            p.thumbnailSize,
+                                            Image::Type::None,
+                                            priority);
+                                        _requestUpdate();
                                     }
                                 }
                             }
+                            else if (auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>())
+                            {
+                                const auto j = p.thumbnailFutures.find(i);
+                                if (j != p.thumbnailFutures.end())
+                                {
+                                    thumbnailSystem->setImagePriority(j->second.uid, priority);
+                                }
+                            }
                             if (item.nameGlyphsInit)
                             {
                                 item.nameGlyphsInit = false;
@@ -406,6 +432,7 @@ namespace djv
                                     const std::string& label = item.info.getFileName(Math::Frame::invalid, false);
                                     const auto fontInfo = style->getFontInfo(Render2D::Font::faceDefault, UI::MetricsRole::FontMedium);
                                     p.nameGlyphsFutures[i] = p.fontSystem->getGlyphs(label, fontInfo);
+                                    _requestUpdate();
                                 }
                             }
                             if (item.sizeGlyphsInit)
@@ -421,6 +448,7 @@ namespace djv
                                     ss << _getText(ss2.str());
                                     const auto fontInfo = style->getFontInfo(Render2D::Font::faceDefault, UI::MetricsRole::FontMedium);
                                     p.sizeGlyphsFutures[i] = p.fontSystem->getGlyphs(ss.str(), fontInfo);
+                                    _requestUpdate();
                                 }
                             }
                             if (item.timeGlyphsInit)
@@ -431,6 +459,7 @@ namespace djv
                                     const std::string& label = AV::Time::getLabel(item.info.getTime());
                                     const auto fontInfo = style->getFontInfo(Render2D::Font::faceDefault, UI::MetricsRole::FontMedium);
                                     p.timeGlyphsFutures[i] = p.fontSystem->getGlyphs(label, fontInfo);
+                                    _requestUpdate();
                                 }
                             }
                         }
@@ -1074,6 +1103,18 @@ namespace djv
                         }
                     }
                 }
+                if (p.nameFontMetricsFuture.valid() ||
+                    !p.nameLinesFutures.empty() ||
+                    !p.ioInfoFutures.empty() ||
+                    !p.thumbnailFutures.empty() ||
+                    !p.thumbnailTimers.empty() ||
+                    !p.iconsFutures.empty() ||
+                    !p.nameGlyphsFutures.empty() ||
+                    !p.sizeGlyphsFutures.empty() ||
+                    !p.timeGlyphsFutures.empty())
+                {
+                    _requestUpdate();
+                }
             }
 
             std::vector<System::File::Info> ItemView::_getSelectedItems(const std::set<size_t>& value) const
@@ -1094,14 +1135,20 @@ namespace djv
             std::string ItemView::_getTooltip(const System::File::Info& fileInfo) const
             {
                 std::stringstream ss;
-                ss << fileInfo << '\n';
-                ss << '\n';
-                std::stringstream ss2;
-                const size_t size = fileInfo.getSize();
-                ss2 << Memory::getUnitLabel(size);
-                ss << _getText(DJV_TEXT("file_browser_file_tooltip_size")) << ": " <<
-                    Memory::getSizeLabel(size) << _getText(ss2.str()) << '\n';
-                ss << _getText(DJV_TEXT("file_browser_file_tooltip_last_modification_time")) << ": " << AV::Time::getLabel(fileInfo.getTime());
+                ss << fileInfo;
+                // The file system information is only available when the
+                // directory was listed with it (see FileBrowser::_optionsUpdate()).
+                if (fileInfo.doesExist())
+                {
+                    ss << '\n';
+                    ss << '\n';
+                    std::stringstream ss2;
+                    const size_t size = fileInfo.getSize();
+                    ss2 << Memory::getUnitLabel(size);
+                    ss << _getText(DJV_TEXT("file_browser_file_tooltip_size")) << ": " <<
+                        Memory::getSizeLabel(size) << _getText(ss2.str()) << '\n';
+                    ss << _getText(DJV_TEXT("file_browser_file_tooltip_last_modification_time")) << ": " << AV::Time::getLabel(fileInfo.getTime());
+                }
                 return ss.str();
             }
 
@@ -1180,6 +1227,7 @@ namespace djv
                         default: name = "djvIconFile"; break;
                         }
                         p.iconsFutures[type] = iconSystem->getIcon(name, p.thumbnailSize.h);
+                        _requestUpdate();
                     }
                 }
             }
@@ -1223,11 +1271,16 @@ namespace djv
                                 item.name,
                                 p.thumbnailSize.w - static_cast<uint16_t>(m * 2.F),
                                 fontInfo);
+                            _requestUpdate();
 
                             auto ioSystem = context->getSystemT<AV::IO::IOSystem>();
                             if (ioSystem && ioSystem->canRead(item.info))
                             {
-                                p.thumbnailFutures[i] = thumbnailSystem->getImage(item.info, p.thumbnailSize);
+                                p.thumbnailFutures[i] = thumbnailSystem->getImage(
+                                    item.info,
+                                    p.thumbnailSize,
+                                    Image::Type::None,
+                                    static_cast<size_t>(std::max(0.F, item.geometry.min.y - clipRect.min.y)));
                             }
                         }
                     }
@@ -1242,6 +1295,7 @@ namespace djv
                     const auto& style = _getStyle();
                     p.nameFontMetricsFuture = p.fontSystem->getMetrics(
                         style->getFontInfo(Render2D::Font::faceDefault, UI::MetricsRole::FontMedium));
+                    _requestUpdate();
 
                     auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>();
                     const size_t itemsSize = p.items.size();
@@ -1261,10 +1315,15 @@ namespace djv
                         item.sizeGlyphs.clear();
                         item.timeGlyphsInit = true;
                         item.timeGlyphs.clear();
-                        const auto j = p.thumbnailFutures.find(i);
-                        if (j != p.thumbnailFutures.end())
+                        const auto j = p.ioInfoFutures.find(i);
+                        if (j != p.ioInfoFutures.end())
                         {
-                            thumbnailSystem->cancelImage(j->second.uid);
+                            thumbnailSystem->cancelInfo(j->second.uid);
+                        }
+                        const auto k = p.thumbnailFutures.find(i);
+                        if (k != p.thumbnailFutures.end())
+                        {
+                            thumbnailSystem->cancelImage(k->second.uid);
                         }
                     }
 
@@ -147,6 +147,7 @@ namespace djv
             p.scene = value;
             p.render->setScene(p.scene);
             _sceneUpdate();
+            _requestUpdate();
         }
 
         std::shared_ptr<Observer::IValueSubject<Scene3D::PolarCameraData> > SceneWidget::observeCameraData() const
@@ -159,6 +160,7 @@ namespace djv
             if (_p->cameraData->setIfChanged(value))
             {
                 _p->camera->setData(value);
+                _requestUpdate();
                 _redraw();
             }
         }
@@ -207,6 +209,7 @@ namespace djv
             {
                 p.offscreenBuffer.reset();
                 p.offscreenBuffer2.reset();
+                _requestUpdate();
                 _redraw();
             }
         }
@@ -243,6 +246,7 @@ namespace djv
             auto cameraData = p.cameraData->get();
             cameraData.aspect = p.size.w / static_cast<float>(p.size.h > 0 ? p.size.h : 0);
             setCameraData(cameraData);
+            _requestUpdate();
         }
 
         void SceneWidget::_paintEvent(System::Event::Paint&)
@@ -486,6 +490,7 @@ namespace djv
                 auto cameraData = p.cameraData->get();
                 cameraData.clip = Math::FloatRange(max * nearMult, max * farMult);
                 setCameraData(cameraData);
+                _requestUpdate();
                 _redraw();
             }
         }
@@ -11,9 +11,11 @@
 #include <djvUIComponents/ThermometerWidget.h>
 
 #include <djvUI/Bellows.h>
+#include <djvUI/CheckBox.h>
 #include <djvUI/EventSystem.h>
 #include <djvUI/IconSystem.h>
 #include <djvUI/Label.h>
+#include <djvUI/PushButton.h>
 #include <djvUI/RowLayout.h>
 #include <djvUI/ScrollWidget.h>
 
@@ -24,8 +26,14 @@
 #include <djvAV/ThumbnailSystem.h>
 
 #include <djvSystem/Context.h>
+#include <djvSystem/FileIO.h>
+#include <djvSystem/Path.h>
+#include <djvSystem/ResourceSystem.h>
 #include <djvSystem/TimerFunc.h>
 
+#include <djvCore/ErrorFunc.h>
+#include <djvCore/TraceFunc.h>
+
 using namespace djv::Core;
 
 namespace djv
@@ -779,6 +787,122 @@ namespace djv
                 }
             }
 
+#if defined(DJV_TRACE_ENABLED)
+            class TraceDebugWidget : public UI::Widget
+            {
+                DJV_NON_COPYABLE(TraceDebugWidget);
+
+            protected:
+                void _init(const std::shared_ptr<System::Context>&);
+                TraceDebugWidget();
+
+            public:
+                static std::shared_ptr<TraceDebugWidget> create(const std::shared_ptr<System::Context>&);
+
+            protected:
+                void _preLayoutEvent(System::Event::PreLayout&) override;
+                void _layoutEvent(System::Event::Layout&) override;
+
+                void _initEvent(System::Event::Init&) override;
+
+            private:
+                void _write();
+
+                std::shared_ptr<UI::CheckBox> _enabledCheckBox;
+                std::shared_ptr<UI::PushButton> _writeButton;
+                std::shared_ptr<UI::Text::Label> _fileNameLabel;
+                std::shared_ptr<UI::VerticalLayout> _layout;
+            };
+
+            void TraceDebugWidget::_init(const std::shared_ptr<System::Context>& context)
+            {
+                Widget::_init(context);
+
+                setClassName("djv::ViewApp::TraceDebugWidget");
+
+                _enabledCheckBox = UI::CheckBox::create(context);
+                _enabledCheckBox->setChecked(Trace::isEnabled());
+                _writeButton = UI::PushButton::create(context);
+                _fileNameLabel = UI::Text::Label::create(context);
+                _fileNameLabel->setTextHAlign(UI::TextHAlign::Left);
+                _fileNameLabel->setFontFamily(Render2D::Font::familyMono);
+
+                _layout = UI::VerticalLayout::create(context);
+                _layout->setMargin(UI::MetricsRole::Margin);
+                _layout->addChild(_enabledCheckBox);
+                _layout->addChild(_writeButton);
+                _layout->addChild(_fileNameLabel);
+                addChild(_layout);
+
+                _enabledCheckBox->setCheckedCallback(
+                    [](bool value)
+                    {
+                        if (value)
+                        {
+                            Trace::clear();
+                        }
+                        Trace::setEnabled(value);
+                    });
+
+                auto weak = std::weak_ptr<TraceDebugWidget>(std::dynamic_pointer_cast<TraceDebugWidget>(shared_from_this()));
+                _writeButton->setClickedCallback(
+                    [weak]
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            widget->_write();
+                        }
+                    });
+            }
+
+            TraceDebugWidget::TraceDebugWidget()
+            {}
+
+            std::shared_ptr<TraceDebugWidget> TraceDebugWidget::create(const std::shared_ptr<System::Context>& context)
+            {
+                auto out = std::shared_ptr<TraceDebugWidget>(new TraceDebugWidget);
+                out->_init(context);
+                return out;
+            }
+
+            void TraceDebugWidget::_preLayoutEvent(System::Event::PreLayout&)
+            {
+                _setMinimumSize(_layout->getMinimumSize());
+            }
+
+            void TraceDebugWidget::_layoutEvent(System::Event::Layout&)
+            {
+                _layout->setGeometry(getGeometry());
+            }
+
+            void TraceDebugWidget::_initEvent(System::Event::Init& event)
+            {
+                if (event.getData().text)
+                {
+                    _enabledCheckBox->setText(_getText(DJV_TEXT("debug_trace_enabled")));
+                    _writeButton->setText(_getText(DJV_TEXT("debug_trace_write")));
+                }
+            }
+
+            void TraceDebugWidget::_write()
+            {
+                const std::string fileName = System::File::Path(
+                    _getResourceSystem()->getPath(System::File::ResourcePath::Documents),
+                    "djvTrace.json").get();
+                try
+                {
+                    auto io = System::File::IO::create();
+                    io->open(fileName, System::File::Mode::Write);
+                    io->write(Trace::toChromeJSON(Trace::getEvents()));
+                    _fileNameLabel->setText(fileName);
+                }
+                catch (const std::exception& e)
+                {
+                    _log(Error::format(e), System::LogLevel::Error);
+                }
+            }
+#endif // DJV_TRACE_ENABLED
+
         } // namespace
 
         struct DebugWidget::Private
@@ -812,6 +936,13 @@ namespace djv
             p.bellows["Media"]->addChild(mediaDebugWidget);
             layout->addChild(p.bellows["Media"]);
 
+#if defined(DJV_TRACE_ENABLED)
+            auto traceDebugWidget = TraceDebugWidget::create(context);
+            p.bellows["Trace"] = UI::Bellows::create(context);
+            p.bellows["Trace"]->addChild(traceDebugWidget);
+            layout->addChild(p.bellows["Trace"]);
+#endif // DJV_TRACE_ENABLED
+
             auto scrollWidget = UI::ScrollWidget::create(UI::ScrollType::Vertical, context);
             scrollWidget->setBorder(false);
             scrollWidget->setBackgroundRole(UI::ColorRole::Background);
@@ -868,6 +999,9 @@ namespace djv
                 p.bellows["General"]->setText(_getText(DJV_TEXT("debug_section_general")));
                 p.bellows["Render"]->setText(_getText(DJV_TEXT("debug_section_render")));
                 p.bellows["Media"]->setText(_getText(DJV_TEXT("debug_section_media")));
+#if defined(DJV_TRACE_ENABLED)
+                p.bellows["Trace"]->setText(_getText(DJV_TEXT("debug_section_trace")));
+#endif // DJV_TRACE_ENABLED
             }
         }
 
@@ -15,6 +15,7 @@
 #include <djvAudio/DataFunc.h>
 
 #include <djvSystem/Context.h>
+#include <djvSystem/DirectoryWatcher.h>
 #include <djvSystem/FileInfoFunc.h>
 #include <djvSystem/LogSystem.h>
 #include <djvSystem/TextSystem.h>
@@ -22,10 +23,15 @@
 
 #include <djvMath/FrameNumberFunc.h>
 
+#include <djvCore/MetricsFunc.h>
 #include <djvCore/StringFormat.h>
 #include <djvCore/StringFunc.h>
+#include <djvCore/TraceFunc.h>
 #include <djvCore/UndoStack.h>
 
+#include <future>
+#include <set>
+
 using namespace djv::Core;
 
 namespace djv
@@ -80,6 +86,11 @@ namespace djv
             std::shared_ptr<Observer::ValueSubject<size_t> > audioQueueMax;
             std::shared_ptr<Observer::ValueSubject<size_t> > audioQueueCount;
             std::shared_ptr<AV::IO::IRead> read;
+            std::shared_ptr<System::File::DirectoryWatcher> directoryWatcher;
+            std::set<Math::Frame::Number> sequenceModified;
+            std::future<Math::Frame::Sequence> sequenceFuture;
+            bool sequenceListPending = false;
+            std::shared_ptr<System::Timer> sequenceTimer;
 
             AV::IO::Direction ioDirection = AV::IO::Direction::Forward;
             std::unique_ptr<RtAudio> rtAudio;
@@ -157,6 +168,27 @@ namespace djv
             p.cacheTimer->setRepeating(true);
             p.debugTimer = System::Timer::create(context);
             p.debugTimer->setRepeating(true);
+            p.sequenceTimer = System::Timer::create(context);
+            p.sequenceTimer->setRepeating(true);
+
+            if (System::File::Type::Sequence == fileInfo.getType())
+            {
+                p.directoryWatcher = System::File::DirectoryWatcher::create(context);
+                p.directoryWatcher->setChangesCallback(
+                    [weak](const std::vector<System::File::DirectoryChange>& value)
+                    {
+                        if (auto media = weak.lock())
+                        {
+                            media->_sequenceUpdate(value);
+                        }
+                    });
+                std::string directory = fileInfo.getPath().getDirectoryName();
+                if (directory.empty())
+                {
+                    directory = ".";
+                }
+                p.directoryWatcher->setPath(System::File::Path(directory));
+            }
 
             try
             {
@@ -925,6 +957,184 @@ namespace djv
             }
         }
 
+        void Media::_sequenceUpdate(const std::vector<System::File::DirectoryChange>& changes)
+        {
+            DJV_PRIVATE_PTR();
+            if (!p.read)
+            {
+                return;
+            }
+
+            // Add the new frames to the sequence. Frames that are removed, or
+            // changes that are not available, require listing the directory.
+            // Frames that are modified are read again.
+            Math::Frame::Sequence sequence = p.sequence->get();
+            bool update = false;
+            bool list = changes.empty();
+            const std::string& directory = p.fileInfo.getPath().getDirectoryName();
+            for (const auto& i : changes)
+            {
+                if (i.directory)
+                {
+                    continue;
+                }
+                const System::File::Info info(System::File::Path(directory, i.fileName), false);
+                if (!info.isCompatible(p.fileInfo))
+                {
+                    continue;
+                }
+                Math::Frame::Sequence frames;
+                try
+                {
+                    Math::Frame::fromString(info.getPath().getNumber(), frames);
+                }
+                catch (const std::exception&)
+                {}
+                if (!frames.isValid())
+                {
+                    continue;
+                }
+                const Math::Frame::Number frame = frames.getFrame(0);
+                switch (i.type)
+                {
+                case System::File::DirectoryChangeType::Added:
+                    if (sequence.contains(frame))
+                    {
+                        // The frame has been replaced.
+                        p.sequenceModified.insert(frame);
+                    }
+                    else
+                    {
+                        sequence.add(Math::Frame::Range(frame));
+                    }
+                    update = true;
+                    break;
+                case System::File::DirectoryChangeType::Removed:
+                    list = true;
+                    break;
+                case System::File::DirectoryChangeType::Modified:
+                    p.sequenceModified.insert(frame);
+                    update = true;
+                    break;
+                default: break;
+                }
+            }
+
+            // List the directory again after the current listing if it
+            // changed while it was being listed.
+            if (p.sequenceFuture.valid())
+            {
+                p.sequenceListPending = true;
+            }
+            else if (list)
+            {
+                _sequenceListStart();
+            }
+            else if (update)
+            {
+                _sequenceSet(sequence);
+            }
+        }
+
+        void Media::_sequenceListStart()
+        {
+            DJV_PRIVATE_PTR();
+            if (auto context = p.context.lock())
+            {
+                // List the directory with a future since it can take a while
+                // for large sequences.
+                auto io = context->getSystemT<AV::IO::IOSystem>();
+                const System::File::Path path = p.fileInfo.getPath();
+                const auto extensions = io->getSequenceExtensions();
+                p.sequenceListPending = false;
+                p.sequenceFuture = std::async(
+                    std::launch::async,
+                    [path, extensions]
+                    {
+                        // Only the frame numbers are needed, so the frames
+                        // are not stat'd.
+                        Math::Frame::Sequence out;
+                        const auto fileInfo = System::File::getSequence(path, extensions, false);
+                        if (System::File::Type::Sequence == fileInfo.getType())
+                        {
+                            out = fileInfo.getSequence();
+                        }
+                        return out;
+                    });
+                if (p.sequenceTimer->isActive())
+                {
+                    // This may be called from the timer callback.
+                    return;
+                }
+                auto weak = std::weak_ptr<Media>(std::dynamic_pointer_cast<Media>(shared_from_this()));
+                p.sequenceTimer->start(
+                    System::getTimerDuration(System::TimerValue::Medium),
+                    [weak](const std::chrono::steady_clock::time_point&, const Time::Duration&)
+                    {
+                        if (auto media = weak.lock())
+                        {
+                            auto& p = *media->_p;
+                            if (p.sequenceFuture.valid() &&
+                                p.sequenceFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                            {
+                                const auto sequence = p.sequenceFuture.get();
+                                if (p.sequenceListPending)
+                                {
+                                    media->_sequenceListStart();
+                                }
+                                else
+                                {
+                                    p.sequenceTimer->stop();
+                                }
+                                if (sequence.isValid())
+                                {
+                                    media->_sequenceSet(sequence);
+                                }
+                            }
+                        }
+                    });
+            }
+        }
+
+        void Media::_sequenceSet(const Math::Frame::Sequence& sequence)
+        {
+            DJV_PRIVATE_PTR();
+            if (!p.read)
+            {
+                return;
+            }
+            const Math::Frame::Sequence prevSequence = p.sequence->get();
+            System::File::Info fileInfo = p.fileInfo;
+            fileInfo.setSequence(sequence);
+            const auto modified = std::move(p.sequenceModified);
+            p.sequenceModified.clear();
+            if (p.read->updateSequence(fileInfo, modified))
+            {
+                p.fileInfo = fileInfo;
+                if (sequence != prevSequence)
+                {
+                    auto info = p.info->get();
+                    info.videoSequence = sequence;
+                    p.info->setIfChanged(info);
+                    p.sequence->setIfChanged(sequence);
+                    const auto& inOutPoints = p.inOutPoints->get();
+                    if (!inOutPoints.isEnabled())
+                    {
+                        p.inOutPoints->setIfChanged(AV::IO::InOutPoints(false, 0, sequence.getLastIndex()));
+                    }
+
+                    // Keep the current frame when frames are inserted
+                    // before it.
+                    const Math::Frame::Index currentFrame = p.currentFrame->get();
+                    const Math::Frame::Index index = sequence.getIndex(prevSequence.getFrame(currentFrame));
+                    if (index != Math::Frame::invalidIndex)
+                    {
+                        p.currentFrame->setIfChanged(index);
+                    }
+                }
+            }
+        }
+
         void Media::_setSpeed(const Math::Rational& value)
         {
             DJV_PRIVATE_PTR();
@@ -1088,6 +1298,7 @@ namespace djv
         void Media::_playbackTick()
         {
             DJV_PRIVATE_PTR();
+            DJV_TRACE_FRAME("djv::ViewApp::Media::_playbackTick", p.currentFrame->get());
             const Playback playback = p.playback->get();
             switch (playback)
             {
@@ -1181,6 +1392,7 @@ namespace djv
         void Media::_queueUpdate()
         {
             DJV_PRIVATE_PTR();
+            static const auto droppedFrameCounter = Metrics::getCounter("djv::ViewApp::Media::droppedFrames");
             if (p.read)
             {
                 // Update the video queue.
@@ -1190,6 +1402,7 @@ namespace djv
                 //std::cout << "every frame: " << playEveryFrameAdvance << ", " <<
                 //    p.playEveryFrameTime.count() << "/" << frameTime.count() << std::endl;
                 const Math::Frame::Index currentFrame = p.currentFrame->get();
+                DJV_TRACE_FRAME("djv::ViewApp::Media::_queueUpdate", currentFrame);
                 AV::IO::VideoFrame frame;
                 bool gotFrame = false;
                 {
@@ -1212,6 +1425,12 @@ namespace djv
                                 (queue.getFrame().frame < currentFrame) :
                                 (queue.getFrame().frame > currentFrame)))
                         {
+                            if (gotFrame)
+                            {
+                                // The previous frame was never displayed.
+                                DJV_TRACE_INSTANT("djv::ViewApp::Media::drop", frame.frame);
+                                droppedFrameCounter->add();
+                            }
                             frame = queue.popFrame();
                             gotFrame = true;
                             p.realSpeedFrameCount = p.realSpeedFrameCount + 1;
@@ -38,6 +38,7 @@ namespace djv
         namespace File
         {
             class Info;
+            struct DirectoryChange;
 
         } // namespace File
     } // namespace System
@@ -47,6 +48,10 @@ namespace djv
         class AnnotatePrimitive;
         
         //! This class provides a media object.
+        //!
+        //! File sequences are watched for changes, and frames that are added
+        //! while the sequence is open (for example by a render) are picked
+        //! up without opening the sequence again.
         class Media : public std::enable_shared_from_this<Media>
         {
             DJV_NON_COPYABLE(Media);
@@ -205,6 +210,9 @@ namespace djv
             bool _isAudioEnabled() const;
             bool _hasAudioSyncPlayback() const;
             void _open();
+            void _sequenceUpdate(const std::vector<System::File::DirectoryChange>&);
+            void _sequenceListStart();
+            void _sequenceSet(const Math::Frame::Sequence&);
             void _setSpeed(const Math::Rational&);
             void _setCurrentFrame(Math::Frame::Index);
             void _seek(Math::Frame::Index);
@@ -182,7 +182,7 @@ namespace djv
             return out;
         }
 
-        void TimelinePIPWidget::setFileInfo(const System::File::Info& value)
+        void TimelinePIPWidget::setFileInfo(const System::File::Info& value, const AV::IO::Info& info)
         {
             DJV_PRIVATE_PTR();
             if (auto context = getContext().lock())
@@ -194,12 +194,24 @@ namespace djv
                 {
                     try
                     {
-                        auto io = context->getSystemT<AV::IO::IOSystem>();
+                        // Open the file at a reduced resolution that is still
+                        // larger than the preview.
                         AV::IO::ReadOptions options;
                         options.videoQueueSize = 1;
                         options.audioQueueSize = 0;
+                        if (info.video.size())
+                        {
+                            const float size = _getStyle()->getMetric(UI::MetricsRole::TextColumn);
+                            const auto& imageSize = info.video[0].size;
+                            while (imageSize.w / (options.proxy * 2) >= size &&
+                                imageSize.h / (options.proxy * 2) >= size)
+                            {
+                                options.proxy *= 2;
+                            }
+                        }
+                        auto io = context->getSystemT<AV::IO::IOSystem>();
                         p.read = io->read(value, options);
-                        const auto info = p.read->getInfo().get();
+
                         p.speed = info.videoSpeed;
                         p.sequence = info.videoSequence;
                     }
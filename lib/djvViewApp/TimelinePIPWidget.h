@@ -12,6 +12,15 @@
 
 namespace djv
 {
+    namespace AV
+    {
+        namespace IO
+        {
+            class Info;
+
+        } // namespace IO
+    } // namespace AV
+
     namespace System
     {
         namespace File
@@ -38,7 +47,9 @@ namespace djv
 
             static std::shared_ptr<TimelinePIPWidget> create(const std::shared_ptr<System::Context>&);
 
-            void setFileInfo(const System::File::Info&);
+            //! Set the file, and the information that has already been read
+            //! from it which is used to pick the proxy resolution.
+            void setFileInfo(const System::File::Info&, const AV::IO::Info&);
             void setPos(const glm::vec2&, Math::Frame::Index, const Math::BBox2f&);
 
         protected:
@@ -206,7 +206,7 @@ namespace djv
                 p.currentFrame = 0;
                 p.speed = Math::Rational();
 
-                p.pipWidget->setFileInfo(System::File::Info());
+                p.pipWidget->setFileInfo(System::File::Info(), AV::IO::Info());
 
                 p.infoObserver.reset();
                 p.speedObserver.reset();
@@ -339,6 +339,7 @@ namespace djv
                                     tick->size.y = p.fontMetrics.lineHeight;
                                     tick->text = AV::Time::toString(p.sequence.getFrame(i.second(unit, speedF)), p.speed, p.timeUnits);
                                     tick->glyphsFuture = p.fontSystem->getGlyphs(tick->text, p.fontInfo);
+                                    _requestUpdate();
                                     tick->textPos = glm::vec2(x + tick->size.x + m - g.min.x, textY);
                                     x2 = x + p.maxFrameLength + m * 2.F;
                                     ++timeTicksCount;
@@ -490,7 +491,7 @@ namespace djv
                     event.accept();
                     if (_isPIPEnabled())
                     {
-                        p.pipWidget->setFileInfo(p.media->getFileInfo());
+                        p.pipWidget->setFileInfo(p.media->getFileInfo(), p.media->observeInfo()->get());
                         _showPIP(true);
                     }
                 }
@@ -649,6 +650,19 @@ namespace djv
                     }
                 }
             }
+            bool pending =
+                p.fontMetricsFuture.valid() ||
+                p.currentFrameSizeFuture.valid() ||
+                p.currentFrameGlyphsFuture.valid() ||
+                p.maxFrameSizeFuture.valid();
+            for (const auto& i : p.timeTicks)
+            {
+                pending |= i->glyphsFuture.valid();
+            }
+            if (pending)
+            {
+                _requestUpdate();
+            }
         }
 
         bool TimelineSlider::_isPIPEnabled() const
@@ -754,6 +768,7 @@ namespace djv
                 default: break;
                 }
                 p.maxFrameSizeFuture = p.fontSystem->measure(maxFrameText, p.fontInfo);
+                _requestUpdate();
                 p.sizePrev = glm::vec2(0.F, 0.F);
                 _resize();
             }
@@ -772,6 +787,7 @@ namespace djv
                 p.currentFrameText = text;
                 p.currentFrameSizeFuture = p.fontSystem->measure(p.currentFrameText, p.fontInfo);
                 p.currentFrameGlyphsFuture = p.fontSystem->getGlyphs(p.currentFrameText, p.fontInfo);
+                _requestUpdate();
             }
         }
 
@@ -270,6 +270,7 @@ namespace djv
                 const auto& style = _getStyle();
                 const auto fontInfo = style->getFontInfo(Render2D::Font::familyMono, Render2D::Font::faceDefault, UI::MetricsRole::FontSmall);
                 p.fontMetricsFuture = p.fontSystem->getMetrics(fontInfo);
+                _requestUpdate();
             }
         }
 
@@ -336,6 +337,12 @@ namespace djv
                     ++textGlyphsFuturesIt;
                 }
             }
+            if (p.fontMetricsFuture.valid() ||
+                !p.textSizeFutures.empty() ||
+                !p.textGlyphsFutures.empty())
+            {
+                _requestUpdate();
+            }
         }
 
         std::string GridOverlay::_getLabel(const GridPos& value) const
@@ -402,6 +409,7 @@ namespace djv
             const auto fontInfo = style->getFontInfo(Render2D::Font::familyMono, Render2D::Font::faceDefault, UI::MetricsRole::FontSmall);
             p.textSizeFutures[pos] = p.fontSystem->measure(label, fontInfo);
             p.textGlyphsFutures[pos] = p.fontSystem->getGlyphs(label, fontInfo);
+            _requestUpdate();
         }
 
         void GridOverlay::_textUpdate()
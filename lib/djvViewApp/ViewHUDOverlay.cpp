@@ -291,6 +291,12 @@ namespace djv
                     ++j;
                 }
             }
+            if (p.fontMetricsFuture.valid() ||
+                !p.textSizeFutures.empty() ||
+                !p.glyphsFutures.empty())
+            {
+                _requestUpdate();
+            }
         }
 
         void HUDOverlay::_textUpdate()
@@ -299,6 +305,7 @@ namespace djv
             const auto& style = _getStyle();
             const auto fontInfo = style->getFontInfo(Render2D::Font::familyMono, std::string(), UI::MetricsRole::FontMedium);
             p.fontMetricsFuture = p.fontSystem->getMetrics(fontInfo);
+            _requestUpdate();
             p.textSizeFutures.clear();
             {
                 std::stringstream ss;
@@ -361,6 +368,7 @@ namespace djv
             {
                 p.textSizeFutures[i.first] = p.fontSystem->measure(i.second.text, fontInfo);
                 p.glyphsFutures[i.first] = p.fontSystem->getGlyphs(i.second.text, fontInfo);
+                _requestUpdate();
             }
         }
 
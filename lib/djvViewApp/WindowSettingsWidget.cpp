@@ -571,6 +571,10 @@ namespace djv
                 }
                 p.imageWidget->setImage(p.image);
             }
+            if (p.imageFuture.future.valid())
+            {
+                _requestUpdate();
+            }
         }
 
         void BackgroundImageSettingsWidget::_widgetUpdate()
@@ -593,6 +597,7 @@ namespace djv
                     const float s = style->getMetric(UI::MetricsRole::TextColumn);
                     auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>();
                     p.imageFuture = thumbnailSystem->getImage(p.fileName, Image::Size(s, s));
+                    _requestUpdate();
                 }
             }
         }
@@ -0,0 +1,756 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCmdLineApp/Application.h>
+
+#include <djvAV/IOSystem.h>
+#include <djvAV/PPMFunc.h>
+#if defined(OpenEXR_FOUND)
+#include <djvAV/OpenEXRFunc.h>
+#endif // OpenEXR_FOUND
+#if defined(TIFF_FOUND)
+#include <djvAV/TIFFFunc.h>
+#endif // TIFF_FOUND
+
+#include <djvImage/Data.h>
+#include <djvImage/TypeFunc.h>
+
+#include <djvSystem/FileInfo.h>
+#include <djvSystem/LogSystem.h>
+#include <djvSystem/PathFunc.h>
+#include <djvSystem/TextSystem.h>
+
+#include <djvMath/MathFunc.h>
+
+#include <djvCore/ErrorFunc.h>
+#include <djvCore/RapidJSONFunc.h>
+#include <djvCore/StringFormat.h>
+#include <djvCore/StringFunc.h>
+
+#include <rapidjson/prettywriter.h>
+
+#if defined(DJV_PLATFORM_WINDOWS)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else // DJV_PLATFORM_WINDOWS
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif // DJV_PLATFORM_WINDOWS
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <thread>
+
+using namespace djv;
+
+//! This program benchmarks reading and writing images with the I/O plugins.
+//!
+//! Synthetic images are generated for each image type and written as a
+//! sequence with each plugin and option set, then read back with a warm
+//! and (where supported) a cold page cache. The results are printed as
+//! JSON so they can be compared between releases.
+//!
+//! Throughput is computed from the uncompressed image data so that the
+//! results are comparable across codecs.
+
+namespace
+{
+    const size_t frameCountDefault = 24;
+    const Image::Size sizeDefault(1920, 1080);
+
+    //! This struct provides a benchmark case.
+    struct Case
+    {
+        std::string pluginName;
+        std::string extension;
+        std::string label;
+        std::function<rapidjson::Value(rapidjson::Document::AllocatorType&)> options;
+    };
+
+    //! This struct provides a benchmark measurement.
+    struct Measurement
+    {
+        double   seconds    = 0.0;
+        size_t   frameCount = 0;
+        size_t   byteCount  = 0;
+        size_t   peakRSS    = 0;
+    };
+
+    //! Generate a pseudo-random number. A fixed generator is used so that
+    //! the images are the same for every run.
+    class Random
+    {
+    public:
+        float get()
+        {
+            _state ^= _state << 13;
+            _state ^= _state >> 17;
+            _state ^= _state << 5;
+            return (_state & 0xffff) / 65535.F;
+        }
+
+    private:
+        uint32_t _state = 2463534242;
+    };
+
+    template<typename T>
+    T getValue(float value, float max)
+    {
+        return static_cast<T>(value * max);
+    }
+
+    //! Create a synthetic image. The image is a gradient with some noise
+    //! added so that the codecs have something realistic to compress.
+    std::shared_ptr<Image::Data> createImage(const Image::Info& info)
+    {
+        auto out = Image::Data::create(info);
+        const uint8_t channelCount = Image::getChannelCount(info.type);
+        const Image::DataType dataType = Image::getDataType(info.type);
+        Random random;
+        for (uint16_t y = 0; y < info.size.h; ++y)
+        {
+            uint8_t* p = out->getData(y);
+            for (uint16_t x = 0; x < info.size.w; ++x)
+            {
+                float values[4] = { 0.F, 0.F, 0.F, 0.F };
+                for (uint8_t c = 0; c < channelCount; ++c)
+                {
+                    const float v =
+                        x / static_cast<float>(info.size.w) * .6F +
+                        y / static_cast<float>(info.size.h) * .3F +
+                        random.get() * .1F;
+                    values[c] = 3 == c ? 1.F : Math::clamp(v - c * .05F, 0.F, 1.F);
+                }
+                switch (dataType)
+                {
+                case Image::DataType::U8:
+                    for (uint8_t c = 0; c < channelCount; ++c, ++p)
+                    {
+                        *p = getValue<Image::U8_T>(values[c], Image::U8Range.getMax());
+                    }
+                    break;
+                case Image::DataType::U10:
+                {
+                    auto u10 = reinterpret_cast<Image::U10_S*>(p);
+                    u10->r = getValue<Image::U10_T>(values[0], Image::U10Range.getMax());
+                    u10->g = getValue<Image::U10_T>(values[1], Image::U10Range.getMax());
+                    u10->b = getValue<Image::U10_T>(values[2], Image::U10Range.getMax());
+                    p += sizeof(Image::U10_S);
+                    break;
+                }
+                case Image::DataType::U16:
+                    for (uint8_t c = 0; c < channelCount; ++c, p += sizeof(Image::U16_T))
+                    {
+                        *reinterpret_cast<Image::U16_T*>(p) = getValue<Image::U16_T>(values[c], Image::U16Range.getMax());
+                    }
+                    break;
+                case Image::DataType::U32:
+                    for (uint8_t c = 0; c < channelCount; ++c, p += sizeof(Image::U32_T))
+                    {
+                        *reinterpret_cast<Image::U32_T*>(p) = getValue<Image::U32_T>(values[c], Image::U32Range.getMax());
+                    }
+                    break;
+                case Image::DataType::F16:
+                    for (uint8_t c = 0; c < channelCount; ++c, p += sizeof(Image::F16_T))
+                    {
+                        *reinterpret_cast<Image::F16_T*>(p) = values[c];
+                    }
+                    break;
+                case Image::DataType::F32:
+                    for (uint8_t c = 0; c < channelCount; ++c, p += sizeof(Image::F32_T))
+                    {
+                        *reinterpret_cast<Image::F32_T*>(p) = values[c];
+                    }
+                    break;
+                default: break;
+                }
+            }
+        }
+        return out;
+    }
+
+    //! Reset the peak resident set size. This is only supported on Linux,
+    //! on other platforms the peak is for the lifetime of the process.
+    void resetPeakRSS()
+    {
+#if defined(DJV_PLATFORM_LINUX)
+        std::ofstream file("/proc/self/clear_refs");
+        file << "5";
+#endif // DJV_PLATFORM_LINUX
+    }
+
+    //! Get the peak resident set size in bytes.
+    size_t getPeakRSS()
+    {
+        size_t out = 0;
+#if defined(DJV_PLATFORM_WINDOWS)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        {
+            out = counters.PeakWorkingSetSize;
+        }
+#elif defined(DJV_PLATFORM_LINUX)
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line))
+        {
+            if (0 == line.compare(0, 6, "VmHWM:"))
+            {
+                std::stringstream ss(line.substr(6));
+                ss >> out;
+                out *= 1024;
+                break;
+            }
+        }
+#else // DJV_PLATFORM_WINDOWS
+        struct rusage usage;
+        if (0 == getrusage(RUSAGE_SELF, &usage))
+        {
+            out = usage.ru_maxrss;
+        }
+#endif // DJV_PLATFORM_WINDOWS
+        return out;
+    }
+
+    //! Remove a file from the page cache. Returns false if this is not
+    //! supported.
+    bool dropPageCache(const std::string& fileName)
+    {
+        bool out = false;
+#if defined(DJV_PLATFORM_LINUX)
+        const int fd = open(fileName.c_str(), O_RDONLY);
+        if (fd != -1)
+        {
+            fdatasync(fd);
+            out = 0 == posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            close(fd);
+        }
+#endif // DJV_PLATFORM_LINUX
+        return out;
+    }
+
+    rapidjson::Value toJSON(const Measurement& value, rapidjson::Document::AllocatorType& allocator)
+    {
+        rapidjson::Value out(rapidjson::kObjectType);
+        const double megabytes = value.byteCount / 1000000.0;
+        out.AddMember("Seconds", djv::toJSON(value.seconds, allocator), allocator);
+        out.AddMember("Frames", djv::toJSON(value.frameCount, allocator), allocator);
+        out.AddMember("MBPerSecond", djv::toJSON(value.seconds > 0.0 ? (megabytes / value.seconds) : 0.0, allocator), allocator);
+        out.AddMember("FramesPerSecond", djv::toJSON(value.seconds > 0.0 ? (value.frameCount / value.seconds) : 0.0, allocator), allocator);
+        out.AddMember("PeakRSS", djv::toJSON(value.peakRSS, allocator), allocator);
+        return out;
+    }
+
+} // namespace
+
+class Application : public CmdLine::Application
+{
+    DJV_NON_COPYABLE(Application);
+
+protected:
+    void _init(std::list<std::string>&);
+
+    Application();
+
+public:
+    static std::shared_ptr<Application> create(std::list<std::string>&);
+
+    void run() override;
+
+protected:
+    void _parseCmdLine(std::list<std::string>&) override;
+    void _printUsage() override;
+
+private:
+    void _addCases();
+    rapidjson::Value _run(const Case&, Image::Type, rapidjson::Document::AllocatorType&);
+    Measurement _write(const System::File::Info&, const std::shared_ptr<Image::Data>&);
+    Measurement _read(const System::File::Info&);
+
+    size_t _frameCount = frameCountDefault;
+    Image::Size _size = sizeDefault;
+    std::set<std::string> _pluginNames;
+    std::set<Image::Type> _types;
+    std::string _output;
+    std::vector<Case> _cases;
+    System::File::Path _tempPath;
+};
+
+void Application::_init(std::list<std::string>& args)
+{
+    CmdLine::Application::_init(args);
+
+    _parseCmdLine(args);
+
+    _addCases();
+
+    _tempPath = System::File::Path(System::File::getTemp(), "djvAVBenchmark");
+    if (!System::File::Info(_tempPath).doesExist())
+    {
+        System::File::mkdir(_tempPath);
+    }
+}
+
+Application::Application()
+{}
+
+std::shared_ptr<Application> Application::create(std::list<std::string>& args)
+{
+    auto out = std::shared_ptr<Application>(new Application);
+    out->_init(args);
+    return out;
+}
+
+void Application::run()
+{
+    rapidjson::Document document;
+    document.SetObject();
+    auto& allocator = document.GetAllocator();
+    document.AddMember("Version", toJSON(std::string(DJV_VERSION), allocator), allocator);
+    {
+        rapidjson::Value size(rapidjson::kArrayType);
+        size.PushBack(toJSON(static_cast<int>(_size.w), allocator), allocator);
+        size.PushBack(toJSON(static_cast<int>(_size.h), allocator), allocator);
+        document.AddMember("Size", size, allocator);
+    }
+    document.AddMember("Frames", toJSON(_frameCount, allocator), allocator);
+
+    rapidjson::Value results(rapidjson::kArrayType);
+    auto io = getSystemT<AV::IO::IOSystem>();
+    for (const auto& i : _cases)
+    {
+        rapidjson::Value defaultOptions = io->getOptions(i.pluginName, allocator);
+        if (i.options)
+        {
+            io->setOptions(i.pluginName, i.options(allocator));
+        }
+        for (auto type : Image::getTypeEnums())
+        {
+            if (type != Image::Type::None && (_types.empty() || _types.count(type)))
+            {
+                std::stringstream ss;
+                ss << i.pluginName << " " << i.label << " " << type;
+                // Keep the standard output for the results when they are
+                // not written to a file.
+                if (!_output.empty())
+                {
+                    std::cout << ss.str() << std::endl;
+                }
+                else
+                {
+                    getSystemT<System::LogSystem>()->log("djvAVBenchmark", ss.str());
+                }
+                results.PushBack(_run(i, type, allocator), allocator);
+            }
+        }
+        // The options are null if the plugin had not been used yet.
+        if (i.options && !defaultOptions.IsNull())
+        {
+            io->setOptions(i.pluginName, defaultOptions);
+        }
+    }
+    document.AddMember("Results", results, allocator);
+
+    try
+    {
+        System::File::rmdir(_tempPath);
+    }
+    catch (const std::exception&)
+    {}
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+    document.Accept(writer);
+    if (_output.empty())
+    {
+        std::cout << buffer.GetString() << std::endl;
+    }
+    else
+    {
+        std::ofstream file(_output);
+        file << buffer.GetString() << std::endl;
+    }
+}
+
+void Application::_parseCmdLine(std::list<std::string>& args)
+{
+    CmdLine::Application::_parseCmdLine(args);
+    if (0 == getExitCode())
+    {
+        auto textSystem = getSystemT<System::TextSystem>();
+        auto arg = args.begin();
+        while (arg != args.end())
+        {
+            if ("-frames" == *arg)
+            {
+                arg = args.erase(arg);
+                int value = 0;
+                if (arg != args.end())
+                {
+                    std::stringstream ss(*arg);
+                    ss >> value;
+                    arg = args.erase(arg);
+                }
+                if (value < 1)
+                {
+                    throw std::invalid_argument(Core::String::Format("{0}: {1}").
+                        arg("-frames").
+                        arg(textSystem->getText(DJV_TEXT("error_cannot_parse_argument"))));
+                }
+                _frameCount = static_cast<size_t>(value);
+            }
+            else if ("-size" == *arg)
+            {
+                arg = args.erase(arg);
+                int w = 0;
+                int h = 0;
+                for (auto value : { &w, &h })
+                {
+                    if (arg != args.end())
+                    {
+                        std::stringstream ss(*arg);
+                        ss >> *value;
+                        arg = args.erase(arg);
+                    }
+                }
+                if (w < 1 || h < 1 || w > 65535 || h > 65535)
+                {
+                    throw std::invalid_argument(Core::String::Format("{0}: {1}").
+                        arg("-size").
+                        arg(textSystem->getText(DJV_TEXT("error_cannot_parse_argument"))));
+                }
+                _size = Image::Size(w, h);
+            }
+            else if ("-plugin" == *arg)
+            {
+                arg = args.erase(arg);
+                if (args.end() == arg)
+                {
+                    throw std::invalid_argument(Core::String::Format("{0}: {1}").
+                        arg("-plugin").
+                        arg(textSystem->getText(DJV_TEXT("error_cannot_parse_argument"))));
+                }
+                _pluginNames.insert(*arg);
+                arg = args.erase(arg);
+            }
+            else if ("-type" == *arg)
+            {
+                arg = args.erase(arg);
+                Image::Type value = Image::Type::None;
+                if (arg != args.end())
+                {
+                    try
+                    {
+                        std::stringstream ss(*arg);
+                        ss >> value;
+                    }
+                    catch (const std::exception&)
+                    {}
+                    arg = args.erase(arg);
+                }
+                if (Image::Type::None == value)
+                {
+                    throw std::invalid_argument(Core::String::Format("{0}: {1}").
+                        arg("-type").
+                        arg(textSystem->getText(DJV_TEXT("error_cannot_parse_argument"))));
+                }
+                _types.insert(value);
+            }
+            else if ("-output" == *arg)
+            {
+                arg = args.erase(arg);
+                if (args.end() == arg)
+                {
+                    throw std::invalid_argument(Core::String::Format("{0}: {1}").
+                        arg("-output").
+                        arg(textSystem->getText(DJV_TEXT("error_cannot_parse_argument"))));
+                }
+                _output = *arg;
+                arg = args.erase(arg);
+            }
+            else
+            {
+                ++arg;
+            }
+        }
+    }
+}
+
+void Application::_printUsage()
+{
+    std::cout << std::endl;
+    std::cout << " Benchmark reading and writing images with the I/O plugins." << std::endl;
+    std::cout << std::endl;
+    std::cout << " Usage: djvAVBenchmark [option]..." << std::endl;
+    std::cout << std::endl;
+    std::cout << " Options" << std::endl;
+    std::cout << std::endl;
+    std::cout << "   -frames (value)" << std::endl;
+    std::cout << "   Set the number of frames. Default: " << frameCountDefault << std::endl;
+    std::cout << std::endl;
+    std::cout << "   -size (width) (height)" << std::endl;
+    std::cout << "   Set the image size. Default: " << sizeDefault.w << " " << sizeDefault.h << std::endl;
+    std::cout << std::endl;
+    std::cout << "   -plugin (name)" << std::endl;
+    std::cout << "   Only benchmark the given plugin. May be given more than once." << std::endl;
+    std::cout << std::endl;
+    std::cout << "   -type (value)" << std::endl;
+    std::cout << "   Only benchmark the given image type (for example \"image_type_rgb_u8\")." << std::endl;
+    std::cout << "   May be given more than once." << std::endl;
+    std::cout << std::endl;
+    std::cout << "   -output (file)" << std::endl;
+    std::cout << "   Write the JSON results to a file instead of the standard output." << std::endl;
+    std::cout << std::endl;
+
+    CmdLine::Application::_printUsage();
+}
+
+void Application::_addCases()
+{
+    // Only plugins that can write are benchmarked since the read-only
+    // plugins have no way to create the test images.
+    std::vector<Case> cases;
+    cases.push_back({ "Cineon", ".cin", std::string(), nullptr });
+    cases.push_back({ "DPX", ".dpx", std::string(), nullptr });
+    cases.push_back({ "JPEG", ".jpg", std::string(), nullptr });
+    cases.push_back({ "PNG", ".png", std::string(), nullptr });
+    for (auto i : AV::IO::PPM::getDataEnums())
+    {
+        std::stringstream ss;
+        ss << i;
+        cases.push_back({
+            "PPM",
+            ".ppm",
+            ss.str(),
+            [i](rapidjson::Document::AllocatorType& allocator)
+            {
+                AV::IO::PPM::Options options;
+                options.data = i;
+                return toJSON(options, allocator);
+            } });
+    }
+#if defined(OpenEXR_FOUND)
+    for (auto i : AV::IO::OpenEXR::getCompressionEnums())
+    {
+        std::stringstream ss;
+        ss << i;
+        cases.push_back({
+            "OpenEXR",
+            ".exr",
+            ss.str(),
+            [i](rapidjson::Document::AllocatorType& allocator)
+            {
+                AV::IO::OpenEXR::Options options;
+                options.compression = i;
+                return toJSON(options, allocator);
+            } });
+    }
+#endif // OpenEXR_FOUND
+#if defined(TIFF_FOUND)
+    for (auto i : AV::IO::TIFF::getCompressionEnums())
+    {
+        std::stringstream ss;
+        ss << i;
+        cases.push_back({
+            "TIFF",
+            ".tif",
+            ss.str(),
+            [i](rapidjson::Document::AllocatorType& allocator)
+            {
+                AV::IO::TIFF::Options options;
+                options.compression = i;
+                return toJSON(options, allocator);
+            } });
+    }
+#endif // TIFF_FOUND
+
+    const auto pluginNames = getSystemT<AV::IO::IOSystem>()->getPluginNames();
+    for (const auto& i : cases)
+    {
+        if (pluginNames.count(i.pluginName) &&
+            (_pluginNames.empty() || _pluginNames.count(i.pluginName)))
+        {
+            _cases.push_back(i);
+        }
+    }
+}
+
+rapidjson::Value Application::_run(const Case& value, Image::Type type, rapidjson::Document::AllocatorType& allocator)
+{
+    rapidjson::Value out(rapidjson::kObjectType);
+    out.AddMember("Plugin", toJSON(value.pluginName, allocator), allocator);
+    out.AddMember("Options", toJSON(value.label, allocator), allocator);
+    {
+        std::stringstream ss;
+        ss << type;
+        out.AddMember("Type", toJSON(ss.str(), allocator), allocator);
+    }
+
+    const System::File::Info fileInfo(
+        System::File::Path(_tempPath, "djvAVBenchmark.0001" + value.extension),
+        System::File::Type::Sequence,
+        Math::Frame::Sequence(Math::Frame::Range(1, _frameCount), 4),
+        false);
+    try
+    {
+        const auto image = createImage(Image::Info(_size, type));
+
+        const Measurement write = _write(fileInfo, image);
+        out.AddMember("Write", toJSON(write, allocator), allocator);
+
+        size_t fileByteCount = 0;
+        for (size_t i = 1; i <= _frameCount; ++i)
+        {
+            fileByteCount += System::File::Info(fileInfo.getFileName(i)).getSize();
+        }
+        out.AddMember("FileByteCount", toJSON(fileByteCount, allocator), allocator);
+
+        // Read the files once to make sure they are in the page cache.
+        _read(fileInfo);
+        const Measurement readWarm = _read(fileInfo);
+        out.AddMember("ReadWarm", toJSON(readWarm, allocator), allocator);
+
+        bool cold = true;
+        for (size_t i = 1; i <= _frameCount; ++i)
+        {
+            cold &= dropPageCache(fileInfo.getFileName(i));
+        }
+        if (cold)
+        {
+            const Measurement readCold = _read(fileInfo);
+            out.AddMember("ReadCold", toJSON(readCold, allocator), allocator);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        out.AddMember("Error", toJSON(Core::Error::format(e), allocator), allocator);
+    }
+
+    for (size_t i = 1; i <= _frameCount; ++i)
+    {
+        std::remove(fileInfo.getFileName(i).c_str());
+    }
+
+    return out;
+}
+
+Measurement Application::_write(const System::File::Info& fileInfo, const std::shared_ptr<Image::Data>& image)
+{
+    Measurement out;
+    resetPeakRSS();
+    auto io = getSystemT<AV::IO::IOSystem>();
+    AV::IO::Info info;
+    info.video.push_back(image->getInfo());
+    const auto start = std::chrono::steady_clock::now();
+    {
+        auto write = io->write(fileInfo, info);
+        {
+            std::lock_guard<std::mutex> lock(write->getMutex());
+            auto& queue = write->getVideoQueue();
+            for (size_t i = 1; i <= _frameCount; ++i)
+            {
+                queue.addFrame(AV::IO::VideoFrame(i, image));
+            }
+            queue.setFinished(true);
+        }
+        while (write->isRunning())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    const std::chrono::duration<double> delta = std::chrono::steady_clock::now() - start;
+    out.seconds = delta.count();
+    out.peakRSS = getPeakRSS();
+
+    // Write errors are logged rather than thrown, so check that the files
+    // were created.
+    for (size_t i = 1; i <= _frameCount; ++i)
+    {
+        const std::string fileName = fileInfo.getFileName(i);
+        if (!System::File::Info(fileName).doesExist())
+        {
+            auto textSystem = getSystemT<System::TextSystem>();
+            throw std::runtime_error(Core::String::Format("{0}: {1}").
+                arg(fileName).
+                arg(textSystem->getText(DJV_TEXT("error_file_write"))));
+        }
+        ++out.frameCount;
+        out.byteCount += image->getDataByteCount();
+    }
+    return out;
+}
+
+Measurement Application::_read(const System::File::Info& fileInfo)
+{
+    Measurement out;
+    resetPeakRSS();
+    auto io = getSystemT<AV::IO::IOSystem>();
+    const auto start = std::chrono::steady_clock::now();
+    {
+        auto read = io->read(fileInfo);
+        bool running = true;
+        while (running)
+        {
+            bool sleep = false;
+            {
+                std::lock_guard<std::mutex> lock(read->getMutex());
+                auto& queue = read->getVideoQueue();
+                if (!queue.isEmpty())
+                {
+                    const auto frame = queue.popFrame();
+                    if (frame.data)
+                    {
+                        ++out.frameCount;
+                        out.byteCount += frame.data->getDataByteCount();
+                    }
+                }
+                else if (queue.isFinished())
+                {
+                    running = false;
+                }
+                else
+                {
+                    sleep = true;
+                }
+            }
+            if (sleep)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+    const std::chrono::duration<double> delta = std::chrono::steady_clock::now() - start;
+    out.seconds = delta.count();
+    out.peakRSS = getPeakRSS();
+    return out;
+}
+
+DJV_MAIN()
+{
+    int r = 1;
+    try
+    {
+        auto args = Application::args(argc, argv);
+        auto app = Application::create(args);
+        if (0 == app->getExitCode())
+        {
+            app->run();
+        }
+        r = app->getExitCode();
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+    }
+    return r;
+}
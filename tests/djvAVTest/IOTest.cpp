@@ -4,12 +4,18 @@
 
 #include <djvAVTest/IOTest.h>
 
+#include <djvAV/DPXFunc.h>
 #include <djvAV/IOSystem.h>
 #include <djvAV/PPMFunc.h>
 #include <djvAV/SpeedFunc.h>
 
+#include <djvImage/DataFunc.h>
+
 #include <djvSystem/Context.h>
+#include <djvSystem/FileIO.h>
+#include <djvSystem/FileInfoFunc.h>
 #include <djvSystem/LogSystem.h>
+#include <djvSystem/PathFunc.h>
 #include <djvSystem/ResourceSystem.h>
 #include <djvSystem/TextSystem.h>
 #include <djvSystem/TimerFunc.h>
@@ -19,6 +25,11 @@
 #include <djvCore/ErrorFunc.h>
 #include <djvCore/StringFunc.h>
 
+#include <functional>
+#include <map>
+#include <sstream>
+#include <thread>
+
 using namespace djv::Core;
 using namespace djv::AV;
 using namespace djv::AV::IO;
@@ -38,6 +49,7 @@ namespace djv
         
         void IOTest::run()
         {
+            _options();
             _info();
             _videoFrame();
             _videoQueue();
@@ -48,8 +60,38 @@ namespace djv
             _plugin();
             _io();
             _system();
+            _sequenceUpdate();
+            _proxy();
         }
         
+        void IOTest::_options()
+        {
+            if (auto context = getContext().lock())
+            {
+                // The plugins have not been created yet, so the default
+                // options are returned.
+                auto io = context->getSystemT<IOSystem>();
+                rapidjson::Document document;
+                auto& allocator = document.GetAllocator();
+                {
+                    const auto json = io->getOptions(DPX::pluginName, allocator);
+                    DJV_ASSERT(json.IsObject());
+                    DPX::Options options;
+                    options.endian = DPX::Endian::LSB;
+                    fromJSON(json, options);
+                    DJV_ASSERT(DPX::Options() == options);
+                }
+                {
+                    const auto json = io->getOptions(PPM::pluginName, allocator);
+                    DJV_ASSERT(json.IsObject());
+                    PPM::Options options;
+                    options.data = PPM::Data::ASCII;
+                    fromJSON(json, options);
+                    DJV_ASSERT(PPM::Options() == options);
+                }
+            }
+        }
+
         void IOTest::_info()
         {
             {
@@ -192,8 +234,8 @@ namespace djv
                 const Cache cache;
                 DJV_ASSERT(0 == cache.getMax());
                 DJV_ASSERT(0 == cache.getTotalByteCount());
-                DJV_ASSERT(Math::Frame::Sequence() == cache.getFrames());
-                DJV_ASSERT(Math::Frame::Sequence() == cache.getSequence());
+                DJV_ASSERT(Math::Frame::Sequence() == *cache.getFrames());
+                DJV_ASSERT(Math::Frame::Sequence() == *cache.getSequence());
                 DJV_ASSERT(!cache.contains(0));
                 std::shared_ptr<Image::Data> image;
                 DJV_ASSERT(!cache.get(0, image));
@@ -226,17 +268,84 @@ namespace djv
                 {
                     cache.get(i, image);
                 }
+                const auto frames = cache.getFrames();
+                DJV_ASSERT(frames->getFrameCount() == cache.getCount());
+                for (const auto i : Math::Frame::toFrames(*frames))
+                {
+                    DJV_ASSERT(cache.getSequence()->contains(i));
+                }
+                DJV_ASSERT(cache.getCount() * 6 == cache.getTotalByteCount());
                 {
                     std::stringstream ss;
-                    ss << "Cache frames: " << cache.getFrames();
+                    ss << "Cache frames: " << *cache.getFrames();
                     _print(ss.str());
                 }
                 {
                     std::stringstream ss;
-                    ss << "Cache sequence: " << cache.getSequence();
+                    ss << "Cache sequence: " << *cache.getSequence();
                     _print(ss.str());
                 }
             }
+
+            {
+                Cache cache;
+                cache.setMax(100);
+                cache.setSequenceSize(100);
+                cache.setCurrentFrame(10);
+                const auto sequence = cache.getSequence();
+                DJV_ASSERT(100 == sequence->getFrameCount());
+                for (Math::Frame::Index i = 20; i < 30; ++i)
+                {
+                    cache.add(i, nullptr);
+                }
+                for (Math::Frame::Index i = 40; i < 50; ++i)
+                {
+                    cache.add(i, Image::Data::create(Image::Info(1, 2, Image::Type::RGB_U8)));
+                }
+                DJV_ASSERT(20 == cache.getCount());
+                DJV_ASSERT(60 == cache.getTotalByteCount());
+                DJV_ASSERT(cache.contains(20));
+                std::shared_ptr<Image::Data> image;
+                DJV_ASSERT(cache.get(20, image));
+                DJV_ASSERT(!image);
+                const auto frames = cache.getFrames();
+                DJV_ASSERT(frames == cache.getFrames());
+                DJV_ASSERT(Math::Frame::Sequence({
+                    Math::Frame::Range(20, 29),
+                    Math::Frame::Range(40, 49) }) == *frames);
+                cache.add(30, nullptr);
+                cache.add(39, nullptr);
+                for (Math::Frame::Index i = 31; i < 39; ++i)
+                {
+                    cache.add(i, nullptr);
+                }
+                DJV_ASSERT(Math::Frame::Sequence(Math::Frame::Range(20, 49)) == *cache.getFrames());
+                DJV_ASSERT(Math::Frame::Sequence({
+                    Math::Frame::Range(20, 29),
+                    Math::Frame::Range(40, 49) }) == *frames);
+
+                cache.setCurrentFrame(30);
+                cache.setMax(15);
+                DJV_ASSERT(sequence != cache.getSequence());
+                DJV_ASSERT(Math::Frame::Sequence(Math::Frame::Range(20, 35)) == *cache.getFrames());
+                DJV_ASSERT(16 == cache.getCount());
+                DJV_ASSERT(0 == cache.getTotalByteCount());
+                cache.add(90, nullptr);
+                DJV_ASSERT(!cache.contains(90));
+                DJV_ASSERT(16 == cache.getCount());
+
+                cache.remove(25);
+                cache.remove(90);
+                DJV_ASSERT(!cache.contains(25));
+                DJV_ASSERT(15 == cache.getCount());
+                DJV_ASSERT(Math::Frame::Sequence({
+                    Math::Frame::Range(20, 24),
+                    Math::Frame::Range(26, 35) }) == *cache.getFrames());
+
+                cache.clear();
+                DJV_ASSERT(0 == cache.getCount());
+                DJV_ASSERT(Math::Frame::Sequence() == *cache.getFrames());
+            }
         }
         
         void IOTest::_plugin()
@@ -437,6 +546,47 @@ namespace djv
                         }
                     }
                 }
+
+                {
+                    ReadOptions options;
+                    options.proxy = 2;
+                    auto read = io->read(System::File::Info(path), options);
+                    const auto info = read->getInfo().get();
+                    DJV_ASSERT(info.video.size() && size == info.video[0].size);
+                    bool running = true;
+                    while (running)
+                    {
+                        bool sleep = false;
+                        {
+                            std::unique_lock<std::mutex> lock(read->getMutex(), std::try_to_lock);
+                            if (lock.owns_lock())
+                            {
+                                auto& readQueue = read->getVideoQueue();
+                                if (!readQueue.isEmpty())
+                                {
+                                    auto frame = readQueue.popFrame();
+                                    DJV_ASSERT(!frame.data || Image::getProxySize(size, 2) == frame.data->getSize());
+                                }
+                                else if (readQueue.isFinished())
+                                {
+                                    running = false;
+                                }
+                                else
+                                {
+                                    sleep = true;
+                                }
+                            }
+                            else
+                            {
+                                sleep = true;
+                            }
+                        }
+                        if (sleep)
+                        {
+                            std::this_thread::sleep_for(System::getTimerDuration(System::TimerValue::Fast));
+                        }
+                    }
+                }
             }
             catch (const std::exception& e)
             {
@@ -515,9 +665,209 @@ namespace djv
                     ss << io->canWrite(System::File::Info(i), Info());
                     _print(ss.str());
                 }
+                DJV_ASSERT(io->canRead(System::File::Info("render.1.DPX")));
+                DJV_ASSERT(!io->canRead(System::File::Info("tmp.txt")));
+
+                {
+                    // Files without a known extension are read by their magic number.
+                    const System::File::Path path(getTempPath(), "IOSystemMagic");
+                    {
+                        auto fileIO = System::File::IO::create();
+                        fileIO->open(path.get(), System::File::Mode::Write);
+                        const std::string data = "P5\n1 1\n255\n";
+                        fileIO->write(data.c_str(), data.size());
+                        fileIO->writeU8(0);
+                    }
+                    DJV_ASSERT(!io->canRead(System::File::Info(path)));
+                    auto read = io->read(System::File::Info(path));
+                    DJV_ASSERT(read);
+                    const auto info = read->getInfo().get();
+                    DJV_ASSERT(info.video.size() && Image::Size(1, 1) == info.video[0].size);
+                }
+
+                {
+                    // The options are kept for plugins that have not been
+                    // created yet.
+                    rapidjson::Document document;
+                    auto& allocator = document.GetAllocator();
+                    PPM::Options options;
+                    options.data = PPM::Data::ASCII;
+                    const auto json = toJSON(options, allocator);
+                    io->setOptions(PPM::pluginName, json);
+                    DJV_ASSERT(json == io->getOptions(PPM::pluginName, allocator));
+                    options.data = PPM::Data::Binary;
+                    io->setOptions(PPM::pluginName, toJSON(options, allocator));
+                }
             }
         }
                 
+        namespace
+        {
+            void writePPM(const System::File::Path& path, uint8_t value, uint16_t size = 1)
+            {
+                auto io = System::File::IO::create();
+                io->open(path.get(), System::File::Mode::Write);
+                std::stringstream ss;
+                ss << "P5\n" << size << " " << size << "\n255\n";
+                const std::string header = ss.str();
+                io->write(header.c_str(), header.size());
+                for (size_t i = 0; i < size * size; ++i)
+                {
+                    io->writeU8(value);
+                }
+            }
+
+            bool waitFor(const std::function<bool(void)>& value)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                bool out = value();
+                while (!out && std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+                {
+                    std::this_thread::sleep_for(System::getTimerDuration(System::TimerValue::Fast));
+                    out = value();
+                }
+                return out;
+            }
+
+            std::map<Math::Frame::Index, uint8_t> readFrames(const std::shared_ptr<IRead>& read)
+            {
+                std::map<Math::Frame::Index, uint8_t> out;
+                read->seek(0, Direction::Forward);
+                waitFor(
+                    [read, &out]
+                    {
+                        std::lock_guard<std::mutex> lock(read->getMutex());
+                        auto& queue = read->getVideoQueue();
+                        while (!queue.isEmpty())
+                        {
+                            const auto frame = queue.popFrame();
+                            if (frame.data)
+                            {
+                                out[frame.frame] = frame.data->getData()[0];
+                            }
+                        }
+                        return queue.isFinished();
+                    });
+                return out;
+            }
+
+        } // namespace
+
+        void IOTest::_sequenceUpdate()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<IOSystem>();
+                const System::File::Path path(getTempPath(), "IOSequenceUpdate");
+                System::File::mkdir(path);
+                for (Math::Frame::Number i = 1; i <= 3; ++i)
+                {
+                    writePPM(System::File::Path(path, "render." + std::to_string(i) + ".ppm"), i);
+                }
+                auto fileInfo = System::File::getSequence(
+                    System::File::Path(path, "render.1.ppm"),
+                    io->getSequenceExtensions());
+                DJV_ASSERT(System::File::Type::Sequence == fileInfo.getType());
+
+                auto read = io->read(fileInfo);
+                read->setCacheMaxByteCount(1000000);
+                read->setCacheEnabled(true);
+                read->getInfo().get();
+                DJV_ASSERT(waitFor(
+                    [read]
+                    {
+                        return 3 == read->getCachedFrames().getFrameCount();
+                    }));
+
+                // Frames inserted before the cached frames move them in the
+                // cache.
+                writePPM(System::File::Path(path, "render.0.ppm"), 0);
+                fileInfo.setSequence(Math::Frame::Sequence(Math::Frame::Range(0, 3)));
+                DJV_ASSERT(read->updateSequence(fileInfo, {}));
+                DJV_ASSERT(waitFor(
+                    [read]
+                    {
+                        return read->getCachedFrames().contains(3);
+                    }));
+                auto frames = readFrames(read);
+                DJV_ASSERT(4 == frames.size());
+                for (const auto& i : frames)
+                {
+                    DJV_ASSERT(i.first == i.second);
+                }
+
+                // Frames that are modified are read again.
+                writePPM(System::File::Path(path, "render.2.ppm"), 20);
+                DJV_ASSERT(read->updateSequence(fileInfo, { 2 }));
+                DJV_ASSERT(waitFor(
+                    [read]
+                    {
+                        return !read->getCachedFrames().contains(2);
+                    }));
+                frames = readFrames(read);
+                DJV_ASSERT(4 == frames.size());
+                DJV_ASSERT(0 == frames[0]);
+                DJV_ASSERT(1 == frames[1]);
+                DJV_ASSERT(20 == frames[2]);
+                DJV_ASSERT(3 == frames[3]);
+            }
+        }
+
+        void IOTest::_proxy()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<IOSystem>();
+                const System::File::Path path(getTempPath(), "IOProxy");
+                System::File::mkdir(path);
+                for (Math::Frame::Number i = 1; i <= 3; ++i)
+                {
+                    writePPM(System::File::Path(path, "render." + std::to_string(i) + ".ppm"), i, 8);
+                }
+                auto fileInfo = System::File::getSequence(
+                    System::File::Path(path, "render.1.ppm"),
+                    io->getSequenceExtensions());
+                DJV_ASSERT(System::File::Type::Sequence == fileInfo.getType());
+
+                // The frames are read and cached at the proxy size.
+                ReadOptions options;
+                options.proxy = 2;
+                auto read = io->read(fileInfo, options);
+                read->setCacheMaxByteCount(1000000);
+                read->setCacheEnabled(true);
+                const auto info = read->getInfo().get();
+                DJV_ASSERT(info.video.size() && Image::Size(8, 8) == info.video[0].size);
+                DJV_ASSERT(waitFor(
+                    [read]
+                    {
+                        return 3 == read->getCachedFrames().getFrameCount();
+                    }));
+                const size_t proxyByteCount = Image::Info(4, 4, Image::Type::L_U8).getDataByteCount();
+                DJV_ASSERT(waitFor(
+                    [read, proxyByteCount]
+                    {
+                        return 3 * proxyByteCount == read->getCacheByteCount();
+                    }));
+                read->seek(0, Direction::Forward);
+                size_t count = 0;
+                waitFor(
+                    [read, &count]
+                    {
+                        std::lock_guard<std::mutex> lock(read->getMutex());
+                        auto& queue = read->getVideoQueue();
+                        while (!queue.isEmpty())
+                        {
+                            const auto frame = queue.popFrame();
+                            DJV_ASSERT(frame.data);
+                            DJV_ASSERT(Image::Size(4, 4) == frame.data->getSize());
+                            ++count;
+                        }
+                        return queue.isFinished();
+                    });
+                DJV_ASSERT(3 == count);
+            }
+        }
+
     } // namespace AVTest
 } // namespace djv
 
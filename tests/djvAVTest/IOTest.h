@@ -20,6 +20,7 @@ namespace djv
             void run() override;
             
         private:
+            void _options();
             void _info();
             void _videoFrame();
             void _videoQueue();
@@ -37,6 +38,8 @@ namespace djv
                 const Image::Tags&,
                 const std::shared_ptr<AV::IO::IOSystem>&);
             void _system();
+            void _sequenceUpdate();
+            void _proxy();
         };
         
     } // namespace AVTest
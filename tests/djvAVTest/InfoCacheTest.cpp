@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/InfoCacheTest.h>
+
+#include <djvAV/InfoCache.h>
+
+#include <djvSystem/FileIO.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            void writeFile(const std::string& fileName, const std::string& contents)
+            {
+                auto io = System::File::IO::create();
+                io->open(fileName, System::File::Mode::Write);
+                io->write(contents);
+            }
+
+        } // namespace
+
+        InfoCacheTest::InfoCacheTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest(
+                "djv::AVTest::InfoCacheTest",
+                System::File::Path(tempPath, "InfoCacheTest"),
+                context)
+        {}
+        
+        void InfoCacheTest::run()
+        {
+            const std::string fileName = System::File::Path(getTempPath(), "InfoCacheTest.ppm").get();
+            writeFile(fileName, "abc");
+            const std::string cacheFileName = System::File::Path(getTempPath(), IO::infoCacheFileName).get();
+
+            IO::Info info;
+            info.fileName = fileName;
+            info.video.push_back(Image::Info(1, 2, Image::Type::RGB_U8));
+            info.video[0].codec = "PPM";
+            info.videoSequence = Math::Frame::Sequence(1, 10, 4);
+            info.tags.set("Key", "Value");
+
+            {
+                auto cache = IO::InfoCache::create();
+                DJV_ASSERT(0 == cache->getCount());
+                DJV_ASSERT(!cache->isDirty());
+                const System::File::Info fileInfo(fileName);
+                IO::Info tmp;
+                DJV_ASSERT(!cache->get(fileInfo, tmp));
+                cache->add(fileInfo, info);
+                DJV_ASSERT(1 == cache->getCount());
+                DJV_ASSERT(cache->isDirty());
+                DJV_ASSERT(cache->get(fileInfo, tmp));
+                DJV_ASSERT(info == tmp);
+                cache->write(cacheFileName);
+                DJV_ASSERT(!cache->isDirty());
+            }
+
+            {
+                auto cache = IO::InfoCache::create();
+                cache->read(cacheFileName);
+                DJV_ASSERT(1 == cache->getCount());
+                IO::Info tmp;
+                DJV_ASSERT(cache->get(System::File::Info(fileName), tmp));
+                DJV_ASSERT(info == tmp);
+
+                // Changing the file invalidates the entry.
+                writeFile(fileName, "abcdef");
+                DJV_ASSERT(!cache->get(System::File::Info(fileName), tmp));
+
+                cache->remove(System::File::Info(fileName));
+                DJV_ASSERT(0 == cache->getCount());
+            }
+
+            {
+                // Sequences that gain frames invalidate the entry.
+                auto cache = IO::InfoCache::create();
+                for (size_t i = 1; i <= 3; ++i)
+                {
+                    writeFile(System::File::Path(getTempPath(), "render." + std::to_string(i) + ".ppm").get(), "abc");
+                }
+                const System::File::Info a(
+                    System::File::Path(getTempPath(), "render.1-2.ppm"),
+                    System::File::Type::Sequence,
+                    Math::Frame::Sequence(1, 2));
+                const System::File::Info b(
+                    System::File::Path(getTempPath(), "render.1-3.ppm"),
+                    System::File::Type::Sequence,
+                    Math::Frame::Sequence(1, 3));
+                cache->add(a, info);
+                IO::Info tmp;
+                DJV_ASSERT(cache->get(a, tmp));
+                DJV_ASSERT(!cache->get(b, tmp));
+                cache->add(b, info);
+                DJV_ASSERT(1 == cache->getCount());
+            }
+
+            {
+                auto cache = IO::InfoCache::create();
+                cache->setMax(10);
+                DJV_ASSERT(10 == cache->getMax());
+                for (size_t i = 0; i < 20; ++i)
+                {
+                    const std::string fileName = System::File::Path(getTempPath(), "max." + std::to_string(i) + ".ppm").get();
+                    writeFile(fileName, "abc");
+                    cache->add(System::File::Info(fileName), info);
+                }
+                DJV_ASSERT(cache->getCount() <= 10);
+                cache->clear();
+                DJV_ASSERT(0 == cache->getCount());
+                DJV_ASSERT(0.F == cache->getPercentageUsed());
+            }
+
+            {
+                // Invalid cache files are ignored.
+                writeFile(cacheFileName, "invalid");
+                auto cache = IO::InfoCache::create();
+                cache->read(cacheFileName);
+                DJV_ASSERT(0 == cache->getCount());
+            }
+        }
+        
+    } // namespace AVTest
+} // namespace djv
+
@@ -0,0 +1,171 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/ThumbnailCacheTest.h>
+
+#include <djvAV/ThumbnailCache.h>
+
+#include <djvImage/Data.h>
+
+#include <djvSystem/FileIO.h>
+#include <djvSystem/FileInfo.h>
+#include <djvSystem/FileInfoFunc.h>
+#include <djvSystem/Path.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            void writeFile(const std::string& fileName, const std::string& contents)
+            {
+                auto io = System::File::IO::create();
+                io->open(fileName, System::File::Mode::Write);
+                io->write(contents);
+            }
+
+            std::shared_ptr<Image::Data> createImage(uint8_t value)
+            {
+                auto out = Image::Data::create(Image::Info(4, 2, Image::Type::RGBA_U8));
+                out->setPluginName("PPM");
+                Image::Tags tags;
+                tags.set("Key", "Value");
+                out->setTags(tags);
+                uint8_t* p = out->getData();
+                for (size_t i = 0; i < out->getDataByteCount(); ++i)
+                {
+                    p[i] = value + static_cast<uint8_t>(i);
+                }
+                return out;
+            }
+
+        } // namespace
+
+        ThumbnailCacheTest::ThumbnailCacheTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest(
+                "djv::AVTest::ThumbnailCacheTest",
+                System::File::Path(tempPath, "ThumbnailCacheTest"),
+                context)
+        {}
+        
+        void ThumbnailCacheTest::run()
+        {
+            const std::string fileName = System::File::Path(getTempPath(), "ThumbnailCacheTest.ppm").get();
+            writeFile(fileName, "abc");
+            const std::string cacheFileName = System::File::Path(getTempPath(), thumbnailCacheFileName).get();
+            const Image::Size size(100, 50);
+            const auto image = createImage(0);
+
+            {
+                auto cache = ThumbnailCache::create();
+                DJV_ASSERT(0 == cache->getCount());
+                DJV_ASSERT(!cache->isDirty());
+                const System::File::Info fileInfo(fileName);
+                DJV_ASSERT(!cache->get(fileInfo, size));
+                cache->add(fileInfo, size, Image::Type::None, image);
+                DJV_ASSERT(1 == cache->getCount());
+                DJV_ASSERT(image->getDataByteCount() == cache->getByteCount());
+                DJV_ASSERT(cache->isDirty());
+                DJV_ASSERT(cache->get(fileInfo, size) == image);
+                DJV_ASSERT(!cache->get(fileInfo, Image::Size(10, 10)));
+                DJV_ASSERT(!cache->get(fileInfo, size, Image::Type::L_U8));
+                cache->write(cacheFileName);
+                DJV_ASSERT(!cache->isDirty());
+                auto data = cache->get(fileInfo, size);
+                DJV_ASSERT(data && *data == *image);
+            }
+
+            {
+                auto cache = ThumbnailCache::create();
+                cache->read(cacheFileName);
+                DJV_ASSERT(1 == cache->getCount());
+                auto data = cache->get(System::File::Info(fileName), size);
+                DJV_ASSERT(data);
+                DJV_ASSERT(*data == *image);
+                DJV_ASSERT(data->getPluginName() == image->getPluginName());
+                DJV_ASSERT(data->getTags() == image->getTags());
+
+                // Write the cache again, replacing the open pack file.
+                cache->add(System::File::Info(fileName), Image::Size(10, 10), Image::Type::None, createImage(1));
+                cache->write(cacheFileName);
+                DJV_ASSERT(2 == cache->getCount());
+                data = cache->get(System::File::Info(fileName), size);
+                DJV_ASSERT(data && *data == *image);
+
+                // Changing the file invalidates the entry.
+                writeFile(fileName, "abcdef");
+                DJV_ASSERT(!cache->get(System::File::Info(fileName), size));
+                DJV_ASSERT(!cache->get(System::File::Info(fileName), Image::Size(10, 10)));
+                DJV_ASSERT(0 == cache->getCount());
+            }
+
+            {
+                // The least recently used entries are removed.
+                auto cache = ThumbnailCache::create();
+                cache->setMax(image->getDataByteCount() * 10);
+                for (size_t i = 0; i < 20; ++i)
+                {
+                    const std::string fileName = System::File::Path(getTempPath(), "max." + std::to_string(i) + ".ppm").get();
+                    writeFile(fileName, "abc");
+                    cache->add(System::File::Info(fileName), size, Image::Type::None, createImage(i));
+                }
+                DJV_ASSERT(cache->getCount() <= 10);
+                DJV_ASSERT(cache->getByteCount() <= cache->getMax());
+                cache->clear();
+                DJV_ASSERT(0 == cache->getCount());
+                DJV_ASSERT(0.F == cache->getPercentageUsed());
+            }
+
+            {
+                // New thumbnails are written to new pack files, which are
+                // merged when there are too many.
+                auto cache = ThumbnailCache::create();
+                cache->read(cacheFileName);
+                cache->clear();
+                for (size_t i = 0; i < 20; ++i)
+                {
+                    cache->add(System::File::Info(fileName), Image::Size(i + 1, i + 1), Image::Type::None, createImage(i));
+                    cache->write(cacheFileName);
+                }
+                size_t packCount = 0;
+                for (const auto& i : System::File::directoryList(getTempPath()))
+                {
+                    const std::string& name = i.getFileName(Math::Frame::invalid, false);
+                    if (name.size() > 5 && name.substr(name.size() - 5) == ".pack")
+                    {
+                        ++packCount;
+                    }
+                }
+                DJV_ASSERT(packCount > 0 && packCount <= 8);
+                auto cache2 = ThumbnailCache::create();
+                cache2->read(cacheFileName);
+                DJV_ASSERT(20 == cache2->getCount());
+                for (size_t i = 0; i < 20; ++i)
+                {
+                    auto data = cache2->get(System::File::Info(fileName), Image::Size(i + 1, i + 1));
+                    DJV_ASSERT(data && *data == *createImage(i));
+                }
+            }
+
+            {
+                // Out of date index files are ignored.
+                auto a = ThumbnailCache::create();
+                a->add(System::File::Info(fileName), size, Image::Type::None, image);
+                a->write(cacheFileName);
+                writeFile(cacheFileName + ".idx", "invalid");
+                auto b = ThumbnailCache::create();
+                b->read(cacheFileName);
+                DJV_ASSERT(0 == b->getCount());
+            }
+        }
+        
+    } // namespace AVTest
+} // namespace djv
+
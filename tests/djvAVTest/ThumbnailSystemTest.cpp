@@ -71,6 +71,14 @@ namespace djv
                 system->cancelInfo(infoCancelFuture.uid);
                 system->cancelImage(imageCancelFuture.uid);
 
+                // Request thumbnails with different priorities.
+                infoFutures.push_back(system->getInfo(fileInfo, 100));
+                imageFutures.push_back(system->getImage(fileInfo, Image::Size(16, 16), Image::Type::None, 100));
+                system->setInfoPriority(infoFutures.back().uid, 0);
+                system->setImagePriority(imageFutures.back().uid, 0);
+                infoFutures.push_back(system->getInfo(fileInfo, 10));
+                imageFutures.push_back(system->getImage(fileInfo, Image::Size(24, 24), Image::Type::None, 10));
+
                 // Wait for and collect info.
                 std::vector<IO::Info> infos;
                 while (!infoFutures.empty())
@@ -6,6 +6,9 @@
 
 #include <djvCore/Cache.h>
 
+#include <chrono>
+#include <thread>
+
 using namespace djv::Core;
 
 namespace djv
@@ -19,6 +22,14 @@ namespace djv
         {}
         
         void CacheTest::run()
+        {
+            _cache();
+            _weight();
+            _sharded();
+            _benchmark();
+        }
+
+        void CacheTest::_cache()
         {
             {
                 Memory::Cache<int, std::string> cache;
@@ -40,11 +51,137 @@ namespace djv
                 std::string value;
                 cache.get(2, value);
                 DJV_ASSERT(value == "b");
-                DJV_ASSERT(cache.getKeys() == std::vector<int>({ 2, 3 }));
-                DJV_ASSERT(cache.getValues() == std::vector<std::string>({ "b", "c" }));
+                DJV_ASSERT(cache.getKeys() == std::vector<int>({ 3, 2 }));
+                DJV_ASSERT(cache.getValues() == std::vector<std::string>({ "c", "b" }));
+                cache.add(4, "d");
+                DJV_ASSERT(cache.getKeys() == std::vector<int>({ 2, 4 }));
+                cache.add(2, "e");
+                DJV_ASSERT(cache.getKeys() == std::vector<int>({ 4, 2 }));
+                DJV_ASSERT(cache.getValues() == std::vector<std::string>({ "d", "e" }));
+                cache.remove(4);
+                DJV_ASSERT(!cache.contains(4));
+                DJV_ASSERT(1 == cache.getSize());
+                cache.clear();
+                DJV_ASSERT(0 == cache.getSize());
+                DJV_ASSERT(0 == cache.getWeight());
             }
         }
+
+        void CacheTest::_weight()
+        {
+            Memory::Cache<int, std::string> cache;
+            cache.setWeightFunc(
+                [](const std::string& value)
+                {
+                    return value.size();
+                });
+            cache.setMax(10);
+            cache.add(1, "aaaa");
+            cache.add(2, "bbbb");
+            DJV_ASSERT(8 == cache.getWeight());
+            DJV_ASSERT(80.F == cache.getPercentageUsed());
+            cache.add(3, "cccc");
+            DJV_ASSERT(cache.getKeys() == std::vector<int>({ 2, 3 }));
+            DJV_ASSERT(8 == cache.getWeight());
+            cache.add(2, "b");
+            DJV_ASSERT(5 == cache.getWeight());
+            cache.setMax(4);
+            DJV_ASSERT(cache.getKeys() == std::vector<int>({ 2 }));
+            cache.setWeightFunc(nullptr);
+            DJV_ASSERT(1 == cache.getWeight());
+        }
+
+        void CacheTest::_sharded()
+        {
+            Memory::ShardedCache<int, int, std::hash<int>, 4> cache;
+            cache.setMax(100);
+            DJV_ASSERT(100 == cache.getMax());
+            std::vector<std::thread> threads;
+            for (int i = 0; i < 4; ++i)
+            {
+                threads.push_back(std::thread(
+                    [&cache, i]
+                    {
+                        for (int j = 0; j < 1000; ++j)
+                        {
+                            const int key = i * 1000 + j;
+                            cache.add(key, key);
+                            int value = 0;
+                            if (cache.get(key, value))
+                            {
+                                DJV_ASSERT(key == value);
+                            }
+                        }
+                    }));
+            }
+            for (auto& i : threads)
+            {
+                i.join();
+            }
+            DJV_ASSERT(cache.getSize() <= 100);
+            DJV_ASSERT(cache.getWeight() == cache.getSize());
+            cache.add(-1, 1);
+            DJV_ASSERT(cache.contains(-1));
+            cache.remove(-1);
+            DJV_ASSERT(!cache.contains(-1));
+            cache.clear();
+            DJV_ASSERT(0 == cache.getSize());
+            DJV_ASSERT(0.F == cache.getPercentageUsed());
+
+            // Fewer shards are used when the maximum is smaller than the
+            // number of shards.
+            cache.setMax(2);
+            for (int i = 0; i < 8; ++i)
+            {
+                cache.add(i, i);
+                DJV_ASSERT(cache.contains(i));
+                DJV_ASSERT(cache.getSize() <= 2);
+            }
+            DJV_ASSERT(2 == cache.getMax());
+            cache.setMax(100);
+            for (int i = 0; i < 100; ++i)
+            {
+                cache.add(i, i);
+            }
+            DJV_ASSERT(100 == cache.getSize());
+        }
+
+        void CacheTest::_benchmark()
+        {
+            const size_t max = 10000;
+            const size_t count = 1000000;
+            Memory::Cache<size_t, size_t> cache;
+            cache.setMax(max);
+            const auto t0 = std::chrono::steady_clock::now();
+            size_t hits = 0;
+            uint32_t random = 1;
+            for (size_t i = 0; i < count; ++i)
+            {
+                // Most of the accesses are to a set of keys that fits in the
+                // cache, the rest are spread over a much larger set so that
+                // values are also evicted.
+                random = random * 1664525 + 1013904223;
+                const size_t key = (random >> 8) % 10 ?
+                    (random >> 4) % (max / 2) :
+                    max + (random >> 4) % (max * 10);
+                size_t value = 0;
+                if (cache.get(key, value))
+                {
+                    ++hits;
+                }
+                else
+                {
+                    cache.add(key, i);
+                }
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+            const std::chrono::duration<float> diff = t1 - t0;
+            std::stringstream ss;
+            ss << "Benchmark: " << count << " operations, " << hits << " hits, " <<
+                static_cast<size_t>(count / std::max(diff.count(), .001F)) << " operations per second";
+            _print(ss.str());
+            DJV_ASSERT(cache.getSize() == max);
+        }
         
     } // namespace CoreTest
 } // namespace djv
-
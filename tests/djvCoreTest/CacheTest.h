@@ -18,6 +18,12 @@ namespace djv
                 const std::shared_ptr<System::Context>&);
             
             void run() override;
+
+        private:
+            void _cache();
+            void _weight();
+            void _sharded();
+            void _benchmark();
         };
         
     } // namespace CoreTest
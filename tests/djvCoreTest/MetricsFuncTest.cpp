@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCoreTest/MetricsFuncTest.h>
+
+#include <djvCore/MetricsFunc.h>
+
+#include <limits>
+#include <sstream>
+#include <thread>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        MetricsFuncTest::MetricsFuncTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::CoreTest::MetricsFuncTest", tempPath, context)
+        {}
+        
+        void MetricsFuncTest::run()
+        {
+            {
+                auto counter = Metrics::getCounter("djv::CoreTest::MetricsFuncTest::counter");
+                DJV_ASSERT(counter == Metrics::getCounter("djv::CoreTest::MetricsFuncTest::counter"));
+                counter->reset();
+                counter->add();
+                counter->add(2);
+                counter->add(-1);
+                DJV_ASSERT(3 == counter->get());
+                DJV_ASSERT(3 == Metrics::getCounterValues()["djv::CoreTest::MetricsFuncTest::counter"]);
+            }
+
+            {
+                auto gauge = Metrics::getGauge("djv::CoreTest::MetricsFuncTest::gauge");
+                gauge->set(10);
+                gauge->add(-3);
+                DJV_ASSERT(7 == gauge->get());
+                DJV_ASSERT(7 == Metrics::getGaugeValues()["djv::CoreTest::MetricsFuncTest::gauge"]);
+            }
+
+            {
+                for (int64_t i = 0; i < 1000000; i += 997)
+                {
+                    const size_t bucket = Metrics::Histogram::getBucket(i);
+                    DJV_ASSERT(bucket < Metrics::Histogram::bucketCount);
+                    DJV_ASSERT(Metrics::Histogram::getBucketMax(bucket) >= i);
+                    DJV_ASSERT(0 == bucket || Metrics::Histogram::getBucketMax(bucket - 1) < i);
+                }
+                DJV_ASSERT(
+                    Metrics::Histogram::getBucket(std::numeric_limits<int64_t>::max()) ==
+                    Metrics::Histogram::bucketCount - 1);
+            }
+
+            {
+                auto histogram = Metrics::getHistogram("djv::CoreTest::MetricsFuncTest::histogram");
+                histogram->reset();
+                DJV_ASSERT(0 == histogram->getData().count);
+                std::vector<std::thread> threads;
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    threads.push_back(std::thread(
+                        [histogram]
+                        {
+                            for (int64_t i = 1; i <= 1000; ++i)
+                            {
+                                histogram->record(i);
+                            }
+                        }));
+                }
+                for (auto& i : threads)
+                {
+                    i.join();
+                }
+                const auto data = histogram->getData();
+                {
+                    std::stringstream ss;
+                    ss << "count: " << data.count << ", p50: " << data.p50 << ", p90: " << data.p90 << ", p99: " << data.p99;
+                    _print(ss.str());
+                }
+                DJV_ASSERT(4000 == data.count);
+                DJV_ASSERT(1 == data.min);
+                DJV_ASSERT(1000 == data.max);
+                DJV_ASSERT(data.mean > 500.0 && data.mean < 501.0);
+                DJV_ASSERT(data.p50 >= 500 && data.p50 <= 500 * 1.125F);
+                DJV_ASSERT(data.p90 >= 900 && data.p90 <= 900 * 1.125F);
+                DJV_ASSERT(data.p99 >= 990 && data.p99 <= 1000);
+            }
+
+            {
+                const std::string json = Metrics::toJSON();
+                _print(json);
+                DJV_ASSERT(json.find("djv::CoreTest::MetricsFuncTest::histogram") != std::string::npos);
+
+                Metrics::reset();
+                DJV_ASSERT(0 == Metrics::getCounter("djv::CoreTest::MetricsFuncTest::counter")->get());
+                DJV_ASSERT(0 == Metrics::getHistogram("djv::CoreTest::MetricsFuncTest::histogram")->getCount());
+            }
+        }
+        
+    } // namespace CoreTest
+} // namespace djv
@@ -0,0 +1,233 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCoreTest/ObserverTest.h>
+
+#include <djvCore/ListObserver.h>
+#include <djvCore/MapObserver.h>
+#include <djvCore/ValueObserver.h>
+
+#include <chrono>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        ObserverTest::ObserverTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::CoreTest::ObserverTest", tempPath, context)
+        {}
+        
+        void ObserverTest::run()
+        {
+            _slots();
+            _coalescing();
+            _benchmark();
+        }
+
+        void ObserverTest::_slots()
+        {
+            {
+                Observer::Slots<int> slots;
+                auto a = std::make_shared<int>(1);
+                auto b = std::make_shared<int>(2);
+                const Observer::SlotID idA = slots.add(a);
+                const Observer::SlotID idB = slots.add(b);
+                DJV_ASSERT(idA != Observer::invalidSlotID);
+                DJV_ASSERT(idA != idB);
+                DJV_ASSERT(2 == slots.getCount());
+
+                slots.remove(idA);
+                DJV_ASSERT(1 == slots.getCount());
+                slots.remove(idA);
+                DJV_ASSERT(1 == slots.getCount());
+
+                // The slot is reused with a new generation, so the stale ID
+                // does not remove the new observer.
+                auto c = std::make_shared<int>(3);
+                const Observer::SlotID idC = slots.add(c);
+                DJV_ASSERT(idC != idA);
+                DJV_ASSERT((idC & 0xffffffff) == (idA & 0xffffffff));
+                slots.remove(idA);
+                DJV_ASSERT(2 == slots.getCount());
+
+                int sum = 0;
+                slots.forEach(
+                    [&sum](const std::shared_ptr<int>& value)
+                    {
+                        sum += *value;
+                    });
+                DJV_ASSERT(5 == sum);
+            }
+
+            {
+                // Add and remove observers from a callback.
+                auto subject = Observer::ValueSubject<int>::create(0);
+                std::shared_ptr<Observer::Value<int> > observerA;
+                std::shared_ptr<Observer::Value<int> > observerB;
+                std::shared_ptr<Observer::Value<int> > observerC;
+                int valueB = 0;
+                int valueC = 0;
+                observerA = Observer::Value<int>::create(
+                    subject,
+                    [&](int value)
+                    {
+                        if (1 == value)
+                        {
+                            observerB.reset();
+                            observerC = Observer::Value<int>::create(
+                                subject,
+                                [&valueC](int value)
+                                {
+                                    valueC = value;
+                                },
+                                Observer::CallbackAction::Suppress);
+                        }
+                    });
+                observerB = Observer::Value<int>::create(
+                    subject,
+                    [&valueB](int value)
+                    {
+                        valueB = value;
+                    });
+                DJV_ASSERT(2 == subject->getObserversCount());
+                subject->setIfChanged(1);
+                DJV_ASSERT(0 == valueB);
+                DJV_ASSERT(0 == valueC);
+                DJV_ASSERT(2 == subject->getObserversCount());
+                subject->setIfChanged(2);
+                DJV_ASSERT(2 == valueC);
+            }
+        }
+
+        void ObserverTest::_coalescing()
+        {
+            Observer::flushPending();
+            {
+                auto subject = Observer::ValueSubject<int>::create(0);
+                DJV_ASSERT(!subject->isCoalescing());
+                subject->setCoalescing(true);
+                DJV_ASSERT(subject->isCoalescing());
+                int value = 0;
+                size_t callbacks = 0;
+                auto observer = Observer::Value<int>::create(
+                    subject,
+                    [&value, &callbacks](int v)
+                    {
+                        value = v;
+                        ++callbacks;
+                    },
+                    Observer::CallbackAction::Suppress);
+
+                for (int i = 1; i <= 10; ++i)
+                {
+                    subject->setIfChanged(i);
+                }
+                DJV_ASSERT(0 == callbacks);
+                DJV_ASSERT(subject->isPending());
+                DJV_ASSERT(1 == Observer::getPendingCount());
+                Observer::flushPending();
+                DJV_ASSERT(1 == callbacks);
+                DJV_ASSERT(10 == value);
+                DJV_ASSERT(!subject->isPending());
+                DJV_ASSERT(0 == Observer::getPendingCount());
+
+                subject->setIfChanged(11);
+                subject->setCoalescing(false);
+                DJV_ASSERT(2 == callbacks);
+                DJV_ASSERT(11 == value);
+                DJV_ASSERT(0 == Observer::getPendingCount());
+                subject->setIfChanged(12);
+                DJV_ASSERT(3 == callbacks);
+            }
+
+            {
+                auto listSubject = Observer::ListSubject<int>::create();
+                auto mapSubject = Observer::MapSubject<int, int>::create();
+                listSubject->setCoalescing(true);
+                mapSubject->setCoalescing(true);
+                size_t listSize = 0;
+                size_t mapSize = 0;
+                auto listObserver = Observer::List<int>::create(
+                    listSubject,
+                    [&listSize](const std::vector<int>& value)
+                    {
+                        listSize = value.size();
+                    });
+                auto mapObserver = Observer::Map<int, int>::create(
+                    mapSubject,
+                    [&mapSize](const std::map<int, int>& value)
+                    {
+                        mapSize = value.size();
+                    });
+                for (int i = 0; i < 10; ++i)
+                {
+                    listSubject->pushBack(i);
+                    mapSubject->setItem(i, i);
+                }
+                DJV_ASSERT(0 == listSize);
+                DJV_ASSERT(0 == mapSize);
+                DJV_ASSERT(2 == Observer::getPendingCount());
+                Observer::flushPending();
+                DJV_ASSERT(10 == listSize);
+                DJV_ASSERT(10 == mapSize);
+            }
+
+            {
+                // Destroy a subject with pending changes.
+                auto subject = Observer::ValueSubject<int>::create(0);
+                subject->setCoalescing(true);
+                subject->setIfChanged(1);
+                DJV_ASSERT(1 == Observer::getPendingCount());
+                subject.reset();
+                DJV_ASSERT(0 == Observer::getPendingCount());
+                Observer::flushPending();
+            }
+        }
+
+        void ObserverTest::_benchmark()
+        {
+            const size_t observerCount = 50;
+            const size_t count = 100000;
+            for (const bool coalescing : { false, true })
+            {
+                auto subject = Observer::ValueSubject<size_t>::create(0);
+                subject->setCoalescing(coalescing);
+                size_t sum = 0;
+                std::vector<std::shared_ptr<Observer::Value<size_t> > > observers;
+                for (size_t i = 0; i < observerCount; ++i)
+                {
+                    observers.push_back(Observer::Value<size_t>::create(
+                        subject,
+                        [&sum](size_t value)
+                        {
+                            sum += value;
+                        }));
+                }
+                const auto t0 = std::chrono::steady_clock::now();
+                for (size_t i = 1; i <= count; ++i)
+                {
+                    subject->setIfChanged(i);
+                    if (coalescing && 0 == i % 100)
+                    {
+                        Observer::flushPending();
+                    }
+                }
+                Observer::flushPending();
+                const auto t1 = std::chrono::steady_clock::now();
+                const std::chrono::duration<float> diff = t1 - t0;
+                std::stringstream ss;
+                ss << "Benchmark: " << (coalescing ? "coalescing, " : "") << count << " changes, " <<
+                    observerCount << " observers, " <<
+                    static_cast<size_t>(count / std::max(diff.count(), .001F)) << " changes per second";
+                _print(ss.str());
+                DJV_ASSERT(sum > 0);
+            }
+        }
+        
+    } // namespace CoreTest
+} // namespace djv
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        class ObserverTest : public Test::ITest
+        {
+        public:
+            ObserverTest(
+                const System::File::Path& tempPath,
+                const std::shared_ptr<System::Context>&);
+            
+            void run() override;
+
+        private:
+            void _slots();
+            void _coalescing();
+            void _benchmark();
+        };
+        
+    } // namespace CoreTest
+} // namespace djv
+
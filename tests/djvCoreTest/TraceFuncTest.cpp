@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCoreTest/TraceFuncTest.h>
+
+#include <djvCore/TraceFunc.h>
+
+#include <thread>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        TraceFuncTest::TraceFuncTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::CoreTest::TraceFuncTest", tempPath, context)
+        {}
+        
+        void TraceFuncTest::run()
+        {
+            const bool enabled = Trace::isEnabled();
+
+            {
+                Trace::setEnabled(false);
+                Trace::clear();
+                {
+                    Trace::Span span("span");
+                }
+                Trace::addInstant("instant");
+                DJV_ASSERT(Trace::getEvents().empty());
+            }
+
+            {
+                Trace::setEnabled(true);
+                Trace::clear();
+                {
+                    Trace::Span span("span", 1);
+                }
+                std::thread thread(
+                    []
+                    {
+                        Trace::Span span("thread", 2);
+                        Trace::addInstant("instant", 2);
+                    });
+                thread.join();
+                const auto events = Trace::getEvents();
+                DJV_ASSERT(3 == events.size());
+                for (size_t i = 1; i < events.size(); ++i)
+                {
+                    DJV_ASSERT(events[i - 1].begin <= events[i].begin);
+                }
+                size_t instantCount = 0;
+                for (const auto& i : events)
+                {
+                    DJV_ASSERT(i.begin <= i.end);
+                    DJV_ASSERT(1 == i.frame || 2 == i.frame);
+                    if (i.instant)
+                    {
+                        ++instantCount;
+                    }
+                }
+                DJV_ASSERT(1 == instantCount);
+                const std::string json = Trace::toChromeJSON(events);
+                _print(json);
+                DJV_ASSERT(json.find("traceEvents") != std::string::npos);
+
+                Trace::clear();
+                DJV_ASSERT(Trace::getEvents().empty());
+            }
+
+            {
+                // Overflow the ring buffer.
+                for (size_t i = 0; i < 100000; ++i)
+                {
+                    Trace::addEvent("overflow", i, i, i);
+                }
+                const auto events = Trace::getEvents();
+                DJV_ASSERT(events.size() > 0 && events.size() < 100000);
+                DJV_ASSERT(99999 == events.back().frame);
+                Trace::clear();
+            }
+
+            Trace::setEnabled(enabled);
+        }
+        
+    } // namespace CoreTest
+} // namespace djv
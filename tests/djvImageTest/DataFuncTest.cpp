@@ -24,6 +24,7 @@ namespace djv
         void DataFuncTest::run()
         {
             _util();
+            _proxy();
         }
         
         void DataFuncTest::_util()
@@ -122,6 +123,69 @@ namespace djv
                 }
             }
         }
+
+        void DataFuncTest::_proxy()
+        {
+            {
+                auto data = Image::Data::create(Image::Info(2, 2, Image::Type::L_U8));
+                DJV_ASSERT(Image::getProxy(data, 1) == data);
+                DJV_ASSERT(!Image::getProxy(nullptr, 2));
+            }
+
+            {
+                auto data = Image::Data::create(Image::Info(5, 3, Image::Type::RGB_U8));
+                data->setPluginName("Test");
+                Image::U8_T* p = reinterpret_cast<Image::U8_T*>(data->getData());
+                for (size_t i = 0; i < data->getDataByteCount(); ++i)
+                {
+                    p[i] = i % 2 ? 0 : 100;
+                }
+                const auto proxy = Image::getProxy(data, 2);
+                DJV_ASSERT(Image::Size(3, 2) == proxy->getSize());
+                DJV_ASSERT(Image::Type::RGB_U8 == proxy->getType());
+                DJV_ASSERT("Test" == proxy->getPluginName());
+            }
+
+            {
+                auto data = Image::Data::create(Image::Info(4, 4, Image::Type::L_F32));
+                Image::F32_T* p = reinterpret_cast<Image::F32_T*>(data->getData());
+                for (size_t i = 0; i < 16; ++i)
+                {
+                    p[i] = static_cast<float>(i);
+                }
+                const auto proxy = Image::getProxy(data, 2);
+                DJV_ASSERT(Image::Size(2, 2) == proxy->getSize());
+                const Image::F32_T* proxyP = reinterpret_cast<const Image::F32_T*>(proxy->getData());
+                DJV_ASSERT(2.5F == proxyP[0]);
+                DJV_ASSERT(4.5F == proxyP[1]);
+                DJV_ASSERT(10.5F == proxyP[2]);
+                DJV_ASSERT(12.5F == proxyP[3]);
+            }
+
+            {
+                auto data = Image::Data::create(Image::Info(8, 8, Image::Type::RGB_U10));
+                data->zero();
+                const auto proxy = Image::getProxy(data, 4);
+                DJV_ASSERT(Image::Size(2, 2) == proxy->getSize());
+            }
+
+            for (const auto type : Image::getTypeEnums())
+            {
+                if (Image::Type::None == type)
+                {
+                    continue;
+                }
+                auto data = Image::Data::create(Image::Info(7, 5, type));
+                data->zero();
+                const auto proxy = Image::getProxy(data, 2);
+                const Image::Size proxySize = Image::getProxySize(data->getSize(), 2);
+                DJV_ASSERT(Image::Size(4, 3) == proxySize);
+                DJV_ASSERT(proxySize == proxy->getSize());
+                DJV_ASSERT(type == proxy->getType());
+                DJV_ASSERT(Image::Info(proxySize, type).getDataByteCount() == proxy->getDataByteCount());
+                DJV_ASSERT(proxy->getDataByteCount() < data->getDataByteCount());
+            }
+        }
         
     } // namespace ImageTest
 } // namespace djv
@@ -19,6 +19,7 @@ namespace djv
         
         private:
             void _util();
+            void _proxy();
         };
         
     } // namespace ImageTest
@@ -4,8 +4,9 @@
 
 #include <djvMathTest/FrameNumberTest.h>
 
-#include <djvMath/FrameNumber.h>
+#include <djvMath/FrameNumberFunc.h>
 
+#include <chrono>
 #include <iostream>
 #include <sstream>
 
@@ -25,7 +26,10 @@ namespace djv
         void FrameNumberTest::run()
         {
             _sequence();
+            _sparse();
+            _iterator();
             _operators();
+            _benchmark();
         }
 
         void FrameNumberTest::_sequence()
@@ -89,6 +93,68 @@ namespace djv
                 sequence.add(Frame::Range(12, 100));
                 DJV_ASSERT(sequence.getRanges()[0] == Frame::Range(1, 10));
             }
+
+            {
+                Frame::Sequence sequence({ Frame::Range(1, 3), Frame::Range(5, 7), Frame::Range(9, 11) });
+                sequence.add(Frame::Range(2, 10));
+                DJV_ASSERT(1 == sequence.getRanges().size());
+                DJV_ASSERT(sequence.getRanges()[0] == Frame::Range(1, 11));
+                DJV_ASSERT(11 == sequence.getFrameCount());
+                DJV_ASSERT(10 == sequence.getLastIndex());
+            }
+        }
+
+        void FrameNumberTest::_sparse()
+        {
+            Frame::Sequence sequence;
+            sequence.add(Frame::Range(1, 10));
+            sequence.add(Frame::Range(20, 30));
+            for (Frame::Number i = 33; i < 1000; i += 2)
+            {
+                sequence.add(Frame::Range(i));
+            }
+            sequence.add(Frame::Range(-5, -1));
+            DJV_ASSERT(5 + 10 + 11 + 484 == sequence.getFrameCount());
+            DJV_ASSERT(static_cast<Frame::Index>(sequence.getFrameCount()) - 1 == sequence.getLastIndex());
+            const auto frames = Frame::toFrames(sequence);
+            DJV_ASSERT(frames.size() == sequence.getFrameCount());
+            for (size_t i = 0; i < frames.size(); ++i)
+            {
+                DJV_ASSERT(sequence.contains(frames[i]));
+                DJV_ASSERT(frames[i] == sequence.getFrame(i));
+                DJV_ASSERT(static_cast<Frame::Index>(i) == sequence.getIndex(frames[i]));
+            }
+            DJV_ASSERT(!sequence.contains(-6));
+            DJV_ASSERT(!sequence.contains(0));
+            DJV_ASSERT(!sequence.contains(15));
+            DJV_ASSERT(!sequence.contains(34));
+            DJV_ASSERT(!sequence.contains(1000));
+            DJV_ASSERT(Frame::invalidIndex == sequence.getIndex(0));
+            DJV_ASSERT(Frame::invalidIndex == sequence.getIndex(34));
+            DJV_ASSERT(Frame::invalid == sequence.getFrame(-1));
+            DJV_ASSERT(Frame::invalid == sequence.getFrame(sequence.getFrameCount()));
+        }
+
+        void FrameNumberTest::_iterator()
+        {
+            {
+                const Frame::Sequence sequence;
+                DJV_ASSERT(sequence.begin() == sequence.end());
+            }
+
+            {
+                const Frame::Sequence sequence({ Frame::Range(1, 3), Frame::Range(5), Frame::Range(7, 8) });
+                std::vector<Frame::Number> frames;
+                for (const auto i : sequence)
+                {
+                    frames.push_back(i);
+                }
+                DJV_ASSERT(std::vector<Frame::Number>({ 1, 2, 3, 5, 7, 8 }) == frames);
+                auto i = sequence.begin();
+                DJV_ASSERT(1 == *i++);
+                DJV_ASSERT(2 == *i);
+                DJV_ASSERT(6 == std::distance(sequence.begin(), sequence.end()));
+            }
         }
                 
         void FrameNumberTest::_operators()
@@ -99,6 +165,39 @@ namespace djv
                 DJV_ASSERT(sequence != Frame::Sequence());
             }
         }
+
+        void FrameNumberTest::_benchmark()
+        {
+            // Simulate a sparse render with many single frame ranges.
+            const Frame::Number count = 100000;
+            Frame::Sequence sequence;
+            for (Frame::Number i = 0; i < count; ++i)
+            {
+                sequence.add(Frame::Range(i * 2));
+            }
+            const size_t frameCount = sequence.getFrameCount();
+            const auto t0 = std::chrono::steady_clock::now();
+            Frame::Number sum = 0;
+            for (size_t i = 0; i < frameCount; ++i)
+            {
+                const Frame::Number frame = sequence.getFrame(i);
+                sum += sequence.getIndex(frame);
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+            for (const auto i : sequence)
+            {
+                sum -= i / 2;
+            }
+            const auto t2 = std::chrono::steady_clock::now();
+            DJV_ASSERT(0 == sum);
+            const std::chrono::duration<float> lookup = t1 - t0;
+            const std::chrono::duration<float> iterate = t2 - t1;
+            std::stringstream ss;
+            ss << "Benchmark: " << sequence.getRanges().size() << " ranges, " <<
+                static_cast<size_t>(frameCount / std::max(lookup.count(), .001F)) << " lookups per second, " <<
+                static_cast<size_t>(frameCount / std::max(iterate.count(), .001F)) << " iterations per second";
+            _print(ss.str());
+        }
                 
     } // namespace MathTest
 } // namespace djv
@@ -21,7 +21,10 @@ namespace djv
             
         private:
             void _sequence();
+            void _sparse();
+            void _iterator();
             void _operators();
+            void _benchmark();
         };
         
     } // namespace MathTest
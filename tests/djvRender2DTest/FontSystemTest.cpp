@@ -205,6 +205,25 @@ namespace djv
                     _print(ss.str());
                 }
                 
+                {
+                    // Glyphs requested by several threads at once are shared.
+                    const std::string text2 = String::getRandomText(50);
+                    std::vector<std::future<std::vector<std::shared_ptr<Font::Glyph> > > > futures;
+                    for (size_t i = 0; i < 8; ++i)
+                    {
+                        futures.push_back(system->getGlyphs(text2, fontInfo));
+                    }
+                    std::vector<std::vector<std::shared_ptr<Font::Glyph> > > results;
+                    for (auto& i : futures)
+                    {
+                        results.push_back(i.get());
+                    }
+                    for (size_t i = 1; i < results.size(); ++i)
+                    {
+                        DJV_ASSERT(results[0] == results[i]);
+                    }
+                }
+
                 system->setLCDRendering(true);
                 system->setLCDRendering(true);
                 const uint16_t elide = text.size() / 2;
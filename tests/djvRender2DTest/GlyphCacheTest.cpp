@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvRender2DTest/GlyphCacheTest.h>
+
+#include <djvRender2D/GlyphCache.h>
+
+#include <djvImage/Data.h>
+
+#include <djvSystem/FileIO.h>
+#include <djvSystem/FileInfo.h>
+#include <djvSystem/Path.h>
+
+using namespace djv::Core;
+using namespace djv::Render2D::Font;
+
+namespace djv
+{
+    namespace Render2DTest
+    {
+        namespace
+        {
+            std::shared_ptr<Glyph> createGlyph(uint32_t code, const FontInfo& fontInfo, uint8_t value)
+            {
+                auto out = Glyph::create();
+                out->glyphInfo = GlyphInfo(code, fontInfo);
+                out->imageData = Image::Data::create(Image::Info(4, 2, Image::Type::L_U8));
+                uint8_t* p = out->imageData->getData();
+                for (size_t i = 0; i < out->imageData->getDataByteCount(); ++i)
+                {
+                    p[i] = value + static_cast<uint8_t>(i);
+                }
+                out->offset = glm::vec2(1.F, 2.F);
+                out->advance = 3;
+                out->lsbDelta = 4;
+                out->rsbDelta = -5;
+                return out;
+            }
+
+        } // namespace
+
+        GlyphCacheTest::GlyphCacheTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest(
+                "djv::Render2DTest::GlyphCacheTest",
+                System::File::Path(tempPath, "GlyphCacheTest"),
+                context)
+        {}
+        
+        void GlyphCacheTest::run()
+        {
+            const std::string fontFileName = System::File::Path(getTempPath(), "GlyphCacheTest.ttf").get();
+            {
+                auto io = System::File::IO::create();
+                io->open(fontFileName, System::File::Mode::Write);
+                io->write("abc");
+            }
+            const std::string fontKey = getGlyphCacheFontKey(System::File::Info(fontFileName));
+            const std::string cacheFileName = System::File::Path(getTempPath(), glyphCacheFileName).get();
+            const FontInfo fontInfo(1, 1, 14, 96);
+            const auto glyph = createGlyph('a', fontInfo, 0);
+
+            {
+                auto cache = GlyphCache::create();
+                DJV_ASSERT(0 == cache->getCount());
+                DJV_ASSERT(!cache->isDirty());
+                DJV_ASSERT(!cache->get(fontKey, glyph->glyphInfo, true));
+                cache->add(fontKey, true, glyph);
+                DJV_ASSERT(1 == cache->getCount());
+                DJV_ASSERT(glyph->imageData->getDataByteCount() == cache->getByteCount());
+                DJV_ASSERT(cache->isDirty());
+                DJV_ASSERT(cache->get(fontKey, glyph->glyphInfo, true));
+                DJV_ASSERT(!cache->get(fontKey, glyph->glyphInfo, false));
+                DJV_ASSERT(!cache->get(fontKey, GlyphInfo('b', fontInfo), true));
+                DJV_ASSERT(!cache->get(fontKey, GlyphInfo('a', FontInfo(1, 1, 12, 96)), true));
+                cache->write(cacheFileName);
+                DJV_ASSERT(!cache->isDirty());
+            }
+
+            {
+                auto cache = GlyphCache::create();
+                cache->read(cacheFileName);
+                DJV_ASSERT(1 == cache->getCount());
+
+                // The font family and face IDs are not part of the key.
+                const GlyphInfo glyphInfo('a', FontInfo(2, 3, 14, 96));
+                auto data = cache->get(fontKey, glyphInfo, true);
+                DJV_ASSERT(data);
+                DJV_ASSERT(data->glyphInfo == glyphInfo);
+                DJV_ASSERT(*data->imageData == *glyph->imageData);
+                DJV_ASSERT(data->offset == glyph->offset);
+                DJV_ASSERT(data->advance == glyph->advance);
+                DJV_ASSERT(data->lsbDelta == glyph->lsbDelta);
+                DJV_ASSERT(data->rsbDelta == glyph->rsbDelta);
+
+                // Changing the font file changes the key.
+                {
+                    auto io = System::File::IO::create();
+                    io->open(fontFileName, System::File::Mode::Write);
+                    io->write("abcdef");
+                }
+                DJV_ASSERT(getGlyphCacheFontKey(System::File::Info(fontFileName)) != fontKey);
+
+                // Write the cache again from the existing file.
+                cache->add(fontKey, false, createGlyph('b', fontInfo, 1));
+                cache->write(cacheFileName);
+                DJV_ASSERT(2 == cache->getCount());
+                DJV_ASSERT(cache->get(fontKey, glyph->glyphInfo, true));
+            }
+
+            {
+                // The least recently used entries are removed.
+                auto cache = GlyphCache::create();
+                cache->setMax(glyph->imageData->getDataByteCount() * 10);
+                for (uint32_t i = 0; i < 20; ++i)
+                {
+                    cache->add(fontKey, true, createGlyph(i, fontInfo, i));
+                }
+                DJV_ASSERT(cache->getCount() <= 10);
+                DJV_ASSERT(cache->getByteCount() <= cache->getMax());
+                cache->clear();
+                DJV_ASSERT(0 == cache->getCount());
+            }
+
+            {
+                // Invalid cache files are ignored.
+                {
+                    auto io = System::File::IO::create();
+                    io->open(cacheFileName, System::File::Mode::Write);
+                    io->write("invalid");
+                }
+                auto cache = GlyphCache::create();
+                cache->read(cacheFileName);
+                DJV_ASSERT(0 == cache->getCount());
+            }
+        }
+        
+    } // namespace Render2DTest
+} // namespace djv
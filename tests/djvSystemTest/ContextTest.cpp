@@ -6,10 +6,12 @@
 
 #include <djvSystem/Context.h>
 #include <djvSystem/ISystem.h>
+#include <djvSystem/TimerFunc.h>
 
 #include <djvCore/String.h>
 
 #include <sstream>
+#include <thread>
 
 using namespace djv::Core;
 using namespace djv::System;
@@ -94,6 +96,26 @@ namespace djv
                     ss << "fps averge: " << context->getFPSAverage();
                     _print(ss.str());
                 }
+
+                {
+                    DJV_ASSERT(!context->waitForTick(std::chrono::steady_clock::now() + std::chrono::milliseconds(10)));
+                    context->requestTick();
+                    DJV_ASSERT(context->waitForTick(std::chrono::steady_clock::now() + std::chrono::milliseconds(10)));
+                    std::thread thread(
+                        [context]
+                        {
+                            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                            context->requestTick();
+                        });
+                    DJV_ASSERT(context->waitForTick(Time::TimePoint::max()));
+                    thread.join();
+                }
+
+                {
+                    Time::TimePoint next;
+                    DJV_ASSERT(context->getNextTickTime(next));
+                    DJV_ASSERT(next <= std::chrono::steady_clock::now() + getTimerDuration(TimerValue::VerySlow));
+                }
             }
         }
         
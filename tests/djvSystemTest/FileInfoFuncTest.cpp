@@ -6,9 +6,13 @@
 
 #include <djvSystem/FileIO.h>
 #include <djvSystem/FileInfoFunc.h>
+#include <djvSystem/FileInfoPrivate.h>
+#include <djvSystem/PathFunc.h>
 
 #include <djvMath/FrameNumberFunc.h>
 
+#include <chrono>
+#include <cstdio>
 #include <iomanip>
 
 using namespace djv::Core;
@@ -47,7 +51,10 @@ namespace djv
             
             _enum();
             _util();
+            _builder();
+            _updater();
             _serialize();
+            _benchmark();
         }
 
         void FileInfoFuncTest::_enum()
@@ -123,6 +130,242 @@ namespace djv
                 const auto info = File::getSequence(path, {});
                 DJV_ASSERT(info.getPath() == path);
             }
+
+            {
+                File::DirectoryListOptions options;
+                options.filter = "^render";
+                options.sequences = true;
+                options.sequenceExtensions.insert(".exr");
+                const auto list = File::directoryList(File::Path(getTempPath()), options);
+                DJV_ASSERT(1 == list.size());
+                DJV_ASSERT(File::Type::Sequence == list[0].getType());
+                DJV_ASSERT(_sequence == list[0].getSequence());
+            }
+
+            {
+                File::DirectoryListOptions options;
+                options.sequences = true;
+                options.sequenceExtensions.insert(".exr");
+                options.stat = false;
+                auto list = File::directoryList(File::Path(getTempPath()), options);
+                DJV_ASSERT(2 == list.size());
+                options.stat = true;
+                list = File::directoryList(File::Path(getTempPath()), options);
+                DJV_ASSERT(2 == list.size());
+                for (const auto& i : list)
+                {
+                    DJV_ASSERT(i.doesExist());
+                    if (File::Type::Sequence == i.getType())
+                    {
+                        File::Info info(i.getPath(), File::Type::Sequence, i.getSequence());
+                        DJV_ASSERT(info.getSize() == i.getSize());
+                        DJV_ASSERT(info.getTime() == i.getTime());
+                    }
+                }
+            }
+        }
+
+        void FileInfoFuncTest::_builder()
+        {
+            {
+                File::DirectoryListOptions options;
+                options.extensions.insert(".exr");
+                options.extensions.insert(".tiff");
+                File::DirectoryListBuilder builder(options);
+                DJV_ASSERT(builder.isMatch("render.1.exr", false));
+                DJV_ASSERT(builder.isMatch("render.1.EXR", false));
+                DJV_ASSERT(builder.isMatch("render.TIFF", false));
+                DJV_ASSERT(!builder.isMatch("render.tif", false));
+                DJV_ASSERT(!builder.isMatch("exr", false));
+                DJV_ASSERT(builder.isMatch("render.tif", true));
+            }
+
+            {
+                File::DirectoryListOptions options;
+                options.filter = "^a";
+                File::DirectoryListBuilder builder(options);
+                DJV_ASSERT(builder.isMatch("abc", false));
+                DJV_ASSERT(builder.isMatch("Abc", false));
+                DJV_ASSERT(!builder.isMatch("cba", false));
+            }
+
+            {
+                File::DirectoryListOptions options;
+                options.filter = "(";
+                File::DirectoryListBuilder builder(options);
+                DJV_ASSERT(!builder.isMatch("(", false));
+            }
+
+            {
+                File::DirectoryListOptions options;
+                options.sequences = true;
+                options.sequenceExtensions.insert(".exr");
+                File::DirectoryListBuilder builder(options);
+                for (const auto& i : { "b.3.exr", "a.0001.exr", "b.1.exr", "a.0003.exr", "a.0002.exr", "c.1.exr", "b.2.png", "b.5.exr" })
+                {
+                    builder.add(File::Info(File::Path(i), false));
+                }
+                const auto list = builder.get();
+                DJV_ASSERT(4 == list.size());
+                DJV_ASSERT("b.1,3,5.exr" == list[0].getFileName(Math::Frame::invalid, false));
+                DJV_ASSERT(File::Type::Sequence == list[0].getType());
+                DJV_ASSERT("a.0001-0003.exr" == list[1].getFileName(Math::Frame::invalid, false));
+                DJV_ASSERT(4 == list[1].getSequence().getPad());
+                DJV_ASSERT("c.1.exr" == list[2].getFileName(Math::Frame::invalid, false));
+                DJV_ASSERT(File::Type::File == list[2].getType());
+                DJV_ASSERT("b.2.png" == list[3].getFileName(Math::Frame::invalid, false));
+            }
+        }
+
+        void FileInfoFuncTest::_updater()
+        {
+            const File::Path path(getTempPath(), "updater");
+            File::mkdir(path);
+            auto io = File::IO::create();
+            for (const auto& i : { "shot.0001.exr", "shot.0002.exr", "shot.0003.exr", "a.txt" })
+            {
+                io->open(File::Path(path, i).get(), File::Mode::Write);
+                io->write(std::string(i));
+            }
+            io->close();
+
+            File::DirectoryListOptions options;
+            options.sequences = true;
+            options.sequenceExtensions.insert(".exr");
+            auto list = File::directoryList(path, options);
+            DJV_ASSERT(2 == list.size());
+            File::FrameSizes frameSizes;
+
+            {
+                io->open(File::Path(path, "shot.0004.exr").get(), File::Mode::Write);
+                io->close();
+                File::mkdir(File::Path(path, "dir"));
+                File::DirectoryListUpdater updater(path, options, list, frameSizes);
+                updater.add("shot.0004.exr", false);
+                updater.add("shot.0004.exr", false);
+                updater.add("dir", true);
+                updater.add(".hidden", false);
+                updater.add("missing.txt", false);
+                list = updater.get();
+                DJV_ASSERT(list == File::directoryList(path, options));
+                DJV_ASSERT(3 == list.size());
+                DJV_ASSERT(File::Type::Directory == list[0].getType());
+                DJV_ASSERT("shot.0001-0004.exr" == list[2].getFileName(Math::Frame::invalid, false));
+            }
+
+            {
+                std::remove(File::Path(path, "shot.0002.exr").get().c_str());
+                io->open(File::Path(path, "a.txt").get(), File::Mode::Write);
+                io->write(std::string("modified"));
+                io->close();
+                File::DirectoryListUpdater updater(path, options, list, frameSizes);
+                updater.remove("shot.0002.exr");
+                updater.modify("a.txt");
+                list = updater.get();
+                DJV_ASSERT(list == File::directoryList(path, options));
+                DJV_ASSERT("shot.0001,0003-0004.exr" == list[2].getFileName(Math::Frame::invalid, false));
+            }
+
+            {
+                std::remove(File::Path(path, "shot.0001.exr").get().c_str());
+                std::remove(File::Path(path, "shot.0004.exr").get().c_str());
+                File::DirectoryListUpdater updater(path, options, list, frameSizes);
+                updater.remove("shot.0001.exr");
+                updater.remove("shot.0004.exr");
+                list = updater.get();
+                DJV_ASSERT(list == File::directoryList(path, options));
+                DJV_ASSERT(File::Type::File == list[2].getType());
+                DJV_ASSERT("shot.0003.exr" == list[2].getFileName(Math::Frame::invalid, false));
+            }
+
+            {
+                std::remove(File::Path(path, "shot.0003.exr").get().c_str());
+                std::remove(File::Path(path, "a.txt").get().c_str());
+                File::rmdir(File::Path(path, "dir"));
+                File::DirectoryListUpdater updater(path, options, list, frameSizes);
+                updater.remove("shot.0003.exr");
+                updater.remove("a.txt");
+                updater.remove("dir");
+                list = updater.get();
+                DJV_ASSERT(list.empty());
+            }
+
+            {
+                // When the size of a frame is known only that frame is
+                // stat'ed when it changes.
+                options.stat = true;
+                for (const auto& i : { "render.0001.exr", "render.0002.exr" })
+                {
+                    io->open(File::Path(path, i).get(), File::Mode::Write);
+                    io->write(std::string("abc"));
+                }
+                io->close();
+                list = File::directoryList(path, options);
+                DJV_ASSERT(1 == list.size());
+                DJV_ASSERT(6 == list[0].getSize());
+
+                io->open(File::Path(path, "render.0003.exr").get(), File::Mode::Write);
+                io->close();
+                {
+                    File::DirectoryListUpdater updater(path, options, list, frameSizes);
+                    updater.add("render.0003.exr", false);
+                    list = updater.get();
+                }
+                DJV_ASSERT(1 == frameSizes.size());
+                DJV_ASSERT(6 == list[0].getSize());
+
+                io->open(File::Path(path, "render.0003.exr").get(), File::Mode::Write);
+                io->write(std::string("abcdef"));
+                io->close();
+                {
+                    File::DirectoryListUpdater updater(path, options, list, frameSizes);
+                    updater.modify("render.0003.exr");
+                    list = updater.get();
+                }
+                DJV_ASSERT(12 == list[0].getSize());
+                DJV_ASSERT("render.0001-0003.exr" == list[0].getFileName(Math::Frame::invalid, false));
+
+                std::remove(File::Path(path, "render.0003.exr").get().c_str());
+                {
+                    File::DirectoryListUpdater updater(path, options, list, frameSizes);
+                    updater.remove("render.0003.exr");
+                    list = updater.get();
+                }
+                DJV_ASSERT(frameSizes.empty());
+                DJV_ASSERT(6 == list[0].getSize());
+                DJV_ASSERT("render.0001-0002.exr" == list[0].getFileName(Math::Frame::invalid, false));
+            }
+
+            {
+                // The sizes of the frames are kept from the listing so the
+                // first change does not stat the whole sequence.
+                io->open(File::Path(path, "render.0003.exr").get(), File::Mode::Write);
+                io->write(std::string("abc"));
+                io->close();
+                list = File::directoryList(path, options, &frameSizes);
+                DJV_ASSERT(1 == list.size());
+                DJV_ASSERT(9 == list[0].getSize());
+                DJV_ASSERT(3 == frameSizes.size());
+                DJV_ASSERT(3 == frameSizes[File::Path(path, "render.0001.exr").get()]);
+
+                io->open(File::Path(path, "render.0001.exr").get(), File::Mode::Write);
+                io->write(std::string("abcdefghi"));
+                io->close();
+                std::remove(File::Path(path, "render.0002.exr").get().c_str());
+                {
+                    File::DirectoryListUpdater updater(path, options, list, frameSizes);
+                    updater.modify("render.0001.exr");
+                    updater.remove("render.0002.exr");
+                    list = updater.get();
+                }
+                DJV_ASSERT(list == File::directoryList(path, options));
+                DJV_ASSERT(12 == list[0].getSize());
+                DJV_ASSERT(2 == frameSizes.size());
+                DJV_ASSERT("render.0001,0003.exr" == list[0].getFileName(Math::Frame::invalid, false));
+
+                std::remove(File::Path(path, "render.0001.exr").get().c_str());
+                std::remove(File::Path(path, "render.0003.exr").get().c_str());
+            }
         }
 
         void FileInfoFuncTest::_serialize()
@@ -197,6 +440,41 @@ namespace djv
             catch (const std::exception&)
             {}
         }
+
+        void FileInfoFuncTest::_benchmark()
+        {
+            // Simulate a large render output directory with many passes, in
+            // the unsorted order that the file system returns them.
+            const size_t passes = 40;
+            const size_t frames = 25000;
+            const size_t count = passes * frames;
+            File::DirectoryListOptions options;
+            options.sequences = true;
+            options.sequenceExtensions.insert(".exr");
+            File::DirectoryListBuilder builder(options);
+            const auto t0 = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < count; ++i)
+            {
+                // Each file is added once, 7919 is coprime with the count.
+                const size_t index = (i * 7919) % count;
+                std::stringstream ss;
+                ss << "render_pass" << index % passes << "." <<
+                    std::setfill('0') << std::setw(6) << index / passes << ".exr";
+                builder.add(File::Info(File::Path(ss.str()), false));
+            }
+            const auto list = builder.get();
+            const auto t1 = std::chrono::steady_clock::now();
+            DJV_ASSERT(passes == list.size());
+            for (const auto& i : list)
+            {
+                DJV_ASSERT(frames == i.getSequence().getFrameCount());
+            }
+            const std::chrono::duration<float> diff = t1 - t0;
+            std::stringstream ss;
+            ss << "Benchmark: " << count << " files, " << list.size() << " sequences, " <<
+                static_cast<size_t>(count / std::max(diff.count(), .001F)) << " files per second";
+            _print(ss.str());
+        }
         
     } // namespace SystemTest
 } // namespace djv
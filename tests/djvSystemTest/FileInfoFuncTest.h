@@ -24,7 +24,10 @@ namespace djv
         private:
             void _enum();
             void _util();
+            void _builder();
+            void _updater();
             void _serialize();
+            void _benchmark();
 
             std::string _fileName;
             std::string _sequenceName;
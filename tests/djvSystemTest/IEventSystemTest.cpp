@@ -30,8 +30,16 @@ namespace djv
 
         public:
             static std::shared_ptr<TestObject> create(const std::shared_ptr<Context>&);
+
+            size_t getUpdateCount() const;
+
+            void requestUpdate();
+            bool isUpdateRequested() const;
             
             bool event(System::Event::Event&) override;
+
+        private:
+            size_t _updateCount = 0;
         };
 
         class TestObject2 : public TestObject
@@ -74,7 +82,6 @@ namespace djv
 
         protected:
             void _init(System::Event::Init&) override;
-            void _update(System::Event::Update&) override;
 
             void _hover(const std::shared_ptr<IObject>&, Event::PointerMove&, std::shared_ptr<IObject>&);
             void _hover(System::Event::PointerMove&, std::shared_ptr<IObject>&) override;
@@ -95,8 +102,27 @@ namespace djv
             return out;
         }
 
+        size_t TestObject::getUpdateCount() const
+        {
+            return _updateCount;
+        }
+
+        void TestObject::requestUpdate()
+        {
+            _requestUpdate();
+        }
+
+        bool TestObject::isUpdateRequested() const
+        {
+            return _isUpdateRequested();
+        }
+
         bool TestObject::event(System::Event::Event& event)
         {
+            if (Event::Type::Update == event.getEventType())
+            {
+                ++_updateCount;
+            }
             bool out = IObject::event(event);
             if (!out)
             {
@@ -250,11 +276,6 @@ namespace djv
         {
             _initRecursive(_parent, event);
         }
-        
-        void TestEventSystem::_update(System::Event::Update& event)
-        {
-            _updateRecursive(_parent, event);
-        }
             
         void TestEventSystem::_hover(const std::shared_ptr<IObject>& object, Event::PointerMove& event, std::shared_ptr<IObject>& hover)
         {
@@ -302,6 +323,7 @@ namespace djv
                 _clipboard();
                 _textFocus();
                 _tick();
+                _update();
                 
                 context->removeSystem(_system);
                 _system.reset();
@@ -393,6 +415,30 @@ namespace djv
                 _object2->removeEventFilter(_object);
             }
         }
+
+        void IEventSystemTest::_update()
+        {
+            // Update events are only sent to objects that request them.
+            const size_t count = _object->getUpdateCount();
+            const size_t count2 = _object2->getUpdateCount();
+            _object->requestUpdate();
+            DJV_ASSERT(_object->isUpdateRequested());
+            _system->tick();
+            DJV_ASSERT(!_object->isUpdateRequested());
+            DJV_ASSERT(count + 1 == _object->getUpdateCount());
+            DJV_ASSERT(count2 == _object2->getUpdateCount());
+            _system->tick();
+            DJV_ASSERT(count + 1 == _object->getUpdateCount());
+
+            // Destroy an object that has requested an update.
+            if (auto context = getContext().lock())
+            {
+                auto object = TestObject::create(context);
+                object->requestUpdate();
+                object.reset();
+                _system->tick();
+            }
+        }
         
     } // namespace SystemTest
 } // namespace djv
@@ -31,6 +31,7 @@ namespace djv
             void _clipboard();
             void _textFocus();
             void _tick();
+            void _update();
             
             std::shared_ptr<TestEventSystem> _system;
             std::shared_ptr<TestObject> _object;
@@ -5,9 +5,15 @@
 #include <djvSystemTest/LogSystemTest.h>
 
 #include <djvSystem/Context.h>
+#include <djvSystem/FileIOFunc.h>
 #include <djvSystem/LogSystem.h>
+#include <djvSystem/ResourceSystem.h>
 
+#include <algorithm>
 #include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
 
 using namespace djv::Core;
 using namespace djv::System;
@@ -28,22 +34,26 @@ namespace djv
             {
                 auto system = context->getSystemT<LogSystem>();
                 
+                std::vector<std::string> warnings;
                 auto warningsObserver = Observer::List<std::string>::create(
                     system->observeWarnings(),
-                    [](const std::vector<std::string>& value)
+                    [&warnings](const std::vector<std::string>& value)
                     {
                         for (const auto& i : value)
                         {
                             std::cout << i << std::endl;
+                            warnings.push_back(i);
                         }
                     });
+                std::vector<std::string> errors;
                 auto errorsObserver = Observer::List<std::string>::create(
                     system->observeErrors(),
-                    [](const std::vector<std::string>& value)
+                    [&errors](const std::vector<std::string>& value)
                     {
                         for (const auto& i : value)
                         {
                             std::cout << i << std::endl;
+                            errors.push_back(i);
                         }
                     });
                 
@@ -52,12 +62,91 @@ namespace djv
                 
                 _tickFor(std::chrono::milliseconds(500));
                 
+                const std::string longMessage(1000, 'x');
                 system->log("LogSystemTest", "Message");
                 system->log("LogSystemTest", "Warning", LogLevel::Warning);
                 system->log("LogSystemTest", "Error", LogLevel::Error);
+                system->log("LogSystemTest", longMessage);
 
                 _tickFor(std::chrono::milliseconds(500));
 
+                DJV_ASSERT(1 == std::count(warnings.begin(), warnings.end(), "Warning"));
+                DJV_ASSERT(1 == std::count(errors.begin(), errors.end(), "Error"));
+
+                const LogLevel level = system->getLevel();
+                system->setLevel(LogLevel::Warning);
+                DJV_ASSERT(LogLevel::Warning == system->getLevel());
+                DJV_ASSERT(!system->isEnabled(LogLevel::Information));
+                DJV_ASSERT(system->isEnabled(LogLevel::Warning));
+                DJV_ASSERT(system->isEnabled(LogLevel::Error));
+                system->log("LogSystemTest", "Disabled");
+                system->setLevel(level);
+
+                // Log from multiple threads, with more messages than fit in
+                // the queue.
+                const size_t threadCount = 4;
+                const size_t threadMessageCount = 1000;
+                std::vector<std::thread> threads;
+                for (size_t i = 0; i < threadCount; ++i)
+                {
+                    threads.push_back(std::thread(
+                        [system, i, threadMessageCount]
+                        {
+                            for (size_t j = 0; j < threadMessageCount; ++j)
+                            {
+                                std::stringstream ss;
+                                ss << "Thread " << i << ": " << j;
+                                system->log("LogSystemTest", ss.str());
+                            }
+                        }));
+                }
+                for (auto& i : threads)
+                {
+                    i.join();
+                }
+
+                _tickFor(std::chrono::milliseconds(2000));
+
+                // Read back the log file and count the messages. The messages
+                // from each thread are written in order.
+                std::map<std::string, size_t> messages;
+                std::vector<int> threadMessages(threadCount, -1);
+                const auto path = context->getSystemT<ResourceSystem>()->getPath(File::ResourcePath::LogFile);
+                for (const auto& i : File::readLines(std::string(path)))
+                {
+                    const std::string prefix = "LogSystemTest | ";
+                    const size_t index = i.find(prefix);
+                    if (index != std::string::npos)
+                    {
+                        const std::string message = i.substr(index + prefix.size());
+                        ++messages[message];
+                        size_t thread = 0;
+                        int j = 0;
+                        char c = 0;
+                        std::stringstream ss(message);
+                        std::string label;
+                        if ((ss >> label >> thread >> c >> j) && "Thread" == label && thread < threadCount)
+                        {
+                            DJV_ASSERT(j == threadMessages[thread] + 1);
+                            threadMessages[thread] = j;
+                        }
+                    }
+                }
+                DJV_ASSERT(1 == messages["Message"]);
+                DJV_ASSERT(1 == messages["[Warning] Warning"]);
+                DJV_ASSERT(1 == messages["[ERROR] Error"]);
+                DJV_ASSERT(1 == messages[longMessage]);
+                DJV_ASSERT(0 == messages["Disabled"]);
+                for (size_t i = 0; i < threadCount; ++i)
+                {
+                    for (size_t j = 0; j < threadMessageCount; ++j)
+                    {
+                        std::stringstream ss;
+                        ss << "Thread " << i << ": " << j;
+                        DJV_ASSERT(1 == messages[ss.str()]);
+                    }
+                }
+
                 system->setConsoleOutput(false);
             }
         }
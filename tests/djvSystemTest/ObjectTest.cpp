@@ -80,7 +80,6 @@ namespace djv
             
             protected:
                 void _init(System::Event::Init&) override {}
-                void _update(System::Event::Update&) override {}
                 void _hover(System::Event::PointerMove&, std::shared_ptr<IObject>&) override {}
             };
         
@@ -155,6 +154,25 @@ namespace djv
                     DJV_ASSERT(child->getChildren().size() == 0);
                 }
 
+                {
+                    auto parent = TestObject::create(context);
+                    auto child = TestObject::create(context);
+                    auto child2 = TestObject::create(context);
+                    parent->addChild(child);
+                    child->addChild(child2);
+                    parent->setEnabled(false);
+                    DJV_ASSERT(child->isEnabled());
+                    DJV_ASSERT(!child->isEnabled(true));
+                    DJV_ASSERT(!child2->isEnabled(true));
+                    child->removeChild(child2);
+                    DJV_ASSERT(child2->isEnabled(true));
+                    child->addChild(child2);
+                    DJV_ASSERT(!child2->isEnabled(true));
+                    parent->setEnabled(true);
+                    DJV_ASSERT(child->isEnabled(true));
+                    DJV_ASSERT(child2->isEnabled(true));
+                }
+
                 context->removeSystem(system);
             }
             
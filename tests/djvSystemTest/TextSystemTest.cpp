@@ -50,11 +50,13 @@ namespace djv
                 }
                 
                 {
+                    const std::string text = system->getText("boolean_true");
                     system->setCurrentLocale("zh");
                     system->setCurrentLocale("zh");
                     DJV_ASSERT("zh" == system->observeCurrentLocale()->get());
                     _print(system->getText("boolean_true"));
                     system->setCurrentLocale("en");
+                    DJV_ASSERT(text == system->getText("boolean_true"));
                 }
             }
         }
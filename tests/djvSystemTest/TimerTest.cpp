@@ -39,6 +39,10 @@ namespace djv
                         _print(ss.str());
                     });
                 DJV_ASSERT(timer->isActive());
+
+                Time::TimePoint next;
+                DJV_ASSERT(context->getSystemT<TimerSystem>()->getNextTimeout(next));
+                DJV_ASSERT(next <= std::chrono::steady_clock::now() + std::chrono::milliseconds(250));
                 
                 _tickFor(std::chrono::milliseconds(500));
             }
@@ -8,12 +8,15 @@
 #include <djvCoreTest/ListObserverTest.h>
 #include <djvCoreTest/MapObserverTest.h>
 #include <djvCoreTest/MemoryFuncTest.h>
+#include <djvCoreTest/MetricsFuncTest.h>
+#include <djvCoreTest/ObserverTest.h>
 #include <djvCoreTest/OSFuncTest.h>
 #include <djvCoreTest/RandomFuncTest.h>
 #include <djvCoreTest/RapidJSONFuncTest.h>
 #include <djvCoreTest/StringFormatTest.h>
 #include <djvCoreTest/StringFuncTest.h>
 #include <djvCoreTest/TimeFuncTest.h>
+#include <djvCoreTest/TraceFuncTest.h>
 #include <djvCoreTest/UIDFuncTest.h>
 #include <djvCoreTest/UndoStackTest.h>
 #include <djvCoreTest/ValueObserverTest.h>
@@ -97,6 +100,7 @@
 #include <djvRender2DTest/DataTest.h>
 #include <djvRender2DTest/EnumFuncTest.h>
 #include <djvRender2DTest/FontSystemTest.h>
+#include <djvRender2DTest/GlyphCacheTest.h>
 #include <djvRender2DTest/RenderSystemTest.h>
 #include <djvRender2DTest/RenderTest.h>
 
@@ -109,8 +113,10 @@
 #include <djvAVTest/CineonFuncTest.h>
 #include <djvAVTest/DPXFuncTest.h>
 #include <djvAVTest/IOTest.h>
+#include <djvAVTest/InfoCacheTest.h>
 #include <djvAVTest/PPMFuncTest.h>
 #include <djvAVTest/SpeedFuncTest.h>
+#include <djvAVTest/ThumbnailCacheTest.h>
 #include <djvAVTest/ThumbnailSystemTest.h>
 #include <djvAVTest/TimeFuncTest.h>
 #if defined(FFmpeg_FOUND)
@@ -129,6 +135,7 @@
 #include <djvUITest/ActionGroupTest.h>
 #include <djvUITest/ButtonGroupTest.h>
 #include <djvUITest/EnumFuncTest.h>
+#include <djvUITest/IconPackTest.h>
 #include <djvUITest/SelectionModelTest.h>
 #include <djvUITest/WidgetTest.h>
 
@@ -176,12 +183,15 @@ int main(int argc, char ** argv)
         tests.emplace_back(new CoreTest::ListObserverTest(tempPath, context));
         tests.emplace_back(new CoreTest::MapObserverTest(tempPath, context));
         tests.emplace_back(new CoreTest::MemoryFuncTest(tempPath, context));
+        tests.emplace_back(new CoreTest::MetricsFuncTest(tempPath, context));
+        tests.emplace_back(new CoreTest::ObserverTest(tempPath, context));
         tests.emplace_back(new CoreTest::OSFuncTest(tempPath, context));
         tests.emplace_back(new CoreTest::RandomFuncTest(tempPath, context));
         tests.emplace_back(new CoreTest::RapidJSONFuncTest(tempPath, context));
         tests.emplace_back(new CoreTest::StringFormatTest(tempPath, context));
         tests.emplace_back(new CoreTest::StringFuncTest(tempPath, context));
         tests.emplace_back(new CoreTest::TimeFuncTest(tempPath, context));
+        tests.emplace_back(new CoreTest::TraceFuncTest(tempPath, context));
         tests.emplace_back(new CoreTest::UIDFuncTest(tempPath, context));
         tests.emplace_back(new CoreTest::UndoStackTest(tempPath, context));
         tests.emplace_back(new CoreTest::ValueObserverTest(tempPath, context));
@@ -265,6 +275,7 @@ int main(int argc, char ** argv)
         tests.emplace_back(new Render2DTest::DataTest(tempPath, context));
         tests.emplace_back(new Render2DTest::EnumFuncTest(tempPath, context));
         tests.emplace_back(new Render2DTest::FontSystemTest(tempPath, context));
+        tests.emplace_back(new Render2DTest::GlyphCacheTest(tempPath, context));
         tests.emplace_back(new Render2DTest::RenderSystemTest(tempPath, context));
         tests.emplace_back(new Render2DTest::RenderTest(tempPath, context));
 
@@ -277,8 +288,10 @@ int main(int argc, char ** argv)
         tests.emplace_back(new AVTest::CineonFuncTest(tempPath, context));
         tests.emplace_back(new AVTest::DPXFuncTest(tempPath, context));
         tests.emplace_back(new AVTest::IOTest(tempPath, context));
+        tests.emplace_back(new AVTest::InfoCacheTest(tempPath, context));
         tests.emplace_back(new AVTest::PPMFuncTest(tempPath, context));
         tests.emplace_back(new AVTest::SpeedFuncTest(tempPath, context));
+        tests.emplace_back(new AVTest::ThumbnailCacheTest(tempPath, context));
         tests.emplace_back(new AVTest::ThumbnailSystemTest(tempPath, context));
         tests.emplace_back(new AVTest::TimeFuncTest(tempPath, context));
 #if defined(FFmpeg_FOUND)
@@ -297,6 +310,7 @@ int main(int argc, char ** argv)
         tests.emplace_back(new UITest::ActionGroupTest(tempPath, context));
         tests.emplace_back(new UITest::ButtonGroupTest(tempPath, context));
         tests.emplace_back(new UITest::EnumFuncTest(tempPath, context));
+        tests.emplace_back(new UITest::IconPackTest(tempPath, context));
         tests.emplace_back(new UITest::SelectionModelTest(tempPath, context));
         tests.emplace_back(new UITest::WidgetTest(tempPath, context));
 
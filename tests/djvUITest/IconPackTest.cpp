@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2020 Darby Johnston
+// All rights reserved.
+
+#include <djvUITest/IconPackTest.h>
+
+#include <djvUI/IconPack.h>
+
+#include <djvImage/Data.h>
+
+#include <djvSystem/File.h>
+#include <djvSystem/FileIO.h>
+#include <djvSystem/Path.h>
+
+using namespace djv::Core;
+using namespace djv::UI;
+
+namespace djv
+{
+    namespace UITest
+    {
+        namespace
+        {
+            std::shared_ptr<Image::Data> createImage(uint16_t size, Image::Type type, uint8_t value)
+            {
+                auto out = Image::Data::create(Image::Info(size, size, type));
+                uint8_t* p = out->getData();
+                for (size_t i = 0; i < out->getDataByteCount(); ++i)
+                {
+                    p[i] = value + static_cast<uint8_t>(i);
+                }
+                return out;
+            }
+
+        } // namespace
+
+        IconPackTest::IconPackTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest(
+                "djv::UITest::IconPackTest",
+                System::File::Path(tempPath, "IconPackTest"),
+                context)
+        {}
+        
+        void IconPackTest::run()
+        {
+            const std::string fileName = System::File::Path(getTempPath(), iconPackFileName).get();
+            const auto a96 = createImage(24, Image::Type::RGBA_U8, 0);
+            const auto a192 = createImage(48, Image::Type::RGBA_U8, 1);
+            const auto b96 = createImage(24, Image::Type::L_U8, 2);
+
+            {
+                auto iconPack = IconPack::create();
+                DJV_ASSERT(0 == iconPack->getCount());
+                DJV_ASSERT(iconPack->getDPIList().empty());
+                iconPack->addIcon("djvIconA", 96, a96);
+                iconPack->addIcon("djvIconA", 192, a192);
+                iconPack->addIcon("djvIconB", 96, b96);
+                DJV_ASSERT(3 == iconPack->getCount());
+                DJV_ASSERT(std::vector<uint16_t>({ 96, 192 }) == iconPack->getDPIList());
+                DJV_ASSERT(iconPack->getIcon("djvIconA", 96) == a96);
+                DJV_ASSERT(!iconPack->getIcon("djvIconA", 48));
+                DJV_ASSERT(!iconPack->getIcon("djvIconC", 96));
+                iconPack->write(fileName);
+            }
+
+            {
+                auto iconPack = IconPack::create();
+                iconPack->read(fileName);
+                DJV_ASSERT(3 == iconPack->getCount());
+                DJV_ASSERT(std::vector<uint16_t>({ 96, 192 }) == iconPack->getDPIList());
+                auto image = iconPack->getIcon("djvIconA", 96);
+                DJV_ASSERT(image && *image == *a96);
+                image = iconPack->getIcon("djvIconA", 192);
+                DJV_ASSERT(image && *image == *a192);
+                image = iconPack->getIcon("djvIconB", 96);
+                DJV_ASSERT(image && *image == *b96);
+                DJV_ASSERT(!iconPack->getIcon("djvIconB", 192));
+            }
+
+            {
+                // Invalid icon packs throw an error.
+                {
+                    auto io = System::File::IO::create();
+                    io->open(fileName, System::File::Mode::Write);
+                    io->write(std::string("djvIconPack"));
+                }
+                auto iconPack = IconPack::create();
+                try
+                {
+                    iconPack->read(fileName);
+                    DJV_ASSERT(false);
+                }
+                catch (const std::exception& e)
+                {
+                    _print(e.what());
+                }
+                DJV_ASSERT(0 == iconPack->getCount());
+            }
+        }
+        
+    } // namespace UITest
+} // namespace djv